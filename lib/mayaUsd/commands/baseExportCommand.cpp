@@ -92,6 +92,10 @@ MSyntax MayaUSDExportCommand::createSyntax()
         kNormalizeNurbsFlag,
         UsdMayaJobExportArgsTokens->normalizeNurbs.GetText(),
         MSyntax::kBoolean);
+    syntax.addFlag(
+        kParallelWriteFlag,
+        UsdMayaJobExportArgsTokens->parallelWrite.GetText(),
+        MSyntax::kBoolean);
     syntax.addFlag(
         kExportColorSetsFlag,
         UsdMayaJobExportArgsTokens->exportColorSets.GetText(),
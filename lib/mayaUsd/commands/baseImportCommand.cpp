@@ -81,6 +81,10 @@ MSyntax MayaUSDImportCommand::createSyntax()
         kUseAsAnimationCacheFlag,
         UsdMayaJobImportArgsTokens->useAsAnimationCache.GetText(),
         MSyntax::kBoolean);
+    syntax.addFlag(
+        kParallelPrefetchFlag,
+        UsdMayaJobImportArgsTokens->parallelPrefetch.GetText(),
+        MSyntax::kBoolean);
 
     // Import chasers
     syntax.addFlag(
@@ -50,6 +50,7 @@ public:
     static constexpr auto kJobContextFlag = "jc";
     static constexpr auto kExcludePrimvarFlag = "epv";
     static constexpr auto kUseAsAnimationCacheFlag = "uac";
+    static constexpr auto kParallelPrefetchFlag = "ppf";
     static constexpr auto kImportChaserFlag = "chr";
     static constexpr auto kImportChaserArgsFlag = "cha";
 
@@ -64,6 +64,14 @@ void UsdMaya_FunctorPrimWriter::Write(const UsdTimeCode& usdTime)
     _modelPaths = ctx.GetModelPaths();
 }
 
+/* virtual */
+bool UsdMaya_FunctorPrimWriter::IsThreadSafe() const
+{
+    // The plugin function may query Maya and author anywhere on the stage, so
+    // it keeps the serial write.
+    return false;
+}
+
 /* virtual */
 bool UsdMaya_FunctorPrimWriter::ExportsGprims() const { return _exportsGprims; }
 
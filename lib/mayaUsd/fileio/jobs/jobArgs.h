@@ -86,6 +86,7 @@ TF_DECLARE_PUBLIC_TOKENS(
     (melPostCallback) \
     (mergeTransformAndShape) \
     (normalizeNurbs) \
+    (parallelWrite) \
     (parentScope) \
     (pythonPerFrameCallback) \
     (pythonPostCallback) \
@@ -133,6 +134,7 @@ TF_DECLARE_PUBLIC_TOKENS(
     (importInstances) \
     (importUSDZTextures) \
     (importUSDZTexturesFilePath) \
+    (parallelPrefetch) \
     /* assemblyRep values */ \
     (Collapsed) \
     (Full) \
@@ -193,6 +195,11 @@ struct UsdMayaJobExportArgs
     const bool normalizeNurbs;
     const bool stripNamespaces;
 
+    /// Whether animated frames are written with the two-phase parallel
+    /// write. Only prim writers that report themselves as thread-safe take
+    /// part in the parallel phase; all others are written serially.
+    const bool parallelWrite;
+
     /// This is the path of the USD prim under which *all* prims will be
     /// authored.
     const SdfPath      parentScope;
@@ -304,6 +311,9 @@ struct UsdMayaJobImportArgs
     const bool        importInstances;
     const bool        useAsAnimationCache;
     const bool        importWithProxyShapes;
+    /// Whether the USD data of upcoming prims is read on worker threads
+    /// while the prim readers create the Maya nodes on the main thread.
+    const bool parallelPrefetch;
     /// The interval over which to import animated data.
     /// An empty interval (<tt>GfInterval::IsEmpty()</tt>) means that no
     /// animated (time-sampled) data should be imported.
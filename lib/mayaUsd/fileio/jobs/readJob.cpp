@@ -16,6 +16,7 @@
 #include "readJob.h"
 
 #include <mayaUsd/fileio/chaser/importChaserRegistry.h>
+#include <mayaUsd/fileio/primReaderPrefetch.h>
 #include <mayaUsd/fileio/primReaderRegistry.h>
 #include <mayaUsd/fileio/translators/translatorMaterial.h>
 #include <mayaUsd/fileio/translators/translatorXformable.h>
@@ -60,6 +61,7 @@
 #include <ghc/filesystem.hpp>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -477,10 +479,20 @@ void UsdMaya_ReadJob::_ImportPrototype(
 {
     _PrimReaderMap     primReaderMap;
     const UsdPrimRange range = UsdPrimRange::PreAndPostVisit(prototype);
+
+    std::unique_ptr<UsdMayaPrimReaderPrefetcher> prefetcher;
+    if (mArgs.parallelPrefetch) {
+        prefetcher.reset(
+            new UsdMayaPrimReaderPrefetcher(UsdPrimRange(prototype), mArgs.timeInterval));
+    }
+
     for (auto primIt = range.begin(); primIt != range.end(); ++primIt) {
         const UsdPrim&           prim = *primIt;
         UsdMayaPrimReaderContext readCtx(&mNewNodeRegistry);
         readCtx.SetTimeSampleMultiplier(mTimeSampleMultiplier);
+        if (prefetcher) {
+            readCtx.SetPrefetchedData(prefetcher->Acquire(prim));
+        }
         if (prim.IsInstance()) {
             _DoImportInstanceIt(primIt, usdRootPrim, readCtx, primReaderMap);
         } else {
@@ -500,15 +512,27 @@ bool UsdMaya_ReadJob::_DoImport(UsdPrimRange& rootRange, const UsdPrim& usdRootP
         const UsdPrim& rootPrim = *rootIt;
         rootIt.PruneChildren();
 
-        _PrimReaderMap     primReaderMap;
-        const UsdPrimRange range = buildInstances
-            ? UsdPrimRange::PreAndPostVisit(rootPrim)
-            : UsdPrimRange::PreAndPostVisit(
-                rootPrim, UsdTraverseInstanceProxies(UsdPrimAllPrimsPredicate));
+        _PrimReaderMap               primReaderMap;
+        const Usd_PrimFlagsPredicate predicate = buildInstances
+            ? Usd_PrimFlagsPredicate(UsdPrimDefaultPredicate)
+            : UsdTraverseInstanceProxies(UsdPrimAllPrimsPredicate);
+        const UsdPrimRange range = UsdPrimRange::PreAndPostVisit(rootPrim, predicate);
+
+        // Read the USD data of the upcoming prims on worker threads, so that
+        // the prim readers below only have to create the Maya nodes.
+        std::unique_ptr<UsdMayaPrimReaderPrefetcher> prefetcher;
+        if (mArgs.parallelPrefetch) {
+            prefetcher.reset(new UsdMayaPrimReaderPrefetcher(
+                UsdPrimRange(rootPrim, predicate), mArgs.timeInterval));
+        }
+
         for (auto primIt = range.begin(); primIt != range.end(); ++primIt) {
             const UsdPrim&           prim = *primIt;
             UsdMayaPrimReaderContext readCtx(&mNewNodeRegistry);
             readCtx.SetTimeSampleMultiplier(mTimeSampleMultiplier);
+            if (prefetcher) {
+                readCtx.SetPrefetchedData(prefetcher->Acquire(prim));
+            }
 
             if (buildInstances && prim.IsInstance()) {
                 _DoImportInstanceIt(primIt, usdRootPrim, readCtx, primReaderMap);
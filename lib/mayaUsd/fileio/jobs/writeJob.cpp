@@ -24,6 +24,7 @@
 #include <pxr/pxr.h>
 #include <pxr/usd/ar/resolver.h>
 #include <pxr/usd/kind/registry.h>
+#include <pxr/usd/sdf/changeBlock.h>
 #include <pxr/usd/sdf/layer.h>
 #include <pxr/usd/sdf/primSpec.h>
 
@@ -39,9 +40,13 @@
 #include <maya/MStatus.h>
 #include <maya/MUuid.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <limits>
 #include <map>
 #include <unordered_set>
+#include <vector>
 // Needed for directly removing a UsdVariant via Sdf
 //   Remove when UsdVariantSet::RemoveVariant() is exposed
 //   XXX [bug 75864]
@@ -70,6 +75,21 @@
 
 PXR_NAMESPACE_OPEN_SCOPE
 
+namespace {
+
+// Writes a single time sample for the given prim writer, running the gather
+// and convert phases inline for writers that support the two-phase write.
+void _WritePrim(UsdMayaPrimWriter& primWriter, const UsdTimeCode& usdTime)
+{
+    if (primWriter.IsThreadSafe()) {
+        primWriter.GatherWriteData(usdTime);
+        primWriter.ConvertWriteData(usdTime);
+    }
+    primWriter.Write(usdTime);
+}
+
+} // namespace
+
 UsdMaya_WriteJob::UsdMaya_WriteJob(const UsdMayaJobExportArgs& iArgs)
     : mJobCtx(iArgs)
     , _modelKindProcessor(new UsdMaya_ModelKindProcessor(iArgs))
@@ -378,7 +398,7 @@ bool UsdMaya_WriteJob::_BeginWriting(const std::string& fileName, bool append)
                         return false;
                     }
 
-                    primWriter->Write(UsdTimeCode::Default());
+                    _WritePrim(*primWriter, UsdTimeCode::Default());
 
                     const UsdMayaUtil::MDagPathMap<SdfPath>& mapping
                         = primWriter->GetDagToUsdPathMapping();
@@ -445,10 +465,14 @@ bool UsdMaya_WriteJob::_WriteFrame(double iFrame)
 {
     const UsdTimeCode usdTime(iFrame);
 
-    for (const UsdMayaPrimWriterSharedPtr& primWriter : mJobCtx.mMayaPrimWriterList) {
-        const UsdPrim& usdPrim = primWriter->GetUsdPrim();
-        if (usdPrim) {
-            primWriter->Write(usdTime);
+    if (mJobCtx.mArgs.parallelWrite) {
+        _WritePrimsParallel(usdTime);
+    } else {
+        for (const UsdMayaPrimWriterSharedPtr& primWriter : mJobCtx.mMayaPrimWriterList) {
+            const UsdPrim& usdPrim = primWriter->GetUsdPrim();
+            if (usdPrim) {
+                _WritePrim(*primWriter, usdTime);
+            }
         }
     }
 
@@ -463,6 +487,52 @@ bool UsdMaya_WriteJob::_WriteFrame(double iFrame)
     return true;
 }
 
+void UsdMaya_WriteJob::_WritePrimsParallel(const UsdTimeCode& usdTime)
+{
+    std::vector<UsdMayaPrimWriter*> threadSafeWriters;
+    threadSafeWriters.reserve(mJobCtx.mMayaPrimWriterList.size());
+
+    // Writers that are not thread-safe keep the serial behavior. Thread-safe
+    // writers only read from Maya here, on the main thread.
+    for (const UsdMayaPrimWriterSharedPtr& primWriter : mJobCtx.mMayaPrimWriterList) {
+        const UsdPrim& usdPrim = primWriter->GetUsdPrim();
+        if (!usdPrim) {
+            continue;
+        }
+
+        if (primWriter->IsThreadSafe()) {
+            primWriter->GatherWriteData(usdTime);
+            threadSafeWriters.push_back(primWriter.get());
+        } else {
+            primWriter->Write(usdTime);
+        }
+    }
+
+    if (mJobCtx.mArgs.verbose) {
+        TF_STATUS("Parallel write: %zu prim writers", threadSafeWriters.size());
+    }
+
+    if (threadSafeWriters.empty()) {
+        return;
+    }
+
+    // Convert the gathered data without touching Maya or the stage.
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, threadSafeWriters.size()),
+        [&threadSafeWriters, &usdTime](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++i) {
+                threadSafeWriters[i]->ConvertWriteData(usdTime);
+            }
+        });
+
+    // Sdf layers do not support concurrent authoring, so the converted values
+    // are authored serially, batching all the change notices into one block.
+    SdfChangeBlock block;
+    for (UsdMayaPrimWriter* primWriter : threadSafeWriters) {
+        primWriter->Write(usdTime);
+    }
+}
+
 bool UsdMaya_WriteJob::_FinishWriting()
 {
     UsdPrimSiblingRange usdRootPrims = mJobCtx.mStage->GetPseudoRoot().GetChildren();
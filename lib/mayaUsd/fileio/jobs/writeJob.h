@@ -23,6 +23,7 @@
 
 #include <pxr/base/tf/hashmap.h>
 #include <pxr/pxr.h>
+#include <pxr/usd/usd/timeCode.h>
 
 #include <maya/MObjectHandle.h>
 
@@ -66,6 +67,11 @@ private:
     /// WriteFrame() call, internal code may generate errors.
     bool _WriteFrame(double iFrame);
 
+    /// Writes the prims at the given time with the two-phase parallel write:
+    /// thread-safe prim writers gather their Maya data on the main thread,
+    /// convert it in parallel, then author it serially.
+    void _WritePrimsParallel(const UsdTimeCode& usdTime);
+
     /// Runs any post-export processes, closes the USD stage, and writes it out
     /// to disk.
     bool _FinishWriting();
@@ -15,6 +15,8 @@
 //
 #include "primReaderContext.h"
 
+#include <mayaUsd/fileio/primReaderPrefetch.h>
+
 #include <pxr/base/tf/diagnostic.h>
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -22,6 +24,7 @@ PXR_NAMESPACE_OPEN_SCOPE
 UsdMayaPrimReaderContext::UsdMayaPrimReaderContext(ObjectRegistry* pathNodeMap)
     : _prune(false)
     , _timeSampleMultiplier(1.0)
+    , _prefetchedData(nullptr)
     , _pathNodeMap(pathNodeMap)
 {
 }
@@ -95,4 +98,18 @@ void UsdMayaPrimReaderContext::SetTimeSampleMultiplier(double multiplier)
     _timeSampleMultiplier = multiplier;
 };
 
+const UsdMayaPrefetchedPrimData*
+UsdMayaPrimReaderContext::GetPrefetchedData(const SdfPath& path) const
+{
+    if (_prefetchedData && _prefetchedData->path == path) {
+        return _prefetchedData;
+    }
+    return nullptr;
+}
+
+void UsdMayaPrimReaderContext::SetPrefetchedData(const UsdMayaPrefetchedPrimData* data)
+{
+    _prefetchedData = data;
+}
+
 PXR_NAMESPACE_CLOSE_SCOPE
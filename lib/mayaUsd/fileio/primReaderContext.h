@@ -25,6 +25,8 @@
 
 PXR_NAMESPACE_OPEN_SCOPE
 
+struct UsdMayaPrefetchedPrimData;
+
 /// \class UsdMayaPrimReaderContext
 /// \brief This class provides an interface for reader plugins to communicate
 /// state back to the core usd maya logic as well as retrieve information set by
@@ -94,12 +96,27 @@ public:
     MAYAUSD_CORE_PUBLIC
     void SetTimeSampleMultiplier(double multiplier);
 
+    /// \brief Returns the USD data of the prim at \p path that was read ahead
+    /// of time on a worker thread, or nullptr if it was not prefetched.
+    ///
+    /// Readers that use it must check that it was read for the time interval
+    /// they import, and read the prim themselves otherwise.
+    MAYAUSD_CORE_PUBLIC
+    const UsdMayaPrefetchedPrimData* GetPrefetchedData(const SdfPath& path) const;
+
+    /// \brief Set the prefetched data of the prim being read.
+    MAYAUSD_CORE_PUBLIC
+    void SetPrefetchedData(const UsdMayaPrefetchedPrimData* data);
+
     ~UsdMayaPrimReaderContext() { }
 
 private:
     bool   _prune;
     double _timeSampleMultiplier;
 
+    // Not owned, see UsdMayaPrimReaderPrefetcher.
+    const UsdMayaPrefetchedPrimData* _prefetchedData;
+
     // used to keep track of prims that are created.
     // for undo/redo
     ObjectRegistry* _pathNodeMap;
@@ -0,0 +1,121 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "primReaderPrefetch.h"
+
+#include <mayaUsd/fileio/translators/translatorMesh.h>
+#include <mayaUsd/fileio/translators/translatorXformable.h>
+
+#include <pxr/usd/usdGeom/mesh.h>
+#include <pxr/usd/usdGeom/primvarsAPI.h>
+#include <pxr/usd/usdGeom/xformable.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+UsdMayaPrimReaderPrefetcher::UsdMayaPrimReaderPrefetcher(
+    const UsdPrimRange& range,
+    const GfInterval&   timeInterval,
+    size_t              windowSize)
+    : _timeInterval(timeInterval)
+    , _windowSize(std::max<size_t>(windowSize, 1))
+{
+    for (const UsdPrim& prim : range) {
+        _indices.emplace(prim.GetPath(), _prims.size());
+        _prims.push_back(prim);
+    }
+    _data.resize(_prims.size());
+}
+
+UsdMayaPrimReaderPrefetcher::~UsdMayaPrimReaderPrefetcher() { _tasks.wait(); }
+
+const UsdMayaPrefetchedPrimData* UsdMayaPrimReaderPrefetcher::Acquire(const UsdPrim& prim)
+{
+    const auto it = _indices.find(prim.GetPath());
+    if (it == _indices.end() || it->second < _cursor) {
+        return nullptr;
+    }
+
+    // Make sure the window holding the prim has been staged.
+    const size_t index = it->second;
+    const size_t window = index / _windowSize;
+    if (window >= _completedWindows) {
+        _tasks.wait();
+        _completedWindows = std::max(_completedWindows, _scheduledWindows);
+        for (; _completedWindows <= window; ++_completedWindows) {
+            _StageWindow(_completedWindows);
+        }
+        _scheduledWindows = _completedWindows;
+    }
+
+    // Release the prims the main thread is done with, including the ones it
+    // skipped because their parent pruned them.
+    for (; _cursor < index; ++_cursor) {
+        _data[_cursor] = UsdMayaPrefetchedPrimData();
+    }
+
+    // Start on the next window while the caller creates the Maya nodes.
+    if (_scheduledWindows == window + 1 && _scheduledWindows * _windowSize < _prims.size()) {
+        const size_t next = _scheduledWindows++;
+        _tasks.run([this, next]() { _StageWindow(next); });
+    }
+
+    return &_data[index];
+}
+
+void UsdMayaPrimReaderPrefetcher::_StageWindow(size_t window)
+{
+    const size_t begin = window * _windowSize;
+    const size_t end = std::min(begin + _windowSize, _prims.size());
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(begin, end), [this](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++i) {
+                Prefetch(_prims[i], _timeInterval, &_data[i]);
+            }
+        });
+}
+
+/* static */
+void UsdMayaPrimReaderPrefetcher::Prefetch(
+    const UsdPrim&             prim,
+    const GfInterval&          timeInterval,
+    UsdMayaPrefetchedPrimData* data)
+{
+    data->path = prim.GetPath();
+    data->timeInterval = timeInterval;
+
+    if (prim.IsA<UsdGeomXformable>()) {
+        UsdMayaTranslatorXformable::Prefetch(UsdGeomXformable(prim), timeInterval, &data->xform);
+        data->hasXform = true;
+    }
+
+    if (prim.IsA<UsdGeomMesh>()) {
+        MayaUsd::TranslatorMeshRead::prefetch(UsdGeomMesh(prim), timeInterval, &data->mesh);
+        data->hasMesh = true;
+
+        // Primvars are only imported at the default time.
+        for (const UsdGeomPrimvar& primvar : UsdGeomPrimvarsAPI(prim).GetPrimvars()) {
+            UsdMayaPrefetchedPrimvar& staged = data->primvars[primvar.GetPrimvarName()];
+            primvar.Get(&staged.value);
+            staged.indexed = primvar.GetIndices(&staged.indices);
+        }
+    }
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
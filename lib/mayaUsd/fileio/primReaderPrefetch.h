@@ -0,0 +1,187 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef PXRUSDMAYA_PRIMREADERPREFETCH_H
+#define PXRUSDMAYA_PRIMREADERPREFETCH_H
+
+#include <mayaUsd/base/api.h>
+#include <mayaUsd/fileio/utils/xformStack.h>
+
+#include <pxr/base/gf/interval.h>
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/base/gf/vec3d.h>
+#include <pxr/base/gf/vec4d.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/base/vt/array.h>
+#include <pxr/base/vt/types.h>
+#include <pxr/base/vt/value.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/primRange.h>
+#include <pxr/usd/usd/timeCode.h>
+#include <pxr/usd/usdGeom/xformOp.h>
+
+#include <tbb/task_group.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// \brief Values of an attribute read at every time sample of the import
+/// interval, or at the earliest time if it has no samples in the interval.
+template <typename T> struct UsdMayaPrefetchedSamples
+{
+    std::vector<UsdTimeCode> times;
+    std::vector<T>           values;
+    /// Whether a value could be read at each time.
+    std::vector<bool> valid;
+    /// True if \c times holds time samples, false if it only holds the
+    /// earliest time.
+    bool animated = false;
+};
+
+/// \brief The transform of a UsdGeomXformable, as read by
+/// UsdMayaTranslatorXformable.
+struct UsdMayaPrefetchedXformData
+{
+    bool                           resetsXformStack = false;
+    std::vector<UsdGeomXformOp>    xformOps;
+    UsdMayaXformStack::OpClassList stackOps;
+
+    /// When the xform ops match a known stack, the value of each op, already
+    /// converted to radians for rotations. Inverted twins are left empty.
+    std::vector<UsdMayaPrefetchedSamples<GfVec3d>> opSamples;
+
+    /// Otherwise, the local transformation that will be decomposed.
+    UsdMayaPrefetchedSamples<GfMatrix4d> localTransformSamples;
+};
+
+/// \brief The topology, points and normals of a UsdGeomMesh, as read by
+/// MayaUsd::TranslatorMeshRead.
+struct UsdMayaPrefetchedMeshData
+{
+    /// Errors found while reading, to be reported on the main thread.
+    std::vector<std::string> errors;
+    bool                     validTopology = false;
+
+    VtIntArray faceVertexCounts;
+    /// Already reordered to be right-handed.
+    VtIntArray faceVertexIndices;
+
+    /// The points at the first time sample in the interval, as the
+    /// homogeneous coordinates MPointArray is built from.
+    std::vector<GfVec4d> points;
+    std::vector<double>  pointsTimeSamples;
+
+    VtVec3fArray normals;
+    TfToken      normalsInterpolation;
+    /// The face of each face-vertex, for MFnMesh::setFaceVertexNormals().
+    /// Only filled when there is one normal per face-vertex.
+    std::vector<int> normalsFaceIds;
+};
+
+/// \brief The value of a primvar at the default time, with its indices.
+struct UsdMayaPrefetchedPrimvar
+{
+    VtValue    value;
+    VtIntArray indices;
+    bool       indexed = false;
+};
+
+using UsdMayaPrefetchedPrimvarMap
+    = std::unordered_map<TfToken, UsdMayaPrefetchedPrimvar, TfToken::HashFunctor>;
+
+/// \brief Everything that was read ahead of time for a single prim.
+struct UsdMayaPrefetchedPrimData
+{
+    SdfPath path;
+    /// The interval the time samples were read for. Readers must fall back to
+    /// reading the prim themselves if they use a different one.
+    GfInterval timeInterval;
+
+    bool                       hasXform = false;
+    UsdMayaPrefetchedXformData xform;
+
+    bool                      hasMesh = false;
+    UsdMayaPrefetchedMeshData mesh;
+
+    UsdMayaPrefetchedPrimvarMap primvars;
+};
+
+/// \class UsdMayaPrimReaderPrefetcher
+/// \brief Reads and converts the USD data of the prims of a range on TBB
+/// worker threads, ahead of the prim readers that create the Maya nodes on
+/// the main thread.
+///
+/// Prims are staged in windows of consecutive prims: while the main thread
+/// works through one window, the next one is being read in the background.
+/// The staged data of a prim is released once the main thread moves past it.
+///
+/// Only USD is read by the worker threads, so the stage must not be edited
+/// while the prefetcher is alive.
+class UsdMayaPrimReaderPrefetcher
+{
+public:
+    /// \brief Prepares to prefetch the prims of \p range, in order, with their
+    /// time samples in \p timeInterval. Nothing is read until Acquire().
+    MAYAUSD_CORE_PUBLIC
+    UsdMayaPrimReaderPrefetcher(
+        const UsdPrimRange& range,
+        const GfInterval&   timeInterval,
+        size_t              windowSize = 256);
+
+    MAYAUSD_CORE_PUBLIC
+    ~UsdMayaPrimReaderPrefetcher();
+
+    UsdMayaPrimReaderPrefetcher(const UsdMayaPrimReaderPrefetcher&) = delete;
+    UsdMayaPrimReaderPrefetcher& operator=(const UsdMayaPrimReaderPrefetcher&) = delete;
+
+    /// \brief Returns the staged data of \p prim, waiting for it if needed,
+    /// and starts staging the upcoming prims.
+    ///
+    /// Prims must be acquired in range order. Prims that are skipped are
+    /// released. Returns nullptr if \p prim is not in the range or has
+    /// already been released.
+    MAYAUSD_CORE_PUBLIC
+    const UsdMayaPrefetchedPrimData* Acquire(const UsdPrim& prim);
+
+    /// \brief Reads the data of \p prim into \p data. Safe to call from any
+    /// thread, as long as the stage is not being edited.
+    MAYAUSD_CORE_PUBLIC
+    static void
+    Prefetch(const UsdPrim& prim, const GfInterval& timeInterval, UsdMayaPrefetchedPrimData* data);
+
+private:
+    void _StageWindow(size_t window);
+
+    std::vector<UsdPrim>                                _prims;
+    std::unordered_map<SdfPath, size_t, SdfPath::Hash> _indices;
+    std::vector<UsdMayaPrefetchedPrimData>              _data;
+    const GfInterval                                    _timeInterval;
+    const size_t                                        _windowSize;
+
+    size_t _cursor = 0;
+    size_t _scheduledWindows = 0;
+    size_t _completedWindows = 0;
+
+    tbb::task_group _tasks;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif
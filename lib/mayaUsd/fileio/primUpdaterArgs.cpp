@@ -34,6 +34,7 @@ static bool _Boolean(const VtDictionary& userArgs, const TfToken& key)
 
 UsdMayaPrimUpdaterArgs::UsdMayaPrimUpdaterArgs(const VtDictionary& userArgs)
     : _copyOperation(_Boolean(userArgs, UsdMayaPrimUpdaterArgsTokens->copyOperation))
+    , _skipUnchangedPrims(_Boolean(userArgs, UsdMayaPrimUpdaterArgsTokens->skipUnchangedPrims))
 {
 }
 
@@ -48,7 +49,10 @@ const VtDictionary& UsdMayaPrimUpdaterArgs::getDefaultDictionary()
 {
     static VtDictionary   d;
     static std::once_flag once;
-    std::call_once(once, []() { d[UsdMayaPrimUpdaterArgsTokens->copyOperation] = false; });
+    std::call_once(once, []() {
+        d[UsdMayaPrimUpdaterArgsTokens->copyOperation] = false;
+        d[UsdMayaPrimUpdaterArgsTokens->skipUnchangedPrims] = false;
+    });
 
     return d;
 }
@@ -29,7 +29,8 @@ PXR_NAMESPACE_OPEN_SCOPE
 // clang-format off
 #define PXRUSDMAYA_UPDATER_ARGS_TOKENS \
     /* Dictionary keys */ \
-    (copyOperation)
+    (copyOperation) \
+    (skipUnchangedPrims)
 // clang-format on
 
 TF_DECLARE_PUBLIC_TOKENS(
@@ -43,6 +44,10 @@ struct UsdMayaPrimUpdaterArgs
 {
     const bool _copyOperation { false };
 
+    // Prims whose exported subtree is identical to the destination layer are
+    // not given to their updater for merging.
+    const bool _skipUnchangedPrims { false };
+
     MAYAUSD_CORE_PUBLIC
     static UsdMayaPrimUpdaterArgs createFromDictionary(const VtDictionary& userArgs);
 
@@ -37,6 +37,7 @@
 #include <pxr/usd/usd/editContext.h>
 #include <pxr/usd/usd/prim.h>
 #include <pxr/usd/usd/primRange.h>
+#include <pxr/usd/usd/stage.h>
 
 #include <maya/MAnimControl.h>
 #include <maya/MDagModifier.h>
@@ -54,6 +55,8 @@
 
 #include <functional>
 #include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 
 using UpdaterFactoryFn = UsdMayaPrimUpdaterRegistry::UpdaterFactoryFn;
 using namespace MAYAUSD_NS_DEF;
@@ -93,6 +96,106 @@ const MString kPullDGMetadataKey("Pull_UfePath");
 // Name of Dag node under which all pulled sub-hierarchies are rooted.
 const MString kPullRootName("__mayaUsd__");
 
+//------------------------------------------------------------------------------
+//
+// Index of the pull information of the prims of each stage, to find the pulled prims without
+// reading the metadata of every prim. The index of a stage is built from its session layer, where
+// the pull information is written, the first time it is needed. It is then kept up to date by
+// writePullInformation() and removePullInformation(), and discarded when the pull information is
+// edited by other means, like an undo of the session layer edits.
+class PulledPrimsIndex
+{
+public:
+    using PulledPrims = std::unordered_map<SdfPath, std::string, SdfPath::Hash>;
+
+    static PulledPrimsIndex& instance()
+    {
+        static PulledPrimsIndex index;
+        return index;
+    }
+
+    const PulledPrims& get(const UsdStagePtr& stage)
+    {
+        auto it = _stages.find(get_pointer(stage));
+        if (it != _stages.end() && it->second._stage == stage) {
+            return it->second._prims;
+        }
+
+        StageIndex& index = _stages[get_pointer(stage)];
+        index._stage = stage;
+        index._prims.clear();
+
+        const SdfLayerHandle sessionLayer = stage->GetSessionLayer();
+        if (!sessionLayer) {
+            return index._prims;
+        }
+        sessionLayer->Traverse(SdfPath::AbsoluteRootPath(), [&](const SdfPath& path) {
+            if (!path.IsPrimPath()) {
+                return;
+            }
+            const VtValue customData = sessionLayer->GetField(path, SdfFieldKeys->CustomData);
+            if (!customData.IsHolding<VtDictionary>()) {
+                return;
+            }
+            const VtValue* dagPath = customData.UncheckedGet<VtDictionary>().GetValueAtPath(
+                kPullPrimMetadataKey.GetString());
+            if (dagPath && dagPath->IsHolding<std::string>()
+                && !dagPath->UncheckedGet<std::string>().empty()) {
+                index._prims[path] = dagPath->UncheckedGet<std::string>();
+            }
+        });
+
+        return index._prims;
+    }
+
+    // Records the pull information of a prim, an empty DAG path removing it.
+    void set(const UsdPrim& prim, const std::string& dagPathStr)
+    {
+        ++_version;
+
+        auto it = _stages.find(get_pointer(prim.GetStage()));
+        if (it == _stages.end() || it->second._stage != prim.GetStage()) {
+            return;
+        }
+        if (dagPathStr.empty()) {
+            it->second._prims.erase(prim.GetPath());
+        } else {
+            it->second._prims[prim.GetPath()] = dagPathStr;
+        }
+    }
+
+    void invalidate(const UsdStagePtr& stage)
+    {
+        if (_stages.erase(get_pointer(stage)) > 0) {
+            ++_version;
+        }
+    }
+
+    // Increased whenever pulled prims are added or removed.
+    size_t version() const { return _version; }
+
+    // True while writePullInformation() or removePullInformation() edit the pull information.
+    bool isUpdating() const { return _updating; }
+
+    class UpdateScope
+    {
+    public:
+        UpdateScope() { PulledPrimsIndex::instance()._updating = true; }
+        ~UpdateScope() { PulledPrimsIndex::instance()._updating = false; }
+    };
+
+private:
+    struct StageIndex
+    {
+        UsdStageWeakPtr _stage;
+        PulledPrims     _prims;
+    };
+
+    std::unordered_map<const UsdStage*, StageIndex> _stages;
+    size_t                                          _version { 0 };
+    bool                                            _updating { false };
+};
+
 MObject findPullRoot()
 {
     // Try to find one in the scene.
@@ -167,9 +270,13 @@ bool writePullInformation(const Ufe::Path& ufePulledPath, const MDagPath& path)
     auto stage = pulledPrim.GetStage();
     if (!stage)
         return false;
-    UsdEditContext editContext(stage, stage->GetSessionLayer());
-    VtValue        value(path.fullPathName().asChar());
-    pulledPrim.SetCustomDataByKey(kPullPrimMetadataKey, value);
+    {
+        PulledPrimsIndex::UpdateScope updateScope;
+        UsdEditContext                editContext(stage, stage->GetSessionLayer());
+        const std::string             dagPathStr(path.fullPathName().asChar());
+        pulledPrim.SetCustomDataByKey(kPullPrimMetadataKey, VtValue(dagPathStr));
+        PulledPrimsIndex::instance().set(pulledPrim, dagPathStr);
+    }
 
     // Store medata on DG node
     auto              ufePathString = Ufe::PathString::string(ufePulledPath);
@@ -202,8 +309,10 @@ void removePullInformation(const Ufe::Path& ufePulledPath)
     auto    stage = prim.GetStage();
     if (!stage)
         return;
-    UsdEditContext editContext(stage, stage->GetSessionLayer());
+    PulledPrimsIndex::UpdateScope updateScope;
+    UsdEditContext                editContext(stage, stage->GetSessionLayer());
     prim.ClearCustomDataByKey(kPullPrimMetadataKey);
+    PulledPrimsIndex::instance().set(prim, std::string());
 
     // Session layer cleanup
     for (const SdfPrimSpecHandle& rootPrimSpec : stage->GetSessionLayer()->GetRootPrims()) {
@@ -579,6 +688,74 @@ UsdMayaPrimUpdaterSharedPtr createUpdater(
     return factory(depNodeFn, ufePath);
 }
 
+//------------------------------------------------------------------------------
+//
+// Verify if a spec of the exported layer is identical to the destination spec,
+// with the same fields holding the same values.
+bool isSpecIdentical(
+    const SdfLayerRefPtr& srcLayer,
+    const SdfPath&        srcPath,
+    const SdfLayerHandle& dstLayer,
+    const SdfPath&        dstPath)
+{
+    if (srcLayer->GetSpecType(srcPath) != dstLayer->GetSpecType(dstPath)) {
+        return false;
+    }
+
+    const std::vector<TfToken> srcFields = srcLayer->ListFields(srcPath);
+    if (srcFields.size() != dstLayer->ListFields(dstPath).size()) {
+        return false;
+    }
+
+    for (const TfToken& field : srcFields) {
+        VtValue dstValue;
+        if (!dstLayer->HasField(dstPath, field, &dstValue)
+            || srcLayer->GetField(srcPath, field) != dstValue) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//
+// Find the specs of the exported layer that differ from the destination layer,
+// along with their ancestors up to the exported root.  A prim that is not in
+// the returned set has an exported subtree identical to the destination, so
+// merging it would not author anything.
+using ChangedPaths = std::unordered_set<SdfPath, SdfPath::Hash>;
+
+ChangedPaths findChangedPaths(
+    const SdfLayerRefPtr& srcLayer,
+    const SdfPath&        srcRootPath,
+    const SdfLayerHandle& dstLayer,
+    const SdfPath&        dstRootParentPath)
+{
+    ChangedPaths  changedPaths;
+    const SdfPath dstRootPath = makeDstPath(dstRootParentPath, srcRootPath);
+
+    // The traversal is post-order: once a child has changed, its parent is
+    // known to have changed and does not need to be compared.
+    srcLayer->Traverse(srcRootPath, [&](const SdfPath& srcPath) {
+        if (changedPaths.count(srcPath) > 0) {
+            return;
+        }
+
+        const SdfPath dstPath = srcPath.ReplacePrefix(srcRootPath, dstRootPath);
+        if (isSpecIdentical(srcLayer, srcPath, dstLayer, dstPath)) {
+            return;
+        }
+
+        SdfPath path = srcPath;
+        while (path.HasPrefix(srcRootPath) && changedPaths.insert(path).second) {
+            path = path.GetParentPath();
+        }
+    });
+
+    return changedPaths;
+}
+
 //------------------------------------------------------------------------------
 //
 // Perform the customization step of the merge to USD (second step).  Traverse
@@ -603,41 +780,58 @@ bool pushCustomize(
     auto dstRootParentPath = dstRootPath.GetParentPath();
     const auto& dstLayer = editTarget.GetLayer();
 
+    // When skipping unchanged prims, the exported subtrees identical to the
+    // destination layer are pruned from the traversal, so that only the edited
+    // parts of a large pulled hierarchy are diffed and merged.
+    const bool   skipUnchanged = context.GetArgs()._skipUnchangedPrims;
+    ChangedPaths changedPaths;
+    if (skipUnchanged) {
+        changedPaths = findChangedPaths(srcLayer, srcRootPath, dstLayer, dstRootParentPath);
+    }
+
     // Traverse the layer, creating a prim updater for each primSpec
     // along the way, and call PushCopySpec on the prim.
-    auto pushCopySpecsFn
-        = [&context, &ufePulledPath, srcStage, srcLayer, dstLayer, dstRootParentPath](
-              const SdfPath& srcPath) {
-              // We can be called with a primSpec path that is not a prim path
-              // (e.g. a property path like "/A.xformOp:translate").  This is not an
-              // error, just prune the traversal.  FIXME Is this still true?  We
-              // should not be traversing property specs.  PPT, 20-Oct-2021.
-              if (!srcPath.IsPrimPath()) {
-                  return false;
-              }
-
-              auto dstPath = makeDstPath(dstRootParentPath, srcPath);
-              auto updater
-                  = createUpdater(ufePulledPath, srcLayer, srcPath, dstLayer, dstPath, context);
-              // If we cannot find an updater for the srcPath, prune the traversal.
-              if (!updater) {
-                  TF_WARN(
-                      "Could not create a prim updater for path %s during PushCopySpecs traversal, "
-                      "pruning at that point.",
-                      srcPath.GetText());
-                  return false;
-              }
-
-              // Report PushCopySpecs() failure.
-              auto result = updater->pushCopySpecs(
-                  srcStage, srcLayer, srcPath, context.GetUsdStage(), dstLayer, dstPath);
-              if (result == UsdMayaPrimUpdater::PushCopySpecs::Failed) {
-                  throw MayaUsd::TraversalFailure(std::string("PushCopySpecs() failed."), srcPath);
-              }
-
-              // If we don't continue, we prune.
-              return result == UsdMayaPrimUpdater::PushCopySpecs::Continue;
-          };
+    auto pushCopySpecsFn = [&context,
+                            &ufePulledPath,
+                            &changedPaths,
+                            skipUnchanged,
+                            srcStage,
+                            srcLayer,
+                            dstLayer,
+                            dstRootParentPath](const SdfPath& srcPath) {
+        // We can be called with a primSpec path that is not a prim path
+        // (e.g. a property path like "/A.xformOp:translate").  This is not an
+        // error, just prune the traversal.  FIXME Is this still true?  We
+        // should not be traversing property specs.  PPT, 20-Oct-2021.
+        if (!srcPath.IsPrimPath()) {
+            return false;
+        }
+
+        if (skipUnchanged && changedPaths.count(srcPath) == 0) {
+            return false;
+        }
+
+        auto dstPath = makeDstPath(dstRootParentPath, srcPath);
+        auto updater = createUpdater(ufePulledPath, srcLayer, srcPath, dstLayer, dstPath, context);
+        // If we cannot find an updater for the srcPath, prune the traversal.
+        if (!updater) {
+            TF_WARN(
+                "Could not create a prim updater for path %s during PushCopySpecs traversal, "
+                "pruning at that point.",
+                srcPath.GetText());
+            return false;
+        }
+
+        // Report PushCopySpecs() failure.
+        auto result = updater->pushCopySpecs(
+            srcStage, srcLayer, srcPath, context.GetUsdStage(), dstLayer, dstPath);
+        if (result == UsdMayaPrimUpdater::PushCopySpecs::Failed) {
+            throw MayaUsd::TraversalFailure(std::string("PushCopySpecs() failed."), srcPath);
+        }
+
+        // If we don't continue, we prune.
+        return result == UsdMayaPrimUpdater::PushCopySpecs::Continue;
+    };
 
     if (!MayaUsd::traverseLayer(srcLayer, srcRootPath, pushCopySpecsFn)) {
         return false;
@@ -1093,6 +1287,20 @@ bool PrimUpdaterManager::duplicate(
 void PrimUpdaterManager::onProxyContentChanged(
     const MayaUsdProxyStageObjectsChangedNotice& proxyNotice)
 {
+    const UsdNotice::ObjectsChanged& notice = proxyNotice.GetNotice();
+
+    // Resyncs and prim metadata changes can add or remove pull information, unless they were made
+    // while maintaining the index.
+    if (!PulledPrimsIndex::instance().isUpdating()) {
+        bool pullInfoChanged = !notice.GetResyncedPaths().empty();
+        for (const SdfPath& path : notice.GetChangedInfoOnlyPaths()) {
+            pullInfoChanged = pullInfoChanged || path.IsPrimPath();
+        }
+        if (pullInfoChanged) {
+            PulledPrimsIndex::instance().invalidate(notice.GetStage());
+        }
+    }
+
     if (_inPushPull) {
         return;
     }
@@ -1126,8 +1334,6 @@ void PrimUpdaterManager::onProxyContentChanged(
         return false;
     };
 
-    const UsdNotice::ObjectsChanged& notice = proxyNotice.GetNotice();
-
     Usd_PrimFlagsPredicate predicate = UsdPrimDefaultPredicate;
 
     auto stage = notice.GetStage();
@@ -1302,6 +1508,33 @@ bool PrimUpdaterManager::readPullInformation(const PXR_NS::UsdPrim& prim, std::s
     return false;
 }
 
+bool PrimUpdaterManager::findPulledPrim(const PXR_NS::UsdPrim& prim, std::string& dagPathStr)
+{
+    auto stage = prim.GetStage();
+    if (!stage) {
+        return false;
+    }
+
+    const auto& pulledPrims = PulledPrimsIndex::instance().get(stage);
+    const auto  found = pulledPrims.find(prim.GetPath());
+    if (found == pulledPrims.end()) {
+        return false;
+    }
+
+    dagPathStr = found->second;
+    return true;
+}
+
+bool PrimUpdaterManager::hasPulledPrims(const PXR_NS::UsdStagePtr& stage)
+{
+    return stage && !PulledPrimsIndex::instance().get(stage).empty();
+}
+
+size_t PrimUpdaterManager::pulledPrimsVersion() const
+{
+    return PulledPrimsIndex::instance().version();
+}
+
 /* static */
 bool PrimUpdaterManager::readPullInformation(
     const PXR_NS::UsdPrim& prim,
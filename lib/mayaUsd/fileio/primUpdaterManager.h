@@ -77,6 +77,19 @@ public:
 
     bool hasPulledPrims() const { return _hasPulledPrims; }
 
+    /// \brief Finds the Maya DAG path of a pulled prim in the index of the pulled prims of its
+    /// stage, which is faster than reading the pull information of the prim.
+    MAYAUSD_CORE_PUBLIC
+    bool findPulledPrim(const PXR_NS::UsdPrim& prim, std::string& dagPathStr);
+
+    /// \brief Returns true if prims of the stage are edited as Maya.
+    MAYAUSD_CORE_PUBLIC
+    bool hasPulledPrims(const PXR_NS::UsdStagePtr& stage);
+
+    /// \brief Increased whenever the pulled prims of a stage may have changed.
+    MAYAUSD_CORE_PUBLIC
+    size_t pulledPrimsVersion() const;
+
 private:
     PrimUpdaterManager();
 
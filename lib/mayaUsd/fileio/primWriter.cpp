@@ -218,6 +218,15 @@ bool UsdMayaPrimWriter::ExportsGprims() const { return false; }
 /* virtual */
 bool UsdMayaPrimWriter::ShouldPruneChildren() const { return false; }
 
+/* virtual */
+bool UsdMayaPrimWriter::IsThreadSafe() const { return false; }
+
+/* virtual */
+void UsdMayaPrimWriter::GatherWriteData(const UsdTimeCode&) { }
+
+/* virtual */
+void UsdMayaPrimWriter::ConvertWriteData(const UsdTimeCode&) { }
+
 /* virtual */
 void UsdMayaPrimWriter::PostExport() { MakeSingleSamplesStatic(); }
 
@@ -75,6 +75,36 @@ public:
     MAYAUSD_CORE_PUBLIC
     virtual void Write(const UsdTimeCode& usdTime);
 
+    /// Whether this prim writer supports the two-phase write used by the
+    /// parallelWrite export mode.
+    ///
+    /// Thread-safe writers split each time sample into three calls:
+    /// GatherWriteData() runs on the main thread and is the only place where
+    /// Maya may be queried; ConvertWriteData() may run concurrently with other
+    /// writers and must neither call into Maya nor author to USD; Write() then
+    /// authors the converted values on the main thread. Write() must only
+    /// author values on prims that were defined in the constructor.
+    ///
+    /// Base implementation returns \c false, in which case only Write() is
+    /// called.
+    MAYAUSD_CORE_PUBLIC
+    virtual bool IsThreadSafe() const;
+
+    /// Reads the Maya data needed to write \p usdTime. Always called on the
+    /// main thread, and only for writers for which IsThreadSafe() is \c true.
+    ///
+    /// Base implementation does nothing.
+    MAYAUSD_CORE_PUBLIC
+    virtual void GatherWriteData(const UsdTimeCode& usdTime);
+
+    /// Converts the data read by GatherWriteData() into USD values. May be
+    /// called from a worker thread, and only for writers for which
+    /// IsThreadSafe() is \c true.
+    ///
+    /// Base implementation does nothing.
+    MAYAUSD_CORE_PUBLIC
+    virtual void ConvertWriteData(const UsdTimeCode& usdTime);
+
     /// Post export function that runs before saving the stage.
     ///
     /// Base implementation handles optional optimization of data.
@@ -79,31 +79,53 @@ static void setXformOp(
 }
 
 /* static */
-void UsdMayaTransformWriter::_ComputeXformOps(
+void UsdMayaTransformWriter::_GatherXformValues(
+    const std::vector<_AnimChannel>& animChanList,
+    _XformValues*                    xformValues)
+{
+    xformValues->values.resize(animChanList.size());
+
+    // Retrieve the default value and pull the Maya data if needed.
+    for (size_t c = 0; c < animChanList.size(); ++c) {
+        const _AnimChannel& animChannel = animChanList[c];
+        if (animChannel.isInverse) {
+            continue;
+        }
+
+        GfVec3d& value = xformValues->values[c];
+        value = animChannel.defValue;
+        for (unsigned int i = 0u; i < 3u; ++i) {
+            if (animChannel.sampleType[i] == _SampleType::Animated) {
+                value[i] = animChannel.plug[i].asDouble();
+            }
+        }
+    }
+}
+
+/* static */
+void UsdMayaTransformWriter::_ConvertXformValues(
     const std::vector<_AnimChannel>&           animChanList,
     const UsdTimeCode&                         usdTime,
     const bool                                 eulerFilter,
     UsdMayaTransformWriter::_TokenRotationMap* previousRotates,
-    UsdUtilsSparseValueWriter*                 valueWriter)
+    _XformValues*                              xformValues)
 {
+    xformValues->shouldSet.assign(animChanList.size(), false);
+
     if (!TF_VERIFY(previousRotates)) {
         return;
     }
 
-    // Iterate over each _AnimChannel, retrieve the default value and pull the
-    // Maya data if needed. Then store it on the USD Ops
-    for (const auto& animChannel : animChanList) {
-
+    for (size_t c = 0; c < animChanList.size(); ++c) {
+        const _AnimChannel& animChannel = animChanList[c];
         if (animChannel.isInverse) {
             continue;
         }
 
-        GfVec3d value = animChannel.defValue;
-        bool    hasAnimated = false;
-        bool    hasStatic = false;
+        bool hasAnimated = false;
+        bool hasStatic = false;
         for (unsigned int i = 0u; i < 3u; ++i) {
             if (animChannel.sampleType[i] == _SampleType::Animated) {
-                value[i] = animChannel.plug[i].asDouble();
                 hasAnimated = true;
             } else if (animChannel.sampleType[i] == _SampleType::Static) {
                 hasStatic = true;
@@ -121,6 +143,7 @@ void UsdMayaTransformWriter::_ComputeXformOps(
         if ((usdTime == UsdTimeCode::Default() && hasStatic && !hasAnimated)
             || (usdTime != UsdTimeCode::Default() && hasAnimated)) {
 
+            GfVec3d& value = xformValues->values[c];
             if (animChannel.opType == _XformType::Rotate) {
                 if (hasAnimated && eulerFilter) {
                     const TfToken& lookupName = animChannel.opName.IsEmpty()
@@ -151,11 +174,39 @@ void UsdMayaTransformWriter::_ComputeXformOps(
                 }
             }
 
-            setXformOp(animChannel.op, value, usdTime, valueWriter);
+            xformValues->shouldSet[c] = true;
         }
     }
 }
 
+/* static */
+void UsdMayaTransformWriter::_SetXformOps(
+    const std::vector<_AnimChannel>& animChanList,
+    const UsdTimeCode&               usdTime,
+    const _XformValues&              xformValues,
+    UsdUtilsSparseValueWriter*       valueWriter)
+{
+    for (size_t c = 0; c < animChanList.size(); ++c) {
+        if (xformValues.shouldSet[c]) {
+            setXformOp(animChanList[c].op, xformValues.values[c], usdTime, valueWriter);
+        }
+    }
+}
+
+/* static */
+void UsdMayaTransformWriter::_ComputeXformOps(
+    const std::vector<_AnimChannel>&           animChanList,
+    const UsdTimeCode&                         usdTime,
+    const bool                                 eulerFilter,
+    UsdMayaTransformWriter::_TokenRotationMap* previousRotates,
+    UsdUtilsSparseValueWriter*                 valueWriter)
+{
+    _XformValues xformValues;
+    _GatherXformValues(animChanList, &xformValues);
+    _ConvertXformValues(animChanList, usdTime, eulerFilter, previousRotates, &xformValues);
+    _SetXformOps(animChanList, usdTime, xformValues, valueWriter);
+}
+
 /* static */
 bool UsdMayaTransformWriter::_GatherAnimChannel(
     const _XformType           opType,
@@ -514,25 +565,62 @@ UsdMayaTransformWriter::UsdMayaTransformWriter(
     }
 }
 
+bool UsdMayaTransformWriter::_WritesXformOps() const
+{
+    // There are special cases where you might subclass UsdMayaTransformWriter
+    // without actually having a transform (e.g. the internal
+    // UsdMaya_FunctorPrimWriter), so accomodate those here.
+    //
+    // There are also valid cases where we have a transform in Maya but not one
+    // in USD, e.g. typeless defs or other container prims in USD.
+    return GetMayaObject().hasFn(MFn::kTransform) && UsdGeomXformable(_usdPrim);
+}
+
 /* virtual */
 void UsdMayaTransformWriter::Write(const UsdTimeCode& usdTime)
 {
     UsdMayaPrimWriter::Write(usdTime);
 
-    // There are special cases where you might subclass UsdMayaTransformWriter
-    // without actually having a transform (e.g. the internal
-    // UsdMaya_FunctorPrimWriter), so accomodate those here.
-    if (GetMayaObject().hasFn(MFn::kTransform)) {
-        // There are valid cases where we have a transform in Maya but not one
-        // in USD, e.g. typeless defs or other container prims in USD.
-        if (UsdGeomXformable xformSchema = UsdGeomXformable(_usdPrim)) {
-            _ComputeXformOps(
-                _animChannels,
-                usdTime,
-                _GetExportArgs().eulerFilter,
-                &_previousRotates,
-                _GetSparseValueWriter());
-        }
+    // Only use the values if they were both gathered and converted for this time.
+    if (_hasXformValues && _xformValuesTime == usdTime
+        && _xformValues.shouldSet.size() == _animChannels.size()) {
+        _SetXformOps(_animChannels, usdTime, _xformValues, _GetSparseValueWriter());
+        _hasXformValues = false;
+    } else if (_WritesXformOps()) {
+        _ComputeXformOps(
+            _animChannels,
+            usdTime,
+            _GetExportArgs().eulerFilter,
+            &_previousRotates,
+            _GetSparseValueWriter());
+    }
+}
+
+/* virtual */
+bool UsdMayaTransformWriter::IsThreadSafe() const { return true; }
+
+/* virtual */
+void UsdMayaTransformWriter::GatherWriteData(const UsdTimeCode& usdTime)
+{
+    _hasXformValues = false;
+    _xformValues.shouldSet.clear();
+    if (_WritesXformOps()) {
+        _GatherXformValues(_animChannels, &_xformValues);
+        _xformValuesTime = usdTime;
+        _hasXformValues = true;
+    }
+}
+
+/* virtual */
+void UsdMayaTransformWriter::ConvertWriteData(const UsdTimeCode& usdTime)
+{
+    if (_hasXformValues && _xformValuesTime == usdTime) {
+        _ConvertXformValues(
+            _animChannels,
+            usdTime,
+            _GetExportArgs().eulerFilter,
+            &_previousRotates,
+            &_xformValues);
     }
 }
 
@@ -57,6 +57,18 @@ public:
     MAYAUSD_CORE_PUBLIC
     void Write(const UsdTimeCode& usdTime) override;
 
+    /// The xform op values are read from Maya in GatherWriteData() and
+    /// converted (euler filtering, units) in ConvertWriteData(), Write() only
+    /// authors them.
+    MAYAUSD_CORE_PUBLIC
+    bool IsThreadSafe() const override;
+
+    MAYAUSD_CORE_PUBLIC
+    void GatherWriteData(const UsdTimeCode& usdTime) override;
+
+    MAYAUSD_CORE_PUBLIC
+    void ConvertWriteData(const UsdTimeCode& usdTime) override;
+
 private:
     using _TokenRotationMap
         = std::unordered_map<const TfToken, MEulerRotation, TfToken::HashFunctor>;
@@ -94,6 +106,36 @@ private:
         UsdGeomXformOp            op;
     };
 
+    // The xformOp values of each _AnimChannel at a given time, and whether
+    // they must be authored at that time.
+    struct _XformValues
+    {
+        std::vector<GfVec3d> values;
+        std::vector<bool>    shouldSet;
+    };
+
+    // For a given array of _AnimChannels, reads the value of the animated
+    // components from Maya. The other components keep their default value.
+    static void
+    _GatherXformValues(const std::vector<_AnimChannel>& animChanList, _XformValues* xformValues);
+
+    // For a given array of _AnimChannels and time, converts the gathered
+    // values into xformOp values and flags the ones to author. Does not call
+    // into the Maya scene nor into USD, so it can run on a worker thread.
+    static void _ConvertXformValues(
+        const std::vector<_AnimChannel>&           animChanList,
+        const UsdTimeCode&                         usdTime,
+        const bool                                 eulerFilter,
+        UsdMayaTransformWriter::_TokenRotationMap* previousRotates,
+        _XformValues*                              xformValues);
+
+    // Sets the xformOps' values that were flagged for authoring.
+    static void _SetXformOps(
+        const std::vector<_AnimChannel>& animChanList,
+        const UsdTimeCode&               usdTime,
+        const _XformValues&              xformValues,
+        UsdUtilsSparseValueWriter*       valueWriter);
+
     // For a given array of _AnimChannels and time, compute the xformOp data if
     // needed and set the xformOps' values.
     static void _ComputeXformOps(
@@ -126,8 +168,17 @@ private:
         const UsdGeomXformable& usdXForm,
         const bool              writeAnim);
 
+    // Whether the xform ops of this writer are authored at all.
+    bool _WritesXformOps() const;
+
     std::vector<_AnimChannel> _animChannels;
     _TokenRotationMap         _previousRotates;
+
+    // The values gathered by GatherWriteData() at _xformValuesTime. Once
+    // converted by ConvertWriteData(), they are authored by Write().
+    _XformValues _xformValues;
+    UsdTimeCode  _xformValuesTime { UsdTimeCode::Default() };
+    bool         _hasXformValues { false };
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
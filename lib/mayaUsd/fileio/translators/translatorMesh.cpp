@@ -15,6 +15,7 @@
 //
 #include "translatorMesh.h"
 
+#include <mayaUsd/fileio/primReaderPrefetch.h>
 #include <mayaUsd/fileio/utils/meshReadUtils.h>
 #include <mayaUsd/fileio/utils/meshWriteUtils.h>
 #include <mayaUsd/fileio/utils/readUtil.h>
@@ -62,122 +63,40 @@ TranslatorMeshRead::TranslatorMeshRead(
 {
     MStatus stat { MS::kSuccess };
 
-    // ==============================================
-    // construct a Maya mesh
-    // ==============================================
-    VtIntArray faceVertexCounts;
-    VtIntArray faceVertexIndices;
-
-    const UsdAttribute fvc = mesh.GetFaceVertexCountsAttr();
-    if (fvc.ValueMightBeTimeVarying()) {
-        // at some point, it would be great, instead of failing, to create a usd/hydra proxy node
-        // for the mesh, perhaps?  For now, better to give a more specific error
-        TF_RUNTIME_ERROR(
-            "<%s> is a topologically varying Mesh (has animated "
-            "faceVertexCounts), which isn't currently supported. "
-            "Skipping...",
-            prim.GetPath().GetText());
-    } else {
-        fvc.Get(&faceVertexCounts, UsdTimeCode::EarliestTime());
-    }
-
-    const UsdAttribute fvi = mesh.GetFaceVertexIndicesAttr();
-    if (fvi.ValueMightBeTimeVarying()) {
-        // at some point, it would be great, instead of failing, to create a usd/hydra proxy node
-        // for the mesh, perhaps?  For now, better to give a more specific error
-        TF_RUNTIME_ERROR(
-            "<%s> is a topologically varying Mesh (has animated "
-            "faceVertexIndices), which isn't currently supported. "
-            "Skipping...",
-            prim.GetPath().GetText());
-    } else {
-        fvi.Get(&faceVertexIndices, UsdTimeCode::EarliestTime());
-    }
-
-    // Sanity Checks. If the vertex arrays are empty, skip this mesh
-    if (faceVertexCounts.empty() || faceVertexIndices.empty()) {
-        TF_RUNTIME_ERROR(
-            "faceVertexCounts or faceVertexIndices array is empty "
-            "[count: %zu, indices:%zu] on Mesh <%s>. Skipping...",
-            faceVertexCounts.size(),
-            faceVertexIndices.size(),
-            prim.GetPath().GetText());
-    }
-
-    // If the USD mesh was left-handed, then the faces had their vertices in left-handed order.
-    // Fix them to be in right-handed order, as expected by Maya.
-    if (isPrimitiveLeftHanded(mesh)) {
-        size_t firstIndex = 0;
-        for (int vertexCount : faceVertexCounts) {
-            std::reverse(
-                faceVertexIndices.begin() + firstIndex,
-                faceVertexIndices.begin() + firstIndex + vertexCount);
-            firstIndex += vertexCount;
+    // Use the mesh data that was prefetched for this prim if there is one,
+    // otherwise read it now.
+    UsdMayaPrefetchedMeshData        localData;
+    const UsdMayaPrefetchedMeshData* data = nullptr;
+    if (context) {
+        const UsdMayaPrefetchedPrimData* prefetched = context->GetPrefetchedData(prim.GetPath());
+        if (prefetched && prefetched->hasMesh && prefetched->timeInterval == frameRange) {
+            data = &prefetched->mesh;
         }
     }
-
-    // Gather points and normals
-    // If timeInterval is non-empty, pick the first available sample in the
-    // timeInterval or default.
-    VtVec3fArray        points;
-    VtVec3fArray        normals;
-    TfToken             normalsInterpolation;
-    UsdTimeCode         pointsTimeSample = UsdTimeCode::EarliestTime();
-    UsdTimeCode         normalsTimeSample = UsdTimeCode::EarliestTime();
-    std::vector<double> pointsTimeSamples;
-
-    if (!frameRange.IsEmpty()) {
-        mesh.GetPointsAttr().GetTimeSamplesInInterval(frameRange, &pointsTimeSamples);
-        if (!pointsTimeSamples.empty()) {
-            m_pointsNumTimeSamples = pointsTimeSamples.size();
-            pointsTimeSample = pointsTimeSamples.front();
-        }
-
-        std::vector<double> normalsTimeSamples;
-        mesh.GetNormalsAttr().GetTimeSamplesInInterval(frameRange, &normalsTimeSamples);
-        if (!normalsTimeSamples.empty()) {
-            normalsTimeSample = normalsTimeSamples.front();
-        }
-    }
-
-    mesh.GetPointsAttr().Get(&points, pointsTimeSample);
-
-    /* If 'normals' and 'primvars:normals' are both specified, the latter has precedence. */
-    UsdGeomPrimvar primvar = mesh.GetPrimvar(UsdGeomTokens->normals);
-
-    if (primvar.HasValue()) {
-        primvar.ComputeFlattened(&normals, normalsTimeSample);
-        normalsInterpolation = primvar.GetInterpolation();
-    } else {
-        mesh.GetNormalsAttr().Get(&normals, normalsTimeSample);
-        normalsInterpolation = mesh.GetNormalsInterpolation();
+    if (!data) {
+        prefetch(mesh, frameRange, &localData);
+        data = &localData;
     }
 
-    if (points.empty()) {
-        TF_RUNTIME_ERROR(
-            "points array is empty on Mesh <%s>. Skipping...", prim.GetPath().GetText());
+    for (const std::string& error : data->errors) {
+        TF_RUNTIME_ERROR("%s", error.c_str());
     }
-
-    std::string reason;
-    if (!UsdGeomMesh::ValidateTopology(
-            faceVertexIndices, faceVertexCounts, points.size(), &reason)) {
-        TF_RUNTIME_ERROR(
-            "Skipping Mesh <%s> with invalid topology: %s",
-            prim.GetPath().GetText(),
-            reason.c_str());
+    if (!data->validTopology) {
         *status = MS::kFailure;
         return;
     }
 
+    const std::vector<double>& pointsTimeSamples = data->pointsTimeSamples;
+    m_pointsNumTimeSamples = pointsTimeSamples.size();
+
     // == Convert data to Maya ( vertices, faces, indices )
-    const size_t mayaNumVertices = points.size();
-    MPointArray  mayaPoints(mayaNumVertices);
-    for (size_t i = 0u; i < mayaNumVertices; ++i) {
-        mayaPoints.set(i, points[i][0], points[i][1], points[i][2]);
-    }
+    const size_t mayaNumVertices = data->points.size();
+    MPointArray  mayaPoints(
+        reinterpret_cast<const double(*)[4]>(data->points.data()),
+        static_cast<unsigned int>(mayaNumVertices));
 
-    MIntArray polygonCounts(faceVertexCounts.cdata(), faceVertexCounts.size());
-    MIntArray polygonConnects(faceVertexIndices.cdata(), faceVertexIndices.size());
+    MIntArray polygonCounts(data->faceVertexCounts.cdata(), data->faceVertexCounts.size());
+    MIntArray polygonConnects(data->faceVertexIndices.cdata(), data->faceVertexIndices.size());
 
     // == Create Mesh Shape Node
     MFnMesh meshFn;
@@ -209,22 +128,16 @@ TranslatorMeshRead::TranslatorMeshRead(
     m_shapePath = prim.GetPath().AppendChild(TfToken(shapeName));
 
     // Set normals if supplied
-    MIntArray normalsFaceIds;
-    if (normals.size() == static_cast<size_t>(meshFn.numFaceVertices())) {
-        for (size_t i = 0u; i < polygonCounts.length(); ++i) {
-            for (int j = 0; j < polygonCounts[i]; ++j) {
-                normalsFaceIds.append(i);
-            }
+    const VtVec3fArray& normals = data->normals;
+    MIntArray           normalsFaceIds(data->normalsFaceIds.data(), data->normalsFaceIds.size());
+    if (normals.size() == static_cast<size_t>(meshFn.numFaceVertices())
+        && normalsFaceIds.length() == static_cast<size_t>(meshFn.numFaceVertices())) {
+        MVectorArray mayaNormals(normals.size());
+        for (size_t i = 0u; i < normals.size(); ++i) {
+            mayaNormals.set(MVector(normals[i][0u], normals[i][1u], normals[i][2u]), i);
         }
 
-        if (normalsFaceIds.length() == static_cast<size_t>(meshFn.numFaceVertices())) {
-            MVectorArray mayaNormals(normals.size());
-            for (size_t i = 0u; i < normals.size(); ++i) {
-                mayaNormals.set(MVector(normals[i][0u], normals[i][1u], normals[i][2u]), i);
-            }
-
-            meshFn.setFaceVertexNormals(mayaNormals, normalsFaceIds, polygonConnects);
-        }
+        meshFn.setFaceVertexNormals(mayaNormals, normalsFaceIds, polygonConnects);
     }
 
     // If we are dealing with polys, check if there are normals and set the
@@ -233,7 +146,7 @@ TranslatorMeshRead::TranslatorMeshRead(
     TfToken subdScheme;
     if (mesh.GetSubdivisionSchemeAttr().Get(&subdScheme) && subdScheme == UsdGeomTokens->none) {
         if (normals.size() == static_cast<size_t>(meshFn.numFaceVertices())
-            && normalsInterpolation == UsdGeomTokens->faceVarying) {
+            && data->normalsInterpolation == UsdGeomTokens->faceVarying) {
             UsdMayaMeshReadUtils::setEmitNormalsTag(meshFn, true);
         }
     } else {
@@ -269,6 +182,8 @@ TranslatorMeshRead::TranslatorMeshRead(
     MFnBlendShapeDeformer blendFn;
     m_meshBlendObj = blendFn.create(m_meshObj);
 
+    VtVec3fArray points;
+    VtVec3fArray animNormals;
     for (unsigned int ti = 0u; ti < m_pointsNumTimeSamples; ++ti) {
         mesh.GetPointsAttr().Get(&points, pointsTimeSamples[ti]);
 
@@ -302,12 +217,13 @@ TranslatorMeshRead::TranslatorMeshRead(
         // NOTE: This normal information is not propagated through the blendShapes, only the
         // controlPoints.
         //
-        mesh.GetNormalsAttr().Get(&normals, pointsTimeSamples[ti]);
-        if (normals.size() == static_cast<size_t>(meshFn.numFaceVertices())
+        mesh.GetNormalsAttr().Get(&animNormals, pointsTimeSamples[ti]);
+        if (animNormals.size() == static_cast<size_t>(meshFn.numFaceVertices())
             && normalsFaceIds.length() == static_cast<size_t>(meshFn.numFaceVertices())) {
-            MVectorArray mayaNormals(normals.size());
-            for (size_t i = 0; i < normals.size(); ++i) {
-                mayaNormals.set(MVector(normals[i][0u], normals[i][1u], normals[i][2u]), i);
+            MVectorArray mayaNormals(animNormals.size());
+            for (size_t i = 0; i < animNormals.size(); ++i) {
+                mayaNormals.set(
+                    MVector(animNormals[i][0u], animNormals[i][1u], animNormals[i][2u]), i);
             }
 
             meshFn.setFaceVertexNormals(mayaNormals, normalsFaceIds, polygonConnects);
@@ -352,6 +268,132 @@ TranslatorMeshRead::TranslatorMeshRead(
     *status = stat;
 }
 
+void TranslatorMeshRead::prefetch(
+    const UsdGeomMesh&         mesh,
+    const GfInterval&          frameRange,
+    UsdMayaPrefetchedMeshData* data)
+{
+    const UsdPrim& prim = mesh.GetPrim();
+
+    // ==============================================
+    // construct a Maya mesh
+    // ==============================================
+    VtIntArray& faceVertexCounts = data->faceVertexCounts;
+    VtIntArray& faceVertexIndices = data->faceVertexIndices;
+
+    const UsdAttribute fvc = mesh.GetFaceVertexCountsAttr();
+    if (fvc.ValueMightBeTimeVarying()) {
+        // at some point, it would be great, instead of failing, to create a usd/hydra proxy node
+        // for the mesh, perhaps?  For now, better to give a more specific error
+        data->errors.push_back(TfStringPrintf(
+            "<%s> is a topologically varying Mesh (has animated "
+            "faceVertexCounts), which isn't currently supported. "
+            "Skipping...",
+            prim.GetPath().GetText()));
+    } else {
+        fvc.Get(&faceVertexCounts, UsdTimeCode::EarliestTime());
+    }
+
+    const UsdAttribute fvi = mesh.GetFaceVertexIndicesAttr();
+    if (fvi.ValueMightBeTimeVarying()) {
+        // at some point, it would be great, instead of failing, to create a usd/hydra proxy node
+        // for the mesh, perhaps?  For now, better to give a more specific error
+        data->errors.push_back(TfStringPrintf(
+            "<%s> is a topologically varying Mesh (has animated "
+            "faceVertexIndices), which isn't currently supported. "
+            "Skipping...",
+            prim.GetPath().GetText()));
+    } else {
+        fvi.Get(&faceVertexIndices, UsdTimeCode::EarliestTime());
+    }
+
+    // Sanity Checks. If the vertex arrays are empty, skip this mesh
+    if (faceVertexCounts.empty() || faceVertexIndices.empty()) {
+        data->errors.push_back(TfStringPrintf(
+            "faceVertexCounts or faceVertexIndices array is empty "
+            "[count: %zu, indices:%zu] on Mesh <%s>. Skipping...",
+            faceVertexCounts.size(),
+            faceVertexIndices.size(),
+            prim.GetPath().GetText()));
+    }
+
+    // If the USD mesh was left-handed, then the faces had their vertices in left-handed order.
+    // Fix them to be in right-handed order, as expected by Maya.
+    if (isPrimitiveLeftHanded(mesh)) {
+        size_t firstIndex = 0;
+        for (int vertexCount : faceVertexCounts) {
+            std::reverse(
+                faceVertexIndices.begin() + firstIndex,
+                faceVertexIndices.begin() + firstIndex + vertexCount);
+            firstIndex += vertexCount;
+        }
+    }
+
+    // Gather points and normals
+    // If timeInterval is non-empty, pick the first available sample in the
+    // timeInterval or default.
+    VtVec3fArray points;
+    UsdTimeCode  pointsTimeSample = UsdTimeCode::EarliestTime();
+    UsdTimeCode  normalsTimeSample = UsdTimeCode::EarliestTime();
+
+    if (!frameRange.IsEmpty()) {
+        mesh.GetPointsAttr().GetTimeSamplesInInterval(frameRange, &data->pointsTimeSamples);
+        if (!data->pointsTimeSamples.empty()) {
+            pointsTimeSample = data->pointsTimeSamples.front();
+        }
+
+        std::vector<double> normalsTimeSamples;
+        mesh.GetNormalsAttr().GetTimeSamplesInInterval(frameRange, &normalsTimeSamples);
+        if (!normalsTimeSamples.empty()) {
+            normalsTimeSample = normalsTimeSamples.front();
+        }
+    }
+
+    mesh.GetPointsAttr().Get(&points, pointsTimeSample);
+
+    /* If 'normals' and 'primvars:normals' are both specified, the latter has precedence. */
+    UsdGeomPrimvar primvar = mesh.GetPrimvar(UsdGeomTokens->normals);
+
+    if (primvar.HasValue()) {
+        primvar.ComputeFlattened(&data->normals, normalsTimeSample);
+        data->normalsInterpolation = primvar.GetInterpolation();
+    } else {
+        mesh.GetNormalsAttr().Get(&data->normals, normalsTimeSample);
+        data->normalsInterpolation = mesh.GetNormalsInterpolation();
+    }
+
+    if (points.empty()) {
+        data->errors.push_back(TfStringPrintf(
+            "points array is empty on Mesh <%s>. Skipping...", prim.GetPath().GetText()));
+    }
+
+    std::string reason;
+    if (!UsdGeomMesh::ValidateTopology(
+            faceVertexIndices, faceVertexCounts, points.size(), &reason)) {
+        data->errors.push_back(TfStringPrintf(
+            "Skipping Mesh <%s> with invalid topology: %s",
+            prim.GetPath().GetText(),
+            reason.c_str()));
+        return;
+    }
+    data->validTopology = true;
+
+    // == Convert data to Maya ( vertices, faces, indices )
+    data->points.resize(points.size());
+    for (size_t i = 0u; i < points.size(); ++i) {
+        data->points[i].Set(points[i][0], points[i][1], points[i][2], 1.0);
+    }
+
+    // The face of each face-vertex, to set the normals if supplied
+    if (data->normals.size() == faceVertexIndices.size()) {
+        data->normalsFaceIds.reserve(faceVertexIndices.size());
+        for (size_t i = 0u; i < faceVertexCounts.size(); ++i) {
+            data->normalsFaceIds.insert(
+                data->normalsFaceIds.end(), faceVertexCounts[i], static_cast<int>(i));
+        }
+    }
+}
+
 bool TranslatorMeshRead::isPrimitiveLeftHanded(const UsdGeomGprim& prim)
 {
     TfToken orientation;
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <mayaUsd/base/api.h>
+#include <mayaUsd/fileio/primReaderPrefetch.h>
 #include <mayaUsd/fileio/primReaderRegistry.h>
 
 #include <pxr/pxr.h>
@@ -62,6 +63,14 @@ public:
 
     SdfPath shapePath() const;
 
+    /// Reads and converts the topology, points and normals of \p mesh into
+    /// \p data. Only USD is read, so this can run on any thread. The mesh
+    /// translator uses the data prefetched in the context when there is some.
+    static void prefetch(
+        const UsdGeomMesh&         mesh,
+        const GfInterval&          frameRange,
+        UsdMayaPrefetchedMeshData* data);
+
 private:
     MStatus setPointBasedDeformerForMayaNode(const MObject&, const MObject&, const UsdPrim&);
 
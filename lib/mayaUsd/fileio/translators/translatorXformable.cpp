@@ -15,6 +15,7 @@
 //
 #include "translatorXformable.h"
 
+#include <mayaUsd/fileio/primReaderPrefetch.h>
 #include <mayaUsd/fileio/translators/translatorPrim.h>
 #include <mayaUsd/fileio/translators/translatorUtil.h>
 #include <mayaUsd/fileio/utils/xformStack.h>
@@ -201,14 +202,48 @@ static void _setMayaAttribute(
     }
 }
 
+// Sets the times to read the samples at: the time samples in the import interval, or the
+// earliest time if there are none.
+template <typename T>
+static void _setSampleTimes(
+    const std::vector<double>&   timeSamples,
+    const T&                     initialValue,
+    UsdMayaPrefetchedSamples<T>* samples)
+{
+    samples->animated = !timeSamples.empty();
+    if (samples->animated) {
+        samples->times.assign(timeSamples.cbegin(), timeSamples.cend());
+    } else {
+        samples->times.assign(1u, UsdTimeCode::EarliestTime());
+    }
+    samples->values.assign(samples->times.size(), initialValue);
+    samples->valid.assign(samples->times.size(), false);
+}
+
+// Reads the values of a given xformop, either time sampled or not.
+static void _readXformOpSamples(
+    const UsdGeomXformOp&              xformop,
+    const GfInterval&                  timeInterval,
+    UsdMayaPrefetchedSamples<GfVec3d>* samples)
+{
+    std::vector<double> timeSamples;
+    if (!timeInterval.IsEmpty()) {
+        xformop.GetTimeSamplesInInterval(timeInterval, &timeSamples);
+    }
+    _setSampleTimes(timeSamples, GfVec3d(0.0), samples);
+    for (size_t ti = 0u; ti < samples->times.size(); ++ti) {
+        samples->valid[ti] = _getXformOpAsVec3d(xformop, samples->values[ti], samples->times[ti]);
+    }
+}
+
 // For each xformop, we gather it's data either time sampled or not and we push
 // it to the corresponding Maya xform
 static bool _pushUSDXformOpToMayaXform(
-    const UsdGeomXformOp&           xformop,
-    const TfToken&                  opName,
-    MFnDagNode&                     MdagNode,
-    const UsdMayaPrimReaderArgs&    args,
-    const UsdMayaPrimReaderContext* context)
+    const UsdGeomXformOp&                    xformop,
+    const UsdMayaPrefetchedSamples<GfVec3d>& samples,
+    const TfToken&                           opName,
+    MFnDagNode&                              MdagNode,
+    const UsdMayaPrimReaderContext*          context)
 {
     MTime::Unit timeUnit = MTime::uiUnit();
     double timeSampleMultiplier = (context != nullptr) ? context->GetTimeSampleMultiplier() : 1.0;
@@ -216,33 +251,30 @@ static bool _pushUSDXformOpToMayaXform(
     std::vector<double> xValue;
     std::vector<double> yValue;
     std::vector<double> zValue;
-    GfVec3d             value;
-    std::vector<double> timeSamples;
-    if (!args.GetTimeInterval().IsEmpty()) {
-        xformop.GetTimeSamplesInInterval(args.GetTimeInterval(), &timeSamples);
-    }
-    MTimeArray timeArray;
-    if (!timeSamples.empty()) {
-        timeArray.setLength(timeSamples.size());
-        xValue.resize(timeSamples.size());
-        yValue.resize(timeSamples.size());
-        zValue.resize(timeSamples.size());
-        for (unsigned int ti = 0; ti < timeSamples.size(); ++ti) {
-            UsdTimeCode time(timeSamples[ti]);
-            if (_getXformOpAsVec3d(xformop, value, time)) {
+    MTimeArray          timeArray;
+    if (samples.animated) {
+        const size_t numSamples = samples.times.size();
+        timeArray.setLength(numSamples);
+        xValue.resize(numSamples);
+        yValue.resize(numSamples);
+        zValue.resize(numSamples);
+        for (unsigned int ti = 0; ti < numSamples; ++ti) {
+            if (samples.valid[ti]) {
+                const GfVec3d& value = samples.values[ti];
                 xValue[ti] = value[0];
                 yValue[ti] = value[1];
                 zValue[ti] = value[2];
-                timeArray.set(MTime(timeSamples[ti] * timeSampleMultiplier, timeUnit), ti);
+                timeArray.set(
+                    MTime(samples.times[ti].GetValue() * timeSampleMultiplier, timeUnit), ti);
             } else {
                 TF_RUNTIME_ERROR(
                     "Missing sampled data on xformOp: %s", xformop.GetName().GetText());
             }
         }
     } else {
-        // pick the first available sample or default
-        UsdTimeCode time = UsdTimeCode::EarliestTime();
-        if (_getXformOpAsVec3d(xformop, value, time)) {
+        // the first available sample or default was picked
+        if (!samples.valid.empty() && samples.valid[0]) {
+            const GfVec3d& value = samples.values[0];
             xValue.resize(1);
             yValue.resize(1);
             zValue.resize(1);
@@ -370,38 +402,41 @@ static bool _isIdentityMatrix(const GfMatrix4d& m)
     return GfIsClose(m, identityMatrix, tolerance);
 }
 
+// Reads the local transformation of the xformable, either time sampled or not.
+static void _readLocalTransformSamples(
+    const UsdGeomXformable&               xformSchema,
+    const GfInterval&                     timeInterval,
+    UsdMayaPrefetchedSamples<GfMatrix4d>* samples)
+{
+    std::vector<double> timeSamples;
+    if (!timeInterval.IsEmpty()) {
+        xformSchema.GetTimeSamplesInInterval(timeInterval, &timeSamples);
+    }
+    _setSampleTimes(timeSamples, GfMatrix4d(1.0), samples);
+    for (size_t ti = 0u; ti < samples->times.size(); ++ti) {
+        bool resetsXformStack;
+        samples->valid[ti] = xformSchema.GetLocalTransformation(
+            &samples->values[ti], &resetsXformStack, samples->times[ti]);
+    }
+}
+
 // For each xformop, we gather it's data either time sampled or not and we push it to the
 // corresponding Maya xform
 static bool _pushUSDXformToMayaXform(
-    const UsdGeomXformable&         xformSchema,
-    MFnDagNode&                     MdagNode,
-    const UsdMayaPrimReaderArgs&    args,
-    const UsdMayaPrimReaderContext* context)
+    const UsdGeomXformable&                     xformSchema,
+    const UsdMayaPrefetchedSamples<GfMatrix4d>& samples,
+    MFnDagNode&                                 MdagNode,
+    const UsdMayaPrimReaderContext*             context)
 {
     MTime::Unit timeUnit = MTime::uiUnit();
     double timeSampleMultiplier = (context != nullptr) ? context->GetTimeSampleMultiplier() : 1.0;
 
-    std::vector<double> timeSamples;
-    if (!args.GetTimeInterval().IsEmpty()) {
-        xformSchema.GetTimeSamplesInInterval(args.GetTimeInterval(), &timeSamples);
-    }
-
-    std::vector<UsdTimeCode> timeCodes;
-    MTimeArray               timeArray;
-
-    if (!timeSamples.empty()) {
-        // Convert all the time samples to UsdTimeCodes.
-        std::transform(
-            timeSamples.cbegin(),
-            timeSamples.cend(),
-            std::back_inserter(timeCodes),
-            [](const double timeSample) { return UsdTimeCode(timeSample); });
-
+    // If there were no time samples, the first available sample or default was picked and the
+    // MTimeArray is left empty.
+    const std::vector<UsdTimeCode>& timeCodes = samples.times;
+    MTimeArray                      timeArray;
+    if (samples.animated) {
         timeArray.setLength(timeCodes.size());
-    } else {
-        // If there were no time samples, pick the first available sample or default and
-        // leave the MTimeArray empty.
-        timeCodes.push_back(UsdTimeCode::EarliestTime());
     }
 
     // Storage for all of the components of the Maya transform attributes. Maya
@@ -422,11 +457,8 @@ static bool _pushUSDXformToMayaXform(
 
     for (size_t ti = 0u; ti < timeCodes.size(); ++ti) {
         const UsdTimeCode& timeCode = timeCodes[ti];
-
-        GfMatrix4d usdLocalTransform(1.0);
-        bool       resetsXformStack;
-        if (!xformSchema.GetLocalTransformation(&usdLocalTransform, &resetsXformStack, timeCode)
-            && !xformSchema.GetPrim().IsInstance()) {
+        const GfMatrix4d&  usdLocalTransform = samples.values[ti];
+        if (!samples.valid[ti] && !xformSchema.GetPrim().IsInstance()) {
             if (timeCode.IsDefault()) {
                 TF_RUNTIME_ERROR(
                     "Missing xform data at the default time on USD prim <%s>",
@@ -488,7 +520,7 @@ static bool _pushUSDXformToMayaXform(
         ShearXZVal[ti] = shear[1];
         ShearYZVal[ti] = shear[2];
 
-        if (!timeSamples.empty()) {
+        if (samples.animated) {
             timeArray.set(MTime(timeCode.GetValue() * timeSampleMultiplier, timeUnit), ti);
         }
     }
@@ -531,28 +563,29 @@ void UsdMayaTranslatorXformable::Read(
     // Read parent class attrs
     UsdMayaTranslatorPrim::Read(xformSchema.GetPrim(), mayaNode, args, context);
 
-    // Scanning Xformops to see if we have a general Maya xform or an xform
-    // that conform to the commonAPI
-    //
-    // If fail to retrieve proper ops with proper name and order, will try to
-    // decompose the xform matrix
-    bool                        resetsXformStack = false;
-    std::vector<UsdGeomXformOp> xformops = xformSchema.GetOrderedXformOps(&resetsXformStack);
-
-    // When we find ops, we match the ops by suffix ("" will define the basic
-    // translate, rotate, scale) and by order. If we find an op with a
-    // different name or out of order that will miss the match, we will rely on
-    // matrix decomposition
-
-    UsdMayaXformStack::OpClassList stackOps = UsdMayaXformStack::FirstMatchingSubstack(
-        { &UsdMayaXformStack::MayaStack(), &UsdMayaXformStack::CommonStack() }, xformops);
+    // Use the xform data that was prefetched for this prim if there is one,
+    // otherwise read it now.
+    UsdMayaPrefetchedXformData        localData;
+    const UsdMayaPrefetchedXformData* data = nullptr;
+    if (context) {
+        const UsdMayaPrefetchedPrimData* prefetched
+            = context->GetPrefetchedData(xformSchema.GetPath());
+        if (prefetched && prefetched->hasXform
+            && prefetched->timeInterval == args.GetTimeInterval()) {
+            data = &prefetched->xform;
+        }
+    }
+    if (!data) {
+        Prefetch(xformSchema, args.GetTimeInterval(), &localData);
+        data = &localData;
+    }
 
     MFnDagNode MdagNode(mayaNode);
-    if (!stackOps.empty()) {
+    if (!data->stackOps.empty()) {
         // make sure stackIndices.size() == xformops.size()
-        for (unsigned int i = 0; i < stackOps.size(); i++) {
-            const UsdGeomXformOp&               xformop(xformops[i]);
-            const UsdMayaXformOpClassification& opDef(stackOps[i]);
+        for (unsigned int i = 0; i < data->stackOps.size(); i++) {
+            const UsdGeomXformOp&               xformop(data->xformOps[i]);
+            const UsdMayaXformOpClassification& opDef(data->stackOps[i]);
             // If we got a valid stack, we have both the members of the inverted twins..
             // ...so we can go ahead and skip the inverted twin
             if (opDef.IsInvertedTwin())
@@ -560,21 +593,53 @@ void UsdMayaTranslatorXformable::Read(
 
             const TfToken& opName(opDef.GetName());
 
-            _pushUSDXformOpToMayaXform(xformop, opName, MdagNode, args, context);
+            _pushUSDXformOpToMayaXform(xformop, data->opSamples[i], opName, MdagNode, context);
         }
     } else {
-        if (!_pushUSDXformToMayaXform(xformSchema, MdagNode, args, context)) {
+        if (!_pushUSDXformToMayaXform(
+                xformSchema, data->localTransformSamples, MdagNode, context)) {
             TF_RUNTIME_ERROR(
                 "Unable to successfully decompose matrix at USD prim <%s>",
                 xformSchema.GetPath().GetText());
         }
     }
 
-    if (resetsXformStack) {
+    if (data->resetsXformStack) {
         MPlug plg = MdagNode.findPlug("inheritsTransform");
         if (!plg.isNull())
             plg.setBool(false);
     }
 }
 
+void UsdMayaTranslatorXformable::Prefetch(
+    const UsdGeomXformable&     xformSchema,
+    const GfInterval&           timeInterval,
+    UsdMayaPrefetchedXformData* data)
+{
+    // Scanning Xformops to see if we have a general Maya xform or an xform
+    // that conform to the commonAPI
+    //
+    // If fail to retrieve proper ops with proper name and order, will try to
+    // decompose the xform matrix
+    data->xformOps = xformSchema.GetOrderedXformOps(&data->resetsXformStack);
+
+    // When we find ops, we match the ops by suffix ("" will define the basic
+    // translate, rotate, scale) and by order. If we find an op with a
+    // different name or out of order that will miss the match, we will rely on
+    // matrix decomposition
+    data->stackOps = UsdMayaXformStack::FirstMatchingSubstack(
+        { &UsdMayaXformStack::MayaStack(), &UsdMayaXformStack::CommonStack() }, data->xformOps);
+
+    if (!data->stackOps.empty()) {
+        data->opSamples.resize(data->stackOps.size());
+        for (size_t i = 0u; i < data->stackOps.size(); ++i) {
+            if (!data->stackOps[i].IsInvertedTwin()) {
+                _readXformOpSamples(data->xformOps[i], timeInterval, &data->opSamples[i]);
+            }
+        }
+    } else {
+        _readLocalTransformSamples(xformSchema, timeInterval, &data->localTransformSamples);
+    }
+}
+
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -19,7 +19,9 @@
 #include <mayaUsd/base/api.h>
 #include <mayaUsd/fileio/primReaderArgs.h>
 #include <mayaUsd/fileio/primReaderContext.h>
+#include <mayaUsd/fileio/primReaderPrefetch.h>
 
+#include <pxr/base/gf/interval.h>
 #include <pxr/base/gf/matrix4d.h>
 #include <pxr/base/gf/vec3d.h>
 #include <pxr/pxr.h>
@@ -33,7 +35,8 @@ PXR_NAMESPACE_OPEN_SCOPE
 struct UsdMayaTranslatorXformable
 {
     /// \brief reads xform attributes from \p xformable and converts them into
-    /// maya transform values.
+    /// maya transform values. The data prefetched in \p context for the prim
+    /// is used when there is some.
     MAYAUSD_CORE_PUBLIC
     static void Read(
         const UsdGeomXformable&      xformable,
@@ -41,6 +44,15 @@ struct UsdMayaTranslatorXformable
         const UsdMayaPrimReaderArgs& args,
         UsdMayaPrimReaderContext*    context);
 
+    /// \brief reads the xform ops of \p xformable, or its local
+    /// transformation if they do not match a known stack, at its time samples
+    /// in \p timeInterval. Only USD is read, so this can run on any thread.
+    MAYAUSD_CORE_PUBLIC
+    static void Prefetch(
+        const UsdGeomXformable&     xformable,
+        const GfInterval&           timeInterval,
+        UsdMayaPrefetchedXformData* data);
+
     /// \brief Convenince function for decomposing \p usdMatrix.
     MAYAUSD_CORE_PUBLIC
     static bool ConvertUsdMatrixToComponents(
@@ -189,12 +189,54 @@ MIntArray getMayaFaceVertexAssignmentIds(
     return valueIds;
 }
 
-bool assignUVSetPrimvarToMesh(const UsdGeomPrimvar& primvar, MFnMesh& meshFn, bool& firstUVPrimvar)
+// Gets the value of the primvar from its prefetched data if there is some, otherwise reads it.
+template <typename T>
+bool getPrimvarValue(
+    const UsdGeomPrimvar&           primvar,
+    const UsdMayaPrefetchedPrimvar* prefetched,
+    T*                              value)
+{
+    if (prefetched && prefetched->value.IsHolding<T>()) {
+        *value = prefetched->value.UncheckedGet<T>();
+        return true;
+    }
+    return primvar.Get(value);
+}
+
+bool getPrimvarValue(
+    const UsdGeomPrimvar&           primvar,
+    const UsdMayaPrefetchedPrimvar* prefetched,
+    VtValue*                        value)
+{
+    if (prefetched && !prefetched->value.IsEmpty()) {
+        *value = prefetched->value;
+        return true;
+    }
+    return primvar.Get(value);
+}
+
+bool getPrimvarIndices(
+    const UsdGeomPrimvar&           primvar,
+    const UsdMayaPrefetchedPrimvar* prefetched,
+    VtIntArray*                     indices)
+{
+    if (prefetched) {
+        *indices = prefetched->indices;
+        return prefetched->indexed;
+    }
+    return primvar.GetIndices(indices);
+}
+
+bool assignUVSetPrimvarToMesh(
+    const UsdGeomPrimvar&           primvar,
+    const UsdMayaPrefetchedPrimvar* prefetched,
+    MFnMesh&                        meshFn,
+    bool&                           firstUVPrimvar)
 {
     const TfToken& primvarName = primvar.GetPrimvarName();
 
     VtVec2fArray uvValues;
-    if (!primvar.Get(&uvValues) || uvValues.empty()) {
+    if (!getPrimvarValue(primvar, prefetched, &uvValues) || uvValues.empty()) {
         TF_WARN(
             "Could not read UV values from primvar '%s' on mesh: %s",
             primvarName.GetText(),
@@ -263,7 +305,7 @@ bool assignUVSetPrimvarToMesh(const UsdGeomPrimvar& primvar, MFnMesh& meshFn, bo
     }
 
     VtIntArray assignmentIndices;
-    if (primvar.GetIndices(&assignmentIndices)) {
+    if (getPrimvarIndices(primvar, prefetched, &assignmentIndices)) {
         if (unauthoredValuesIndex >= 0) {
             // Since the unauthored value was removed above, we need to fix up
             // the assignment indices to replace any index equal to the
@@ -309,9 +351,10 @@ bool assignUVSetPrimvarToMesh(const UsdGeomPrimvar& primvar, MFnMesh& meshFn, bo
 }
 
 bool assignColorSetPrimvarToMesh(
-    const UsdGeomMesh&    mesh,
-    const UsdGeomPrimvar& primvar,
-    MFnMesh&              meshFn)
+    const UsdGeomMesh&              mesh,
+    const UsdGeomPrimvar&           primvar,
+    const UsdMayaPrefetchedPrimvar* prefetched,
+    MFnMesh&                        meshFn)
 {
 
     const TfToken&          primvarName = primvar.GetPrimvarName();
@@ -351,7 +394,7 @@ bool assignColorSetPrimvarToMesh(
 
     if (typeName == SdfValueTypeNames->FloatArray) {
         colorRep = MFnMesh::kAlpha;
-        if (!primvar.Get(&alphaArray) || alphaArray.empty()) {
+        if (!getPrimvarValue(primvar, prefetched, &alphaArray) || alphaArray.empty()) {
             status = MS::kFailure;
         } else {
             numValues = alphaArray.size();
@@ -359,7 +402,7 @@ bool assignColorSetPrimvarToMesh(
     } else if (
         typeName == SdfValueTypeNames->Float3Array || typeName == SdfValueTypeNames->Color3fArray) {
         colorRep = MFnMesh::kRGB;
-        if (!primvar.Get(&rgbArray) || rgbArray.empty()) {
+        if (!getPrimvarValue(primvar, prefetched, &rgbArray) || rgbArray.empty()) {
             status = MS::kFailure;
         } else {
             numValues = rgbArray.size();
@@ -367,7 +410,7 @@ bool assignColorSetPrimvarToMesh(
     } else if (
         typeName == SdfValueTypeNames->Float4Array || typeName == SdfValueTypeNames->Color4fArray) {
         colorRep = MFnMesh::kRGBA;
-        if (!primvar.Get(&rgbaArray) || rgbaArray.empty()) {
+        if (!getPrimvarValue(primvar, prefetched, &rgbaArray) || rgbaArray.empty()) {
             status = MS::kFailure;
         } else {
             numValues = rgbaArray.size();
@@ -392,7 +435,7 @@ bool assignColorSetPrimvarToMesh(
 
     VtIntArray assignmentIndices;
     int        unauthoredValuesIndex = -1;
-    if (primvar.GetIndices(&assignmentIndices)) {
+    if (getPrimvarIndices(primvar, prefetched, &assignmentIndices)) {
         // The primvar IS indexed, so the indices array is what determines the
         // number of color values.
         numValues = assignmentIndices.size();
@@ -526,7 +569,10 @@ bool assignColorSetPrimvarToMesh(
     return true;
 }
 
-bool assignConstantPrimvarToMesh(const UsdGeomPrimvar& primvar, MFnMesh& meshFn)
+bool assignConstantPrimvarToMesh(
+    const UsdGeomPrimvar&           primvar,
+    const UsdMayaPrefetchedPrimvar* prefetched,
+    MFnMesh&                        meshFn)
 {
     const TfToken& interpolation = primvar.GetInterpolation();
     if (interpolation != UsdGeomTokens->constant) {
@@ -544,7 +590,7 @@ bool assignConstantPrimvarToMesh(const UsdGeomPrimvar& primvar, MFnMesh& meshFn)
     }
 
     VtValue primvarData;
-    primvar.Get(&primvarData);
+    getPrimvarValue(primvar, prefetched, &primvarData);
 
     MStatus status { MS::kSuccess };
     MPlug   plug = meshFn.findPlug(
@@ -587,9 +633,10 @@ void UsdMayaMeshReadUtils::setEmitNormalsTag(MFnMesh& meshFn, const bool emitNor
 }
 
 void UsdMayaMeshReadUtils::assignPrimvarsToMesh(
-    const UsdGeomMesh&  mesh,
-    const MObject&      meshObj,
-    const TfToken::Set& excludePrimvarSet)
+    const UsdGeomMesh&                 mesh,
+    const MObject&                     meshObj,
+    const TfToken::Set&                excludePrimvarSet,
+    const UsdMayaPrefetchedPrimvarMap* prefetchedPrimvars)
 {
     if (meshObj.apiType() != MFn::kMesh) {
         return;
@@ -614,6 +661,14 @@ void UsdMayaMeshReadUtils::assignPrimvarsToMesh(
             continue;
         }
 
+        const UsdMayaPrefetchedPrimvar* prefetched = nullptr;
+        if (prefetchedPrimvars) {
+            const auto it = prefetchedPrimvars->find(fullName);
+            if (it != prefetchedPrimvars->end()) {
+                prefetched = &it->second;
+            }
+        }
+
         // If the primvar is called either displayColor or displayOpacity check
         // if it was really authored from the user.  It may not have been
         // authored by the user, for example if it was generated by shader
@@ -636,7 +691,7 @@ void UsdMayaMeshReadUtils::assignPrimvarsToMesh(
             // Otherwise, if env variable for reading Float2
             // as uv sets is turned on, we assume that Float2Array primvars
             // are UV sets.
-            if (!assignUVSetPrimvarToMesh(primvar, meshFn, firstUVPrimvar)) {
+            if (!assignUVSetPrimvarToMesh(primvar, prefetched, meshFn, firstUVPrimvar)) {
                 TF_WARN(
                     "Unable to retrieve and assign data for UV set <%s> on "
                     "mesh <%s>",
@@ -648,7 +703,7 @@ void UsdMayaMeshReadUtils::assignPrimvarsToMesh(
             || typeName == SdfValueTypeNames->Color3fArray
             || typeName == SdfValueTypeNames->Float4Array
             || typeName == SdfValueTypeNames->Color4fArray) {
-            if (!assignColorSetPrimvarToMesh(mesh, primvar, meshFn)) {
+            if (!assignColorSetPrimvarToMesh(mesh, primvar, prefetched, meshFn)) {
                 TF_WARN(
                     "Unable to retrieve and assign data for color set <%s> "
                     "on mesh <%s>",
@@ -657,7 +712,7 @@ void UsdMayaMeshReadUtils::assignPrimvarsToMesh(
             }
         } else if (interpolation == UsdGeomTokens->constant) {
             // Constant primvars get added as attributes on the mesh.
-            if (!assignConstantPrimvarToMesh(primvar, meshFn)) {
+            if (!assignConstantPrimvarToMesh(primvar, prefetched, meshFn)) {
                 TF_WARN(
                     "Unable to assign constant primvar <%s> as attribute "
                     "on mesh <%s>",
@@ -19,6 +19,7 @@
 #define PXRUSDMAYA_MESH_READ_UTILS_H
 
 #include <mayaUsd/base/api.h>
+#include <mayaUsd/fileio/primReaderPrefetch.h>
 
 #include <pxr/base/gf/vec3f.h>
 #include <pxr/base/tf/staticTokens.h>
@@ -62,11 +63,15 @@ bool getEmitNormalsTag(const MFnMesh& mesh, bool* value);
 MAYAUSD_CORE_PUBLIC
 void setEmitNormalsTag(MFnMesh& meshFn, const bool emitNormals);
 
+/// Imports the primvars of \p mesh as UV sets, color sets and attributes.
+/// The values found in \p prefetchedPrimvars are used instead of reading them
+/// from \p mesh.
 MAYAUSD_CORE_PUBLIC
 void assignPrimvarsToMesh(
-    const UsdGeomMesh&  mesh,
-    const MObject&      meshObj,
-    const TfToken::Set& excludePrimvarSet);
+    const UsdGeomMesh&                 mesh,
+    const MObject&                     meshObj,
+    const TfToken::Set&                excludePrimvarSet,
+    const UsdMayaPrefetchedPrimvarMap* prefetchedPrimvars = nullptr);
 
 MAYAUSD_CORE_PUBLIC
 void assignInvisibleFaces(const UsdGeomMesh& mesh, const MObject& meshObj);
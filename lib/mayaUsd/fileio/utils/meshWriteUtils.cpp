@@ -801,8 +801,18 @@ void UsdMayaMeshWriteUtils::writePointsData(
     // Compute the extent using the raw points
     UsdGeomPointBased::ComputeExtent(points, &extent);
 
-    UsdMayaWriteUtil::SetAttribute(primSchema.GetPointsAttr(), &points, usdTime, valueWriter);
-    UsdMayaWriteUtil::SetAttribute(primSchema.CreateExtentAttr(), &extent, usdTime, valueWriter);
+    writePointsData(&points, &extent, primSchema, usdTime, valueWriter);
+}
+
+void UsdMayaMeshWriteUtils::writePointsData(
+    VtVec3fArray*              points,
+    VtVec3fArray*              extent,
+    UsdGeomMesh&               primSchema,
+    const UsdTimeCode&         usdTime,
+    UsdUtilsSparseValueWriter* valueWriter)
+{
+    UsdMayaWriteUtil::SetAttribute(primSchema.GetPointsAttr(), points, usdTime, valueWriter);
+    UsdMayaWriteUtil::SetAttribute(primSchema.CreateExtentAttr(), extent, usdTime, valueWriter);
 }
 
 void UsdMayaMeshWriteUtils::writeFaceVertexIndicesData(
@@ -123,6 +123,16 @@ void writePointsData(
     const UsdTimeCode&         usdTime,
     UsdUtilsSparseValueWriter* valueWriter);
 
+/// Writes points already read from Maya, with their extent. The arrays are
+/// swapped out to avoid a copy and are left empty.
+MAYAUSD_CORE_PUBLIC
+void writePointsData(
+    VtVec3fArray*              points,
+    VtVec3fArray*              extent,
+    UsdGeomMesh&               primSchema,
+    const UsdTimeCode&         usdTime,
+    UsdUtilsSparseValueWriter* valueWriter);
+
 MAYAUSD_CORE_PUBLIC
 void writeFaceVertexIndicesData(
     const MFnMesh&             meshFn,
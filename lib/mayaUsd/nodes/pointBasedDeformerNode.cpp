@@ -30,7 +30,10 @@
 #include <pxr/usd/usd/stage.h>
 #include <pxr/usd/usd/timeCode.h>
 #include <pxr/usd/usdGeom/pointBased.h>
+#include <pxr/usd/usdGeom/tokens.h>
 
+#include <maya/MAnimControl.h>
+#include <maya/MArrayDataHandle.h>
 #include <maya/MDataBlock.h>
 #include <maya/MDataHandle.h>
 #include <maya/MFnData.h>
@@ -49,6 +52,9 @@
 #include <maya/MTime.h>
 #include <maya/MTypeId.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <string>
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -147,9 +153,7 @@ MStatus UsdMayaPointBasedDeformerNode::deform(
 
     const SdfPath primPath(primPathString);
 
-    const UsdPrim&          usdPrim = usdStage->GetPrimAtPath(primPath);
-    const UsdGeomPointBased usdPointBased(usdPrim);
-    if (!usdPointBased) {
+    if (!_UpdatePointsQuery(usdStage, primPath)) {
         return MS::kFailure;
     }
 
@@ -161,29 +165,187 @@ MStatus UsdMayaPointBasedDeformerNode::deform(
     CHECK_MSTATUS_AND_RETURN_IT(status);
     const float envelope = envelopeHandle.asFloat();
 
-    VtVec3fArray usdPoints;
-    if (!usdPointBased.GetPointsAttr().Get(&usdPoints, usdTime) || usdPoints.empty()) {
+    if (!_ReadPoints(usdTime)) {
         return MS::kFailure;
     }
 
+    _PrefetchPoints(usdTime);
+
+    // Work on raw arrays rather than going through the iterator for every
+    // point: only the indices of the deformed points are gathered from it.
+    _indices.clear();
+    _indices.reserve(iter.count());
     for (; !iter.isDone(); iter.next()) {
-        const int index = iter.index();
-        if (index < 0 || static_cast<size_t>(index) >= usdPoints.size()) {
-            continue;
+        _indices.push_back(iter.index());
+    }
+    iter.reset();
+
+    status = iter.allPositions(_mayaPoints);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    if (_mayaPoints.length() != _indices.size()) {
+        return MS::kFailure;
+    }
+    if (_indices.empty()) {
+        return status;
+    }
+
+    const size_t usdPointCount = _usdPoints.size();
+    _ReadWeights(block, multiIndex, usdPointCount);
+
+    const GfVec3f* const usdPoints = _usdPoints.cdata();
+    const float* const   pointWeights = _weights.data();
+    const int* const     indices = _indices.data();
+    MPoint* const        mayaPoints = &_mayaPoints[0];
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, _indices.size(), 4096),
+        [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++i) {
+                const int index = indices[i];
+                if (index < 0 || static_cast<size_t>(index) >= usdPointCount) {
+                    continue;
+                }
+
+                const double   alpha = pointWeights[index] * envelope;
+                const GfVec3f& usdPoint = usdPoints[index];
+                MPoint&        mayaPoint = mayaPoints[i];
+
+                mayaPoint.x += alpha * (usdPoint[0] - mayaPoint.x);
+                mayaPoint.y += alpha * (usdPoint[1] - mayaPoint.y);
+                mayaPoint.z += alpha * (usdPoint[2] - mayaPoint.z);
+            }
+        });
+
+    return iter.setAllPositions(_mayaPoints);
+}
+
+/// Resolves the points attribute of the prim at \p primPath, unless it is
+/// still valid. Returns false if the prim is not a UsdGeomPointBased.
+bool UsdMayaPointBasedDeformerNode::_UpdatePointsQuery(
+    const UsdStageRefPtr& usdStage,
+    const SdfPath&        primPath)
+{
+    if (!_pointsQueryDirty && _usdStage == usdStage && _primPath == primPath) {
+        return _pointsQuery.IsValid();
+    }
+
+    // The prefetch may be reading the attribute being replaced.
+    _WaitForPrefetch();
+
+    if (_usdStage != usdStage) {
+        _usdStage = usdStage;
+        _stageNoticeListener.SetStage(usdStage);
+        _stageNoticeListener.SetStageObjectsChangedCallback(
+            [this](const UsdNotice::ObjectsChanged& notice) { _OnStageObjectsChanged(notice); });
+    }
+
+    _primPath = primPath;
+    _pointsQueryDirty = false;
+    _hasUsdPoints = false;
+
+    const UsdGeomPointBased usdPointBased(usdStage->GetPrimAtPath(primPath));
+    _pointsQuery = usdPointBased ? UsdAttributeQuery(usdPointBased.GetPointsAttr())
+                                 : UsdAttributeQuery();
+
+    return _pointsQuery.IsValid();
+}
+
+/// Reads the points at \p usdTime into _usdPoints, taking them from the
+/// prefetch when it read that time. Returns false if there are no points.
+bool UsdMayaPointBasedDeformerNode::_ReadPoints(const UsdTimeCode& usdTime)
+{
+    const bool prefetched = _prefetching && _prefetchedTime == usdTime;
+    _WaitForPrefetch();
+
+    if (prefetched && !_prefetchedPoints.empty()) {
+        _usdPoints.swap(_prefetchedPoints);
+        _usdPointsTime = usdTime;
+        _hasUsdPoints = true;
+    } else if (
+        !_hasUsdPoints || (_usdPointsTime != usdTime && _pointsQuery.ValueMightBeTimeVarying())) {
+        _hasUsdPoints = _pointsQuery.Get(&_usdPoints, usdTime);
+        _usdPointsTime = usdTime;
+    }
+
+    return _hasUsdPoints && !_usdPoints.empty();
+}
+
+/// Starts reading the points of the next frame on a worker thread if time is
+/// advancing by a constant step during playback.
+void UsdMayaPointBasedDeformerNode::_PrefetchPoints(const UsdTimeCode& usdTime)
+{
+    const double timeStep = _lastTime.IsDefault() ? 0.0 : usdTime.GetValue() - _lastTime.GetValue();
+    const bool linear = timeStep != 0.0 && GfIsClose(timeStep, _lastTimeStep, 1e-6);
+
+    _lastTime = usdTime;
+    _lastTimeStep = timeStep;
+
+    // Prefetching is limited to playback, where the stage is not edited while
+    // the worker thread reads it.
+    if (!linear || !_pointsQuery.ValueMightBeTimeVarying() || !MAnimControl::isPlaying()) {
+        return;
+    }
+
+    _prefetchedTime = UsdTimeCode(usdTime.GetValue() + timeStep);
+    _prefetching = true;
+    _prefetchTask.run([this]() {
+        if (!_pointsQuery.Get(&_prefetchedPoints, _prefetchedTime)) {
+            _prefetchedPoints.clear();
         }
+    });
+}
 
-        const MPoint mayaPoint = iter.position();
-        const float  weight = weightValue(block, multiIndex, index);
+/// Waits for the running prefetch, if any.
+void UsdMayaPointBasedDeformerNode::_WaitForPrefetch()
+{
+    if (_prefetching) {
+        _prefetchTask.wait();
+        _prefetching = false;
+    }
+}
 
-        const GfVec3f& usdPoint = usdPoints[static_cast<size_t>(index)];
+/// Reads the weights of the deformed geometry at \p multiIndex into a dense
+/// array of \p count weights, rather than calling weightValue() per point.
+void UsdMayaPointBasedDeformerNode::_ReadWeights(
+    MDataBlock&  block,
+    unsigned int multiIndex,
+    size_t       count)
+{
+    // Points without a weight are fully deformed.
+    _weights.assign(count, 1.0f);
 
-        const GfVec3f deformedPoint = GfLerp<GfVec3f>(
-            weight * envelope, GfVec3f(mayaPoint[0], mayaPoint[1], mayaPoint[2]), usdPoint);
+    MStatus          status;
+    MArrayDataHandle weightListHandle = block.inputArrayValue(weightList, &status);
+    if (!status || weightListHandle.jumpToElement(multiIndex) != MS::kSuccess) {
+        return;
+    }
 
-        iter.setPosition(MPoint(deformedPoint[0], deformedPoint[1], deformedPoint[2]));
+    MArrayDataHandle   weightsHandle(weightListHandle.inputValue().child(weights));
+    const unsigned int weightCount = weightsHandle.elementCount();
+    for (unsigned int i = 0; i < weightCount; ++i, weightsHandle.next()) {
+        const unsigned int index = weightsHandle.elementIndex();
+        if (index < count) {
+            _weights[index] = weightsHandle.inputValue().asFloat();
+        }
     }
+}
 
-    return status;
+/// Invalidates the points attribute when the stage notifies a change to it.
+void UsdMayaPointBasedDeformerNode::_OnStageObjectsChanged(const UsdNotice::ObjectsChanged& notice)
+{
+    const SdfPath pointsPath = _primPath.AppendProperty(UsdGeomTokens->points);
+    for (const SdfPath& path : notice.GetResyncedPaths()) {
+        if (pointsPath.HasPrefix(path)) {
+            _pointsQueryDirty = true;
+            return;
+        }
+    }
+    for (const SdfPath& path : notice.GetChangedInfoOnlyPaths()) {
+        if (path == pointsPath) {
+            _pointsQueryDirty = true;
+            return;
+        }
+    }
 }
 
 UsdMayaPointBasedDeformerNode::UsdMayaPointBasedDeformerNode()
@@ -192,6 +354,6 @@ UsdMayaPointBasedDeformerNode::UsdMayaPointBasedDeformerNode()
 }
 
 /* virtual */
-UsdMayaPointBasedDeformerNode::~UsdMayaPointBasedDeformerNode() { }
+UsdMayaPointBasedDeformerNode::~UsdMayaPointBasedDeformerNode() { _WaitForPrefetch(); }
 
 PXR_NAMESPACE_CLOSE_SCOPE
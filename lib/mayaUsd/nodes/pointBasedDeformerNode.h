@@ -17,19 +17,32 @@
 #define PXRUSDMAYA_POINT_BASED_DEFORMER_NODE_H
 
 #include <mayaUsd/base/api.h>
+#include <mayaUsd/listeners/stageNoticeListener.h>
 
 #include <pxr/base/tf/staticTokens.h>
+#include <pxr/base/vt/types.h>
 #include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/attributeQuery.h>
+#include <pxr/usd/usd/notice.h>
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usd/timeCode.h>
 
 #include <maya/MDataBlock.h>
 #include <maya/MItGeometry.h>
 #include <maya/MMatrix.h>
 #include <maya/MObject.h>
+#include <maya/MPointArray.h>
 #include <maya/MPxDeformerNode.h>
 #include <maya/MStatus.h>
 #include <maya/MString.h>
 #include <maya/MTypeId.h>
 
+#include <tbb/task_group.h>
+
+#include <atomic>
+#include <vector>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 // clang-format off
@@ -52,6 +65,11 @@ TF_DECLARE_PUBLIC_TOKENS(
 /// the deformer runs, it will read the points attribute of the prim at that
 /// time sample and use the positions to modify the positions of the geometry
 /// being deformed.
+///
+/// The points attribute is resolved once and kept until the stage or the prim
+/// path changes, or the stage notifies a change to the attribute. During
+/// playback, when time advances by a constant step, the points of the next
+/// frame are read on a worker thread while the current frame is deformed.
 class UsdMayaPointBasedDeformerNode : public MPxDeformerNode
 {
 public:
@@ -86,6 +104,43 @@ private:
 
     UsdMayaPointBasedDeformerNode(const UsdMayaPointBasedDeformerNode&);
     UsdMayaPointBasedDeformerNode& operator=(const UsdMayaPointBasedDeformerNode&);
+
+    bool _UpdatePointsQuery(const UsdStageRefPtr& usdStage, const SdfPath& primPath);
+    bool _ReadPoints(const UsdTimeCode& usdTime);
+    void _PrefetchPoints(const UsdTimeCode& usdTime);
+    void _WaitForPrefetch();
+    void _ReadWeights(MDataBlock& block, unsigned int multiIndex, size_t count);
+
+    void _OnStageObjectsChanged(const UsdNotice::ObjectsChanged& notice);
+
+    UsdMayaStageNoticeListener _stageNoticeListener;
+
+    // The resolved points attribute. It is reset from the notice listener by
+    // raising _pointsQueryDirty, since the prefetch may be using it.
+    UsdStageWeakPtr   _usdStage;
+    SdfPath           _primPath;
+    UsdAttributeQuery _pointsQuery;
+    std::atomic_bool  _pointsQueryDirty { true };
+
+    // The points of the last time read, reused when they are not animated.
+    VtVec3fArray _usdPoints;
+    UsdTimeCode  _usdPointsTime = UsdTimeCode::Default();
+    bool         _hasUsdPoints = false;
+
+    // Time step between the last two evaluations, to detect playback.
+    UsdTimeCode _lastTime = UsdTimeCode::Default();
+    double      _lastTimeStep = 0.0;
+
+    // Points of the next frame, read by _prefetchTask.
+    VtVec3fArray    _prefetchedPoints;
+    UsdTimeCode     _prefetchedTime = UsdTimeCode::Default();
+    bool            _prefetching = false;
+    tbb::task_group _prefetchTask;
+
+    // Buffers reused from one evaluation to the next.
+    MPointArray        _mayaPoints;
+    std::vector<int>   _indices;
+    std::vector<float> _weights;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -19,6 +19,7 @@
 #include <mayaUsd/base/tokens.h>
 #include <mayaUsd/listeners/proxyShapeNotice.h>
 #include <mayaUsd/nodes/stageData.h>
+#include <mayaUsd/undo/UsdUndoBlock.h>
 #include <mayaUsd/utils/customLayerData.h>
 #include <mayaUsd/utils/query.h>
 #include <mayaUsd/utils/stageCache.h>
@@ -41,6 +42,7 @@
 #include <pxr/pxr.h>
 #include <pxr/usd/ar/resolver.h>
 #include <pxr/usd/sdf/attributeSpec.h>
+#include <pxr/usd/sdf/changeBlock.h>
 #include <pxr/usd/sdf/layer.h>
 #include <pxr/usd/sdf/path.h>
 #include <pxr/usd/usd/editContext.h>
@@ -62,6 +64,7 @@
 #include <maya/MDataBlock.h>
 #include <maya/MDataHandle.h>
 #include <maya/MEvaluationNode.h>
+#include <maya/MEventMessage.h>
 #include <maya/MFileIO.h>
 #include <maya/MFnCompoundAttribute.h>
 #include <maya/MFnDagNode.h>
@@ -89,6 +92,8 @@
 #include <maya/MViewport2Renderer.h>
 
 #include <ghc/filesystem.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 
 #include <map>
 #include <string>
@@ -135,6 +140,7 @@ MObject MayaUsdProxyShapeBase::loadPayloadsAttr;
 MObject MayaUsdProxyShapeBase::shareStageAttr;
 MObject MayaUsdProxyShapeBase::timeAttr;
 MObject MayaUsdProxyShapeBase::complexityAttr;
+MObject MayaUsdProxyShapeBase::maxTextureResolutionAttr;
 MObject MayaUsdProxyShapeBase::inStageDataAttr;
 MObject MayaUsdProxyShapeBase::inStageDataCachedAttr;
 MObject MayaUsdProxyShapeBase::stageCacheIdAttr;
@@ -196,6 +202,27 @@ void createNewAnonSubLayerRecursive(
         }
     }
 }
+
+// Returns true if path is under one of the prototypes the stage creates for instanceable prims.
+bool isPrototypePath(const UsdStageWeakPtr& stage, const SdfPath& path)
+{
+    if (!path.IsAbsolutePath() || path.IsAbsoluteRootPath()) {
+        return false;
+    }
+
+    SdfPath rootPath = path.GetPrimPath();
+    while (!rootPath.GetParentPath().IsAbsoluteRootPath()) {
+        rootPath = rootPath.GetParentPath();
+    }
+
+    const UsdPrim rootPrim = stage->GetPrimAtPath(rootPath);
+#if PXR_VERSION < 2011
+    return rootPrim && rootPrim.IsMaster();
+#else
+    return rootPrim && rootPrim.IsPrototype();
+#endif
+}
+
 //! Profiler category for proxy accessor events
 const int _shapeBaseProfilerCategory = MProfiler::addCategory(
 #if MAYA_API_VERSION >= 20190000
@@ -281,6 +308,15 @@ MStatus MayaUsdProxyShapeBase::initialize()
     retValue = addAttribute(complexityAttr);
     CHECK_MSTATUS_AND_RETURN_IT(retValue);
 
+    maxTextureResolutionAttr = numericAttrFn.create(
+        "maxTextureResolution", "mtr", MFnNumericData::kInt, 0, &retValue);
+    numericAttrFn.setMin(0);
+    numericAttrFn.setSoftMax(4096);
+    numericAttrFn.setAffectsAppearance(true);
+    CHECK_MSTATUS_AND_RETURN_IT(retValue);
+    retValue = addAttribute(maxTextureResolutionAttr);
+    CHECK_MSTATUS_AND_RETURN_IT(retValue);
+
     inStageDataAttr = typedAttrFn.create(
         "inStageData", "id", MayaUsdStageData::mayaTypeId, MObject::kNullObj, &retValue);
     typedAttrFn.setReadable(false);
@@ -496,8 +532,8 @@ MStatus MayaUsdProxyShapeBase::compute(const MPlug& plug, MDataBlock& dataBlock)
         ProxyAccessor::compute(_usdAccessor, plug, dataBlock);
 
     if (plug == excludePrimPathsAttr || plug == timeAttr || plug == complexityAttr
-        || plug == drawRenderPurposeAttr || plug == drawProxyPurposeAttr
-        || plug == drawGuidePurposeAttr) {
+        || plug == maxTextureResolutionAttr || plug == drawRenderPurposeAttr
+        || plug == drawProxyPurposeAttr || plug == drawGuidePurposeAttr) {
         MProfilingScope profilingScope(
             _shapeBaseProfilerCategory,
             MProfiler::kColorE_L3,
@@ -933,7 +969,8 @@ MStatus MayaUsdProxyShapeBase::computeOutStageData(MDataBlock& dataBlock)
 
     const bool isNormalContext = dataBlock.context().isNormal();
     if (isNormalContext) {
-        TfReset(_boundingBoxCache);
+        _boundsCache.Clear();
+        _ClearPendingExtents();
 
         // Reset the stage listener until we determine that everything is valid.
         _stageNoticeListener.SetStage(UsdStageWeakPtr());
@@ -1198,19 +1235,8 @@ MBoundingBox MayaUsdProxyShapeBase::boundingBox() const
     dataBlock.inputValue(outStageDataAttr, &status);
     CHECK_MSTATUS_AND_RETURN(status, MBoundingBox());
 
-    // XXX:
-    // If we could cheaply determine whether a stage only has static geometry,
-    // we could make this value a constant one for that case, avoiding the
-    // memory overhead of a cache entry per frame
     UsdTimeCode currTime = GetOutputTime(dataBlock);
 
-    std::map<UsdTimeCode, MBoundingBox>::const_iterator cacheLookup
-        = _boundingBoxCache.find(currTime);
-
-    if (cacheLookup != _boundingBoxCache.end()) {
-        return cacheLookup->second;
-    }
-
     MProfilingScope profilingScope(
         _shapeBaseProfilerCategory, MProfiler::kColorB_L1, "Compute USD Stage BoundingBox");
 
@@ -1219,22 +1245,28 @@ MBoundingBox MayaUsdProxyShapeBase::boundingBox() const
         return MBoundingBox();
     }
 
-    const UsdGeomImageable imageablePrim(prim);
-
     bool drawRenderPurpose = false;
     bool drawProxyPurpose = true;
     bool drawGuidePurpose = false;
     _GetDrawPurposeToggles(dataBlock, &drawRenderPurpose, &drawProxyPurpose, &drawGuidePurpose);
 
-    const TfToken purpose1 = UsdGeomTokens->default_;
-    const TfToken purpose2 = drawRenderPurpose ? UsdGeomTokens->render : TfToken();
-    const TfToken purpose3 = drawProxyPurpose ? UsdGeomTokens->proxy : TfToken();
-    const TfToken purpose4 = drawGuidePurpose ? UsdGeomTokens->guide : TfToken();
+    TfTokenVector purposes { UsdGeomTokens->default_ };
+    if (drawRenderPurpose) {
+        purposes.push_back(UsdGeomTokens->render);
+    }
+    if (drawProxyPurpose) {
+        purposes.push_back(UsdGeomTokens->proxy);
+    }
+    if (drawGuidePurpose) {
+        purposes.push_back(UsdGeomTokens->guide);
+    }
 
+    // Static subtrees are only computed once, animated ones are recomputed
+    // when the time changes.
     const GfBBox3d allBox
-        = imageablePrim.ComputeUntransformedBound(currTime, purpose1, purpose2, purpose3, purpose4);
+        = nonConstThis->_boundsCache.ComputeUntransformedBound(prim, currTime, purposes);
 
-    MBoundingBox& retval = nonConstThis->_boundingBoxCache[currTime];
+    MBoundingBox retval;
 
     const GfRange3d boxRange = allBox.ComputeAlignedBox();
 
@@ -1251,7 +1283,119 @@ MBoundingBox MayaUsdProxyShapeBase::boundingBox() const
     return retval;
 }
 
-void MayaUsdProxyShapeBase::clearBoundingBoxCache() { _boundingBoxCache.clear(); }
+void MayaUsdProxyShapeBase::clearBoundingBoxCache() { _boundsCache.Clear(); }
+
+void MayaUsdProxyShapeBase::updatePendingExtents()
+{
+    SdfPathSet dirtyPaths;
+    dirtyPaths.swap(_pendingExtentUpdates);
+    dirtyPaths.insert(_pendingUndoableExtentUpdates.begin(), _pendingUndoableExtentUpdates.end());
+    _ClearPendingExtents();
+
+    _UpdateExtents(dirtyPaths);
+}
+
+void MayaUsdProxyShapeBase::_UpdateExtents(const SdfPathSet& dirtyPaths)
+{
+    if (dirtyPaths.empty()) {
+        return;
+    }
+
+    MProfilingScope profilingScope(
+        _shapeBaseProfilerCategory, MProfiler::kColorB_L1, "Update pending extents");
+
+    const UsdStageRefPtr stage = getUsdStage();
+    if (!stage) {
+        return;
+    }
+
+    struct ExtentUpdate
+    {
+        UsdGeomBoundable boundable;
+        UsdAttribute     extentsAttr;
+        VtVec3fArray     extent;
+        bool             isValid { false };
+    };
+
+    std::vector<ExtentUpdate> updates;
+    updates.reserve(dirtyPaths.size());
+    for (const SdfPath& dirtyPath : dirtyPaths) {
+        UsdGeomBoundable boundableObj(stage->GetPrimAtPath(dirtyPath));
+        if (!boundableObj) {
+            continue;
+        }
+
+        // Only fix up extents that were authored.
+        UsdAttribute extentsAttr = boundableObj.GetExtentAttr();
+        if (!extentsAttr || !extentsAttr.HasValue()) {
+            continue;
+        }
+        if (extentsAttr.GetNumTimeSamples() > 0) {
+            TF_CODING_ERROR("Can not fix animated extents of %s.", dirtyPath.GetText());
+            continue;
+        }
+
+        updates.push_back({ boundableObj, extentsAttr, VtVec3fArray(2), false });
+    }
+
+    // Computing the extents only reads from the stage, so it can be done in parallel.
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, updates.size()),
+        [&updates](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++i) {
+                ExtentUpdate& update = updates[i];
+                update.isValid = UsdGeomBoundable::ComputeExtentFromPlugins(
+                    update.boundable, UsdTimeCode::Default(), &update.extent);
+            }
+        });
+
+    // Author all the results at once, sending a single change notice.
+    SdfChangeBlock changeBlock;
+    for (const ExtentUpdate& update : updates) {
+        if (update.isValid) {
+            update.extentsAttr.Set(update.extent);
+        }
+    }
+}
+
+void MayaUsdProxyShapeBase::_OnIdleUpdateExtents(void* clientData)
+{
+    auto* shape = static_cast<MayaUsdProxyShapeBase*>(clientData);
+
+    SdfPathSet dirtyPaths;
+    dirtyPaths.swap(shape->_pendingExtentUpdates);
+    MMessage::removeCallback(shape->_extentUpdateCallbackId);
+    shape->_extentUpdateCallbackId = 0;
+
+    shape->_UpdateExtents(dirtyPaths);
+}
+
+void MayaUsdProxyShapeBase::_OnUndoBlockClosing(void* clientData)
+{
+    auto* shape = static_cast<MayaUsdProxyShapeBase*>(clientData);
+
+    SdfPathSet dirtyPaths;
+    dirtyPaths.swap(shape->_pendingUndoableExtentUpdates);
+    MayaUsd::UsdUndoBlock::removeClosingCallback(_OnUndoBlockClosing, shape);
+    shape->_extentUpdateScheduled = false;
+
+    shape->_UpdateExtents(dirtyPaths);
+}
+
+void MayaUsdProxyShapeBase::_ClearPendingExtents()
+{
+    _pendingExtentUpdates.clear();
+    if (_extentUpdateCallbackId != 0) {
+        MMessage::removeCallback(_extentUpdateCallbackId);
+        _extentUpdateCallbackId = 0;
+    }
+
+    _pendingUndoableExtentUpdates.clear();
+    if (_extentUpdateScheduled) {
+        MayaUsd::UsdUndoBlock::removeClosingCallback(_OnUndoBlockClosing, this);
+        _extentUpdateScheduled = false;
+    }
+}
 
 bool MayaUsdProxyShapeBase::isStageValid() const
 {
@@ -1470,6 +1614,18 @@ int MayaUsdProxyShapeBase::_GetComplexity(MDataBlock dataBlock) const
     return complexity;
 }
 
+int MayaUsdProxyShapeBase::getMaxTextureResolution() const
+{
+    return _GetMaxTextureResolution(const_cast<MayaUsdProxyShapeBase*>(this)->forceCache());
+}
+
+int MayaUsdProxyShapeBase::_GetMaxTextureResolution(MDataBlock dataBlock) const
+{
+    MStatus status;
+
+    return dataBlock.inputValue(maxTextureResolutionAttr, &status).asInt();
+}
+
 UsdTimeCode MayaUsdProxyShapeBase::getTime() const
 {
     return _GetTime(const_cast<MayaUsdProxyShapeBase*>(this)->forceCache());
@@ -1615,12 +1771,7 @@ MayaUsdProxyShapeBase::MayaUsdProxyShapeBase(const bool enableUfeSelection)
 }
 
 /* virtual */
-MayaUsdProxyShapeBase::~MayaUsdProxyShapeBase()
-{
-    //
-    // empty
-    //
-}
+MayaUsdProxyShapeBase::~MayaUsdProxyShapeBase() { _ClearPendingExtents(); }
 
 MSelectionMask MayaUsdProxyShapeBase::getShapeSelectionMask() const
 {
@@ -1663,10 +1814,28 @@ void MayaUsdProxyShapeBase::_OnStageObjectsChanged(const UsdNotice::ObjectsChang
     MProfilingScope profilingScope(
         _shapeBaseProfilerCategory, MProfiler::kColorB_L1, "Process USD objects changed");
 
-    // This will definitely force a BBox recomputation on "Frame All" or when framing a selected
-    // stage. Computing bounds in USD is expensive, so if it pops up in other frequently used
-    // scenarios we will have to investigate ways to make this cache clearing less expensive.
-    clearBoundingBoxCache();
+    // Only discard the cached bounds of the changed prims and of their ancestors. Resyncs and
+    // purpose changes also affect the bounds of the descendants. The bounds of instances are
+    // cached under their instance proxy paths, while edits to their prototype are only notified
+    // under the prototype paths, so any prototype change discards all the cached bounds.
+    for (const auto& resyncedPath : notice.GetResyncedPaths()) {
+        if (isPrototypePath(notice.GetStage(), resyncedPath)) {
+            _boundsCache.Clear();
+            break;
+        }
+        const bool affectsDescendants = resyncedPath.IsAbsoluteRootOrPrimPath()
+            || resyncedPath.GetNameToken() == UsdGeomTokens->purpose;
+        _boundsCache.Invalidate(resyncedPath.GetPrimPath(), affectsDescendants);
+    }
+    for (const auto& changedPath : notice.GetChangedInfoOnlyPaths()) {
+        if (isPrototypePath(notice.GetStage(), changedPath)) {
+            _boundsCache.Clear();
+            break;
+        }
+        const bool affectsDescendants = changedPath.IsPrimPropertyPath()
+            && changedPath.GetNameToken() == UsdGeomTokens->purpose;
+        _boundsCache.Invalidate(changedPath.GetPrimPath(), affectsDescendants);
+    }
 
     ProxyAccessor::stageChanged(_usdAccessor, thisMObject(), notice);
     MayaUsdProxyStageObjectsChangedNotice(*this, notice).Send();
@@ -1679,6 +1848,8 @@ void MayaUsdProxyShapeBase::_OnStageObjectsChanged(const UsdNotice::ObjectsChang
         return;
     }
 
+    const bool  isUndoable = MayaUsd::UsdUndoBlock::depth() > 0;
+    SdfPathSet& pendingPaths = isUndoable ? _pendingUndoableExtentUpdates : _pendingExtentUpdates;
     for (const auto& changedPath : notice.GetChangedInfoOnlyPaths()) {
         if (!changedPath.IsPrimPropertyPath()) {
             continue;
@@ -1712,21 +1883,26 @@ void MayaUsdProxyShapeBase::_OnStageObjectsChanged(const UsdNotice::ObjectsChang
             continue;
         }
 
-        UsdAttribute extentsAttr = boundableObj.GetExtentAttr();
-        if (extentsAttr.GetNumTimeSamples() > 0) {
-            TF_CODING_ERROR(
-                "Can not fix animated extents of %s made dirty by a change on %s.",
-                changedPrimPath.GetString().c_str(),
-                changedPropertyToken.GetText());
-            continue;
-        }
-        if (extentsAttr && extentsAttr.HasValue()) {
-            VtVec3fArray extent(2);
-            if (UsdGeomBoundable::ComputeExtentFromPlugins(
-                    boundableObj, UsdTimeCode::Default(), &extent)) {
-                extentsAttr.Set(extent);
-            }
+        // Defer the extent computation: a bulk edit sends one notice per changed attribute and
+        // authoring the extent here would send yet another notice for each of them.
+        pendingPaths.insert(changedPrimPath);
+    }
+
+    if (pendingPaths.empty()) {
+        return;
+    }
+
+    // Author the extents of edits made in an undo block when the outermost block closes, so that
+    // they are undone with the edits. Edits made outside of an undo block cannot be undone, so
+    // their extents are authored at idle time.
+    if (isUndoable) {
+        if (!_extentUpdateScheduled) {
+            MayaUsd::UsdUndoBlock::addClosingCallback(_OnUndoBlockClosing, this);
+            _extentUpdateScheduled = true;
         }
+    } else if (_extentUpdateCallbackId == 0) {
+        _extentUpdateCallbackId
+            = MEventMessage::addEventCallback("idle", _OnIdleUpdateExtents, this);
     }
 }
 
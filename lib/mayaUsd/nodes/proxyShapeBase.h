@@ -30,6 +30,7 @@
 #include <maya/MDagPath.h>
 #include <maya/MDataBlock.h>
 #include <maya/MDataHandle.h>
+#include <maya/MMessage.h>
 #include <maya/MObject.h>
 #include <maya/MPlug.h>
 #include <maya/MPlugArray.h>
@@ -55,6 +56,7 @@ constexpr char USD_UFE_SEPARATOR = '/';
 #include <mayaUsd/base/api.h>
 #include <mayaUsd/listeners/stageNoticeListener.h>
 #include <mayaUsd/nodes/proxyAccessor.h>
+#include <mayaUsd/nodes/proxyShapeBoundsCache.h>
 #include <mayaUsd/nodes/proxyStageProvider.h>
 #include <mayaUsd/nodes/usdPrimProvider.h>
 
@@ -105,6 +107,8 @@ public:
     MAYAUSD_CORE_PUBLIC
     static MObject complexityAttr;
     MAYAUSD_CORE_PUBLIC
+    static MObject maxTextureResolutionAttr;
+    MAYAUSD_CORE_PUBLIC
     static MObject inStageDataAttr;
     MAYAUSD_CORE_PUBLIC
     static MObject inStageDataCachedAttr;
@@ -197,6 +201,11 @@ public:
     MAYAUSD_CORE_PUBLIC
     int getComplexity() const;
 
+    /// Maximum width and height of the textures drawn in the viewport, or 0
+    /// to draw them at full resolution.
+    MAYAUSD_CORE_PUBLIC
+    int getMaxTextureResolution() const;
+
     MAYAUSD_CORE_PUBLIC
     UsdTimeCode getTime() const override;
     MAYAUSD_CORE_PUBLIC
@@ -248,6 +257,17 @@ public:
     MAYAUSD_CORE_PUBLIC
     void clearBoundingBoxCache();
 
+    /// \brief  Recomputes and authors the extents of the boundable prims made
+    /// dirty by stage edits since the last update.
+    ///
+    /// Extent updates are queued by the stage change notices. Edits made in a
+    /// UsdUndoBlock are processed in bulk when the outermost block closes, so
+    /// the extents are undone along with the edits. Other edits are processed
+    /// in bulk at idle time. Call this to force the pending updates to be
+    /// processed now.
+    MAYAUSD_CORE_PUBLIC
+    void updatePendingExtents();
+
     // returns the shape's parent transform
     MAYAUSD_CORE_PUBLIC
     MDagPath parentTransform();
@@ -347,6 +367,7 @@ private:
 
     SdfPathVector _GetExcludePrimPaths(MDataBlock dataBlock) const;
     int           _GetComplexity(MDataBlock dataBlock) const;
+    int           _GetMaxTextureResolution(MDataBlock dataBlock) const;
     UsdTimeCode   _GetTime(MDataBlock dataBlock) const;
 
     bool _GetDrawPurposeToggles(
@@ -358,11 +379,24 @@ private:
     void _OnStageContentsChanged(const UsdNotice::StageContentsChanged& notice);
     void _OnStageObjectsChanged(const UsdNotice::ObjectsChanged& notice);
 
+    static void _OnIdleUpdateExtents(void* clientData);
+    static void _OnUndoBlockClosing(void* clientData);
+    void        _UpdateExtents(const SdfPathSet& dirtyPaths);
+    void        _ClearPendingExtents();
+
     UsdMayaStageNoticeListener _stageNoticeListener;
 
-    std::map<UsdTimeCode, MBoundingBox> _boundingBoxCache;
-    size_t                              _excludePrimPathsVersion { 1 };
-    size_t                              _UsdStageVersion { 1 };
+    MayaUsdProxyShapeBoundsCache _boundsCache;
+    size_t                       _excludePrimPathsVersion { 1 };
+    size_t                       _UsdStageVersion { 1 };
+
+    // Boundable prims whose extents must be recomputed, edited outside of an
+    // undo block and processed by the idle callback, or edited in an undo
+    // block and processed when it closes.
+    SdfPathSet  _pendingExtentUpdates;
+    MCallbackId _extentUpdateCallbackId { 0 };
+    SdfPathSet  _pendingUndoableExtentUpdates;
+    bool        _extentUpdateScheduled { false };
 
     MayaUsd::ProxyAccessor::Owner _usdAccessor;
 
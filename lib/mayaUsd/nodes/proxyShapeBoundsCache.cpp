@@ -0,0 +1,249 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "proxyShapeBoundsCache.h"
+
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/base/trace/trace.h>
+#include <pxr/usd/usd/attribute.h>
+#include <pxr/usd/usd/primRange.h>
+#include <pxr/usd/usdGeom/bboxCache.h>
+#include <pxr/usd/usdGeom/boundable.h>
+#include <pxr/usd/usdGeom/imageable.h>
+#include <pxr/usd/usdGeom/tokens.h>
+#include <pxr/usd/usdGeom/xformable.h>
+
+#include <algorithm>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace {
+
+// Returns true if any attribute in the subtree rooted at prim might have a
+// time-varying value. This is conservative: any animated attribute, including
+// ones that do not contribute to the bound, makes the subtree animated.
+bool _IsSubtreeTimeVarying(const UsdPrim& prim)
+{
+    for (const UsdPrim& subPrim : UsdPrimRange(prim, UsdTraverseInstanceProxies())) {
+        for (const UsdAttribute& attr : subPrim.GetAttributes()) {
+            if (attr.ValueMightBeTimeVarying()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Reads the purpose authored on prim, if any.
+bool _GetAuthoredPurpose(const UsdPrim& prim, TfToken* purpose)
+{
+    const UsdAttribute purposeAttr = prim.GetAttribute(UsdGeomTokens->purpose);
+    return purposeAttr.HasAuthoredValue() && purposeAttr.Get(purpose);
+}
+
+} // namespace
+
+MayaUsdProxyShapeBoundsCache::MayaUsdProxyShapeBoundsCache() = default;
+
+MayaUsdProxyShapeBoundsCache::~MayaUsdProxyShapeBoundsCache() = default;
+
+GfBBox3d MayaUsdProxyShapeBoundsCache::ComputeUntransformedBound(
+    const UsdPrim&       prim,
+    const UsdTimeCode&   time,
+    const TfTokenVector& includedPurposes)
+{
+    TRACE_FUNCTION();
+
+    if (!prim) {
+        return GfBBox3d();
+    }
+
+    if (includedPurposes != _includedPurposes) {
+        Clear();
+        _includedPurposes = includedPurposes;
+    }
+
+    // Like UsdGeomImageable::ComputePurposeInfo(), the purpose authored on the topmost ancestor
+    // is inherited by all its descendants.
+    TfToken inheritedPurpose = UsdGeomTokens->default_;
+    bool    isPurposeInherited = false;
+    for (UsdPrim ancestor = prim.GetParent(); ancestor && !ancestor.IsPseudoRoot();
+         ancestor = ancestor.GetParent()) {
+        TfToken purpose;
+        if (_GetAuthoredPurpose(ancestor, &purpose)) {
+            inheritedPurpose = purpose;
+            isPurposeInherited = true;
+        }
+    }
+
+    // Leaf bounds are only evaluated for entries that are missing or out of
+    // date, so a cache scoped to this query is enough.
+    UsdGeomBBoxCache leafCache(time, _includedPurposes);
+    bool             isAnimated = false;
+    bool             dependsOnAncestors = false;
+    return _ComputeBound(
+        prim,
+        time,
+        inheritedPurpose,
+        isPurposeInherited,
+        leafCache,
+        &isAnimated,
+        &dependsOnAncestors);
+}
+
+void MayaUsdProxyShapeBoundsCache::Invalidate(const SdfPath& primPath, bool recursive)
+{
+    auto it = _entries.find(primPath);
+    if (it != _entries.end()) {
+        if (recursive) {
+            // Erasing from a path table also erases all the descendants.
+            _entries.erase(it);
+        } else {
+            it->second.isValid = false;
+        }
+    }
+
+    for (SdfPath path = primPath.GetParentPath(); !path.IsEmpty(); path = path.GetParentPath()) {
+        auto ancestorIt = _entries.find(path);
+        if (ancestorIt != _entries.end()) {
+            ancestorIt->second.isValid = false;
+        }
+    }
+}
+
+void MayaUsdProxyShapeBoundsCache::Clear() { _entries.clear(); }
+
+bool MayaUsdProxyShapeBoundsCache::_IsPurposeIncluded(const TfToken& purpose) const
+{
+    return std::find(_includedPurposes.begin(), _includedPurposes.end(), purpose)
+        != _includedPurposes.end();
+}
+
+GfBBox3d MayaUsdProxyShapeBoundsCache::_ComputeBound(
+    const UsdPrim&     prim,
+    const UsdTimeCode& time,
+    const TfToken&     inheritedPurpose,
+    bool               isPurposeInherited,
+    UsdGeomBBoxCache&  leafCache,
+    bool*              isAnimated,
+    bool*              dependsOnAncestors)
+{
+    bool wasAnimated = false;
+
+    auto it = _entries.find(prim.GetPath());
+    if (it != _entries.end() && it->second.isValid) {
+        const _Entry& entry = it->second;
+        if (!entry.isAnimated || entry.time == time) {
+            *isAnimated = entry.isAnimated;
+            *dependsOnAncestors = false;
+            return entry.bound;
+        }
+        wasAnimated = true;
+    }
+
+    bool     animated = false;
+    bool     ancestorDependent = false;
+    GfBBox3d bound;
+
+    // Mirror UsdGeomBBoxCache: only imageable prims with an included purpose
+    // and that are visible contribute to the bound. The purpose authored on a
+    // prim only applies when none of its ancestors has an authored purpose.
+    TfToken purpose = inheritedPurpose;
+    bool    purposeInherited = isPurposeInherited;
+    bool    isIncluded = true;
+    if (!prim.IsPseudoRoot()) {
+        const UsdGeomImageable imageable(prim);
+        if (!imageable) {
+            isIncluded = false;
+        } else {
+            if (!purposeInherited && _GetAuthoredPurpose(prim, &purpose)) {
+                purposeInherited = true;
+            }
+
+            const UsdAttribute visibilityAttr = imageable.GetVisibilityAttr();
+            TfToken            visibility;
+            visibilityAttr.Get(&visibility, time);
+            animated = visibilityAttr.ValueMightBeTimeVarying();
+
+            isIncluded = _IsPurposeIncluded(purpose) && visibility != UsdGeomTokens->invisible;
+        }
+    }
+
+    if (isIncluded && prim.IsA<UsdGeomBoundable>()) {
+        bound = leafCache.ComputeUntransformedBound(prim);
+        animated = animated || wasAnimated || _IsSubtreeTimeVarying(prim);
+    } else if (isIncluded) {
+        bool childResetsXformStack = false;
+        for (const UsdPrim& child : prim.GetFilteredChildren(UsdTraverseInstanceProxies())) {
+            bool     childAnimated = false;
+            bool     childDependsOnAncestors = false;
+            GfBBox3d childBound = _ComputeBound(
+                child,
+                time,
+                purpose,
+                purposeInherited,
+                leafCache,
+                &childAnimated,
+                &childDependsOnAncestors);
+            animated = animated || childAnimated;
+            ancestorDependent = ancestorDependent || childDependsOnAncestors;
+
+            const UsdGeomXformable xformable(child);
+            if (xformable) {
+                GfMatrix4d localXform(1.0);
+                bool       resetsXformStack = false;
+                xformable.GetLocalTransformation(&localXform, &resetsXformStack, time);
+                if (resetsXformStack) {
+                    childResetsXformStack = true;
+                    break;
+                }
+                childBound.Transform(localXform);
+                animated = animated || xformable.TransformMightBeTimeVarying();
+            }
+
+            bound = GfBBox3d::Combine(bound, childBound);
+        }
+
+        // A child that resets the transform stack is placed relative to the stage rather than
+        // to this prim, so its bound in this prim's space depends on the transforms of all the
+        // ancestors. Let UsdGeomBBoxCache handle the reset for this subtree, and do not cache
+        // the bounds of this prim or of its ancestors, as they are not invalidated when an
+        // ancestor transform changes.
+        if (childResetsXformStack) {
+            bound = leafCache.ComputeUntransformedBound(prim);
+            ancestorDependent = true;
+        }
+    }
+
+    *isAnimated = animated;
+    *dependsOnAncestors = ancestorDependent;
+    if (ancestorDependent) {
+        auto staleIt = _entries.find(prim.GetPath());
+        if (staleIt != _entries.end()) {
+            staleIt->second.isValid = false;
+        }
+        return bound;
+    }
+
+    _Entry& entry = _entries[prim.GetPath()];
+    entry.isValid = true;
+    entry.isAnimated = animated;
+    entry.time = time;
+    entry.bound = bound;
+
+    return bound;
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
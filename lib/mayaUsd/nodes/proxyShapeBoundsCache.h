@@ -0,0 +1,104 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef MAYAUSD_PROXY_SHAPE_BOUNDS_CACHE_H
+#define MAYAUSD_PROXY_SHAPE_BOUNDS_CACHE_H
+
+#include <mayaUsd/base/api.h>
+
+#include <pxr/base/gf/bbox3d.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/pathTable.h>
+#include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/timeCode.h>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+class UsdGeomBBoxCache;
+
+/// Per-prim cache of untransformed bounds used by the proxy shape.
+///
+/// Each cached prim is classified as static or animated. A static subtree is
+/// computed once and its bound is reused at every time code, while an animated
+/// subtree only keeps the bound of the last time code it was computed at, so
+/// the memory used by the cache does not grow with the number of frames
+/// visited.
+///
+/// Bounds are computed hierarchically: boundable prims (gprims, point
+/// instancers, ...) are treated as leaves and evaluated with a UsdGeomBBoxCache,
+/// and every other imageable prim combines the transformed bounds of its
+/// children. Invalidating a path therefore only needs to discard the entry of
+/// that path and of its ancestors.
+///
+/// Subtrees containing a prim that resets the transform stack are evaluated
+/// with a UsdGeomBBoxCache as well, and are not cached along with their
+/// ancestors, since their bound depends on the transforms above them.
+class MayaUsdProxyShapeBoundsCache
+{
+public:
+    MAYAUSD_CORE_PUBLIC
+    MayaUsdProxyShapeBoundsCache();
+
+    MAYAUSD_CORE_PUBLIC
+    ~MayaUsdProxyShapeBoundsCache();
+
+    /// Computes the bound of \p prim at \p time, expressed in the prim's own
+    /// space, only including prims whose purpose is in \p includedPurposes.
+    /// Changing the included purposes clears the cache.
+    MAYAUSD_CORE_PUBLIC
+    GfBBox3d ComputeUntransformedBound(
+        const UsdPrim&       prim,
+        const UsdTimeCode&   time,
+        const TfTokenVector& includedPurposes);
+
+    /// Discards the cached bound of \p primPath and of all its ancestors.
+    /// If \p recursive is true, the cached bounds of all the descendants of
+    /// \p primPath are discarded as well.
+    MAYAUSD_CORE_PUBLIC
+    void Invalidate(const SdfPath& primPath, bool recursive);
+
+    /// Discards all cached bounds.
+    MAYAUSD_CORE_PUBLIC
+    void Clear();
+
+private:
+    struct _Entry
+    {
+        bool        isValid { false };
+        bool        isAnimated { false };
+        UsdTimeCode time;
+        GfBBox3d    bound;
+    };
+
+    GfBBox3d _ComputeBound(
+        const UsdPrim&     prim,
+        const UsdTimeCode& time,
+        const TfToken&     inheritedPurpose,
+        bool               isPurposeInherited,
+        UsdGeomBBoxCache&  leafCache,
+        bool*              isAnimated,
+        bool*              dependsOnAncestors);
+
+    bool _IsPurposeIncluded(const TfToken& purpose) const;
+
+    SdfPathTable<_Entry> _entries;
+    TfTokenVector        _includedPurposes;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif
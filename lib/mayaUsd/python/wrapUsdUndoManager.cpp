@@ -67,6 +67,12 @@ void _trackLayerStates(const SdfLayerHandle& layer)
     MayaUsd::UsdUndoManager::instance().trackLayerStates(layer);
 }
 
+size_t _getMemoryUsage() { return MayaUsd::UsdUndoManager::instance().memoryUsage(); }
+
+size_t _getMemoryBudget() { return MayaUsd::UsdUndoManager::instance().memoryBudget(); }
+
+void _setMemoryBudget(size_t bytes) { MayaUsd::UsdUndoManager::instance().setMemoryBudget(bytes); }
+
 } // namespace
 
 void wrapUsdUndoManager()
@@ -76,7 +82,13 @@ void wrapUsdUndoManager()
         typedef MayaUsd::UsdUndoManager This;
         class_<This, boost::noncopyable>("UsdUndoManager", no_init)
             .def("trackLayerStates", &_trackLayerStates)
-            .staticmethod("trackLayerStates");
+            .staticmethod("trackLayerStates")
+            .def("getMemoryUsage", &_getMemoryUsage)
+            .staticmethod("getMemoryUsage")
+            .def("getMemoryBudget", &_getMemoryBudget)
+            .staticmethod("getMemoryBudget")
+            .def("setMemoryBudget", &_setMemoryBudget)
+            .staticmethod("setMemoryBudget");
     }
 
     // UsdUndoBlock
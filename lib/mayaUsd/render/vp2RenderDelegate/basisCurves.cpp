@@ -546,7 +546,12 @@ void HdVP2BasisCurves::Sync(
     auto* const          param = static_cast<HdVP2RenderParam*>(_delegate->GetRenderParam());
     ProxyRenderDelegate& drawScene = param->GetDrawScene();
     HdRenderIndex&       renderIndex = delegate->GetRenderIndex();
-    if (!drawScene.DrawRenderTag(renderIndex.GetRenderTag(GetId()))) {
+    const TfToken&       renderTag = renderIndex.GetRenderTag(GetId());
+    if (renderTag != _indexedRenderTag) {
+        drawScene.UpdateRenderTag(GetId(), renderTag);
+        _indexedRenderTag = renderTag;
+    }
+    if (!drawScene.DrawRenderTag(renderTag)) {
         _HideAllDrawItems(reprToken);
         *dirtyBits &= ~(
             HdChangeTracker::DirtyRenderTag
@@ -557,6 +562,12 @@ void HdVP2BasisCurves::Sync(
         return;
     }
 
+    // With progressive population, the ProxyRenderDelegate draws a placeholder box until it
+    // promotes the rprim. The dirty bits are kept for the sync which follows the promotion.
+    if (drawScene.IsRprimDeferred(GetId())) {
+        return;
+    }
+
     MProfilingScope profilingScope(
         HdVP2RenderDelegate::sProfilerCategory,
         MProfiler::kColorC_L2,
@@ -0,0 +1,166 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Micro-benchmarks for the primvar gather of the VP2 render delegate.
+//
+// HdVP2Mesh fills its vertex buffers by gathering the primvar values of each rendering vertex
+// through renderingToSceneFaceVtxIds. The gather is run against the face vertex indices of
+// synthetic quad grid meshes (100k to 10M face-vertices by default), for planar GfVec2f, GfVec3f
+// and GfVec4f buffers and for a GfVec3f interleaved into a GfVec4f buffer, like displayColor.
+// Each case is timed with the per-element checked loop HdVP2Mesh used before (reference) and with
+// HdVP2GatherPrimvarData, serially and on all cores. No Maya session is needed.
+//
+#include "primvarGather.h"
+
+#include <mayaUsdBenchmark.h>
+
+#include <pxr/base/gf/vec2f.h>
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/gf/vec4f.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+using MayaUsdBenchmark::Benchmark;
+
+namespace {
+
+//! The face vertex indices of a grid of quads, and primvar values for each of its points.
+struct SyntheticMesh
+{
+    std::vector<int> faceVertexIndices;
+
+    std::vector<GfVec2f> values2f;
+    std::vector<GfVec3f> values3f;
+    std::vector<GfVec4f> values4f;
+};
+
+SyntheticMesh makeGridMesh(const size_t targetFaceVertices)
+{
+    const size_t side
+        = std::max<size_t>(2, size_t(std::ceil(std::sqrt(double(targetFaceVertices) / 4.0))) + 1);
+    const size_t numPoints = side * side;
+
+    SyntheticMesh mesh;
+    mesh.faceVertexIndices.reserve((side - 1) * (side - 1) * 4);
+    for (size_t z = 0; z < side - 1; ++z) {
+        for (size_t x = 0; x < side - 1; ++x) {
+            mesh.faceVertexIndices.push_back(int(z * side + x));
+            mesh.faceVertexIndices.push_back(int(z * side + x + 1));
+            mesh.faceVertexIndices.push_back(int((z + 1) * side + x + 1));
+            mesh.faceVertexIndices.push_back(int((z + 1) * side + x));
+        }
+    }
+
+    mesh.values2f.resize(numPoints);
+    mesh.values3f.resize(numPoints);
+    mesh.values4f.resize(numPoints);
+    for (size_t i = 0; i < numPoints; ++i) {
+        const float x = float(i % side);
+        const float z = float(i / side);
+        const float y = std::sin(x * 0.1f) * std::cos(z * 0.1f);
+        mesh.values2f[i] = GfVec2f(x, z);
+        mesh.values3f[i] = GfVec3f(x, y, z);
+        mesh.values4f[i] = GfVec4f(x, y, z, 1.0f);
+    }
+    return mesh;
+}
+
+//! The per-element checked gather HdVP2Mesh used before HdVP2GatherPrimvarData.
+template <class DEST_TYPE, class SRC_TYPE>
+void referenceGather(
+    DEST_TYPE*                   vertexBuffer,
+    size_t                       numVertices,
+    size_t                       channelOffset,
+    const std::vector<int>&      indices,
+    const std::vector<SRC_TYPE>& data)
+{
+    const unsigned int dataSize = data.size();
+    for (size_t v = 0; v < numVertices; v++) {
+        unsigned int index = indices[v];
+        if (index < dataSize) {
+            SRC_TYPE* pointer = reinterpret_cast<SRC_TYPE*>(
+                reinterpret_cast<float*>(&vertexBuffer[v]) + channelOffset);
+            *pointer = data[index];
+        }
+    }
+}
+
+template <class DEST_TYPE, class SRC_TYPE>
+void addBenchmarks(
+    std::vector<Benchmark>&      benchmarks,
+    const std::string&           name,
+    const SyntheticMesh&         mesh,
+    const std::vector<SRC_TYPE>& data,
+    size_t                       channelOffset,
+    std::vector<DEST_TYPE>&      buffer)
+{
+    const std::vector<int>& indices = mesh.faceVertexIndices;
+    const size_t            n = indices.size();
+    const size_t            bytes = n * (sizeof(int) + sizeof(SRC_TYPE) * 2);
+    buffer.resize(n);
+    DEST_TYPE* out = buffer.data();
+
+    const auto reference
+        = [=, &indices, &data]() { referenceGather(out, n, channelOffset, indices, data); };
+    const auto gather = [=, &indices, &data]() {
+        HdVP2GatherPrimvarData(out, n, channelOffset, indices.data(), data.data(), data.size());
+    };
+
+    benchmarks.push_back({ name + "/reference", bytes, n, reference, true });
+    benchmarks.push_back({ name + "/serial", bytes, n, gather, true });
+    benchmarks.push_back({ name + "/parallel", bytes, n, gather });
+}
+
+//! Scratch vertex buffers, kept alive while the benchmarks run.
+struct VertexBuffers
+{
+    std::vector<GfVec2f> planar2f;
+    std::vector<GfVec3f> planar3f;
+    std::vector<GfVec4f> planar4f;
+    std::vector<GfVec4f> interleaved;
+};
+
+std::vector<Benchmark> makeBenchmarks(const SyntheticMesh& mesh, VertexBuffers& buffers)
+{
+    std::vector<Benchmark> benchmarks;
+    addBenchmarks(benchmarks, "gather<GfVec2f>", mesh, mesh.values2f, 0, buffers.planar2f);
+    addBenchmarks(benchmarks, "gather<GfVec3f>", mesh, mesh.values3f, 0, buffers.planar3f);
+    addBenchmarks(benchmarks, "gather<GfVec4f>", mesh, mesh.values4f, 0, buffers.planar4f);
+    addBenchmarks(
+        benchmarks, "gather<GfVec3f,GfVec4f>", mesh, mesh.values3f, 0, buffers.interleaved);
+    return benchmarks;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    return MayaUsdBenchmark::runBenchmarks(
+        argc,
+        argv,
+        "mayaUsdVP2Benchmarks",
+        { 100000, 1000000, 10000000 },
+        [](size_t size, const MayaUsdBenchmark::RunFunction& run) {
+            const SyntheticMesh mesh = makeGridMesh(size);
+            VertexBuffers       buffers;
+            run(mesh.faceVertexIndices.size(), makeBenchmarks(mesh, buffers));
+        });
+}
@@ -92,6 +92,12 @@ public:
         //! Whether or not the render item is using GPU instanced draw.
         bool _usingInstancedDraw { false };
 
+        //! How each instance was drawn by the render item in its last update
+        std::vector<unsigned char> _instanceInfo;
+
+        //! Version of the instance transforms last uploaded to the render item
+        unsigned int _instanceTransformsVersion { 0 };
+
         //! Dirty bits to control data update of draw item
         HdDirtyBits _dirtyBits { HdChangeTracker::AllDirty };
 
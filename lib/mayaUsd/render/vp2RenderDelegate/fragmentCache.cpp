@@ -0,0 +1,327 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "fragmentCache.h"
+
+#include "debugCodes.h"
+
+#include <pxr/base/arch/hash.h>
+#include <pxr/base/tf/debug.h>
+#include <pxr/base/tf/diagnostic.h>
+#include <pxr/base/tf/getenv.h>
+#include <pxr/base/tf/stringUtils.h>
+
+#include <maya/MProfiler.h>
+#include <maya/MTypes.h>
+
+#include <ghc/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#if !defined(MAYAUSD_VERSION)
+#error "MAYAUSD_VERSION is not defined"
+#endif
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x)  STRINGIFY(x)
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace {
+
+//! Version of the file format, to be increased whenever it changes
+const int _kFormatVersion = 1;
+
+//! First line of the cache files
+const std::string _kFileHeader = TfStringPrintf("HdVP2Fragment %d", _kFormatVersion);
+
+} // anonymous namespace
+
+const int HdVP2FragmentCache::sProfilerCategory = MProfiler::addCategory(
+#if MAYA_API_VERSION >= 20190000
+    "HdVP2FragmentCache",
+    "HdVP2FragmentCache"
+#else
+    "HdVP2FragmentCache"
+#endif
+);
+
+/*! \brief  Returns the cache shared by all the render delegates.
+ */
+HdVP2FragmentCache& HdVP2FragmentCache::GetInstance()
+{
+    static HdVP2FragmentCache instance;
+    return instance;
+}
+
+/*! \brief  Constructor, reads the settings from the environment.
+ */
+HdVP2FragmentCache::HdVP2FragmentCache()
+    : _enabled(TfGetenvInt("HDVP2_USE_FRAGMENT_CACHE", 1) > 0)
+{
+    if (!_enabled) {
+        return;
+    }
+
+    _directory = TfGetenv("HDVP2_FRAGMENT_CACHE_DIR");
+    if (_directory.empty()) {
+        std::error_code ec;
+        auto            tmpDir = ghc::filesystem::temp_directory_path(ec);
+        tmpDir /= "mayaUsdFragmentCache";
+        _directory = tmpDir.string();
+    }
+
+    _maxSize = static_cast<size_t>(std::max(0, TfGetenvInt("HDVP2_FRAGMENT_CACHE_MAX_SIZE", 64)))
+        << 20;
+    _Trim();
+}
+
+/*! \brief  Returns the key of a fragment in the cache.
+
+    \param  topology            Description of the material network topology. It must only
+                                contain values that are stable across sessions.
+    \param  generatorVersion    Version of the library generating the fragment
+    \param  libraries           Identifies the libraries and search paths of the generator, for
+                                example a hash of their content.
+*/
+std::string HdVP2FragmentCache::GetKey(
+    const std::string& topology,
+    const std::string& generatorVersion,
+    const std::string& libraries)
+{
+    std::ostringstream versions;
+    versions << _kFormatVersion << ' ' << generatorVersion << ' ' << MAYA_API_VERSION << ' '
+             << TOSTRING(MAYAUSD_VERSION) << ' ' << libraries << '\n';
+    const std::string hashed = versions.str() + topology;
+    return TfStringPrintf(
+        "%016llx", static_cast<unsigned long long>(ArchHash64(hashed.c_str(), hashed.size())));
+}
+
+/*! \brief  Reads a fragment from the cache.
+
+    Counts a hit or a miss in the statistics.
+
+    \return True if the fragment was found.
+*/
+bool HdVP2FragmentCache::Find(const std::string& key, HdVP2CachedFragment& fragment)
+{
+    MProfilingScope profilingScope(
+        sProfilerCategory, MProfiler::kColorD_L2, "HdVP2FragmentCache::Find");
+
+    bool found = false;
+
+    if (_enabled) {
+        const std::string path = _GetPath(key);
+        std::ifstream     file(path, std::ios::binary);
+
+        std::string header, transparent, primvars;
+        if (file && std::getline(file, header) && header == _kFileHeader
+            && std::getline(file, fragment._name) && std::getline(file, transparent)
+            && std::getline(file, primvars)) {
+            fragment._isTransparent = transparent == "1";
+            fragment._requiredPrimvars.clear();
+            for (const std::string& primvar : TfStringTokenize(primvars)) {
+                fragment._requiredPrimvars.emplace_back(primvar);
+            }
+            fragment._source.assign(
+                std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+            found = !file.bad() && !fragment._name.empty() && !fragment._source.empty();
+        }
+
+        // Trimming the cache removes the least recently used files first.
+        if (found) {
+            std::error_code ec;
+            ghc::filesystem::last_write_time(
+                path, ghc::filesystem::file_time_type::clock::now(), ec);
+        }
+    }
+
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (found) {
+            ++_stats._hits;
+        } else {
+            ++_stats._misses;
+        }
+        stats = _stats;
+    }
+
+    TF_DEBUG(HDVP2_DEBUG_FRAGMENT_CACHE)
+        .Msg(
+            "Fragment cache %s for %s (%zu hits, %zu misses)\n",
+            found ? "hit" : "miss",
+            key.c_str(),
+            stats._hits,
+            stats._misses);
+
+    return found;
+}
+
+/*! \brief  Writes a generated fragment to the cache.
+
+    Failing to write is not an error: the fragment will be generated again in the next session.
+
+    \param  key             Key of the fragment, see GetKey()
+    \param  fragment        Generated fragment
+    \param  generationTime  Time it took to generate the fragment, in seconds
+*/
+void HdVP2FragmentCache::Add(
+    const std::string&         key,
+    const HdVP2CachedFragment& fragment,
+    double                     generationTime)
+{
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stats._generationTime += generationTime;
+        stats = _stats;
+    }
+
+    TF_DEBUG(HDVP2_DEBUG_FRAGMENT_CACHE)
+        .Msg(
+            "Generated fragment %s in %.3fs (%.3fs in total)\n",
+            fragment._name.c_str(),
+            generationTime,
+            stats._generationTime);
+
+    if (!_enabled) {
+        return;
+    }
+
+    MProfilingScope profilingScope(
+        sProfilerCategory, MProfiler::kColorD_L2, "HdVP2FragmentCache::Add");
+
+    std::error_code ec;
+    ghc::filesystem::create_directories(_directory, ec);
+    if (ec) {
+        TF_DEBUG(HDVP2_DEBUG_FRAGMENT_CACHE)
+            .Msg("Cannot create fragment cache folder %s\n", _directory.c_str());
+        return;
+    }
+
+    // Write to a unique temporary file, then rename it, so that other sessions never read a
+    // partially written fragment.
+    const std::string path = _GetPath(key);
+    const std::string tmpPath = TfStringPrintf("%s.%08x", path.c_str(), std::random_device {}());
+    size_t            fileSize = 0;
+    {
+        const std::vector<std::string> primvars = TfToStringVector(fragment._requiredPrimvars);
+
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        file << _kFileHeader << '\n'
+             << fragment._name << '\n'
+             << (fragment._isTransparent ? '1' : '0') << '\n'
+             << TfStringJoin(primvars, " ") << '\n'
+             << fragment._source;
+        if (!file.flush()) {
+            file.close();
+            ghc::filesystem::remove(tmpPath, ec);
+            return;
+        }
+        fileSize = static_cast<size_t>(file.tellp());
+    }
+
+    ghc::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        ghc::filesystem::remove(tmpPath, ec);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _size += fileSize;
+    if (_size > _maxSize) {
+        _Trim();
+    }
+}
+
+/*! \brief  Returns the statistics since the start of the session.
+ */
+HdVP2FragmentCache::Stats HdVP2FragmentCache::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+/*! \brief  Returns the path of the cache file of a fragment.
+ */
+std::string HdVP2FragmentCache::_GetPath(const std::string& key) const
+{
+    return (ghc::filesystem::path(_directory) / (key + ".xml")).string();
+}
+
+/*! \brief  Removes the least recently used fragments if the files are larger than the maximum.
+
+    The files of other sessions are counted too. Half of the maximum size is kept, so that the
+    folder is not listed again for every new fragment.
+*/
+void HdVP2FragmentCache::_Trim()
+{
+    struct CacheFile
+    {
+        ghc::filesystem::path           _path;
+        ghc::filesystem::file_time_type _time;
+        size_t                          _size;
+    };
+
+    std::vector<CacheFile> files;
+    std::error_code        ec;
+    _size = 0;
+    for (ghc::filesystem::directory_iterator it(_directory, ec), end; !ec && it != end;
+         it.increment(ec)) {
+        const ghc::filesystem::path& path = it->path();
+        if (path.extension() != ".xml") {
+            continue;
+        }
+
+        std::error_code fileEc;
+        const size_t    size = static_cast<size_t>(ghc::filesystem::file_size(path, fileEc));
+        const auto      time = ghc::filesystem::last_write_time(path, fileEc);
+        if (!fileEc) {
+            files.push_back({ path, time, size });
+            _size += size;
+        }
+    }
+
+    if (_size <= _maxSize) {
+        return;
+    }
+
+    std::sort(files.begin(), files.end(), [](const CacheFile& a, const CacheFile& b) {
+        return a._time < b._time;
+    });
+
+    size_t removed = 0;
+    for (const CacheFile& file : files) {
+        if (_size <= _maxSize / 2) {
+            break;
+        }
+        if (ghc::filesystem::remove(file._path, ec)) {
+            _size -= file._size;
+            ++removed;
+        }
+    }
+
+    TF_DEBUG(HDVP2_DEBUG_FRAGMENT_CACHE)
+        .Msg("Removed %zu fragments from the cache, %zu bytes left\n", removed, _size);
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
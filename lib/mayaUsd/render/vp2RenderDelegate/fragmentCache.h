@@ -0,0 +1,109 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef HD_VP2_FRAGMENT_CACHE
+#define HD_VP2_FRAGMENT_CACHE
+
+#include <mayaUsd/base/api.h>
+
+#include <pxr/base/tf/token.h>
+#include <pxr/pxr.h>
+
+#include <mutex>
+#include <string>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/*! \brief  A shader fragment generated for a material network topology.
+ */
+struct HdVP2CachedFragment
+{
+    std::string   _name;                    //!< Name the fragment is registered with
+    std::string   _source;                  //!< OGS XML source of the fragment
+    bool          _isTransparent { false }; //!< Whether the shader is transparent
+    TfTokenVector _requiredPrimvars;        //!< Primvars read by the vertex shader
+};
+
+/*! \brief  Persistent cache of the shader fragments generated from MaterialX networks.
+    \class  HdVP2FragmentCache
+
+    Generating the OGS XML and GLSL of a MaterialX network is expensive, and is otherwise done
+    again in every session for every network topology. Fragments are stored in one file each,
+    named after a hash of the network topology, of the MaterialX libraries and search paths, and
+    of the versions of MaterialX, Maya and MayaUSD they were generated with. A change to any of
+    them therefore never reads stale fragments.
+
+    Files are written to a temporary name first and then renamed, so that concurrent Maya
+    sessions can share the cache directory.
+
+    The cache is in the "mayaUsdFragmentCache" folder of the temporary directory, unless the
+    HDVP2_FRAGMENT_CACHE_DIR environment variable is set. It can be disabled by setting the
+    HDVP2_USE_FRAGMENT_CACHE environment variable to 0. The files take at most 64 MB, or the
+    number of MB set in the HDVP2_FRAGMENT_CACHE_MAX_SIZE environment variable: the least
+    recently used fragments are removed when the cache grows beyond it.
+
+    Lookups and generation times are counted, and reported with the HDVP2_DEBUG_FRAGMENT_CACHE
+    debug code.
+*/
+class MAYAUSD_CORE_PUBLIC HdVP2FragmentCache
+{
+public:
+    //! Usage statistics of the cache since the start of the session
+    struct Stats
+    {
+        size_t _hits { 0 };             //!< Fragments read from the cache
+        size_t _misses { 0 };           //!< Fragments that had to be generated
+        double _generationTime { 0.0 }; //!< Total time spent generating fragments, in seconds
+    };
+
+    static HdVP2FragmentCache& GetInstance();
+
+    HdVP2FragmentCache(const HdVP2FragmentCache&) = delete;
+    HdVP2FragmentCache& operator=(const HdVP2FragmentCache&) = delete;
+
+    bool IsEnabled() const { return _enabled; }
+
+    static std::string GetKey(
+        const std::string& topology,
+        const std::string& generatorVersion,
+        const std::string& libraries);
+
+    bool Find(const std::string& key, HdVP2CachedFragment& fragment);
+
+    void Add(const std::string& key, const HdVP2CachedFragment& fragment, double generationTime);
+
+    Stats GetStats() const;
+
+    static const int sProfilerCategory; //!< Profiler category
+
+private:
+    HdVP2FragmentCache();
+
+    std::string _GetPath(const std::string& key) const;
+
+    void _Trim();
+
+    const bool  _enabled;       //!< Whether fragments are read and written
+    std::string _directory;     //!< Folder of the cache files
+    size_t      _maxSize { 0 }; //!< Size of the files above which the cache is trimmed, in bytes
+
+    mutable std::mutex _mutex;      //!< Protects the statistics and the size
+    Stats              _stats;      //!< Statistics since the start of the session
+    size_t             _size { 0 }; //!< Size of the files, updated by the writes of the session
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif
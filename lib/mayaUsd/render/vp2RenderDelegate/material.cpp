@@ -16,14 +16,17 @@
 #include "material.h"
 
 #include "debugCodes.h"
+#include "fragmentCache.h"
 #include "pxr/usd/sdr/registry.h"
 #include "pxr/usd/sdr/shaderNode.h"
 #include "render_delegate.h"
+#include "textureLoader.h"
 #include "tokens.h"
 
 #include <mayaUsd/render/vp2ShaderFragments/shaderFragments.h>
 #include <mayaUsd/utils/hash.h>
 
+#include <pxr/base/arch/hash.h>
 #include <pxr/base/gf/matrix4d.h>
 #include <pxr/base/gf/matrix4f.h>
 #include <pxr/base/gf/vec2f.h>
@@ -32,6 +35,7 @@
 #include <pxr/base/tf/diagnostic.h>
 #include <pxr/base/tf/getenv.h>
 #include <pxr/base/tf/pathUtils.h>
+#include <pxr/base/tf/stringUtils.h>
 #include <pxr/imaging/hd/sceneDelegate.h>
 
 #ifdef WANT_MATERIALX_BUILD
@@ -61,8 +65,10 @@
 #include <mayaUsd/render/MaterialXGenOgsXml/OgsXmlGenerator.h>
 
 #include <MaterialXCore/Document.h>
+#include <MaterialXCore/Util.h>
 #include <MaterialXFormat/File.h>
 #include <MaterialXFormat/Util.h>
+#include <MaterialXFormat/XmlIo.h>
 #include <MaterialXGenGlsl/GlslShaderGenerator.h>
 #include <MaterialXGenShader/HwShaderGenerator.h>
 #include <MaterialXGenShader/ShaderStage.h>
@@ -70,17 +76,14 @@
 #include <MaterialXRender/ImageHandler.h>
 #endif
 
-#if PXR_VERSION <= 2008
-// Needed for GL_HALF_FLOAT.
-#include <GL/glew.h>
-#endif
-
 #include <ghc/filesystem.hpp>
 #include <tbb/parallel_for.h>
 
+#include <chrono>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 
 #if PXR_VERSION >= 2102
 #include <pxr/imaging/hdSt/udimTextureObject.h>
@@ -211,9 +214,19 @@ struct _MaterialXData
         _mtlxSearchPath = HdMtlxSearchPaths();
 
         mx::loadLibraries({}, _mtlxSearchPath, _mtlxLibrary);
+
+        // Cached fragments generated with other libraries must not be reused.
+        if (HdVP2FragmentCache::GetInstance().IsEnabled()) {
+            const std::string libraries
+                = _mtlxSearchPath.asString() + '\n' + mx::writeToXmlString(_mtlxLibrary);
+            _libraryHash = TfStringPrintf(
+                "%016llx",
+                static_cast<unsigned long long>(ArchHash64(libraries.c_str(), libraries.size())));
+        }
     }
     MaterialX::FileSearchPath _mtlxSearchPath; //!< MaterialX library search path
     MaterialX::DocumentPtr    _mtlxLibrary;    //!< MaterialX library
+    std::string               _libraryHash;    //!< Hash of the library and of its search path
 };
 
 _MaterialXData& _GetMaterialXData()
@@ -295,6 +308,35 @@ size_t _GenerateNetwork2TopoHash(const HdMaterialNetwork2& materialNetwork)
     return topoHash;
 }
 
+//! Helper function to describe the same topology as _GenerateNetwork2TopoHash, in a form that is
+//  stable across sessions. The hash of tokens and paths is not, so it cannot key persistent data.
+std::string _GenerateNetwork2TopoKey(const HdMaterialNetwork2& materialNetwork)
+{
+    std::ostringstream result;
+    for (const auto& c : materialNetwork.terminals) {
+        result << c.first << " " << c.second.upstreamNode << "." << c.second.upstreamOutputName
+               << "\n";
+    }
+    for (const auto& nodePair : materialNetwork.nodes) {
+        const auto& node = nodePair.second;
+        result << nodePair.first << " " << node.nodeTypeId << "\n";
+
+        if (_IsTopologicalNode(node)) {
+            for (auto const& p : node.parameters) {
+                result << "  " << p.first << "=" << p.second << "\n";
+            }
+        }
+        for (auto const& i : node.inputConnections) {
+            result << "  " << i.first << "<-";
+            for (auto const& c : i.second) {
+                result << " " << c.upstreamNode << "." << c.upstreamOutputName;
+            }
+            result << "\n";
+        }
+    }
+    return result.str();
+}
+
 //! Helper function to generate a XML string about nodes, relationships and primvars in the
 //! specified material network.
 std::string _GenerateXMLString(const HdMaterialNetwork2& materialNetwork)
@@ -459,6 +501,74 @@ void _AddMissingTexcoordReaders(mx::DocumentPtr& mtlxDoc)
     }
 }
 
+//! Generates the OGS fragment of a MaterialX network. Can throw if any MaterialX error is raised.
+bool _GenerateMaterialXFragment(
+    SdfPath const&            materialId,
+    HdMaterialNetwork2 const& network,
+    HdMaterialNode2 const&    surfTerminal,
+    HdVP2CachedFragment&      fragment)
+{
+    // Create the MaterialX Document from the HdMaterialNetwork
+    std::set<SdfPath> hdTextureNodes;
+    mx::StringMap     mxHdTextureMap; // Mx-Hd texture name counterparts
+    mx::DocumentPtr   mtlxDoc = HdMtlxCreateMtlxDocumentFromHdNetwork(
+        network,
+        surfTerminal, // MaterialX HdNode
+        SdfPath(_mtlxTokens->USD_Mtlx_VP2_Material),
+        _GetMaterialXData()._mtlxLibrary,
+        &hdTextureNodes,
+        &mxHdTextureMap);
+
+    if (!mtlxDoc) {
+        return false;
+    }
+
+    // Fix any missing texcoord reader.
+    _AddMissingTexcoordReaders(mtlxDoc);
+
+    if (TfDebug::IsEnabled(HDVP2_DEBUG_MATERIAL)) {
+        std::cout << "generated shader code for " << materialId.GetText() << ":\n";
+        std::cout << "Generated graph\n==============================\n";
+        mx::writeToXmlStream(mtlxDoc, std::cout);
+        std::cout << "\n==============================\n";
+    }
+
+    // This function is very recent and might only exist in a PR at this point in time
+    // See https://github.com/autodesk-forks/MaterialX/pull/1197 for current status.
+    mx::OgsXmlGenerator::setUseLightAPIV2(true);
+
+    mx::NodePtr materialNode;
+    for (const mx::NodePtr& material : mtlxDoc->getMaterialNodes()) {
+        if (material->getName() == _mtlxTokens->USD_Mtlx_VP2_Material.GetText()) {
+            materialNode = material;
+        }
+    }
+
+    if (!materialNode) {
+        return false;
+    }
+
+    MaterialXMaya::OgsFragment ogsFragment(materialNode, _GetMaterialXData()._mtlxSearchPath);
+
+    // Explore the fragment for primvars:
+    mx::ShaderPtr            shader = ogsFragment.getShader();
+    const mx::VariableBlock& vertexInputs
+        = shader->getStage(mx::Stage::VERTEX).getInputBlock(mx::HW::VERTEX_INPUTS);
+    for (size_t i = 0; i < vertexInputs.size(); ++i) {
+        const mx::ShaderPort* variable = vertexInputs[i];
+        // Position is always assumed.
+        // Tangent will be generated in the vertex shader using a utility fragment
+        if (variable->getName() == mx::HW::T_IN_NORMAL) {
+            fragment._requiredPrimvars.push_back(HdTokens->normals);
+        }
+    }
+
+    fragment._name = ogsFragment.getFragmentName();
+    fragment._source = ogsFragment.getFragmentSource();
+    fragment._isTransparent = ogsFragment.isTransparent();
+    return true;
+}
+
 #endif // WANT_MATERIALX_BUILD
 
 bool _IsUsdDrawModeId(const TfToken& id)
@@ -685,8 +795,68 @@ MHWRender::MSamplerStateDesc _GetSamplerStateDesc(const HdMaterialNode& node)
     return desc;
 }
 
-MHWRender::MTexture*
-_LoadUdimTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvScaleOffset)
+//! Return true if the path is a UDIM texture path
+bool _IsUdimTexture(const std::string& path)
+{
+#if PXR_VERSION >= 2102
+    return HdStIsSupportedUdimTexture(path);
+#else
+    return GlfIsSupportedUdimTexture(path);
+#endif
+}
+
+//! Load a 1x1 texture of the specified color
+MHWRender::MTexture* _LoadColorTexture(const std::string& name, const GfVec4f& color)
+{
+    MHWRender::MRenderer* const       renderer = MHWRender::MRenderer::theRenderer();
+    MHWRender::MTextureManager* const textureMgr
+        = renderer ? renderer->getTextureManager() : nullptr;
+    if (!TF_VERIFY(textureMgr)) {
+        return nullptr;
+    }
+
+    MHWRender::MTextureDescription desc;
+    desc.setToDefault2DTexture();
+    desc.fWidth = 1;
+    desc.fHeight = 1;
+    desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
+    desc.fBytesPerRow = 4;
+    desc.fBytesPerSlice = desc.fBytesPerRow;
+
+    std::vector<unsigned char> texels(4);
+    for (size_t i = 0; i < 4; ++i) {
+        float texelValue = std::max(std::min(color[i], 1.0f), 0.0f);
+        texels[i] = static_cast<unsigned char>(texelValue * 255.0);
+    }
+    return textureMgr->acquireTexture(name.c_str(), desc, texels.data());
+}
+
+//! Load the texture bound while the texture of the node is being loaded in the background
+MHWRender::MTexture* _LoadPlaceholderTexture(const HdMaterialNode& node)
+{
+    // Use the fallback color if it was specified, or middle gray otherwise.
+    GfVec4f color(0.5f, 0.5f, 0.5f, 1.0f);
+    auto    it = node.parameters.find(_tokens->fallback);
+    if (it != node.parameters.end() && it->second.IsHolding<GfVec4f>()) {
+        color = it->second.UncheckedGet<GfVec4f>();
+    }
+
+    // Placeholders of the same color are shared through the texture manager cache.
+    const std::string name = TfStringPrintf(
+        "HdVP2PlaceholderTexture_%g_%g_%g_%g", color[0], color[1], color[2], color[3]);
+
+    MHWRender::MRenderer* const       renderer = MHWRender::MRenderer::theRenderer();
+    MHWRender::MTextureManager* const textureMgr
+        = renderer ? renderer->getTextureManager() : nullptr;
+    MHWRender::MTexture* texture = textureMgr ? textureMgr->findTexture(name.c_str()) : nullptr;
+    return texture ? texture : _LoadColorTexture(name, color);
+}
+
+MHWRender::MTexture* _LoadUdimTexture(
+    const std::string& path,
+    int                maxResolution,
+    bool&              isColorSpaceSRGB,
+    MFloatArray&       uvScaleOffset)
 {
     /*
         For this method to work path needs to be an absolute file path, not an asset path.
@@ -699,13 +869,8 @@ _LoadUdimTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& u
     */
 
     // test for a UDIM texture
-#if PXR_VERSION >= 2102
-    if (!HdStIsSupportedUdimTexture(path))
-        return nullptr;
-#else
-    if (!GlfIsSupportedUdimTexture(path))
+    if (!_IsUdimTexture(path))
         return nullptr;
-#endif
 
     /*
         Maya's tiled texture support is implemented quite differently from Usd's UDIM support.
@@ -722,7 +887,10 @@ _LoadUdimTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& u
         return nullptr;
     }
 
-    MHWRender::MTexture* texture = textureMgr->findTexture(path.c_str());
+    // used for caching, using the string with <UDIM> in it is fine
+    const std::string textureName = HdVP2TextureLoader::GetTextureName(path, maxResolution);
+
+    MHWRender::MTexture* texture = textureMgr->findTexture(textureName.c_str());
     if (texture) {
         return texture;
     }
@@ -770,10 +938,10 @@ _LoadUdimTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& u
                 path.c_str());
     }
 
-    MString textureName(
-        path.c_str()); // used for caching, using the string with <UDIM> in it is fine
     MStringArray tilePaths;
     MFloatArray  tilePositions;
+    unsigned int tileColumns = 0;
+    unsigned int tileRows = 0;
     for (auto& tile : tiles) {
         tilePaths.append(MString(std::get<1>(tile).GetText()));
 
@@ -799,12 +967,20 @@ _LoadUdimTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& u
         float v = (float)((tileId - u) / 10);
         tilePositions.append(u);
         tilePositions.append(v);
+        tileColumns = std::max(tileColumns, (unsigned int)u + 1);
+        tileRows = std::max(tileRows, (unsigned int)v + 1);
+    }
+
+    // Limit the resolution of each tile, Maya downscales the tiles to fit.
+    if (maxResolution > 0) {
+        maxWidth = std::min(maxWidth, tileColumns * maxResolution);
+        maxHeight = std::min(maxHeight, tileRows * maxResolution);
     }
 
     MColor       undefinedColor(0.0f, 1.0f, 0.0f, 1.0f);
     MStringArray failedTilePaths;
     texture = textureMgr->acquireTiledTexture(
-        textureName,
+        textureName.c_str(),
         tilePaths,
         tilePositions,
         undefinedColor,
@@ -820,9 +996,10 @@ _LoadUdimTexture(const std::string& path, bool& isColorSpaceSRGB, MFloatArray& u
     return texture;
 }
 
-//! Load texture from the specified path
+//! Load texture from the specified path, limiting its resolution if maxResolution isn't 0
 MHWRender::MTexture* _LoadTexture(
     const std::string&    path,
+    int                   maxResolution,
     bool&                 isColorSpaceSRGB,
     MFloatArray&          uvScaleOffset,
     const HdMaterialNode& node)
@@ -831,13 +1008,8 @@ MHWRender::MTexture* _LoadTexture(
         HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L2, "LoadTexture", path.c_str());
 
     // If it is a UDIM texture we need to modify the path before calling OpenForReading
-#if PXR_VERSION >= 2102
-    if (HdStIsSupportedUdimTexture(path))
-        return _LoadUdimTexture(path, isColorSpaceSRGB, uvScaleOffset);
-#else
-    if (GlfIsSupportedUdimTexture(path))
-        return _LoadUdimTexture(path, isColorSpaceSRGB, uvScaleOffset);
-#endif
+    if (_IsUdimTexture(path))
+        return _LoadUdimTexture(path, maxResolution, isColorSpaceSRGB, uvScaleOffset);
 
     MHWRender::MRenderer* const       renderer = MHWRender::MRenderer::theRenderer();
     MHWRender::MTextureManager* const textureMgr
@@ -846,18 +1018,16 @@ MHWRender::MTexture* _LoadTexture(
         return nullptr;
     }
 
-    MHWRender::MTexture* texture = textureMgr->findTexture(path.c_str());
+    const std::string name = HdVP2TextureLoader::GetTextureName(path, maxResolution);
+
+    MHWRender::MTexture* texture = textureMgr->findTexture(name.c_str());
     if (texture) {
         return texture;
     }
 
-#if PXR_VERSION >= 2102
-    HioImageSharedPtr image = HioImage::OpenForReading(path);
-#else
-    GlfImageSharedPtr     image = GlfImage::OpenForReading(path);
-#endif
-
-    if (!TF_VERIFY(image, "Unable to create an image from %s", path.c_str())) {
+    HdVP2TextureData data;
+    const bool       success = HdVP2TextureLoader::Read(path, maxResolution, data);
+    if (!TF_VERIFY(success, "Unable to read an image from %s", path.c_str())) {
         // Create a 1x1 texture of the fallback color, if it was specified:
         auto it = node.parameters.find(_tokens->fallback);
         if (it == node.parameters.end()) {
@@ -868,311 +1038,12 @@ MHWRender::MTexture* _LoadTexture(
             return nullptr;
         }
 
-        MHWRender::MTextureDescription desc;
-        desc.setToDefault2DTexture();
-        desc.fWidth = 1;
-        desc.fHeight = 1;
-        desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
-        desc.fBytesPerRow = 4;
-        desc.fBytesPerSlice = desc.fBytesPerRow;
-
-        const GfVec4f&             fallbackValue = value.UncheckedGet<GfVec4f>();
-        std::vector<unsigned char> texels(4);
-        for (size_t i = 0; i < 4; ++i) {
-            float texelValue = std::max(std::min(fallbackValue[i], 1.0f), 0.0f);
-            texels[i] = static_cast<unsigned char>(texelValue * 255.0);
-        }
         isColorSpaceSRGB = false;
-        return textureMgr->acquireTexture(path.c_str(), desc, texels.data());
-    }
-
-    // This image is used for loading pixel data from usdz only and should
-    // not trigger any OpenGL call. VP2RenderDelegate will transfer the
-    // texels to GPU memory with VP2 API which is 3D API agnostic.
-#if PXR_VERSION >= 2102
-    HioImage::StorageSpec spec;
-#else
-    GlfImage::StorageSpec spec;
-#endif
-    spec.width = image->GetWidth();
-    spec.height = image->GetHeight();
-    spec.depth = 1;
-#if PXR_VERSION >= 2102
-    spec.format = image->GetFormat();
-#elif PXR_VERSION > 2008
-    spec.hioFormat = image->GetHioFormat();
-#else
-    spec.format = image->GetFormat();
-    spec.type = image->GetType();
-#endif
-    spec.flipped = false;
-
-    const int bpp = image->GetBytesPerPixel();
-    const int bytesPerRow = spec.width * bpp;
-    const int bytesPerSlice = bytesPerRow * spec.height;
-
-    std::vector<unsigned char> storage(bytesPerSlice);
-    spec.data = storage.data();
-
-    if (!image->Read(spec)) {
-        return nullptr;
+        return _LoadColorTexture(name, value.UncheckedGet<GfVec4f>());
     }
 
-    MHWRender::MTextureDescription desc;
-    desc.setToDefault2DTexture();
-    desc.fWidth = spec.width;
-    desc.fHeight = spec.height;
-    desc.fBytesPerRow = bytesPerRow;
-    desc.fBytesPerSlice = bytesPerSlice;
-
-#if PXR_VERSION > 2008
-#if PXR_VERSION >= 2102
-    auto specFormat = spec.format;
-#else
-    auto specFormat = spec.hioFormat;
-#endif
-    switch (specFormat) {
-    // Single Channel
-    case HioFormatFloat32:
-        desc.fFormat = MHWRender::kR32_FLOAT;
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        break;
-    case HioFormatFloat16:
-        desc.fFormat = MHWRender::kR16_FLOAT;
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        break;
-    case HioFormatUNorm8:
-        desc.fFormat = MHWRender::kR8_UNORM;
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        break;
-
-    // Dual channel (quite rare, but seen with mono + alpha files)
-    case HioFormatFloat32Vec2:
-        desc.fFormat = MHWRender::kR32G32_FLOAT;
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        break;
-    case HioFormatFloat16Vec2: {
-        // R16G16 is not supported by VP2. Converted to R16G16B16A16.
-        constexpr int bpp_8 = 8;
-
-        desc.fFormat = MHWRender::kR16G16B16A16_FLOAT;
-        desc.fBytesPerRow = spec.width * bpp_8;
-        desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
-
-        std::vector<unsigned char> texels(desc.fBytesPerSlice);
-
-        for (int y = 0; y < spec.height; y++) {
-            for (int x = 0; x < spec.width; x++) {
-                const int t = spec.width * y + x;
-                texels[t * bpp_8 + 0] = storage[t * bpp + 0];
-                texels[t * bpp_8 + 1] = storage[t * bpp + 1];
-                texels[t * bpp_8 + 2] = storage[t * bpp + 0];
-                texels[t * bpp_8 + 3] = storage[t * bpp + 1];
-                texels[t * bpp_8 + 4] = storage[t * bpp + 0];
-                texels[t * bpp_8 + 5] = storage[t * bpp + 1];
-                texels[t * bpp_8 + 6] = storage[t * bpp + 2];
-                texels[t * bpp_8 + 7] = storage[t * bpp + 3];
-            }
-        }
-
-        texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
-        break;
-    }
-    case HioFormatUNorm8Vec2:
-    case HioFormatUNorm8Vec2srgb: {
-        // R8G8 is not supported by VP2. Converted to R8G8B8A8.
-        constexpr int bpp_4 = 4;
-
-        desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
-        desc.fBytesPerRow = spec.width * bpp_4;
-        desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
-
-        std::vector<unsigned char> texels(desc.fBytesPerSlice);
-
-        for (int y = 0; y < spec.height; y++) {
-            for (int x = 0; x < spec.width; x++) {
-                const int t = spec.width * y + x;
-                texels[t * bpp_4] = storage[t * bpp];
-                texels[t * bpp_4 + 1] = storage[t * bpp];
-                texels[t * bpp_4 + 2] = storage[t * bpp];
-                texels[t * bpp_4 + 3] = storage[t * bpp + 1];
-            }
-        }
-
-        texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
-        isColorSpaceSRGB = image->IsColorSpaceSRGB();
-        break;
-    }
-
-    // 3-Channel
-    case HioFormatFloat32Vec3:
-        desc.fFormat = MHWRender::kR32G32B32_FLOAT;
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        break;
-    case HioFormatFloat16Vec3: {
-        // R16G16B16 is not supported by VP2. Converted to R16G16B16A16.
-        constexpr int bpp_8 = 8;
-
-        desc.fFormat = MHWRender::kR16G16B16A16_FLOAT;
-        desc.fBytesPerRow = spec.width * bpp_8;
-        desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
-
-        GfHalf               opaqueAlpha(1.0f);
-        const unsigned short alphaBits = opaqueAlpha.bits();
-        const unsigned char  lowAlpha = reinterpret_cast<const unsigned char*>(&alphaBits)[0];
-        const unsigned char  highAlpha = reinterpret_cast<const unsigned char*>(&alphaBits)[1];
-
-        std::vector<unsigned char> texels(desc.fBytesPerSlice);
-
-        for (int y = 0; y < spec.height; y++) {
-            for (int x = 0; x < spec.width; x++) {
-                const int t = spec.width * y + x;
-                texels[t * bpp_8 + 0] = storage[t * bpp + 0];
-                texels[t * bpp_8 + 1] = storage[t * bpp + 1];
-                texels[t * bpp_8 + 2] = storage[t * bpp + 2];
-                texels[t * bpp_8 + 3] = storage[t * bpp + 3];
-                texels[t * bpp_8 + 4] = storage[t * bpp + 4];
-                texels[t * bpp_8 + 5] = storage[t * bpp + 5];
-                texels[t * bpp_8 + 6] = lowAlpha;
-                texels[t * bpp_8 + 7] = highAlpha;
-            }
-        }
-
-        texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
-        break;
-    }
-    case HioFormatFloat16Vec4:
-        desc.fFormat = MHWRender::kR16G16B16A16_FLOAT;
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        break;
-    case HioFormatUNorm8Vec3:
-    case HioFormatUNorm8Vec3srgb: {
-        // R8G8B8 is not supported by VP2. Converted to R8G8B8A8.
-        constexpr int bpp_4 = 4;
-
-        desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
-        desc.fBytesPerRow = spec.width * bpp_4;
-        desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
-
-        std::vector<unsigned char> texels(desc.fBytesPerSlice);
-
-        for (int y = 0; y < spec.height; y++) {
-            for (int x = 0; x < spec.width; x++) {
-                const int t = spec.width * y + x;
-                texels[t * bpp_4] = storage[t * bpp];
-                texels[t * bpp_4 + 1] = storage[t * bpp + 1];
-                texels[t * bpp_4 + 2] = storage[t * bpp + 2];
-                texels[t * bpp_4 + 3] = 255;
-            }
-        }
-
-        texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
-        isColorSpaceSRGB = image->IsColorSpaceSRGB();
-        break;
-    }
-
-    // 4-Channel
-    case HioFormatFloat32Vec4:
-        desc.fFormat = MHWRender::kR32G32B32A32_FLOAT;
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        break;
-    case HioFormatUNorm8Vec4:
-    case HioFormatUNorm8Vec4srgb:
-        desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
-        isColorSpaceSRGB = image->IsColorSpaceSRGB();
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        break;
-    default:
-        TF_WARN(
-            "VP2 renderer delegate: unsupported pixel format (%d) in texture file %s.",
-            (int)specFormat,
-            path.c_str());
-        break;
-    }
-#else
-    switch (spec.format) {
-    case GL_RED:
-        desc.fFormat = MHWRender::kR8_UNORM;
-        if (spec.type == GL_FLOAT)
-            desc.fFormat = MHWRender::kR32_FLOAT;
-        else if (spec.type == GL_HALF_FLOAT)
-            desc.fFormat = MHWRender::kR16_FLOAT;
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        break;
-    case GL_RGB:
-        if (spec.type == GL_FLOAT) {
-            desc.fFormat = MHWRender::kR32G32B32_FLOAT;
-            texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        } else if (spec.type == GL_HALF_FLOAT) {
-            // R16G16B16 is not supported by VP2. Converted to R16G16B16A16.
-            constexpr int bpp_8 = 8;
-
-            desc.fFormat = MHWRender::kR16G16B16A16_FLOAT;
-            desc.fBytesPerRow = spec.width * bpp_8;
-            desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
-
-            GfHalf               opaqueAlpha(1.0f);
-            const unsigned short alphaBits = opaqueAlpha.bits();
-            const unsigned char  lowAlpha = reinterpret_cast<const unsigned char*>(&alphaBits)[0];
-            const unsigned char  highAlpha = reinterpret_cast<const unsigned char*>(&alphaBits)[1];
-
-            std::vector<unsigned char> texels(desc.fBytesPerSlice);
-
-            for (int y = 0; y < spec.height; y++) {
-                for (int x = 0; x < spec.width; x++) {
-                    const int t = spec.width * y + x;
-                    texels[t * bpp_8 + 0] = storage[t * bpp + 0];
-                    texels[t * bpp_8 + 1] = storage[t * bpp + 1];
-                    texels[t * bpp_8 + 2] = storage[t * bpp + 2];
-                    texels[t * bpp_8 + 3] = storage[t * bpp + 3];
-                    texels[t * bpp_8 + 4] = storage[t * bpp + 4];
-                    texels[t * bpp_8 + 5] = storage[t * bpp + 5];
-                    texels[t * bpp_8 + 6] = lowAlpha;
-                    texels[t * bpp_8 + 7] = highAlpha;
-                }
-            }
-
-            texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
-        } else {
-            // R8G8B8 is not supported by VP2. Converted to R8G8B8A8.
-            constexpr int bpp_4 = 4;
-
-            desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
-            desc.fBytesPerRow = spec.width * bpp_4;
-            desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
-
-            std::vector<unsigned char> texels(desc.fBytesPerSlice);
-
-            for (int y = 0; y < spec.height; y++) {
-                for (int x = 0; x < spec.width; x++) {
-                    const int t = spec.width * y + x;
-                    texels[t * bpp_4] = storage[t * bpp];
-                    texels[t * bpp_4 + 1] = storage[t * bpp + 1];
-                    texels[t * bpp_4 + 2] = storage[t * bpp + 2];
-                    texels[t * bpp_4 + 3] = 255;
-                }
-            }
-
-            texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
-            isColorSpaceSRGB = image->IsColorSpaceSRGB();
-        }
-        break;
-    case GL_RGBA:
-        if (spec.type == GL_FLOAT) {
-            desc.fFormat = MHWRender::kR32G32B32A32_FLOAT;
-        } else if (spec.type == GL_HALF_FLOAT) {
-            desc.fFormat = MHWRender::kR16G16B16A16_FLOAT;
-        } else {
-            desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
-            isColorSpaceSRGB = image->IsColorSpaceSRGB();
-        }
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        break;
-    default: break;
-    }
-#endif
-
-    return texture;
+    isColorSpaceSRGB = data._isColorSpaceSRGB;
+    return HdVP2TextureLoader::Upload(name, data);
 }
 
 TfToken MayaDescriptorToToken(const MVertexBufferDescriptor& descriptor)
@@ -1219,6 +1090,10 @@ HdVP2Material::HdVP2Material(HdVP2RenderDelegate* renderDelegate, const SdfPath&
 {
 }
 
+/*! \brief  Destructor.
+ */
+HdVP2Material::~HdVP2Material() { _ReleaseTextures(); }
+
 /*! \brief  Synchronize VP2 state with scene delegate state based on dirty bits
  */
 void HdVP2Material::Sync(
@@ -1805,77 +1680,49 @@ MHWRender::MShaderInstance* HdVP2Material::_CreateMaterialXShaderInstance(
     }
 
     try {
-        // The HdMtlxCreateMtlxDocumentFromHdNetwork function can throw if any MaterialX error is
-        // raised.
+        // Generating the fragment can throw if any MaterialX error is raised.
 
         // Check if the Terminal is a MaterialX Node
         SdrRegistry&                sdrRegistry = SdrRegistry::GetInstance();
         const SdrShaderNodeConstPtr mtlxSdrNode = sdrRegistry.GetShaderNodeByIdentifierAndType(
             surfTerminal->nodeTypeId, HdVP2Tokens->mtlx);
-
-        mx::DocumentPtr           mtlxDoc;
-        const mx::FileSearchPath& crLibrarySearchPath(_GetMaterialXData()._mtlxSearchPath);
-        if (mtlxSdrNode) {
-
-            // Create the MaterialX Document from the HdMaterialNetwork
-            std::set<SdfPath> hdTextureNodes;
-            mx::StringMap     mxHdTextureMap; // Mx-Hd texture name counterparts
-            mtlxDoc = HdMtlxCreateMtlxDocumentFromHdNetwork(
-                fixedNetwork,
-                *surfTerminal, // MaterialX HdNode
-                SdfPath(_mtlxTokens->USD_Mtlx_VP2_Material),
-                _GetMaterialXData()._mtlxLibrary,
-                &hdTextureNodes,
-                &mxHdTextureMap);
-
-            if (!mtlxDoc) {
-                return shaderInstance;
-            }
-
-            // Fix any missing texcoord reader.
-            _AddMissingTexcoordReaders(mtlxDoc);
-
-            _surfaceShaderId = terminalPath;
-
-            if (TfDebug::IsEnabled(HDVP2_DEBUG_MATERIAL)) {
-                std::cout << "generated shader code for " << materialId.GetText() << ":\n";
-                std::cout << "Generated graph\n==============================\n";
-                mx::writeToXmlStream(mtlxDoc, std::cout);
-                std::cout << "\n==============================\n";
-            }
-        } else {
+        if (!mtlxSdrNode) {
             return shaderInstance;
         }
 
-        // This function is very recent and might only exist in a PR at this point in time
-        // See https://github.com/autodesk-forks/MaterialX/pull/1197 for current status.
-        mx::OgsXmlGenerator::setUseLightAPIV2(true);
+        _surfaceShaderId = terminalPath;
 
-        mx::NodePtr materialNode;
-        for (const mx::NodePtr& material : mtlxDoc->getMaterialNodes()) {
-            if (material->getName() == _mtlxTokens->USD_Mtlx_VP2_Material.GetText()) {
-                materialNode = material;
+        // The generated fragment only depends on the topology of the network, parameter values
+        // are set on the shader instance. Reuse the fragment generated by a previous session if
+        // there is one.
+        HdVP2FragmentCache& fragmentCache = HdVP2FragmentCache::GetInstance();
+        const std::string   fragmentKey = HdVP2FragmentCache::GetKey(
+            _GenerateNetwork2TopoKey(fixedNetwork),
+            mx::getVersionString(),
+            _GetMaterialXData()._libraryHash);
+
+        HdVP2CachedFragment fragment;
+        if (!fragmentCache.Find(fragmentKey, fragment)) {
+            MProfilingScope profilingScope(
+                HdVP2RenderDelegate::sProfilerCategory,
+                MProfiler::kColorD_L2,
+                "Generate MaterialX fragment",
+                materialId.GetText());
+
+            const auto start = std::chrono::steady_clock::now();
+            if (!_GenerateMaterialXFragment(materialId, fixedNetwork, *surfTerminal, fragment)) {
+                return shaderInstance;
             }
-        }
+            const std::chrono::duration<double> generationTime
+                = std::chrono::steady_clock::now() - start;
 
-        if (!materialNode) {
-            return shaderInstance;
+            fragmentCache.Add(fragmentKey, fragment, generationTime.count());
         }
 
-        MaterialXMaya::OgsFragment ogsFragment(materialNode, crLibrarySearchPath);
-
-        // Explore the fragment for primvars:
-        mx::ShaderPtr            shader = ogsFragment.getShader();
-        const mx::VariableBlock& vertexInputs
-            = shader->getStage(mx::Stage::VERTEX).getInputBlock(mx::HW::VERTEX_INPUTS);
-        for (size_t i = 0; i < vertexInputs.size(); ++i) {
-            const mx::ShaderPort* variable = vertexInputs[i];
-            // Position is always assumed.
-            // Tangent will be generated in the vertex shader using a utility fragment
-            if (variable->getName() == mx::HW::T_IN_NORMAL) {
-                _requiredPrimvars.push_back(HdTokens->normals);
-            }
-        }
+        _requiredPrimvars.insert(
+            _requiredPrimvars.end(),
+            fragment._requiredPrimvars.begin(),
+            fragment._requiredPrimvars.end());
 
         MHWRender::MRenderer* const renderer = MHWRender::MRenderer::theRenderer();
         if (!TF_VERIFY(renderer)) {
@@ -1887,12 +1734,11 @@ MHWRender::MShaderInstance* HdVP2Material::_CreateMaterialXShaderInstance(
             return shaderInstance;
         }
 
-        MString fragmentName(ogsFragment.getFragmentName().c_str());
+        MString fragmentName(fragment._name.c_str());
 
         if (!fragmentManager->hasFragment(fragmentName)) {
-            std::string   fragSrc = ogsFragment.getFragmentSource();
             const MString registeredFragment
-                = fragmentManager->addShadeFragmentFromBuffer(fragSrc.c_str(), false);
+                = fragmentManager->addShadeFragmentFromBuffer(fragment._source.c_str(), false);
             if (registeredFragment.length() == 0) {
                 TF_WARN("Failed to register shader fragment %s", fragmentName.asChar());
                 return shaderInstance;
@@ -1924,7 +1770,7 @@ MHWRender::MShaderInstance* HdVP2Material::_CreateMaterialXShaderInstance(
         // Add automatic tangent generation:
         shaderInstance->addInputFragment("materialXTw", "Tw", "Tw");
 
-        shaderInstance->setIsTransparent(ogsFragment.isTransparent());
+        shaderInstance->setIsTransparent(fragment._isTransparent);
 
     } catch (mx::Exception& e) {
         TF_RUNTIME_ERROR(
@@ -2162,6 +2008,15 @@ void HdVP2Material::_UpdateShaderInstance(const HdMaterialNetwork& mat)
     MProfilingScope profilingScope(
         HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L2, "UpdateShaderInstance");
 
+    // Reload the textures when their resolution limit has changed.
+    const int maxTextureResolution = _renderDelegate->GetMaxTextureResolution();
+    if (maxTextureResolution != _textureMaxResolution) {
+        _ReleaseTextures();
+        _textureMap.clear();
+        _textureMaxResolution = maxTextureResolution;
+    }
+
+    std::unordered_set<std::string> texturePaths;
     for (const HdMaterialNode& node : mat.nodes) {
         MString nodeName = "";
 #ifdef WANT_MATERIALX_BUILD
@@ -2256,8 +2111,10 @@ void HdVP2Material::_UpdateShaderInstance(const HdMaterialNetwork& mat)
                 const std::string&  resolvedPath = val.GetResolvedPath();
                 const std::string&  assetPath = val.GetAssetPath();
                 if (_IsUsdUVTexture(node) && token == _tokens->file) {
-                    const HdVP2TextureInfo& info
-                        = _AcquireTexture(!resolvedPath.empty() ? resolvedPath : assetPath, node);
+                    const std::string& texturePath
+                        = !resolvedPath.empty() ? resolvedPath : assetPath;
+                    const HdVP2TextureInfo& info = _AcquireTexture(texturePath, node);
+                    texturePaths.insert(texturePath);
 
                     MHWRender::MTextureAssignment assignment;
                     assignment.texture = info._texture.get();
@@ -2347,6 +2204,17 @@ void HdVP2Material::_UpdateShaderInstance(const HdMaterialNetwork& mat)
             }
         }
     }
+
+    // Stop waiting for the textures that the network does not use anymore, so that the loader
+    // does not keep their texels for this material.
+    for (auto it = _textureMap.begin(); it != _textureMap.end();) {
+        if (it->second._isLoading && texturePaths.count(it->first) == 0) {
+            _renderDelegate->GetTextureLoader().Release(it->first, _textureMaxResolution, GetId());
+            it = _textureMap.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 /*! \brief  Acquires a texture for the given image path.
@@ -2355,17 +2223,39 @@ const HdVP2TextureInfo&
 HdVP2Material::_AcquireTexture(const std::string& path, const HdMaterialNode& node)
 {
     const auto it = _textureMap.find(path);
-    if (it != _textureMap.end()) {
+    if (it != _textureMap.end() && !it->second._isLoading) {
         return it->second;
     }
 
     bool                 isSRGB = false;
     MFloatArray          uvScaleOffset;
-    MHWRender::MTexture* texture = _LoadTexture(path, isSRGB, uvScaleOffset, node);
+    MHWRender::MTexture* texture = nullptr;
+
+    // UDIM textures are assembled by VP2 from the tile files, they are always loaded here.
+    if (HdVP2TextureLoader::IsEnabled() && !_IsUdimTexture(path)) {
+        const HdVP2TextureLoader::Status status = _renderDelegate->GetTextureLoader().Load(
+            path, _textureMaxResolution, GetId(), &texture, &isSRGB);
+        if (status == HdVP2TextureLoader::Status::Loading) {
+            // Bind a placeholder until the texture is read, this material will be synced again.
+            HdVP2TextureInfo& info = _textureMap[path];
+            if (!info._isLoading) {
+                info._texture.reset(_LoadPlaceholderTexture(node));
+                info._isLoading = true;
+            }
+            return info;
+        }
+        // When the texture could not be read, load it here again to report the error and use the
+        // fallback color.
+    }
+
+    if (!texture) {
+        texture = _LoadTexture(path, _textureMaxResolution, isSRGB, uvScaleOffset, node);
+    }
 
     HdVP2TextureInfo& info = _textureMap[path];
     info._texture.reset(texture);
     info._isColorSpaceSRGB = isSRGB;
+    info._isLoading = false;
     if (uvScaleOffset.length() > 0) {
         TF_VERIFY(uvScaleOffset.length() == 4);
         info._stScale.Set(uvScaleOffset[0], uvScaleOffset[1]); // The first 2 elements are the scale
@@ -2375,6 +2265,22 @@ HdVP2Material::_AcquireTexture(const std::string& path, const HdMaterialNode& no
     return info;
 }
 
+/*! \brief  Releases the textures acquired from the texture loader.
+
+    The loader stops notifying this material of the textures it waits for.
+*/
+void HdVP2Material::_ReleaseTextures()
+{
+    if (!HdVP2TextureLoader::IsEnabled()) {
+        return;
+    }
+
+    HdVP2TextureLoader& loader = _renderDelegate->GetTextureLoader();
+    for (const auto& entry : _textureMap) {
+        loader.Release(entry.first, _textureMaxResolution, GetId());
+    }
+}
+
 #ifdef HDVP2_MATERIAL_CONSOLIDATION_UPDATE_WORKAROUND
 
 void HdVP2Material::SubscribeForMaterialUpdates(const SdfPath& rprimId)
@@ -59,6 +59,7 @@ struct HdVP2TextureInfo
     GfVec2f               _stScale { 1.0f, 1.0f };     //!< UV scale for tiled textures
     GfVec2f               _stOffset { 0.0f, 0.0f };    //!< UV offset for tiled textures
     bool                  _isColorSpaceSRGB { false }; //!< Whether sRGB linearization is needed
+    bool                  _isLoading { false };        //!< Whether a placeholder is bound
 };
 
 /*! \brief  An unordered string-indexed map to cache texture information.
@@ -76,7 +77,7 @@ public:
     HdVP2Material(HdVP2RenderDelegate*, const SdfPath&);
 
     //! Destructor.
-    ~HdVP2Material() override = default;
+    ~HdVP2Material() override;
 
     void Sync(HdSceneDelegate*, HdRenderParam*, HdDirtyBits*) override;
 
@@ -111,6 +112,7 @@ private:
     MHWRender::MShaderInstance* _CreateShaderInstance(const HdMaterialNetwork& mat);
     void                        _UpdateShaderInstance(const HdMaterialNetwork& mat);
     const HdVP2TextureInfo& _AcquireTexture(const std::string& path, const HdMaterialNode& node);
+    void                    _ReleaseTextures();
 
 #ifdef HDVP2_MATERIAL_CONSOLIDATION_UPDATE_WORKAROUND
     //! Trigger sync on all Rprims which are listening to changes on this material.
@@ -129,6 +131,9 @@ private:
     SdfPath              _surfaceShaderId;  //!< Path of the surface shader
     HdVP2TextureMap      _textureMap;       //!< Textures used by this material
     TfTokenVector        _requiredPrimvars; //!< primvars required by this material
+
+    //! Maximum width and height of the textures in _textureMap, or 0 if they are not limited
+    int _textureMaxResolution = 0;
 #ifdef HDVP2_MATERIAL_CONSOLIDATION_UPDATE_WORKAROUND
     //! Mutex protecting concurrent access to the Rprim set
     std::mutex _materialSubscriptionsMutex;
@@ -19,6 +19,7 @@
 #include "debugCodes.h"
 #include "instancer.h"
 #include "material.h"
+#include "primvarGather.h"
 #include "render_delegate.h"
 #include "tokens.h"
 
@@ -35,6 +36,7 @@
 #include <pxr/imaging/hd/smoothNormals.h>
 #include <pxr/imaging/hd/version.h>
 #include <pxr/imaging/hd/vertexAdjacency.h>
+#include <pxr/imaging/pxOsd/tokens.h>
 #include <pxr/pxr.h>
 #include <pxr/usdImaging/usdImaging/delegate.h>
 
@@ -43,7 +45,11 @@
 #include <maya/MProfiler.h>
 #include <maya/MSelectionMask.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <numeric>
+#include <set>
 #include <type_traits>
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -58,6 +64,12 @@ const MColor       kOpaqueBlue(0.0f, 0.0f, 1.0f, 1.0f); //!< Opaque blue
 const MColor       kOpaqueGray(.18f, .18f, .18f, 1.0f); //!< Opaque gray
 const unsigned int kNumColorChannels = 4;               //!< The number of color channels
 
+//! Number of instances processed by each task when converting instance data
+const size_t kInstanceGrainSize = 4096;
+
+//! Instance data is uploaded in full when more than one instance in this many changed
+const unsigned int kPartialInstanceUpdateRatio = 8;
+
 const MString kPositionsStr("positions");       //!< Cached string for efficiency
 const MString kNormalsStr("normals");           //!< Cached string for efficiency
 const MString kDiffuseColorStr("diffuseColor"); //!< Cached string for efficiency
@@ -66,6 +78,9 @@ const MString kSolidColorStr("solidColor");     //!< Cached string for efficienc
 //! A primvar vertex buffer data map indexed by primvar name.
 using PrimvarBufferDataMap = std::unordered_map<TfToken, void*, TfToken::HashFunctor>;
 
+//! Vertex buffers to associate with a render item, with the primvar they hold.
+using VertexBufferList = std::vector<std::pair<TfToken, MHWRender::MVertexBuffer*>>;
+
 //! \brief  Helper struct used to package all the changes into single commit task
 //!         (such commit task will be executed on main-thread)
 struct CommitState
@@ -86,16 +101,31 @@ struct CommitState
     //! if valid, enable or disable the render item
     bool* _enabled { nullptr };
 
-    //! Instancing doesn't have dirty bits, every time we do update, we must update instance
-    //! transforms
+    //! Number of instances drawn by the render item
+    unsigned int _instanceCount { 0 };
+
+    //! If true, _instanceTransforms must be committed
+    bool _instanceTransformsDirty { false };
+
+    //! Instance transforms to set, all of them unless _instanceTransformIds is not empty
     MMatrixArray _instanceTransforms;
 
+    //! If not empty, Maya instance ids of the transforms in _instanceTransforms
+    std::vector<unsigned int> _instanceTransformIds;
+
     //! Color parameter that _instanceColors should be bound to
     MString _instanceColorParam;
 
-    //! Color array to support per-instance color and selection highlight.
+    //! If true, _instanceColors must be committed
+    bool _instanceColorsDirty { false };
+
+    //! Color array to support per-instance color and selection highlight, for all the instances
+    //! unless _instanceColorIds is not empty
     MFloatArray _instanceColors;
 
+    //! If not empty, Maya instance ids of the colors in _instanceColors
+    std::vector<unsigned int> _instanceColorIds;
+
     MStringArray _ufeIdentifiers;
 
     //! If valid, new shader instance to set
@@ -108,6 +138,9 @@ struct CommitState
     //! update
     bool _geometryDirty { false };
 
+    //! Vertex buffers to associate with the render item when _geometryDirty or _boundingBox is set
+    VertexBufferList _vertexBuffers;
+
     //! Construct valid commit state
     CommitState(HdVP2DrawItem::RenderItemData& renderItemData)
         : _renderItemData(renderItemData)
@@ -121,12 +154,59 @@ struct CommitState
     bool Empty()
     {
         return _indexBufferData == nullptr && _shader == nullptr && _enabled == nullptr
-            && !_geometryDirty && _boundingBox == nullptr && !_renderItemData._usingInstancedDraw
-            && _instanceTransforms.length() == 0 && _ufeIdentifiers.length() == 0
-            && _worldMatrix == nullptr;
+            && !_geometryDirty && _boundingBox == nullptr && !_instanceTransformsDirty
+            && !_instanceColorsDirty && _ufeIdentifiers.length() == 0 && _worldMatrix == nullptr;
     }
 };
 
+/*! \brief  Lists the vertex buffers to associate with a render item.
+
+    Points and normals come first, then the required primvars in order, then the remaining
+    primvars. Bounding box items use the positions of the shared bounding box geometry.
+*/
+void _GatherVertexBuffers(
+    const PrimvarInfoMap& primvarInfo,
+    const TfTokenVector&  requiredPrimvars,
+    const HdVP2BBoxGeom*  sharedBBoxGeom,
+    VertexBufferList&     vertexBuffers)
+{
+    std::set<TfToken> addedPrimvars;
+    auto              addPrimvar = [&](const TfToken& p) {
+        auto entry = primvarInfo.find(p);
+        if (entry == primvarInfo.cend()) {
+            // No primvar by that name.
+            return;
+        }
+        MHWRender::MVertexBuffer* primvarBuffer = nullptr;
+        if (sharedBBoxGeom && p == HdTokens->points) {
+            primvarBuffer
+                = const_cast<MHWRender::MVertexBuffer*>(sharedBBoxGeom->GetPositionBuffer());
+        } else {
+            primvarBuffer = entry->second->_buffer.get();
+        }
+        if (primvarBuffer) { // this filters out the separate color & alpha entries
+            vertexBuffers.emplace_back(p, primvarBuffer);
+        }
+        addedPrimvars.insert(p);
+    };
+
+    // Points and normals always are at the beginning of vertex requirements:
+    addPrimvar(HdTokens->points);
+    addPrimvar(HdTokens->normals);
+    // Then add required primvars *in order*:
+    for (const TfToken& primvarName : requiredPrimvars) {
+        if (addedPrimvars.find(primvarName) == addedPrimvars.cend()) {
+            addPrimvar(primvarName);
+        }
+    }
+    // Then add whatever primvar is left that was not in the requirements:
+    for (auto& entry : primvarInfo) {
+        if (addedPrimvars.find(entry.first) == addedPrimvars.cend()) {
+            addPrimvar(entry.first);
+        }
+    }
+}
+
 //! Helper utility function to fill primvar data to vertex buffer.
 template <class DEST_TYPE, class SRC_TYPE>
 void _FillPrimvarData(
@@ -152,13 +232,22 @@ void _FillPrimvarData(
     case HdInterpolationVertex:
         if (numVertices <= renderingToSceneFaceVtxIds.size()) {
             const unsigned int dataSize = primvarData.size();
+            const int*         indices = renderingToSceneFaceVtxIds.cdata();
+            if (HdVP2GatherPrimvarData(
+                    vertexBuffer,
+                    numVertices,
+                    channelOffset,
+                    indices,
+                    primvarData.cdata(),
+                    dataSize)
+                || !TfDebug::IsEnabled(HDVP2_DEBUG_MESH)) {
+                break;
+            }
+
+            // Report the indices which are out of range, their vertices were skipped.
             for (size_t v = 0; v < numVertices; v++) {
-                unsigned int index = renderingToSceneFaceVtxIds[v];
-                if (index < dataSize) {
-                    SRC_TYPE* pointer = reinterpret_cast<SRC_TYPE*>(
-                        reinterpret_cast<float*>(&vertexBuffer[v]) + channelOffset);
-                    *pointer = primvarData[index];
-                } else {
+                unsigned int index = indices[v];
+                if (index >= dataSize) {
                     TF_DEBUG(HDVP2_DEBUG_MESH)
                         .Msg(
                             "Invalid Hydra prim '%s': "
@@ -872,7 +961,12 @@ void HdVP2Mesh::Sync(
     // of the ProxyRenderDelegate. In additional, we need to hide any already
     // existing render items because they should not be drawn.
     HdRenderIndex& renderIndex = delegate->GetRenderIndex();
-    if (!drawScene.DrawRenderTag(renderIndex.GetRenderTag(id))) {
+    const TfToken& renderTag = renderIndex.GetRenderTag(id);
+    if (renderTag != _indexedRenderTag) {
+        drawScene.UpdateRenderTag(id, renderTag);
+        _indexedRenderTag = renderTag;
+    }
+    if (!drawScene.DrawRenderTag(renderTag)) {
         _HideAllDrawItems(reprToken);
         *dirtyBits &= ~(
             HdChangeTracker::DirtyRenderTag
@@ -883,6 +977,12 @@ void HdVP2Mesh::Sync(
         return;
     }
 
+    // With progressive population, the ProxyRenderDelegate draws a placeholder box until it
+    // promotes the rprim. The dirty bits are kept for the sync which follows the promotion.
+    if (drawScene.IsRprimDeferred(id)) {
+        return;
+    }
+
     MProfilingScope profilingScope(
         HdVP2RenderDelegate::sProfilerCategory,
         MProfiler::kColorC_L2,
@@ -918,6 +1018,22 @@ void HdVP2Mesh::Sync(
             _meshSharedData->_topology = GetMeshTopology(delegate);
         }
 
+        // Refine subdivision meshes on the CPU, the rest of the sync then sees the refined mesh.
+        // Meshes with geom subsets are not refined, as the subsets index the base faces.
+        _refinedTopology.reset();
+        if (HdVP2RefinedTopology::IsEnabled()) {
+            const HdMeshTopology& topology = _meshSharedData->_topology;
+            const int             refineLevel = GetDisplayStyle(delegate).refineLevel;
+            if (refineLevel > 0 && topology.GetScheme() != PxOsdOpenSubdivTokens->none
+                && topology.GetGeomSubsets().empty() && topology.GetNumFaces() > 0) {
+                _refinedTopology
+                    = HdVP2RefinedTopologyCache::GetInstance().Get(topology, refineLevel);
+                if (_refinedTopology) {
+                    _meshSharedData->_topology = _refinedTopology->GetTopology();
+                }
+            }
+        }
+
         // subscribe to material updates from the new geom subset materials
 #ifdef HDVP2_MATERIAL_CONSOLIDATION_UPDATE_WORKAROUND
         for (const auto& geomSubset : _meshSharedData->_topology.GetGeomSubsets()) {
@@ -980,6 +1096,11 @@ void HdVP2Mesh::Sync(
                | HdChangeTracker::DirtyInstanceIndex))
            != 0);
 
+    // Pull the instance transforms once for all the render items.
+    if (instancerDirty && !GetInstancerId().IsEmpty()) {
+        _UpdateInstanceTransforms(renderIndex);
+    }
+
     if (HdChangeTracker::IsPrimvarDirty(*dirtyBits, id, HdTokens->points)
         || HdChangeTracker::IsPrimvarDirty(*dirtyBits, id, HdTokens->normals)
         || HdChangeTracker::IsPrimvarDirty(*dirtyBits, id, HdTokens->primvar) || instancerDirty) {
@@ -1159,6 +1280,41 @@ void HdVP2Mesh::Sync(
     _UpdateRepr(delegate, reprToken);
 }
 
+/*! \brief  Pulls the instance transforms from the instancer.
+
+    The render items only upload the instances whose transform changed since the previous pull,
+    if they were up to date with it. Otherwise they upload all of them.
+*/
+void HdVP2Mesh::_UpdateInstanceTransforms(HdRenderIndex& renderIndex)
+{
+    MProfilingScope profilingScope(
+        HdVP2RenderDelegate::sProfilerCategory,
+        MProfiler::kColorC_L2,
+        _rprimId.asChar(),
+        "HdVP2Mesh::_UpdateInstanceTransforms");
+
+    HdInstancer*    instancer = renderIndex.GetInstancer(GetInstancerId());
+    VtMatrix4dArray transforms
+        = static_cast<HdVP2Instancer*>(instancer)->ComputeInstanceTransforms(GetId());
+
+    const size_t instanceCount = transforms.size();
+    _instanceTransformChanged.assign(instanceCount, 1);
+    if (_instanceTransforms.size() == instanceCount) {
+        const GfMatrix4d* previous = _instanceTransforms.cdata();
+        const GfMatrix4d* current = transforms.cdata();
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, instanceCount, kInstanceGrainSize),
+            [this, previous, current](const tbb::blocked_range<size_t>& range) {
+                for (size_t i = range.begin(); i < range.end(); i++) {
+                    _instanceTransformChanged[i] = (current[i] != previous[i]);
+                }
+            });
+    }
+
+    _instanceTransforms = std::move(transforms);
+    _instanceTransformsVersion++;
+}
+
 /*! \brief  Returns the minimal set of dirty bits to place in the
             change tracker for use in the first sync of this prim.
 */
@@ -1203,6 +1359,14 @@ HdDirtyBits HdVP2Mesh::_PropagateDirtyBits(HdDirtyBits bits) const
         bits |= HdChangeTracker::DirtySubdivTags | HdChangeTracker::DirtyDisplayStyle;
     }
 
+    // The refined topology depends on the refine level, and the primvars are refined with it.
+    if (HdVP2RefinedTopology::IsEnabled()
+        && (bits & (HdChangeTracker::DirtyDisplayStyle | HdChangeTracker::DirtyTopology))) {
+        bits
+            |= (HdChangeTracker::DirtyPoints | HdChangeTracker::DirtyNormals
+                | HdChangeTracker::DirtyPrimvar | HdChangeTracker::DirtyTopology);
+    }
+
     // A change of material means that the Quadrangulate state may have
     // changed.
     if (bits & HdChangeTracker::DirtyMaterialId) {
@@ -2023,22 +2187,23 @@ void HdVP2Mesh::_UpdateDrawItem(
         stateToCommit._worldMatrix = &drawItemData._worldMatrix;
     }
 
-    // If the mesh is instanced, create one new instance per transform.
-    // The current instancer invalidation tracking makes it hard for
-    // us to tell whether transforms will be dirty, so this code
-    // pulls them every time something changes.
-    if (!GetInstancerId().IsEmpty()) {
-        bool instancerWithNoInstances = false;
-        // Retrieve instance transforms from the instancer.
-        HdInstancer*    instancer = renderIndex.GetInstancer(GetInstancerId());
-        VtMatrix4dArray transforms
-            = static_cast<HdVP2Instancer*>(instancer)->ComputeInstanceTransforms(id);
-
-        MMatrix            instanceMatrix;
-        const unsigned int instanceCount = transforms.size();
+    // If the mesh is instanced, create one new instance per transform. The instance transforms
+    // are pulled from the instancer in Sync(), the render item is only updated when they, its
+    // own transform or the selection changed. The bits which may enable the render item above are
+    // included, so that a render item without instances is disabled again.
+    constexpr HdDirtyBits dirtyInstanceBits = HdChangeTracker::DirtyInstancer
+        | HdChangeTracker::DirtyInstanceIndex | HdChangeTracker::DirtyPrimvar
+        | HdChangeTracker::DirtyTransform | HdChangeTracker::DirtyExtent
+        | HdChangeTracker::DirtyVisibility | HdChangeTracker::DirtyRenderTag
+        | HdChangeTracker::DirtyPoints | DirtySelectionHighlight | DirtySelectionMode;
+    if (!GetInstancerId().IsEmpty() && (itemDirtyBits & dirtyInstanceBits)) {
+        bool                   instancerWithNoInstances = false;
+        const VtMatrix4dArray& transforms = _instanceTransforms;
+        const unsigned int     instanceCount = transforms.size();
 
         if (0 == instanceCount) {
             instancerWithNoInstances = true;
+            drawItemData._instanceInfo.clear();
         } else {
             // The shaded instances are split into two render items: one for the
             // selected instance and one for the unselected instances. We do this so
@@ -2158,11 +2323,125 @@ void HdVP2Mesh::_UpdateDrawItem(
                 }
             }
 
-#ifdef MAYA_NEW_POINT_SNAPPING_SUPPORT
-            // Create & fill the per-instance data buffers: the transform buffer, the color buffer
-            // and the Maya instance id to usd instance id mapping buffer.
-            InstanceIdMap mayaToUsd;
-#endif
+            // Find the instances drawn by the render item, in Maya instance id order. If they are
+            // the same as in the previous update of the render item, only the instances that
+            // changed are uploaded.
+            std::vector<unsigned int> mayaToUsd;
+            mayaToUsd.reserve(instanceCount);
+            for (unsigned int usdInstanceId = 0; usdInstanceId < instanceCount; usdInstanceId++) {
+                if (instanceInfo[usdInstanceId] != invalid) {
+                    mayaToUsd.push_back(usdInstanceId);
+                }
+            }
+            const unsigned int mayaInstanceCount = mayaToUsd.size();
+
+            std::vector<unsigned char>& previousInstanceInfo = drawItemData._instanceInfo;
+            bool                        sameInstances = drawItemData._usingInstancedDraw
+                && drawItemData._instanceCount == mayaInstanceCount
+                && previousInstanceInfo.size() == instanceCount;
+            for (unsigned int i = 0; sameInstances && i < instanceCount; i++) {
+                sameInstances
+                    = (previousInstanceInfo[i] == invalid) == (instanceInfo[i] == invalid);
+            }
+
+            // All the transforms are uploaded when the world matrix changed, or when the render
+            // item missed a pull of the instance transforms.
+            std::vector<unsigned int> changedTransforms;
+            bool                      allTransformsChanged = !sameInstances
+                || (itemDirtyBits & HdChangeTracker::DirtyTransform)
+                || (isBBoxItem && (itemDirtyBits & HdChangeTracker::DirtyExtent));
+            if (!allTransformsChanged
+                && drawItemData._instanceTransformsVersion != _instanceTransformsVersion) {
+                if (drawItemData._instanceTransformsVersion + 1 == _instanceTransformsVersion) {
+                    for (unsigned int i = 0; i < mayaInstanceCount; i++) {
+                        if (_instanceTransformChanged[mayaToUsd[i]]) {
+                            changedTransforms.push_back(i);
+                        }
+                    }
+                    allTransformsChanged = changedTransforms.size() * kPartialInstanceUpdateRatio
+                        > mayaInstanceCount;
+                } else {
+                    allTransformsChanged = true;
+                }
+            }
+
+            if (allTransformsChanged || !changedTransforms.empty()) {
+                if (allTransformsChanged) {
+                    changedTransforms.resize(mayaInstanceCount);
+                    std::iota(changedTransforms.begin(), changedTransforms.end(), 0);
+                }
+
+                MMatrixArray& instanceTransforms = stateToCommit._instanceTransforms;
+                instanceTransforms.setLength(changedTransforms.size());
+                tbb::parallel_for(
+                    tbb::blocked_range<size_t>(0, changedTransforms.size(), kInstanceGrainSize),
+                    [&](const tbb::blocked_range<size_t>& range) {
+                        MMatrix instanceMatrix;
+                        for (size_t i = range.begin(); i < range.end(); i++) {
+                            transforms[mayaToUsd[changedTransforms[i]]].Get(instanceMatrix.matrix);
+                            instanceTransforms[i] = worldMatrix * instanceMatrix;
+                        }
+                    });
+
+                stateToCommit._instanceTransformsDirty = true;
+                if (!allTransformsChanged) {
+                    stateToCommit._instanceTransformIds = std::move(changedTransforms);
+                }
+            }
+
+            // Shaded colors are instance primvars, wireframe colors only change with the
+            // selection of the instances.
+            std::vector<unsigned int> changedColors;
+            bool                      allColorsChanged = !sameInstances
+                || (itemDirtyBits
+                    & (HdChangeTracker::DirtyPrimvar | HdChangeTracker::DirtyInstancer
+                       | HdChangeTracker::DirtyInstanceIndex));
+            if (!allColorsChanged && useWireframeColors) {
+                for (unsigned int i = 0; i < mayaInstanceCount; i++) {
+                    const unsigned int usdInstanceId = mayaToUsd[i];
+                    if (previousInstanceInfo[usdInstanceId] != instanceInfo[usdInstanceId]) {
+                        changedColors.push_back(i);
+                    }
+                }
+                allColorsChanged
+                    = changedColors.size() * kPartialInstanceUpdateRatio > mayaInstanceCount;
+            }
+
+            if ((useWireframeColors || shadedColors)
+                && (allColorsChanged || !changedColors.empty())) {
+                if (allColorsChanged) {
+                    changedColors.resize(mayaInstanceCount);
+                    std::iota(changedColors.begin(), changedColors.end(), 0);
+                }
+
+                MFloatArray& instanceColors = stateToCommit._instanceColors;
+                instanceColors.setLength(changedColors.size() * kNumColorChannels);
+                tbb::parallel_for(
+                    tbb::blocked_range<size_t>(0, changedColors.size(), kInstanceGrainSize),
+                    [&](const tbb::blocked_range<size_t>& range) {
+                        for (size_t i = range.begin(); i < range.end(); i++) {
+                            const unsigned int usdInstanceId = mayaToUsd[changedColors[i]];
+                            const size_t       offset = i * kNumColorChannels;
+                            if (useWireframeColors) {
+                                const MColor& color = wireframeColors[instanceInfo[usdInstanceId]];
+                                for (unsigned int j = 0; j < kNumColorChannels; j++) {
+                                    instanceColors[offset + j] = color[j];
+                                }
+                            } else {
+                                const unsigned int shadedOffset = usdInstanceId * kNumColorChannels;
+                                for (unsigned int j = 0; j < kNumColorChannels; j++) {
+                                    instanceColors[offset + j] = (*shadedColors)[shadedOffset + j];
+                                }
+                            }
+                        }
+                    });
+
+                stateToCommit._instanceColorsDirty = true;
+                if (!allColorsChanged) {
+                    stateToCommit._instanceColorIds = std::move(changedColors);
+                }
+            }
+
 #ifdef MAYA_UPDATE_UFE_IDENTIFIER_SUPPORT
             // Mark the Ufe Identifiers on the item dirty. The next time isolate select
             // updates the Ufe Identifiers will be updated.
@@ -2180,32 +2459,6 @@ void HdVP2Mesh::_UpdateDrawItem(
                 instancePrimPaths.resize(instanceCount);
             }
 #endif
-
-            for (unsigned int usdInstanceId = 0; usdInstanceId < instanceCount; usdInstanceId++) {
-                unsigned char info = instanceInfo[usdInstanceId];
-                if (info == invalid)
-                    continue;
-#ifndef MAYA_UPDATE_UFE_IDENTIFIER_SUPPORT
-                stateToCommit._ufeIdentifiers.append(
-                    drawScene.GetScenePrimPath(GetId(), usdInstanceId).GetString().c_str());
-#endif
-                transforms[usdInstanceId].Get(instanceMatrix.matrix);
-                stateToCommit._instanceTransforms.append(worldMatrix * instanceMatrix);
-#ifdef MAYA_NEW_POINT_SNAPPING_SUPPORT
-                mayaToUsd.push_back(usdInstanceId);
-#endif
-                if (useWireframeColors) {
-                    const MColor& color = wireframeColors[info];
-                    for (unsigned int j = 0; j < kNumColorChannels; j++) {
-                        stateToCommit._instanceColors.append(color[j]);
-                    }
-                } else if (shadedColors) {
-                    unsigned int offset = usdInstanceId * kNumColorChannels;
-                    for (unsigned int j = 0; j < kNumColorChannels; j++) {
-                        stateToCommit._instanceColors.append((*shadedColors)[offset + j]);
-                    }
-                }
-            }
 #ifdef MAYA_UPDATE_UFE_IDENTIFIER_SUPPORT
             InstanceIdMap& cachedMayaToUsd = MayaUsdCustomData::Get(*renderItem);
             bool           mayaToUsdChanged = cachedMayaToUsd.size() != mayaToUsd.size();
@@ -2214,7 +2467,6 @@ void HdVP2Mesh::_UpdateDrawItem(
             }
 
             if (mayaToUsdChanged && drawScene.ufeIdentifiersInUse()) {
-                unsigned int mayaInstanceCount = mayaToUsd.size();
                 for (unsigned int mayaInstanceId = 0; mayaInstanceId < mayaInstanceCount;
                      mayaInstanceId++) {
                     unsigned int usdInstanceId = mayaToUsd[mayaInstanceId];
@@ -2229,11 +2481,21 @@ void HdVP2Mesh::_UpdateDrawItem(
             }
             cachedMayaToUsd = std::move(mayaToUsd);
 #else
-            TF_VERIFY(
-                stateToCommit._ufeIdentifiers.length()
-                == stateToCommit._instanceTransforms.length());
+            if (allTransformsChanged
+                || (itemDirtyBits
+                    & (HdChangeTracker::DirtyInstancer | HdChangeTracker::DirtyInstanceIndex))) {
+                for (const unsigned int usdInstanceId : mayaToUsd) {
+                    stateToCommit._ufeIdentifiers.append(
+                        drawScene.GetScenePrimPath(GetId(), usdInstanceId).GetString().c_str());
+                }
+                TF_VERIFY(stateToCommit._ufeIdentifiers.length() == mayaInstanceCount);
+            }
 #endif
-            if (stateToCommit._instanceTransforms.length() == 0)
+            stateToCommit._instanceCount = mayaInstanceCount;
+            previousInstanceInfo = std::move(instanceInfo);
+            drawItemData._instanceTransformsVersion = _instanceTransformsVersion;
+
+            if (mayaInstanceCount == 0)
                 instancerWithNoInstances = true;
 
             // instancer with no instances means nothing to draw. Disable
@@ -2295,24 +2557,27 @@ void HdVP2Mesh::_UpdateDrawItem(
 
     // Capture buffers we need
     MHWRender::MIndexBuffer* indexBuffer = drawItemData._indexBuffer.get();
-    PrimvarInfoMap*          primvarInfo = &_meshSharedData->_primvarInfo;
-    TfTokenVector*           primvars = &_meshSharedData->_allRequiredPrimvars;
     const HdVP2BBoxGeom&     sharedBBoxGeom = _delegate->GetSharedBBoxGeom();
     if (isBBoxItem) {
         indexBuffer = const_cast<MHWRender::MIndexBuffer*>(sharedBBoxGeom.GetIndexBuffer());
     }
 
+    // Order the vertex buffers here, as rprims sync in parallel, rather than in the commit task.
+    // TODO: this is now including all buffers for the requirements of all the render items on
+    // this rprim. We could filter it down based on the requirements of the shader.
+    if (stateToCommit._geometryDirty || stateToCommit._boundingBox) {
+        _GatherVertexBuffers(
+            _meshSharedData->_primvarInfo,
+            _meshSharedData->_allRequiredPrimvars,
+            isBBoxItem ? &sharedBBoxGeom : nullptr,
+            stateToCommit._vertexBuffers);
+    }
+
     // We can get an empty stateToCommit when viewport draw modes change. In this case every
     // rprim is marked dirty to give any stale render items a chance to update. If there are
     // no stale render items then stateToCommit can be empty!
     if (!stateToCommit.Empty()) {
-        _delegate->GetVP2ResourceRegistry().EnqueueCommit([stateToCommit,
-                                                           param,
-                                                           primvarInfo,
-                                                           primvars,
-                                                           indexBuffer,
-                                                           isBBoxItem,
-                                                           &sharedBBoxGeom]() {
+        _delegate->GetVP2ResourceRegistry().EnqueueCommit([stateToCommit, param, indexBuffer]() {
             // This code executes serially, once per mesh updated. Keep
             // performance in mind while modifying this code.
             const HdVP2DrawItem::RenderItemData& drawItemData = stateToCommit._renderItemData;
@@ -2343,51 +2608,11 @@ void HdVP2Mesh::_UpdateDrawItem(
 
             ProxyRenderDelegate& drawScene = param->GetDrawScene();
 
-            // TODO: this is now including all buffers for the requirements of all
-            // the render items on this rprim. We could filter it down based on the
-            // requirements of the shader.
             if (stateToCommit._geometryDirty || stateToCommit._boundingBox) {
                 MHWRender::MVertexBufferArray vertexBuffers;
-
-                std::set<TfToken> addedPrimvars;
-                auto              addPrimvar =
-                    [primvarInfo, &vertexBuffers, &addedPrimvars, isBBoxItem, &sharedBBoxGeom](
-                        const TfToken& p) {
-                        auto entry = primvarInfo->find(p);
-                        if (entry == primvarInfo->cend()) {
-                            // No primvar by that name.
-                            return;
-                        }
-                        MHWRender::MVertexBuffer* primvarBuffer = nullptr;
-                        if (isBBoxItem && p == HdTokens->points) {
-                            primvarBuffer = const_cast<MHWRender::MVertexBuffer*>(
-                                sharedBBoxGeom.GetPositionBuffer());
-                        } else {
-                            primvarBuffer = entry->second->_buffer.get();
-                        }
-                        if (primvarBuffer) { // this filters out the separate color & alpha entries
-                            MStatus result = vertexBuffers.addBuffer(p.GetText(), primvarBuffer);
-                            TF_VERIFY(result == MStatus::kSuccess);
-                        }
-                        addedPrimvars.insert(p);
-                    };
-
-                // Points and normals always are at the beginning of vertex requirements:
-                addPrimvar(HdTokens->points);
-                addPrimvar(HdTokens->normals);
-                // Then add required primvars *in order*:
-                if (primvars) {
-                    for (const TfToken& primvarName : *primvars) {
-                        if (addedPrimvars.find(primvarName) == addedPrimvars.cend()) {
-                            addPrimvar(primvarName);
-                        }
-                    }
-                }
-                // Then add whatever primvar is left that was not in the requirements:
-                for (auto& entry : *primvarInfo) {
-                    if (addedPrimvars.find(entry.first) == addedPrimvars.cend()) {
-                        addPrimvar(entry.first);
-                    }
+                for (const auto& entry : stateToCommit._vertexBuffers) {
+                    result = vertexBuffers.addBuffer(entry.first.GetText(), entry.second);
+                    TF_VERIFY(result == MStatus::kSuccess);
                 }
 
                 // The API call does three things:
@@ -2400,55 +2625,81 @@ void HdVP2Mesh::_UpdateDrawItem(
             }
 
             // Important, update instance transforms after setting geometry on render items!
-            auto& oldInstanceCount = stateToCommit._renderItemData._instanceCount;
-            auto  newInstanceCount = stateToCommit._instanceTransforms.length();
+            auto&      oldInstanceCount = stateToCommit._renderItemData._instanceCount;
+            const auto newInstanceCount = stateToCommit._instanceCount;
 
             // GPU instancing has been enabled. We cannot switch to consolidation
             // without recreating render item, so we keep using GPU instancing.
             if (stateToCommit._renderItemData._usingInstancedDraw) {
-                if (oldInstanceCount == newInstanceCount) {
-                    for (unsigned int i = 0; i < newInstanceCount; i++) {
-                        // VP2 defines instance ID of the first instance to be 1.
-                        result = drawScene.updateInstanceTransform(
-                            *renderItem, i + 1, stateToCommit._instanceTransforms[i]);
+                if (stateToCommit._instanceTransformsDirty) {
+                    const auto& ids = stateToCommit._instanceTransformIds;
+                    if (!ids.empty()) {
+                        TF_VERIFY(oldInstanceCount == newInstanceCount);
+                        for (unsigned int i = 0; i < ids.size(); i++) {
+                            // VP2 defines instance ID of the first instance to be 1.
+                            result = drawScene.updateInstanceTransform(
+                                *renderItem, ids[i] + 1, stateToCommit._instanceTransforms[i]);
+                            TF_VERIFY(result == MStatus::kSuccess);
+                        }
+                    } else if (oldInstanceCount == newInstanceCount) {
+                        for (unsigned int i = 0; i < newInstanceCount; i++) {
+                            // VP2 defines instance ID of the first instance to be 1.
+                            result = drawScene.updateInstanceTransform(
+                                *renderItem, i + 1, stateToCommit._instanceTransforms[i]);
+                            TF_VERIFY(result == MStatus::kSuccess);
+                        }
+                    } else {
+                        result = drawScene.setInstanceTransformArray(
+                            *renderItem, stateToCommit._instanceTransforms);
                         TF_VERIFY(result == MStatus::kSuccess);
                     }
-                } else {
-                    result = drawScene.setInstanceTransformArray(
-                        *renderItem, stateToCommit._instanceTransforms);
-                    TF_VERIFY(result == MStatus::kSuccess);
                 }
 
-                if (newInstanceCount > 0
-                    && stateToCommit._instanceColors.length()
+                if (stateToCommit._instanceColorsDirty && newInstanceCount > 0) {
+                    const auto& ids = stateToCommit._instanceColorIds;
+                    if (!ids.empty()) {
+                        MFloatArray color(kNumColorChannels);
+                        for (unsigned int i = 0; i < ids.size(); i++) {
+                            for (unsigned int j = 0; j < kNumColorChannels; j++) {
+                                color[j]
+                                    = stateToCommit._instanceColors[i * kNumColorChannels + j];
+                            }
+                            result = drawScene.updateExtraInstanceData(
+                                *renderItem, ids[i] + 1, stateToCommit._instanceColorParam, color);
+                            TF_VERIFY(result == MStatus::kSuccess);
+                        }
+                    } else if (
+                        stateToCommit._instanceColors.length()
                         == newInstanceCount * kNumColorChannels) {
-                    result = drawScene.setExtraInstanceData(
-                        *renderItem,
-                        stateToCommit._instanceColorParam,
-                        stateToCommit._instanceColors);
-                    TF_VERIFY(result == MStatus::kSuccess);
+                        result = drawScene.setExtraInstanceData(
+                            *renderItem,
+                            stateToCommit._instanceColorParam,
+                            stateToCommit._instanceColors);
+                        TF_VERIFY(result == MStatus::kSuccess);
+                    }
                 }
             }
 #if MAYA_API_VERSION >= 20210000
-            else if (newInstanceCount >= 1) {
+            else if (stateToCommit._instanceTransformsDirty && newInstanceCount >= 1) {
 #else
             // In Maya 2020 and before, GPU instancing and consolidation are two separate systems
             // that cannot be used by a render item at the same time. In case of single instance, we
             // keep the original render item to allow consolidation with other prims. In case of
             // multiple instances, we need to disable consolidation to allow GPU instancing to be
             // used.
-            else if (newInstanceCount == 1) {
+            else if (stateToCommit._instanceTransformsDirty && newInstanceCount == 1) {
                 bool success = renderItem->setMatrix(&stateToCommit._instanceTransforms[0]);
                 TF_VERIFY(success);
-            } else if (newInstanceCount > 1) {
+            } else if (stateToCommit._instanceTransformsDirty && newInstanceCount > 1) {
                 setWantConsolidation(*renderItem, false);
 #endif
                 result = drawScene.setInstanceTransformArray(
                     *renderItem, stateToCommit._instanceTransforms);
                 TF_VERIFY(result == MStatus::kSuccess);
 
-                if (stateToCommit._instanceColors.length()
-                    == newInstanceCount * kNumColorChannels) {
+                if (stateToCommit._instanceColorsDirty
+                    && stateToCommit._instanceColors.length()
+                        == newInstanceCount * kNumColorChannels) {
                     result = drawScene.setExtraInstanceData(
                         *renderItem,
                         stateToCommit._instanceColorParam,
@@ -2464,7 +2715,9 @@ void HdVP2Mesh::_UpdateDrawItem(
                 TF_VERIFY(success);
             }
 
-            oldInstanceCount = newInstanceCount;
+            if (stateToCommit._instanceTransformsDirty) {
+                oldInstanceCount = newInstanceCount;
+            }
 #ifdef MAYA_MRENDERITEM_UFE_IDENTIFIER_SUPPORT
             if (stateToCommit._ufeIdentifiers.length() > 0) {
                 drawScene.setUfeIdentifiers(*renderItem, stateToCommit._ufeIdentifiers);
@@ -2713,7 +2966,10 @@ void HdVP2Mesh::_UpdatePrimvarSources(
                 _meshSharedData->_primvarInfo.erase(pv.name);
             } else {
                 if (HdChangeTracker::IsPrimvarDirty(dirtyBits, id, pv.name)) {
-                    const VtValue value = GetPrimvar(sceneDelegate, pv.name);
+                    VtValue value = GetPrimvar(sceneDelegate, pv.name);
+                    if (_refinedTopology) {
+                        value = _refinedTopology->Refine(value, interp);
+                    }
                     updatePrimvarInfo(pv.name, value, interp);
 
                     // if the primvar color changes then we might need to use a different fallback
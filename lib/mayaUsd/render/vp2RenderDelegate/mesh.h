@@ -20,6 +20,7 @@
 #include "mayaPrimCommon.h"
 #include "meshViewportCompute.h"
 #include "primvarInfo.h"
+#include "refinedTopology.h"
 
 #include <mayaUsd/render/vp2RenderDelegate/proxyRenderDelegate.h>
 
@@ -145,6 +146,8 @@ private:
 
     void _HideAllDrawItems(const TfToken& reprToken);
 
+    void _UpdateInstanceTransforms(HdRenderIndex& renderIndex);
+
     void _UpdatePrimvarSources(
         HdSceneDelegate*     sceneDelegate,
         HdDirtyBits          dirtyBits,
@@ -204,6 +207,19 @@ private:
     //! Selection status of the Rprim
     HdVP2SelectionStatus _selectionStatus { kUnselected };
 
+    //! Render tag last recorded with ProxyRenderDelegate::UpdateRenderTag
+    TfToken _indexedRenderTag;
+
+    //! Instance transforms pulled from the instancer
+    VtMatrix4dArray _instanceTransforms;
+    //! For each instance, whether its transform changed in the last pull from the instancer
+    std::vector<unsigned char> _instanceTransformChanged;
+    //! Number of pulls of the instance transforms, see HdVP2DrawItem::RenderItemData
+    unsigned int _instanceTransformsVersion { 0 };
+
+    //! The refinement of the scene topology, when the mesh is refined on the CPU
+    std::shared_ptr<const HdVP2RefinedTopology> _refinedTopology;
+
     //! Control GPU compute behavior
     //! Having these in place even without HDVP2_ENABLE_GPU_COMPUTE or HDVP2_ENABLE_GPU_OSD
     //! defined makes the expressions using these variables much simpler
@@ -0,0 +1,88 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef HD_VP2_PRIMVAR_GATHER
+#define HD_VP2_PRIMVAR_GATHER
+
+#include <pxr/pxr.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <atomic>
+#include <cstring>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+//! Number of vertices gathered by each task, smaller buffers are gathered on the calling thread
+constexpr size_t kHdVP2GatherGrainSize = 16384;
+
+/*! \brief  Copies data[indices[v]] to the vertex v of a vertex buffer, for each vertex.
+
+    The vertex buffer is either planar, when DEST_TYPE is SRC_TYPE, or interleaved, in which case
+    the source element is written channelOffset floats into each vertex. The vertices whose index
+    is out of range are left untouched.
+
+    The bounds check stays in the copy loop: the gather is bound by memory accesses, so the check
+    is free while a separate validation pass over the indices is not. Large buffers are split
+    across worker threads.
+
+    \return True if all the indices were in range.
+*/
+template <class DEST_TYPE, class SRC_TYPE>
+bool HdVP2GatherPrimvarData(
+    DEST_TYPE*      vertexBuffer,
+    size_t          numVertices,
+    size_t          channelOffset,
+    const int*      indices,
+    const SRC_TYPE* data,
+    size_t          dataSize)
+{
+    static_assert(sizeof(DEST_TYPE) % sizeof(float) == 0, "Vertices must be made of floats");
+    constexpr size_t kStride = sizeof(DEST_TYPE) / sizeof(float);
+
+    auto gather = [vertexBuffer, channelOffset, indices, data, dataSize](
+                      size_t begin, size_t end) {
+        bool   inRange = true;
+        float* dest = reinterpret_cast<float*>(vertexBuffer + begin) + channelOffset;
+        for (size_t v = begin; v < end; v++, dest += kStride) {
+            const size_t index = static_cast<unsigned int>(indices[v]);
+            if (index < dataSize) {
+                std::memcpy(dest, data + index, sizeof(SRC_TYPE));
+            } else {
+                inRange = false;
+            }
+        }
+        return inRange;
+    };
+
+    if (numVertices <= kHdVP2GatherGrainSize) {
+        return gather(0, numVertices);
+    }
+
+    std::atomic<bool> inRange { true };
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, numVertices, kHdVP2GatherGrainSize),
+        [&gather, &inRange](const tbb::blocked_range<size_t>& range) {
+            if (!gather(range.begin(), range.end())) {
+                inRange = false;
+            }
+        });
+    return inRange;
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif
@@ -15,6 +15,7 @@
 //
 #include "proxyRenderDelegate.h"
 
+#include "bboxGeom.h"
 #include "draw_item.h"
 #include "mayaPrimCommon.h"
 #include "render_delegate.h"
@@ -27,16 +28,18 @@
 #include <mayaUsd/utils/util.h>
 
 #include <pxr/base/tf/diagnostic.h>
+#include <pxr/base/tf/getenv.h>
 #include <pxr/base/tf/staticTokens.h>
 #include <pxr/base/tf/stringUtils.h>
 #include <pxr/base/tf/token.h>
 #include <pxr/imaging/hd/basisCurves.h>
 #include <pxr/imaging/hd/enums.h>
+#include <pxr/imaging/hd/material.h>
 #include <pxr/imaging/hd/mesh.h>
-#include <pxr/imaging/hd/primGather.h>
 #include <pxr/imaging/hd/repr.h>
 #include <pxr/imaging/hd/rprimCollection.h>
 #include <pxr/imaging/hd/sceneDelegate.h>
+#include <pxr/imaging/hd/tokens.h>
 #include <pxr/imaging/hdx/renderTask.h>
 #include <pxr/imaging/hdx/selectionTracker.h>
 #include <pxr/imaging/hdx/taskController.h>
@@ -47,12 +50,18 @@
 #include <pxr/usd/usd/prim.h>
 #include <pxr/usdImaging/usdImaging/delegate.h>
 
+#include <maya/MBoundingBox.h>
 #include <maya/MEventMessage.h>
 #include <maya/MFileIO.h>
 #include <maya/MFnPluginData.h>
 #include <maya/MHWGeometryUtilities.h>
 #include <maya/MProfiler.h>
 #include <maya/MSelectionContext.h>
+#include <maya/MSelectionMask.h>
+#include <maya/MUiMessage.h>
+
+#include <algorithm>
+#include <chrono>
 
 #if defined(WANT_UFE_BUILD)
 #include <mayaUsd/ufe/UsdSceneItem.h>
@@ -96,6 +105,51 @@ const HdReprSelector kBBoxReprSelector(TfToken(), HdVP2ReprTokens->bbox);
 //! Representation selector for point snapping
 const HdReprSelector kPointsReprSelector(TfToken(), TfToken(), HdReprTokens->points);
 
+//! \brief  Whether rprims are drawn as boxes first and synced over the following frames.
+bool IsProgressivePopulationEnabled()
+{
+    static const bool enabled = TfGetenvInt("HDVP2_PROGRESSIVE_POPULATION", 0) > 0;
+    return enabled;
+}
+
+//! \brief  Time the progressive population may spend syncing rprims in each frame, in seconds.
+double GetProgressivePopulationBudget()
+{
+    static const double budget
+        = std::max(TfGetenvInt("HDVP2_PROGRESSIVE_POPULATION_BUDGET_MS", 30), 1) / 1000.0;
+    return budget;
+}
+
+//! \brief  Area of the viewport covered by a box, in normalized device coordinates.
+//!         Boxes entirely behind the camera cover none of the viewport, boxes crossing the
+//!         near plane cover all of it.
+double GetScreenSpaceArea(const GfRange3d& box, const GfMatrix4d& boxToClip)
+{
+    double minX = 1.0, minY = 1.0, maxX = -1.0, maxY = -1.0;
+    size_t cornersBehind = 0;
+    for (size_t i = 0; i < 8; i++) {
+        const GfVec3d corner = box.GetCorner(i);
+        const GfVec4d p = GfVec4d(corner[0], corner[1], corner[2], 1.0) * boxToClip;
+        if (p[3] <= 0.0) {
+            ++cornersBehind;
+            continue;
+        }
+        minX = std::min(minX, p[0] / p[3]);
+        minY = std::min(minY, p[1] / p[3]);
+        maxX = std::max(maxX, p[0] / p[3]);
+        maxY = std::max(maxY, p[1] / p[3]);
+    }
+    if (cornersBehind == 8) {
+        return 0.0;
+    } else if (cornersBehind > 0) {
+        return 4.0;
+    }
+
+    const double width = std::min(maxX, 1.0) - std::max(minX, -1.0);
+    const double height = std::min(maxY, 1.0) - std::max(minY, -1.0);
+    return (width > 0.0 && height > 0.0) ? width * height : 0.0;
+}
+
 #if defined(WANT_UFE_BUILD)
 //! \brief  Query the global selection list adjustment.
 MGlobal::ListAdjustment GetListAdjustment()
@@ -247,6 +301,44 @@ void AppendSelectedPrimPaths(const HdSelectionSharedPtr& selection, SdfPathVecto
     }
 }
 
+//! \brief  Query the selection state of a given prim from a selection.
+const HdSelection::PrimSelectionState*
+GetPrimSelectionState(const HdSelectionSharedPtr& selection, const SdfPath& path)
+{
+    return (selection == nullptr)
+        ? nullptr
+        : selection->GetPrimSelectionState(HdSelection::HighlightModeSelect, path);
+}
+
+//! \brief  Query the selection status of a given prim from the display status of the proxy
+//!         shape and from the lead and active selection.
+HdVP2SelectionStatus ComputeSelectionStatus(
+    MHWRender::DisplayStatus    displayStatus,
+    const HdSelectionSharedPtr& leadSelection,
+    const HdSelectionSharedPtr& activeSelection,
+    const SdfPath&              path)
+{
+    if (displayStatus == MHWRender::kLead) {
+        return kFullyLead;
+    }
+
+    if (displayStatus == MHWRender::kActive) {
+        return kFullyActive;
+    }
+
+    const HdSelection::PrimSelectionState* state = GetPrimSelectionState(leadSelection, path);
+    if (state) {
+        return state->fullySelected ? kFullyLead : kPartiallySelected;
+    }
+
+    state = GetPrimSelectionState(activeSelection, path);
+    if (state) {
+        return state->fullySelected ? kFullyActive : kPartiallySelected;
+    }
+
+    return kUnselected;
+}
+
 //! \brief  Configure repr descriptions
 void _ConfigureReprs()
 {
@@ -331,103 +423,6 @@ void SelectionChangedCB(void* data)
 }
 #endif
 
-// Copied from renderIndex.cpp, the code that does HdRenderIndex::GetDrawItems. But I just want the
-// rprimIds, I don't want to go all the way to draw items.
-#if defined(HD_API_VERSION) && HD_API_VERSION >= 42
-struct _FilterParam
-{
-    const TfTokenVector& renderTags;
-    const HdRenderIndex* renderIndex;
-};
-
-bool _DrawItemFilterPredicate(const SdfPath& rprimID, const void* predicateParam)
-{
-    const _FilterParam* filterParam = static_cast<const _FilterParam*>(predicateParam);
-
-    const TfTokenVector& renderTags = filterParam->renderTags;
-    const HdRenderIndex* renderIndex = filterParam->renderIndex;
-
-    //
-    // Render Tag Filter
-    //
-    if (renderTags.empty()) {
-        // An empty render tag set means everything passes the filter
-        // Primary user is tests, but some single task render delegates
-        // that don't support render tags yet also use it.
-        return true;
-    } else {
-        // As the number of tags is expected to be low (<10)
-        // use a simple linear search.
-        TfToken primRenderTag = renderIndex->GetRenderTag(rprimID);
-        size_t  numRenderTags = renderTags.size();
-        size_t  tagNum = 0;
-        while (tagNum < numRenderTags) {
-            if (renderTags[tagNum] == primRenderTag) {
-                return true;
-            }
-            ++tagNum;
-        }
-    }
-    return false;
-}
-#else
-struct _FilterParam
-{
-    const HdRprimCollection& collection;
-    const TfTokenVector&     renderTags;
-    const HdRenderIndex*     renderIndex;
-};
-
-bool _DrawItemFilterPredicate(const SdfPath& rprimID, const void* predicateParam)
-{
-    const _FilterParam* filterParam = static_cast<const _FilterParam*>(predicateParam);
-
-    const HdRprimCollection& collection = filterParam->collection;
-    const TfTokenVector&     renderTags = filterParam->renderTags;
-    const HdRenderIndex*     renderIndex = filterParam->renderIndex;
-
-    //
-    // Render Tag Filter
-    //
-    bool passedRenderTagFilter = false;
-    if (renderTags.empty()) {
-        // An empty render tag set means everything passes the filter
-        // Primary user is tests, but some single task render delegates
-        // that don't support render tags yet also use it.
-        passedRenderTagFilter = true;
-    } else {
-        // As the number of tags is expected to be low (<10)
-        // use a simple linear search.
-        TfToken primRenderTag = renderIndex->GetRenderTag(rprimID);
-        size_t  numRenderTags = renderTags.size();
-        size_t  tagNum = 0;
-        while (!passedRenderTagFilter && tagNum < numRenderTags) {
-            if (renderTags[tagNum] == primRenderTag) {
-                passedRenderTagFilter = true;
-            }
-            ++tagNum;
-        }
-    }
-
-    //
-    // Material Tag Filter
-    //
-    bool passedMaterialTagFilter = false;
-
-    // Filter out rprims that do not match the collection's materialTag.
-    // E.g. We may want to gather only opaque or translucent prims.
-    // An empty materialTag on collection means: ignore material-tags.
-    // This is important for tasks such as the selection-task which wants
-    // to ignore materialTags and receive all prims in its collection.
-    TfToken const& collectionMatTag = collection.GetMaterialTag();
-    if (collectionMatTag.IsEmpty() || renderIndex->GetMaterialTag(rprimID) == collectionMatTag) {
-        passedMaterialTagFilter = true;
-    }
-
-    return (passedRenderTagFilter && passedMaterialTagFilter);
-}
-#endif
-
 } // namespace
 
 //! \brief  Draw classification used during plugin load to register in VP2
@@ -460,6 +455,12 @@ ProxyRenderDelegate::~ProxyRenderDelegate()
 {
     _ClearRenderDelegate();
 
+    for (const auto& viewport : _viewportReprSelectors) {
+        if (viewport.second._destroyedCallbackId != 0) {
+            MMessage::removeCallback(viewport.second._destroyedCallbackId);
+        }
+    }
+
 #if !defined(WANT_UFE_BUILD)
     if (_mayaSelectionCallbackId != 0) {
         MMessage::removeCallback(_mayaSelectionCallbackId);
@@ -512,6 +513,15 @@ void ProxyRenderDelegate::_ClearRenderDelegate()
 #endif
     _taskRenderTagsValid = false;
     _isPopulated = false;
+
+    // The placeholders are removed with the rest of the container.
+    _deferredRprims.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(_renderTagIndexMutex);
+        _rprimsByRenderTag.clear();
+        _renderTagOfRprim.clear();
+    }
 }
 
 //! \brief  Clear data which is now stale because proxy shape attributes have changed
@@ -652,6 +662,7 @@ bool ProxyRenderDelegate::_Populate()
         }
         _proxyShapeData->ExcludePrimsUpdated();
         _sceneDelegate->Populate(_proxyShapeData->ProxyShape()->usdPrim(), excludePrimPaths);
+        _DeferRprims();
         _isPopulated = true;
     }
 
@@ -723,6 +734,24 @@ void ProxyRenderDelegate::_UpdateSceneDelegate()
 
         _sceneDelegate->SetRefineLevelFallback(refineLevel);
     }
+
+    auto* const renderDelegate = static_cast<HdVP2RenderDelegate*>(_renderDelegate.get());
+    const int   maxTextureResolution = _proxyShapeData->ProxyShape()->getMaxTextureResolution();
+    if (maxTextureResolution != renderDelegate->GetMaxTextureResolution()) {
+        MProfilingScope subProfilingScope(
+            HdVP2RenderDelegate::sProfilerCategory,
+            MProfiler::kColorC_L1,
+            "SetMaxTextureResolution");
+
+        renderDelegate->SetMaxTextureResolution(maxTextureResolution);
+
+        // Sync all of the materials again so that they reload their textures.
+        HdChangeTracker& changeTracker = _renderIndex->GetChangeTracker();
+        for (const SdfPath& materialId : _renderIndex->GetSprimSubtree(
+                 HdPrimTypeTokens->material, SdfPath::AbsoluteRootPath())) {
+            changeTracker.MarkSprimDirty(materialId, HdMaterial::DirtyParams);
+        }
+    }
 }
 
 //! \brief  Execute Hydra engine to perform minimal VP2 draw data update based on change tracker.
@@ -830,25 +859,78 @@ void ProxyRenderDelegate::_Execute(const MHWRender::MFrameContext& frameContext)
                 }
             }
         }
+
+        // Keep the reprs of the other viewports live, so that drawing viewports with different
+        // display styles one after the other reuses their render items. VP2 only draws the
+        // render items matching the display style of each viewport. The reprs of the current
+        // viewport take precedence when two viewports need different reprs of the same slot.
+        MString destination;
+        if (frameContext.renderingDestination(destination)
+            == MHWRender::MFrameContext::k3dViewport) {
+            auto it = _viewportReprSelectors.find(destination.asChar());
+            if (it == _viewportReprSelectors.end()) {
+                it = _viewportReprSelectors.emplace(destination.asChar(), _ViewportReprSelector())
+                         .first;
+                it->second._destroyedCallbackId = MUiMessage::add3dViewDestroyMsgCallback(
+                    destination, _ViewportDestroyedCallback, this);
+            }
+            it->second._reprSelector = reprSelector;
+            for (const auto& viewport : _viewportReprSelectors) {
+                reprSelector = reprSelector.CompositeOver(viewport.second._reprSelector);
+            }
+        }
     }
 
     // if there are no repr's to update then don't even call sync.
     if (reprSelector != HdReprSelector()) {
-        if (_defaultCollection->GetReprSelector() != reprSelector) {
+        const HdReprSelector previousReprSelector = _defaultCollection->GetReprSelector();
+        if (previousReprSelector != reprSelector) {
             _defaultCollection->SetReprSelector(reprSelector);
             _taskController->SetCollection(*_defaultCollection);
 
+            // The render items of the reprs which were not synced so far may be out of date.
+            bool addedRepr = false;
+            for (size_t i = 0; i < HdReprSelector::MAX_TOPOLOGY_REPRS; i++) {
+                if (reprSelector.IsActiveRepr(i)
+                    && !previousReprSelector.Contains(reprSelector[i])) {
+                    addedRepr = true;
+                }
+            }
+
             // Mark everything "dirty" so that sync is called on everything
-            // If there are multiple views up with different viewport modes then
-            // this is slow.
-            auto&            rprims = _renderIndex->GetRprimIds();
-            HdChangeTracker& changeTracker = _renderIndex->GetChangeTracker();
-            for (auto path : rprims) {
-                changeTracker.MarkRprimDirty(path, MayaPrimCommon::DirtyDisplayMode);
+            if (addedRepr) {
+                auto&            rprims = _renderIndex->GetRprimIds();
+                HdChangeTracker& changeTracker = _renderIndex->GetChangeTracker();
+                for (auto path : rprims) {
+                    changeTracker.MarkRprimDirty(path, MayaPrimCommon::DirtyDisplayMode);
+                }
             }
         }
 
+        // Sync the materials again when their textures have been loaded in the background.
+        static_cast<HdVP2RenderDelegate*>(_renderDelegate.get())
+            ->GetTextureLoader()
+            .MarkLoadedMaterialsDirty(_renderIndex->GetChangeTracker());
+
+        // Sync the next batch of rprims postponed by the progressive population.
+        const size_t promoted = inSelectionPass ? 0 : _PromoteDeferredRprims(frameContext);
+        const auto   executeStart = std::chrono::steady_clock::now();
+
         _engine.Execute(_renderIndex.get(), &_dummyTasks);
+
+        if (promoted > 0) {
+            // Scale the next batch to the time it took to sync this one.
+            const std::chrono::duration<double> elapsed
+                = std::chrono::steady_clock::now() - executeStart;
+            const double scale
+                = GetProgressivePopulationBudget() / std::max(elapsed.count(), 1e-4);
+            _promotionBatchSize = std::max<size_t>(size_t(promoted * std::min(scale, 2.0)), 16);
+
+            // Keep drawing frames until every rprim is synced, even if nothing else changes.
+            if (!_deferredRprims.empty()) {
+                MGlobal::executeCommandOnIdle("refresh -force", false);
+            }
+        }
     }
 }
 
@@ -1199,6 +1281,21 @@ bool ProxyRenderDelegate::updateUfeIdentifiers(
 //! \brief  Notify of selection change.
 void ProxyRenderDelegate::SelectionChanged() { _selectionChanged = true; }
 
+//! \brief  Stop keeping the reprs of a viewport live once it is destroyed.
+void ProxyRenderDelegate::_ViewportDestroyedCallback(const MString& panelName, void* data)
+{
+    auto* instance = static_cast<ProxyRenderDelegate*>(data);
+    if (!TF_VERIFY(instance)) {
+        return;
+    }
+
+    const auto it = instance->_viewportReprSelectors.find(panelName.asChar());
+    if (it != instance->_viewportReprSelectors.end()) {
+        MMessage::removeCallback(it->second._destroyedCallbackId);
+        instance->_viewportReprSelectors.erase(it);
+    }
+}
+
 //! \brief  Populate lead and active selection for Rprims under the proxy shape.
 void ProxyRenderDelegate::_PopulateSelection()
 {
@@ -1228,60 +1325,89 @@ void ProxyRenderDelegate::_PopulateSelection()
 }
 
 /*! \brief  Notify selection change to rprims.
- */
+
+    Only the Rprims whose selection status changed are synced, except when the proxy shape itself
+    gets selected or deselected: the whole render index is then visited.
+*/
 void ProxyRenderDelegate::_UpdateSelectionStates()
 {
     const MHWRender::DisplayStatus previousStatus = _displayStatus;
+    const HdSelectionSharedPtr     previousLeadSelection = _leadSelection;
+    const HdSelectionSharedPtr     previousActiveSelection = _activeSelection;
+
     _displayStatus = MHWRender::MGeometryUtilities::displayStatus(_proxyShapeData->ProxyDagPath());
 
-    SdfPathVector        rootPaths;
-    const SdfPathVector* dirtyPaths = nullptr;
+    auto isFullySelected = [](MHWRender::DisplayStatus status) {
+        return status == MHWRender::kLead || status == MHWRender::kActive;
+    };
 
-    if (_displayStatus == MHWRender::kLead || _displayStatus == MHWRender::kActive) {
-        if (_displayStatus != previousStatus) {
-            rootPaths.push_back(SdfPath::AbsoluteRootPath());
-            dirtyPaths = &_renderIndex->GetRprimIds();
+    // The lead and active selection are not used while the proxy shape is selected.
+    if (isFullySelected(_displayStatus)) {
+        if (_displayStatus == previousStatus) {
+            return;
         }
-    } else if (previousStatus == MHWRender::kLead || previousStatus == MHWRender::kActive) {
-        rootPaths.push_back(SdfPath::AbsoluteRootPath());
-        dirtyPaths = &_renderIndex->GetRprimIds();
-        _PopulateSelection();
     } else {
-        // Append pre-update lead and active selection.
-        AppendSelectedPrimPaths(_leadSelection, rootPaths);
-        AppendSelectedPrimPaths(_activeSelection, rootPaths);
-
-        // Update lead and active selection.
         _PopulateSelection();
+    }
 
-        // Append post-update lead and active selection.
-        AppendSelectedPrimPaths(_leadSelection, rootPaths);
-        AppendSelectedPrimPaths(_activeSelection, rootPaths);
+    // When the proxy shape gets selected or deselected, the status of any Rprim can change.
+    // Otherwise only the status of the Rprims selected before or after the update can.
+    //
+    // Each Rprim enables and colors its own highlight render items, so a proxy shape selection
+    // change still dirties and syncs every Rprim whose status changes. Drawing the highlight
+    // from the proxy shape display status alone, without syncing the Rprims, is not supported.
+    const bool    proxyStatusChanged
+        = isFullySelected(_displayStatus) || isFullySelected(previousStatus);
+    SdfPathVector selectedPaths;
+    if (!proxyStatusChanged) {
+        AppendSelectedPrimPaths(previousLeadSelection, selectedPaths);
+        AppendSelectedPrimPaths(previousActiveSelection, selectedPaths);
+        AppendSelectedPrimPaths(_leadSelection, selectedPaths);
+        AppendSelectedPrimPaths(_activeSelection, selectedPaths);
+        std::sort(selectedPaths.begin(), selectedPaths.end());
+        selectedPaths.erase(
+            std::unique(selectedPaths.begin(), selectedPaths.end()), selectedPaths.end());
+    }
+    const SdfPathVector& candidatePaths
+        = proxyStatusChanged ? _renderIndex->GetRprimIds() : selectedPaths;
+
+    HdDirtyBits dirtySelectionBits = MayaPrimCommon::DirtySelectionHighlight;
+    bool        dirtyAllCandidates = false;
+#ifdef MAYA_NEW_POINT_SNAPPING_SUPPORT
+    // If the selection mode changes, for example into or out of point snapping,
+    // then we need to do a little extra work.
+    if (_selectionModeChanged) {
+        dirtySelectionBits |= MayaPrimCommon::DirtySelectionMode;
+        dirtyAllCandidates = true;
+    }
+#endif
 
-        dirtyPaths = &rootPaths;
+    // Only sync the Rprims whose selection status changed. Partially selected Rprims are always
+    // synced, because the selected instances may have changed.
+    SdfPathVector dirtyPaths;
+    for (const SdfPath& path : candidatePaths) {
+        const HdVP2SelectionStatus status = GetSelectionStatus(path);
+        const HdVP2SelectionStatus previous = ComputeSelectionStatus(
+            previousStatus, previousLeadSelection, previousActiveSelection, path);
+        if ((dirtyAllCandidates || status != previous || status == kPartiallySelected)
+            && _renderIndex->HasRprim(path)) {
+            dirtyPaths.push_back(path);
+        }
     }
 
-    if (!rootPaths.empty()) {
+    if (!dirtyPaths.empty()) {
         // When the selection changes then we have to update all the selected render
         // items. Set a dirty flag on each of the rprims so they know what to update.
-        // Avoid trying to set dirty the absolute root as it is not a Rprim.
-        HdDirtyBits dirtySelectionBits = MayaPrimCommon::DirtySelectionHighlight;
-#ifdef MAYA_NEW_POINT_SNAPPING_SUPPORT
-        // If the selection mode changes, for example into or out of point snapping,
-        // then we need to do a little extra work.
-        if (_selectionModeChanged)
-            dirtySelectionBits |= MayaPrimCommon::DirtySelectionMode;
-#endif
         HdChangeTracker& changeTracker = _renderIndex->GetChangeTracker();
-        for (auto path : *dirtyPaths) {
-            if (_renderIndex->HasRprim(path))
-                changeTracker.MarkRprimDirty(path, dirtySelectionBits);
+        for (const SdfPath& path : dirtyPaths) {
+            changeTracker.MarkRprimDirty(path, dirtySelectionBits);
         }
 
         // now that the appropriate prims have been marked dirty trigger
         // a sync so that they all update.
         HdRprimCollection collection(HdTokens->geometry, _defaultCollection->GetReprSelector());
-        collection.SetRootPaths(rootPaths);
+        collection.SetRootPaths(
+            proxyStatusChanged ? SdfPathVector { SdfPath::AbsoluteRootPath() } : dirtyPaths);
         _taskController->SetCollection(collection);
         _engine.Execute(_renderIndex.get(), &_dummyTasks);
         _taskController->SetCollection(*_defaultCollection);
@@ -1353,8 +1479,9 @@ void ProxyRenderDelegate::_UpdateRenderTags()
             changedRenderTags.push_back(HdRenderTagTokens->guide);
         }
 
-        // Mark all the rprims which have a render tag which changed dirty
-        SdfPathVector rprimsToDirty = _GetFilteredRprims(*_defaultCollection, changedRenderTags);
+        // Mark all the rprims which have a render tag which changed dirty. The index only holds
+        // the rprims which have been synced: the others are still dirty anyway.
+        SdfPathVector rprimsToDirty = _GetRprimsWithRenderTags(changedRenderTags);
 
         for (auto& id : rprimsToDirty) {
             // this call to MarkRprimDirty will increment the change tracker render
@@ -1418,67 +1545,252 @@ void ProxyRenderDelegate::_UpdateRenderTags()
 #endif
 }
 
-//! \brief  List the rprims in collection that match renderTags
-SdfPathVector ProxyRenderDelegate::_GetFilteredRprims(
-    HdRprimCollection const& collection,
-    TfTokenVector const&     renderTags)
+//! \brief  List the rprims which last synced with one of renderTags
+SdfPathVector ProxyRenderDelegate::_GetRprimsWithRenderTags(TfTokenVector const& renderTags)
 {
-    SdfPathVector        rprimIds;
-    const SdfPathVector& paths = _renderIndex->GetRprimIds();
-    const SdfPathVector& includePaths = collection.GetRootPaths();
-    const SdfPathVector& excludePaths = collection.GetExcludePaths();
-#if defined(HD_API_VERSION) && HD_API_VERSION >= 42
-    _FilterParam filterParam = { renderTags, _renderIndex.get() };
-#else
-    _FilterParam filterParam = { collection, renderTags, _renderIndex.get() };
-#endif
-    HdPrimGather gather;
-    gather.PredicatedFilter(
-        paths, includePaths, excludePaths, _DrawItemFilterPredicate, &filterParam, &rprimIds);
+    SdfPathVector rprimIds;
+
+    std::lock_guard<std::mutex> lock(_renderTagIndexMutex);
+    for (const TfToken& renderTag : renderTags) {
+        const auto it = _rprimsByRenderTag.find(renderTag);
+        if (it != _rprimsByRenderTag.end()) {
+            rprimIds.insert(rprimIds.end(), it->second.begin(), it->second.end());
+        }
+    }
 
     return rprimIds;
 }
 
-//! \brief  Query the selection state of a given prim from the lead selection.
-const HdSelection::PrimSelectionState*
-ProxyRenderDelegate::GetLeadSelectionState(const SdfPath& path) const
+/*! \brief  Record the render tag an rprim is synced with.
+
+    Rprims call this from Sync when the render tag Hydra filtered them with differs from the one
+    they last recorded, so the lock is only taken on the first sync and when the tag changes.
+    It keeps the index of the rprims of each render tag up to date, so that changing the displayed
+    purposes only dirties the rprims of the affected render tags.
+*/
+void ProxyRenderDelegate::UpdateRenderTag(const SdfPath& id, const TfToken& renderTag)
 {
-    return (_leadSelection == nullptr)
-        ? nullptr
-        : _leadSelection->GetPrimSelectionState(HdSelection::HighlightModeSelect, path);
+    std::lock_guard<std::mutex> lock(_renderTagIndexMutex);
+
+    const auto it = _renderTagOfRprim.find(id);
+    if (it == _renderTagOfRprim.end()) {
+        _renderTagOfRprim.emplace(id, renderTag);
+    } else if (it->second == renderTag) {
+        return;
+    } else {
+        _rprimsByRenderTag[it->second].erase(id);
+        it->second = renderTag;
+    }
+
+    _rprimsByRenderTag[renderTag].insert(id);
 }
 
-//! \brief  Qeury the selection state of a given prim from the active selection.
-const HdSelection::PrimSelectionState*
-ProxyRenderDelegate::GetActiveSelectionState(const SdfPath& path) const
+/*! \brief  Forget the render tag of an rprim which is being destroyed.
+ */
+void ProxyRenderDelegate::RemoveRenderTag(const SdfPath& id)
 {
-    return (_activeSelection == nullptr)
-        ? nullptr
-        : _activeSelection->GetPrimSelectionState(HdSelection::HighlightModeSelect, path);
+    std::lock_guard<std::mutex> lock(_renderTagIndexMutex);
+
+    const auto it = _renderTagOfRprim.find(id);
+    if (it != _renderTagOfRprim.end()) {
+        _rprimsByRenderTag[it->second].erase(id);
+        _renderTagOfRprim.erase(it);
+    }
 }
 
-//! \brief  Query the selection status of a given prim.
-HdVP2SelectionStatus ProxyRenderDelegate::GetSelectionStatus(const SdfPath& path) const
+/*! \brief  Postpone the first sync of the rprims when progressive population is enabled.
+
+    Syncing every rprim of a large stage can take minutes before anything is drawn. With the
+    HDVP2_PROGRESSIVE_POPULATION environment variable set to 1, each rprim is instead drawn as a
+    box of its authored extent, using the unit cube shared by the bbox reprs, until
+    _PromoteDeferredRprims() syncs it in one of the following frames. Rprims without an authored
+    extent, and the prototypes drawn by an instancer, are drawn only once synced. They are promoted
+    first.
+*/
+void ProxyRenderDelegate::_DeferRprims()
 {
-    if (_displayStatus == MHWRender::kLead) {
-        return kFullyLead;
+    if (!IsProgressivePopulationEnabled()) {
+        return;
     }
 
-    if (_displayStatus == MHWRender::kActive) {
-        return kFullyActive;
+    auto* const param = reinterpret_cast<HdVP2RenderParam*>(_renderDelegate->GetRenderParam());
+    MSubSceneContainer* container = param->GetContainer();
+    if (!TF_VERIFY(container)) {
+        return;
     }
 
-    const HdSelection::PrimSelectionState* state = GetLeadSelectionState(path);
-    if (state) {
-        return state->fullySelected ? kFullyLead : kPartiallySelected;
+    MProfilingScope profilingScope(
+        HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L1, "DeferRprims");
+
+    auto* const vp2RenderDelegate = static_cast<HdVP2RenderDelegate*>(_renderDelegate.get());
+    const HdVP2BBoxGeom&        sharedBBoxGeom = vp2RenderDelegate->GetSharedBBoxGeom();
+    MHWRender::MShaderInstance* shader = vp2RenderDelegate->Get3dSolidShader(
+        MHWRender::MGeometryUtilities::wireframeColor(_proxyShapeData->ProxyDagPath()));
+
+    MHWRender::MVertexBufferArray vertexBuffers;
+    vertexBuffers.addBuffer(
+        HdTokens->points.GetText(),
+        const_cast<MHWRender::MVertexBuffer*>(sharedBBoxGeom.GetPositionBuffer()));
+    MHWRender::MIndexBuffer& indexBuffer
+        = *const_cast<MHWRender::MIndexBuffer*>(sharedBBoxGeom.GetIndexBuffer());
+
+    const GfVec3d&     unitMin = sharedBBoxGeom.GetRange().GetMin();
+    const GfVec3d&     unitMax = sharedBBoxGeom.GetRange().GetMax();
+    const MBoundingBox unitBounds(
+        MPoint(unitMin[0], unitMin[1], unitMin[2]), MPoint(unitMax[0], unitMax[1], unitMax[2]));
+
+    const GfMatrix4d rootInverse = _sceneDelegate->GetRootTransform().GetInverse();
+
+    for (const SdfPath& id : _renderIndex->GetRprimIds()) {
+        DeferredRprim& deferred = _deferredRprims[id];
+
+        // The transform of a prototype is relative to its instances, a single box would be drawn
+        // at the wrong place.
+        if (!_sceneDelegate->GetInstancerId(id).IsEmpty()) {
+            continue;
+        }
+
+        const GfRange3d extent = _sceneDelegate->GetExtent(id);
+        if (extent.IsEmpty() || !_sceneDelegate->GetVisible(id)) {
+            continue;
+        }
+
+        // Scale and move the unit cube to the extent, like the bbox repr of the rprims does. The
+        // root transform is applied by _PromoteDeferredRprims(), as it can change while loading.
+        deferred._cubeTransform = GfMatrix4d(1.0).SetScale(extent.GetSize())
+            * GfMatrix4d(1.0).SetTranslate(extent.GetMidpoint()) * _sceneDelegate->GetTransform(id)
+            * rootInverse;
+        deferred._renderTag = _sceneDelegate->GetRenderTag(id);
+
+        MHWRender::MRenderItem* const renderItem = MHWRender::MRenderItem::Create(
+            MString(id.GetText()) + "_placeholder",
+            MHWRender::MRenderItem::DecorationItem,
+            MHWRender::MGeometry::kLines);
+        renderItem->castsShadows(false);
+        renderItem->receivesShadows(false);
+        renderItem->setShader(shader);
+        renderItem->setSelectionMask(MSelectionMask());
+        renderItem->enable(false);
+
+        container->add(renderItem);
+        setGeometryForRenderItem(*renderItem, vertexBuffers, indexBuffer, &unitBounds);
+
+        deferred._placeholder = renderItem;
     }
 
-    state = GetActiveSelectionState(path);
-    if (state) {
-        return state->fullySelected ? kFullyActive : kPartiallySelected;
+    _placeholderRootTransform = GfMatrix4d(0.0);
+    _promotionBatchSize = 64;
+}
+
+/*! \brief  Sync the next batch of deferred rprims, starting with the largest on screen.
+
+    The batch size follows the HDVP2_PROGRESSIVE_POPULATION_BUDGET_MS time budget, 30ms by
+    default. The placeholders of the promoted rprims are removed in the frame which commits their
+    geometry. The others follow the purposes drawn by the proxy shape.
+
+    \return The number of promoted rprims.
+*/
+size_t ProxyRenderDelegate::_PromoteDeferredRprims(const MHWRender::MFrameContext& frameContext)
+{
+    if (_deferredRprims.empty()) {
+        return 0;
     }
 
-    return kUnselected;
+    MProfilingScope profilingScope(
+        HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L1, "PromoteDeferredRprims");
+
+    const GfMatrix4d& rootTransform = _sceneDelegate->GetRootTransform();
+    const bool        rootTransformChanged = (rootTransform != _placeholderRootTransform);
+    _placeholderRootTransform = rootTransform;
+
+    const GfMatrix4d rootToClip = rootTransform
+        * GfMatrix4d(frameContext.getMatrix(MHWRender::MFrameContext::kViewProjMtx).matrix);
+    const GfRange3d& unitCube = static_cast<HdVP2RenderDelegate*>(_renderDelegate.get())
+                                    ->GetSharedBBoxGeom()
+                                    .GetRange();
+
+    // Rprims without a placeholder go first, as nothing is drawn for them so far.
+    std::vector<std::pair<double, SdfPath>> candidates;
+    candidates.reserve(_deferredRprims.size());
+    for (auto& entry : _deferredRprims) {
+        DeferredRprim& deferred = entry.second;
+        double         area = 4.0;
+        if (deferred._placeholder) {
+            if (rootTransformChanged) {
+                MMatrix worldMatrix;
+                (deferred._cubeTransform * rootTransform).Get(worldMatrix.matrix);
+                deferred._placeholder->setMatrix(&worldMatrix);
+            }
+
+            const bool enable = DrawRenderTag(deferred._renderTag);
+            if (deferred._placeholder->isEnabled() != enable) {
+                deferred._placeholder->enable(enable);
+            }
+            area = enable ? GetScreenSpaceArea(unitCube, deferred._cubeTransform * rootToClip)
+                          : 0.0;
+        }
+        candidates.emplace_back(area, entry.first);
+    }
+
+    const size_t batchSize = std::min(_promotionBatchSize, candidates.size());
+    std::partial_sort(
+        candidates.begin(),
+        candidates.begin() + batchSize,
+        candidates.end(),
+        [](const std::pair<double, SdfPath>& a, const std::pair<double, SdfPath>& b) {
+            return a.first > b.first;
+        });
+
+    auto* const param = reinterpret_cast<HdVP2RenderParam*>(_renderDelegate->GetRenderParam());
+    MSubSceneContainer* container = param->GetContainer();
+
+    HdChangeTracker& changeTracker = _renderIndex->GetChangeTracker();
+    for (size_t i = 0; i < batchSize; i++) {
+        const SdfPath& id = candidates[i].second;
+
+        const auto it = _deferredRprims.find(id);
+        if (it->second._placeholder && container) {
+            container->remove(it->second._placeholder->name());
+        }
+        _deferredRprims.erase(it);
+
+        // The rprims kept their dirty bits, marking them again puts them back in the dirty list.
+        if (_renderIndex->HasRprim(id)) {
+            changeTracker.MarkRprimDirty(id, MayaPrimCommon::DirtyDisplayMode);
+        }
+    }
+
+    return batchSize;
+}
+
+/*! \brief  Whether the first sync of an rprim is postponed by the progressive population.
+
+    Rprims call this from Sync, which runs in parallel: the deferred rprims only change on the
+    main thread, outside of the Hydra sync.
+*/
+bool ProxyRenderDelegate::IsRprimDeferred(const SdfPath& id) const
+{
+    return !_deferredRprims.empty() && _deferredRprims.count(id) > 0;
+}
+
+//! \brief  Query the selection state of a given prim from the lead selection.
+const HdSelection::PrimSelectionState*
+ProxyRenderDelegate::GetLeadSelectionState(const SdfPath& path) const
+{
+    return GetPrimSelectionState(_leadSelection, path);
+}
+
+//! \brief  Qeury the selection state of a given prim from the active selection.
+const HdSelection::PrimSelectionState*
+ProxyRenderDelegate::GetActiveSelectionState(const SdfPath& path) const
+{
+    return GetPrimSelectionState(_activeSelection, path);
+}
+
+//! \brief  Query the selection status of a given prim.
+HdVP2SelectionStatus ProxyRenderDelegate::GetSelectionStatus(const SdfPath& path) const
+{
+    return ComputeSelectionStatus(_displayStatus, _leadSelection, _activeSelection, path);
 }
 
 //! \brief  Query the wireframe color assigned to the proxy shape.
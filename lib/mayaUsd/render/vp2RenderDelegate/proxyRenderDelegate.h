@@ -18,7 +18,9 @@
 
 #include <mayaUsd/base/api.h>
 
+#include <pxr/base/gf/matrix4d.h>
 #include <pxr/imaging/hd/engine.h>
+#include <pxr/imaging/hd/repr.h>
 #include <pxr/imaging/hd/selection.h>
 #include <pxr/imaging/hd/task.h>
 #include <pxr/pxr.h>
@@ -36,6 +38,10 @@
 #include <maya/MPxSubSceneOverride.h>
 
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 #if defined(WANT_UFE_BUILD)
 #include <ufe/observer.h>
@@ -188,6 +194,15 @@ public:
     MAYAUSD_CORE_PUBLIC
     bool DrawRenderTag(const TfToken& renderTag) const;
 
+    MAYAUSD_CORE_PUBLIC
+    void UpdateRenderTag(const SdfPath& id, const TfToken& renderTag);
+
+    MAYAUSD_CORE_PUBLIC
+    void RemoveRenderTag(const SdfPath& id);
+
+    MAYAUSD_CORE_PUBLIC
+    bool IsRprimDeferred(const SdfPath& id) const;
+
     MAYAUSD_CORE_PUBLIC
     UsdImagingDelegate* GetUsdImagingDelegate() const;
 
@@ -215,8 +230,11 @@ private:
     void _UpdateSelectionStates();
     void _UpdateRenderTags();
     void _ClearRenderDelegate();
-    SdfPathVector
-    _GetFilteredRprims(HdRprimCollection const& collection, TfTokenVector const& renderTags);
+    SdfPathVector _GetRprimsWithRenderTags(TfTokenVector const& renderTags);
+    void          _DeferRprims();
+    size_t        _PromoteDeferredRprims(const MHWRender::MFrameContext& frameContext);
+
+    static void _ViewportDestroyedCallback(const MString& panelName, void* data);
 
     /*! \brief  Hold all data related to the proxy shape.
 
@@ -295,6 +313,16 @@ private:
     //! A collection of Rprims to prepare render data for specified reprs
     std::unique_ptr<HdRprimCollection> _defaultCollection;
 
+    //! The reprs needed by a viewport the proxy shape was drawn in
+    struct _ViewportReprSelector
+    {
+        HdReprSelector _reprSelector;
+        MCallbackId    _destroyedCallbackId { 0 }; //!< Forgets the viewport when it is destroyed
+    };
+
+    //! The reprs needed by each viewport the proxy shape was drawn in, by panel name
+    std::unordered_map<std::string, _ViewportReprSelector> _viewportReprSelectors;
+
     //! The render tag version used the last time render tags were updated
     unsigned int _renderTagVersion { 0 }; // initialized to 1 in HdChangeTracker, so we'll always
                                           // have an invalid version the first update.
@@ -305,6 +333,32 @@ private:
         false
     }; //!< If false the render tags on the dummy render task are not the minimum set of tags.
 
+    std::mutex _renderTagIndexMutex; //!< Protects the render tag index, rprims sync in parallel
+
+    //! The rprims which last synced with each render tag, see UpdateRenderTag()
+    std::unordered_map<TfToken, std::unordered_set<SdfPath, SdfPath::Hash>, TfToken::HashFunctor>
+        _rprimsByRenderTag;
+
+    //! The render tag each rprim last synced with
+    std::unordered_map<SdfPath, TfToken, SdfPath::Hash> _renderTagOfRprim;
+
+    //! An rprim whose first sync is postponed by the progressive population
+    struct DeferredRprim
+    {
+        GfMatrix4d _cubeTransform; //!< Unit cube to the authored extent, under the root transform
+        TfToken    _renderTag;     //!< Render tag of the rprim
+        MHWRender::MRenderItem* _placeholder { nullptr }; //!< Box drawn until the rprim syncs
+    };
+
+    //! The rprims waiting for their first sync, see _DeferRprims()
+    std::unordered_map<SdfPath, DeferredRprim, SdfPath::Hash> _deferredRprims;
+
+    //! The root transform of the scene delegate the placeholders were last moved with
+    GfMatrix4d _placeholderRootTransform { 0.0 };
+
+    //! Number of deferred rprims to sync in the next frame, adjusted to the time budget
+    size_t _promotionBatchSize { 64 };
+
     MHWRender::DisplayStatus _displayStatus {
         MHWRender::kNoStatus
     };                                     //!< The display status of the proxy shape
@@ -0,0 +1,319 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "refinedTopology.h"
+
+#include "debugCodes.h"
+#include "render_delegate.h"
+
+#include <pxr/base/gf/vec2f.h>
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/gf/vec4f.h>
+#include <pxr/base/tf/debug.h>
+#include <pxr/base/tf/getenv.h>
+#include <pxr/base/vt/types.h>
+#include <pxr/imaging/pxOsd/refinerFactory.h>
+#include <pxr/imaging/pxOsd/tokens.h>
+
+#include <maya/MProfiler.h>
+
+#include <opensubdiv/far/primvarRefiner.h>
+#include <opensubdiv/far/stencilTableFactory.h>
+#include <opensubdiv/far/topologyRefiner.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace {
+
+namespace Far = OpenSubdiv::Far;
+
+//! Number of refined values computed by each task
+constexpr int kRefineGrainSize = 4096;
+
+//! \brief  Computes the refined values of the stencils, in parallel for large meshes.
+template <class T>
+VtValue _EvalStencils(const Far::StencilTable& stencils, const VtArray<T>& src)
+{
+    if (src.size() < size_t(stencils.GetNumControlVertices())) {
+        return VtValue();
+    }
+
+    const int* const   sizes = stencils.GetSizes().data();
+    const int* const   offsets = stencils.GetOffsets().data();
+    const int* const   indices = stencils.GetControlIndices().data();
+    const float* const weights = stencils.GetWeights().data();
+    const T* const     source = src.cdata();
+
+    VtArray<T> dst(stencils.GetNumStencils());
+    T* const   dest = dst.data();
+
+    tbb::parallel_for(
+        tbb::blocked_range<int>(0, stencils.GetNumStencils(), kRefineGrainSize),
+        [=](const tbb::blocked_range<int>& range) {
+            for (int i = range.begin(); i < range.end(); i++) {
+                T         value = VtZero<T>();
+                const int end = offsets[i] + sizes[i];
+                for (int j = offsets[i]; j < end; j++) {
+                    value += source[indices[j]] * weights[j];
+                }
+                dest[i] = value;
+            }
+        });
+
+    return VtValue(dst);
+}
+
+//! \brief  Copies src[indices[i]] to the element i of the result.
+template <class T> VtValue _Gather(const VtArray<T>& src, const VtIntArray& indices)
+{
+    VtArray<T> dst(indices.size());
+    for (size_t i = 0; i < indices.size(); i++) {
+        const size_t index = static_cast<unsigned int>(indices[i]);
+        if (index >= src.size()) {
+            return VtValue();
+        }
+        dst[i] = src[index];
+    }
+    return VtValue(dst);
+}
+
+//! \brief  Calls refine with the array held by data, for the supported primvar types.
+template <class REFINE> VtValue _RefineArray(const VtValue& data, const REFINE& refine)
+{
+    if (data.IsHolding<VtFloatArray>()) {
+        return refine(data.UncheckedGet<VtFloatArray>());
+    } else if (data.IsHolding<VtVec2fArray>()) {
+        return refine(data.UncheckedGet<VtVec2fArray>());
+    } else if (data.IsHolding<VtVec3fArray>()) {
+        return refine(data.UncheckedGet<VtVec3fArray>());
+    } else if (data.IsHolding<VtVec4fArray>()) {
+        return refine(data.UncheckedGet<VtVec4fArray>());
+    }
+    return VtValue();
+}
+
+} // anonymous namespace
+
+/*! \brief  Refines a topology uniformly.
+
+    The refinement fails if OpenSubdiv cannot refine the topology, which IsValid() reports.
+*/
+HdVP2RefinedTopology::HdVP2RefinedTopology(const HdMeshTopology& topology, int refineLevel)
+{
+    MProfilingScope profilingScope(
+        HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L2, "RefineTopology");
+
+    // Give each face vertex its own face-varying value, as Hydra flattens face-varying primvars.
+    VtIntArray faceVaryingTopology(topology.GetFaceVertexIndices().size());
+    std::iota(faceVaryingTopology.begin(), faceVaryingTopology.end(), 0);
+
+    PxOsdTopologyRefinerSharedPtr refiner = PxOsdRefinerFactory::Create(
+        topology.GetPxOsdMeshTopology(), std::vector<VtIntArray>(1, faceVaryingTopology));
+    if (!refiner) {
+        return;
+    }
+
+    Far::TopologyRefiner::UniformOptions refineOptions(refineLevel);
+    refineOptions.fullTopologyInLastLevel = true;
+    refiner->RefineUniform(refineOptions);
+
+    // Only the vertices of the last level are needed, directly from the base vertices.
+    Far::StencilTableFactory::Options stencilOptions;
+    stencilOptions.generateIntermediateLevels = false;
+    stencilOptions.generateOffsets = true;
+    stencilOptions.interpolationMode = Far::StencilTableFactory::INTERPOLATE_VERTEX;
+    _vertexStencils.reset(Far::StencilTableFactory::Create(*refiner, stencilOptions));
+    stencilOptions.interpolationMode = Far::StencilTableFactory::INTERPOLATE_VARYING;
+    _varyingStencils.reset(Far::StencilTableFactory::Create(*refiner, stencilOptions));
+    stencilOptions.interpolationMode = Far::StencilTableFactory::INTERPOLATE_FACE_VARYING;
+    stencilOptions.fvarChannel = 0;
+    _faceVaryingStencils.reset(Far::StencilTableFactory::Create(*refiner, stencilOptions));
+
+    // Follow each base face down to its refined faces, for uniform primvars.
+    std::vector<int>          parentFaces(topology.GetFaceVertexCounts().size());
+    std::vector<int>          childFaces;
+    const Far::PrimvarRefiner primvarRefiner(*refiner);
+    std::iota(parentFaces.begin(), parentFaces.end(), 0);
+    for (int level = 1; level <= refineLevel; level++) {
+        childFaces.resize(refiner->GetLevel(level).GetNumFaces());
+        primvarRefiner.InterpolateFaceUniform(level, parentFaces, childFaces);
+        parentFaces.swap(childFaces);
+    }
+
+    const Far::TopologyLevel& lastLevel = refiner->GetLevel(refineLevel);
+    const int                 numFaces = lastLevel.GetNumFaces();
+
+    VtIntArray faceVertexCounts;
+    VtIntArray faceVertexIndices;
+    faceVertexCounts.reserve(numFaces);
+    faceVertexIndices.reserve(lastLevel.GetNumFaceVertices());
+    _baseFaces.reserve(numFaces);
+    _faceVaryingIndices.reserve(lastLevel.GetNumFaceVertices());
+
+    for (int face = 0; face < numFaces; face++) {
+        if (lastLevel.IsFaceHole(face)) {
+            continue;
+        }
+
+        const Far::ConstIndexArray vertices = lastLevel.GetFaceVertices(face);
+        const Far::ConstIndexArray values = lastLevel.GetFaceFVarValues(face, 0);
+        faceVertexCounts.push_back(vertices.size());
+        for (int i = 0; i < vertices.size(); i++) {
+            faceVertexIndices.push_back(vertices[i]);
+            _faceVaryingIndices.push_back(values[i]);
+        }
+        _baseFaces.push_back(parentFaces[face]);
+    }
+
+    // The refiner reverses the winding of left-handed faces, so the refined faces are right-handed.
+    _topology = HdMeshTopology(
+        topology.GetScheme(),
+        PxOsdOpenSubdivTokens->rightHanded,
+        faceVertexCounts,
+        faceVertexIndices);
+}
+
+HdVP2RefinedTopology::~HdVP2RefinedTopology() = default;
+
+/*! \brief  Whether meshes with a refine level are refined on the CPU.
+
+    Set the HDVP2_USE_CPU_SUBDIVISION environment variable to 1 to enable it.
+*/
+bool HdVP2RefinedTopology::IsEnabled()
+{
+    static const bool enabled = TfGetenvInt("HDVP2_USE_CPU_SUBDIVISION", 0) > 0;
+    return enabled;
+}
+
+/*! \brief  Refines the values of a primvar of the base mesh.
+
+    Float, GfVec2f, GfVec3f and GfVec4f arrays can be refined. Constant and instance primvars
+    are returned as they are.
+
+    \return The refined values, or an empty value if the primvar cannot be refined.
+*/
+VtValue HdVP2RefinedTopology::Refine(const VtValue& data, HdInterpolation interpolation) const
+{
+    VtValue refined;
+
+    switch (interpolation) {
+    case HdInterpolationConstant:
+    case HdInterpolationInstance: return data;
+    case HdInterpolationUniform:
+        refined = _RefineArray(
+            data, [this](const auto& array) { return _Gather(array, _baseFaces); });
+        break;
+    case HdInterpolationVertex:
+        refined = _RefineArray(
+            data, [this](const auto& array) { return _EvalStencils(*_vertexStencils, array); });
+        break;
+    case HdInterpolationVarying:
+        refined = _RefineArray(
+            data, [this](const auto& array) { return _EvalStencils(*_varyingStencils, array); });
+        break;
+    case HdInterpolationFaceVarying:
+        refined = _RefineArray(data, [this](const auto& array) -> VtValue {
+            using ArrayType = typename std::decay<decltype(array)>::type;
+            const VtValue values = _EvalStencils(*_faceVaryingStencils, array);
+            if (values.IsEmpty()) {
+                return values;
+            }
+            return _Gather(values.UncheckedGet<ArrayType>(), _faceVaryingIndices);
+        });
+        break;
+    default: break;
+    }
+
+    if (refined.IsEmpty()) {
+        TF_DEBUG(HDVP2_DEBUG_MESH)
+            .Msg("Cannot refine a primvar of type %s\n", data.GetTypeName().c_str());
+    }
+
+    return refined;
+}
+
+/*! \brief  Returns the cache shared by all the render delegates.
+ */
+HdVP2RefinedTopologyCache& HdVP2RefinedTopologyCache::GetInstance()
+{
+    static HdVP2RefinedTopologyCache instance;
+    return instance;
+}
+
+/*! \brief  Returns the refinement of a topology, refining it unless another mesh did.
+
+    \return The refined topology, or nullptr if the topology cannot be refined.
+*/
+std::shared_ptr<const HdVP2RefinedTopology>
+HdVP2RefinedTopologyCache::Get(const HdMeshTopology& topology, int refineLevel)
+{
+    const size_t hash = topology.ComputeHash();
+
+    std::shared_ptr<Entry> entry;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        const auto range = _entries.equal_range(hash);
+        for (auto it = range.first; it != range.second && !entry; ++it) {
+            std::shared_ptr<Entry> candidate = it->second.lock();
+            if (candidate && candidate->_refineLevel == refineLevel
+                && candidate->_topology == topology) {
+                entry = std::move(candidate);
+            }
+        }
+
+        if (!entry) {
+            entry = std::make_shared<Entry>();
+            entry->_topology = topology;
+            entry->_refineLevel = refineLevel;
+            _entries.emplace(hash, entry);
+
+            if (_entries.size() >= _purgeSize) {
+                for (auto it = _entries.begin(); it != _entries.end();) {
+                    it = it->second.expired() ? _entries.erase(it) : std::next(it);
+                }
+                _purgeSize = std::max<size_t>(64, _entries.size() * 2);
+            }
+        }
+    }
+
+    // Refine outside of the lock: the meshes needing the same topology wait for the result, the
+    // others don't.
+    std::call_once(entry->_refined, [&entry]() {
+        auto refinedTopology
+            = std::make_unique<HdVP2RefinedTopology>(entry->_topology, entry->_refineLevel);
+        if (refinedTopology->IsValid()) {
+            entry->_refinedTopology = std::move(refinedTopology);
+        }
+    });
+
+    if (!entry->_refinedTopology) {
+        return nullptr;
+    }
+
+    // The refined topology keeps the entry alive.
+    return std::shared_ptr<const HdVP2RefinedTopology>(entry, entry->_refinedTopology.get());
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
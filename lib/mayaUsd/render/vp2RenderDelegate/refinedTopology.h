@@ -0,0 +1,113 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef HD_VP2_REFINED_TOPOLOGY
+#define HD_VP2_REFINED_TOPOLOGY
+
+#include <mayaUsd/base/api.h>
+
+#include <pxr/base/vt/array.h>
+#include <pxr/base/vt/value.h>
+#include <pxr/imaging/hd/enums.h>
+#include <pxr/imaging/hd/meshTopology.h>
+#include <pxr/pxr.h>
+
+#include <opensubdiv/far/stencilTable.h>
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/*! \brief  A subdivision mesh topology uniformly refined on the CPU.
+    \class  HdVP2RefinedTopology
+
+    The topology is refined with OpenSubdiv once, and the stencil tables of the refined vertices
+    are kept to refine the primvars of the mesh, which is done again whenever they change. The
+    refined mesh is drawn like any polygonal mesh, so that refined display does not depend on
+    GPU compute support.
+
+    Face-varying primvars are refined through a face-varying channel in which each face vertex
+    has its own value. Uniform primvars are copied to the refined faces of each base face.
+*/
+class MAYAUSD_CORE_PUBLIC HdVP2RefinedTopology
+{
+public:
+    HdVP2RefinedTopology(const HdMeshTopology& topology, int refineLevel);
+    ~HdVP2RefinedTopology();
+
+    HdVP2RefinedTopology(const HdVP2RefinedTopology&) = delete;
+    HdVP2RefinedTopology& operator=(const HdVP2RefinedTopology&) = delete;
+
+    static bool IsEnabled();
+
+    //! Whether the topology could be refined
+    bool IsValid() const { return _vertexStencils && _varyingStencils && _faceVaryingStencils; }
+
+    //! The refined polygonal topology, without refine level nor holes
+    const HdMeshTopology& GetTopology() const { return _topology; }
+
+    VtValue Refine(const VtValue& data, HdInterpolation interpolation) const;
+
+private:
+    using StencilTablePtr = std::unique_ptr<const OpenSubdiv::Far::StencilTable>;
+
+    HdMeshTopology  _topology;            //!< Refined topology
+    StencilTablePtr _vertexStencils;      //!< Refined vertices from the base vertices
+    StencilTablePtr _varyingStencils;     //!< Refined vertices from the base varying values
+    StencilTablePtr _faceVaryingStencils; //!< Refined face-varying values from the base ones
+    VtIntArray      _baseFaces;           //!< Base face of each refined face
+    VtIntArray      _faceVaryingIndices;  //!< Refined face-varying value of each face vertex
+};
+
+/*! \brief  Shares the refined topologies between the meshes with identical topology.
+    \class  HdVP2RefinedTopologyCache
+
+    Duplicated meshes, like the characters of a crowd, are refined once. Entries are only kept
+    alive by the meshes using them. The mesh Rprims sync in parallel: the first of them to need
+    a topology refines it, while the others wait for the result.
+*/
+class MAYAUSD_CORE_PUBLIC HdVP2RefinedTopologyCache
+{
+public:
+    static HdVP2RefinedTopologyCache& GetInstance();
+
+    HdVP2RefinedTopologyCache(const HdVP2RefinedTopologyCache&) = delete;
+    HdVP2RefinedTopologyCache& operator=(const HdVP2RefinedTopologyCache&) = delete;
+
+    std::shared_ptr<const HdVP2RefinedTopology>
+    Get(const HdMeshTopology& topology, int refineLevel);
+
+private:
+    HdVP2RefinedTopologyCache() = default;
+
+    //! A base topology and its refinement, built by the first mesh needing it
+    struct Entry
+    {
+        HdMeshTopology                              _topology;          //!< Base topology
+        int                                         _refineLevel { 0 }; //!< Uniform refine level
+        std::once_flag                              _refined;         //!< Guards _refinedTopology
+        std::unique_ptr<const HdVP2RefinedTopology> _refinedTopology; //!< Refined topology
+    };
+
+    std::mutex _mutex; //!< Protects _entries
+    std::unordered_multimap<size_t, std::weak_ptr<Entry>> _entries; //!< Entries by topology hash
+    size_t _purgeSize { 64 }; //!< Number of entries at which expired entries are removed
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif
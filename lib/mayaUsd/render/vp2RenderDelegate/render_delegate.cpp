@@ -24,6 +24,7 @@
 #include "render_pass.h"
 #include "tokens.h"
 
+#include <mayaUsd/render/vp2RenderDelegate/proxyRenderDelegate.h>
 #include <mayaUsd/render/vp2ShaderFragments/shaderFragments.h>
 #include <mayaUsd/utils/hash.h>
 
@@ -39,6 +40,7 @@
 #include <tbb/reader_writer_lock.h>
 #include <tbb/spin_rw_mutex.h>
 
+#include <algorithm>
 #include <unordered_map>
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -612,6 +614,24 @@ HdVP2ResourceRegistry& HdVP2RenderDelegate::GetVP2ResourceRegistry()
     return _resourceRegistryVP2;
 }
 
+/*! \brief  Return the loader of the textures used by the materials of this render delegate.
+ */
+HdVP2TextureLoader& HdVP2RenderDelegate::GetTextureLoader() { return _textureLoader; }
+
+/*! \brief  Return the maximum width and height of the textures, or 0 if they are not limited.
+ */
+int HdVP2RenderDelegate::GetMaxTextureResolution() const { return _maxTextureResolution; }
+
+/*! \brief  Limit the width and height of the textures loaded from now on.
+
+    Larger textures are downsampled when loaded. The materials must be synced again to reload
+    their textures.
+*/
+void HdVP2RenderDelegate::SetMaxTextureResolution(int maxResolution)
+{
+    _maxTextureResolution = std::max(maxResolution, 0);
+}
+
 /*! \brief  Create a renderpass for rendering a given collection.
  */
 HdRenderPassSharedPtr
@@ -691,7 +711,13 @@ HdRprim* HdVP2RenderDelegate::CreateRprim(
 
 /*! \brief  Destroy & deallocate Rprim instance
  */
-void HdVP2RenderDelegate::DestroyRprim(HdRprim* rPrim) { delete rPrim; }
+void HdVP2RenderDelegate::DestroyRprim(HdRprim* rPrim)
+{
+    if (rPrim) {
+        _renderParam->GetDrawScene().RemoveRenderTag(rPrim->GetId());
+    }
+    delete rPrim;
+}
 
 /*! \brief  Request to Allocate and Construct a new, VP2 specialized Sprim.
 
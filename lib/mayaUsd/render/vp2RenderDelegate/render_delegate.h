@@ -19,6 +19,7 @@
 #include "render_param.h"
 #include "resource_registry.h"
 #include "shader.h"
+#include "textureLoader.h"
 
 #include <pxr/imaging/hd/renderDelegate.h>
 #include <pxr/imaging/hd/resourceRegistry.h>
@@ -87,6 +88,11 @@ public:
 
     HdVP2ResourceRegistry& GetVP2ResourceRegistry();
 
+    HdVP2TextureLoader& GetTextureLoader();
+
+    int  GetMaxTextureResolution() const;
+    void SetMaxTextureResolution(int maxResolution);
+
     HdRenderPassSharedPtr
     CreateRenderPass(HdRenderIndex* index, HdRprimCollection const& collection) override;
 
@@ -178,6 +184,8 @@ private:
     SdfPath _id;          //!< Render delegate ID
     HdVP2ResourceRegistry
         _resourceRegistryVP2; //!< VP2 resource registry used for enqueue and execution of commits
+    HdVP2TextureLoader _textureLoader;            //!< Background loader of the material textures
+    int                _maxTextureResolution { 0 }; //!< Maximum texture width and height, or 0
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,670 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "textureLoader.h"
+
+#include <pxr/base/gf/half.h>
+#include <pxr/base/tf/diagnostic.h>
+#include <pxr/base/tf/getenv.h>
+#include <pxr/base/tf/stringUtils.h>
+#include <pxr/imaging/hd/changeTracker.h>
+#include <pxr/imaging/hd/material.h>
+
+#include <maya/MGlobal.h>
+#include <maya/MProfiler.h>
+#include <maya/MViewport2Renderer.h>
+
+#if PXR_VERSION <= 2008
+// Needed for GL_HALF_FLOAT.
+#include <GL/glew.h>
+#endif
+
+#if PXR_VERSION >= 2102
+#include <pxr/imaging/hio/image.h>
+#else
+#include <pxr/imaging/glf/image.h>
+#endif
+
+#include <algorithm>
+#include <thread>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace {
+
+//! Texture manager of the VP2 renderer
+MHWRender::MTextureManager* _GetTextureManager()
+{
+    MHWRender::MRenderer* const renderer = MHWRender::MRenderer::theRenderer();
+    return renderer ? renderer->getTextureManager() : nullptr;
+}
+
+//! Open an image, or one of its mip levels, for reading
+#if PXR_VERSION >= 2102
+HioImageSharedPtr _OpenForReading(const std::string& path, int mip = 0)
+{
+    return HioImage::OpenForReading(path, 0, mip);
+}
+#else
+GlfImageSharedPtr _OpenForReading(const std::string& path, int mip = 0)
+{
+    return GlfImage::OpenForReading(path, 0, mip);
+}
+#endif
+
+} // anonymous namespace
+
+const int HdVP2TextureLoader::sProfilerCategory = MProfiler::addCategory(
+#if MAYA_API_VERSION >= 20190000
+    "HdVP2TextureLoader",
+    "HdVP2TextureLoader"
+#else
+    "HdVP2TextureLoader"
+#endif
+);
+
+/*! \brief  Constructor.
+ */
+HdVP2TextureLoader::HdVP2TextureLoader()
+    : _budget(size_t(std::max(TfGetenvInt("HDVP2_TEXTURE_LOADING_MEMORY_BUDGET_MB", 512), 1)) << 20)
+    , _maxReading(std::max(std::thread::hardware_concurrency(), 1u))
+{
+}
+
+/*! \brief  Destructor, drops the queued reads and waits for the running ones.
+ */
+HdVP2TextureLoader::~HdVP2TextureLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queue.clear();
+    }
+    _tasks.wait();
+}
+
+/*! \brief  Whether textures should be loaded asynchronously.
+ */
+bool HdVP2TextureLoader::IsEnabled()
+{
+    static const bool enabled = TfGetenvInt("HDVP2_ASYNC_TEXTURE_LOADING", 0) > 0;
+    return enabled;
+}
+
+/*! \brief  Returns the name of the VP2 texture loaded from an image with a resolution limit.
+
+    The name is the key of the texture in the cache of the VP2 texture manager, so textures
+    loaded with different limits have different names.
+*/
+std::string HdVP2TextureLoader::GetTextureName(const std::string& path, int maxResolution)
+{
+    return maxResolution > 0 ? TfStringPrintf("%s?maxResolution=%d", path.c_str(), maxResolution)
+                             : path;
+}
+
+/*! \brief  Reads the texels of the image at the specified path.
+
+    The texels are converted to a format supported by VP2. This function does not call into VP2,
+    so it can be used from any thread.
+
+    \param  path            Path of the image file
+    \param  maxResolution   Maximum width and height of the texels, or 0 to read the image at
+                            full resolution. The largest mip level that fits is read if the file
+                            has any, and is downsampled further if needed.
+    \param  data            Receives the texels
+
+    \return False if the image cannot be read, or has a format that is not supported.
+*/
+bool HdVP2TextureLoader::Read(const std::string& path, int maxResolution, HdVP2TextureData& data)
+{
+    auto image = _OpenForReading(path);
+    if (!image) {
+        return false;
+    }
+
+    // Skip the mip levels that are larger than the maximum resolution.
+    if (maxResolution > 0) {
+        const int mipCount = image->GetNumMipLevels();
+        for (int mip = 1;
+             mip < mipCount && std::max(image->GetWidth(), image->GetHeight()) > maxResolution;
+             ++mip) {
+            auto mipImage = _OpenForReading(path, mip);
+            if (!mipImage) {
+                break;
+            }
+            image = mipImage;
+        }
+    }
+
+    // This image is used for loading pixel data from usdz only and should
+    // not trigger any OpenGL call. VP2RenderDelegate will transfer the
+    // texels to GPU memory with VP2 API which is 3D API agnostic.
+#if PXR_VERSION >= 2102
+    HioImage::StorageSpec spec;
+#else
+    GlfImage::StorageSpec spec;
+#endif
+    spec.width = image->GetWidth();
+    spec.height = image->GetHeight();
+    spec.depth = 1;
+#if PXR_VERSION >= 2102
+    spec.format = image->GetFormat();
+#elif PXR_VERSION > 2008
+    spec.hioFormat = image->GetHioFormat();
+#else
+    spec.format = image->GetFormat();
+    spec.type = image->GetType();
+#endif
+    spec.flipped = false;
+
+    // The image resizes the texels as they are read when the storage has a different size.
+    if (maxResolution > 0 && std::max(spec.width, spec.height) > maxResolution) {
+        const double scale = double(maxResolution) / std::max(spec.width, spec.height);
+        spec.width = std::max(1, int(spec.width * scale + 0.5));
+        spec.height = std::max(1, int(spec.height * scale + 0.5));
+    }
+
+    const int bpp = image->GetBytesPerPixel();
+    const int bytesPerRow = spec.width * bpp;
+    const int bytesPerSlice = bytesPerRow * spec.height;
+
+    std::vector<unsigned char> storage(bytesPerSlice);
+    spec.data = storage.data();
+
+    if (!image->Read(spec)) {
+        return false;
+    }
+
+    MHWRender::MTextureDescription& desc = data._desc;
+    desc.setToDefault2DTexture();
+    desc.fWidth = spec.width;
+    desc.fHeight = spec.height;
+    desc.fBytesPerRow = bytesPerRow;
+    desc.fBytesPerSlice = bytesPerSlice;
+
+    std::vector<unsigned char>& texels = data._texels;
+    data._isColorSpaceSRGB = false;
+
+#if PXR_VERSION > 2008
+#if PXR_VERSION >= 2102
+    auto specFormat = spec.format;
+#else
+    auto specFormat = spec.hioFormat;
+#endif
+    switch (specFormat) {
+    // Single Channel
+    case HioFormatFloat32:
+        desc.fFormat = MHWRender::kR32_FLOAT;
+        texels = std::move(storage);
+        break;
+    case HioFormatFloat16:
+        desc.fFormat = MHWRender::kR16_FLOAT;
+        texels = std::move(storage);
+        break;
+    case HioFormatUNorm8:
+        desc.fFormat = MHWRender::kR8_UNORM;
+        texels = std::move(storage);
+        break;
+
+    // Dual channel (quite rare, but seen with mono + alpha files)
+    case HioFormatFloat32Vec2:
+        desc.fFormat = MHWRender::kR32G32_FLOAT;
+        texels = std::move(storage);
+        break;
+    case HioFormatFloat16Vec2: {
+        // R16G16 is not supported by VP2. Converted to R16G16B16A16.
+        constexpr int bpp_8 = 8;
+
+        desc.fFormat = MHWRender::kR16G16B16A16_FLOAT;
+        desc.fBytesPerRow = spec.width * bpp_8;
+        desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
+
+        texels.resize(desc.fBytesPerSlice);
+
+        for (int y = 0; y < spec.height; y++) {
+            for (int x = 0; x < spec.width; x++) {
+                const int t = spec.width * y + x;
+                texels[t * bpp_8 + 0] = storage[t * bpp + 0];
+                texels[t * bpp_8 + 1] = storage[t * bpp + 1];
+                texels[t * bpp_8 + 2] = storage[t * bpp + 0];
+                texels[t * bpp_8 + 3] = storage[t * bpp + 1];
+                texels[t * bpp_8 + 4] = storage[t * bpp + 0];
+                texels[t * bpp_8 + 5] = storage[t * bpp + 1];
+                texels[t * bpp_8 + 6] = storage[t * bpp + 2];
+                texels[t * bpp_8 + 7] = storage[t * bpp + 3];
+            }
+        }
+        break;
+    }
+    case HioFormatUNorm8Vec2:
+    case HioFormatUNorm8Vec2srgb: {
+        // R8G8 is not supported by VP2. Converted to R8G8B8A8.
+        constexpr int bpp_4 = 4;
+
+        desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
+        desc.fBytesPerRow = spec.width * bpp_4;
+        desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
+
+        texels.resize(desc.fBytesPerSlice);
+
+        for (int y = 0; y < spec.height; y++) {
+            for (int x = 0; x < spec.width; x++) {
+                const int t = spec.width * y + x;
+                texels[t * bpp_4] = storage[t * bpp];
+                texels[t * bpp_4 + 1] = storage[t * bpp];
+                texels[t * bpp_4 + 2] = storage[t * bpp];
+                texels[t * bpp_4 + 3] = storage[t * bpp + 1];
+            }
+        }
+
+        data._isColorSpaceSRGB = image->IsColorSpaceSRGB();
+        break;
+    }
+
+    // 3-Channel
+    case HioFormatFloat32Vec3:
+        desc.fFormat = MHWRender::kR32G32B32_FLOAT;
+        texels = std::move(storage);
+        break;
+    case HioFormatFloat16Vec3: {
+        // R16G16B16 is not supported by VP2. Converted to R16G16B16A16.
+        constexpr int bpp_8 = 8;
+
+        desc.fFormat = MHWRender::kR16G16B16A16_FLOAT;
+        desc.fBytesPerRow = spec.width * bpp_8;
+        desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
+
+        GfHalf               opaqueAlpha(1.0f);
+        const unsigned short alphaBits = opaqueAlpha.bits();
+        const unsigned char  lowAlpha = reinterpret_cast<const unsigned char*>(&alphaBits)[0];
+        const unsigned char  highAlpha = reinterpret_cast<const unsigned char*>(&alphaBits)[1];
+
+        texels.resize(desc.fBytesPerSlice);
+
+        for (int y = 0; y < spec.height; y++) {
+            for (int x = 0; x < spec.width; x++) {
+                const int t = spec.width * y + x;
+                texels[t * bpp_8 + 0] = storage[t * bpp + 0];
+                texels[t * bpp_8 + 1] = storage[t * bpp + 1];
+                texels[t * bpp_8 + 2] = storage[t * bpp + 2];
+                texels[t * bpp_8 + 3] = storage[t * bpp + 3];
+                texels[t * bpp_8 + 4] = storage[t * bpp + 4];
+                texels[t * bpp_8 + 5] = storage[t * bpp + 5];
+                texels[t * bpp_8 + 6] = lowAlpha;
+                texels[t * bpp_8 + 7] = highAlpha;
+            }
+        }
+        break;
+    }
+    case HioFormatFloat16Vec4:
+        desc.fFormat = MHWRender::kR16G16B16A16_FLOAT;
+        texels = std::move(storage);
+        break;
+    case HioFormatUNorm8Vec3:
+    case HioFormatUNorm8Vec3srgb: {
+        // R8G8B8 is not supported by VP2. Converted to R8G8B8A8.
+        constexpr int bpp_4 = 4;
+
+        desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
+        desc.fBytesPerRow = spec.width * bpp_4;
+        desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
+
+        texels.resize(desc.fBytesPerSlice);
+
+        for (int y = 0; y < spec.height; y++) {
+            for (int x = 0; x < spec.width; x++) {
+                const int t = spec.width * y + x;
+                texels[t * bpp_4] = storage[t * bpp];
+                texels[t * bpp_4 + 1] = storage[t * bpp + 1];
+                texels[t * bpp_4 + 2] = storage[t * bpp + 2];
+                texels[t * bpp_4 + 3] = 255;
+            }
+        }
+
+        data._isColorSpaceSRGB = image->IsColorSpaceSRGB();
+        break;
+    }
+
+    // 4-Channel
+    case HioFormatFloat32Vec4:
+        desc.fFormat = MHWRender::kR32G32B32A32_FLOAT;
+        texels = std::move(storage);
+        break;
+    case HioFormatUNorm8Vec4:
+    case HioFormatUNorm8Vec4srgb:
+        desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
+        data._isColorSpaceSRGB = image->IsColorSpaceSRGB();
+        texels = std::move(storage);
+        break;
+    default:
+        TF_WARN(
+            "VP2 renderer delegate: unsupported pixel format (%d) in texture file %s.",
+            (int)specFormat,
+            path.c_str());
+        return false;
+    }
+#else
+    switch (spec.format) {
+    case GL_RED:
+        desc.fFormat = MHWRender::kR8_UNORM;
+        if (spec.type == GL_FLOAT)
+            desc.fFormat = MHWRender::kR32_FLOAT;
+        else if (spec.type == GL_HALF_FLOAT)
+            desc.fFormat = MHWRender::kR16_FLOAT;
+        texels = std::move(storage);
+        break;
+    case GL_RGB:
+        if (spec.type == GL_FLOAT) {
+            desc.fFormat = MHWRender::kR32G32B32_FLOAT;
+            texels = std::move(storage);
+        } else if (spec.type == GL_HALF_FLOAT) {
+            // R16G16B16 is not supported by VP2. Converted to R16G16B16A16.
+            constexpr int bpp_8 = 8;
+
+            desc.fFormat = MHWRender::kR16G16B16A16_FLOAT;
+            desc.fBytesPerRow = spec.width * bpp_8;
+            desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
+
+            GfHalf               opaqueAlpha(1.0f);
+            const unsigned short alphaBits = opaqueAlpha.bits();
+            const unsigned char  lowAlpha = reinterpret_cast<const unsigned char*>(&alphaBits)[0];
+            const unsigned char  highAlpha = reinterpret_cast<const unsigned char*>(&alphaBits)[1];
+
+            texels.resize(desc.fBytesPerSlice);
+
+            for (int y = 0; y < spec.height; y++) {
+                for (int x = 0; x < spec.width; x++) {
+                    const int t = spec.width * y + x;
+                    texels[t * bpp_8 + 0] = storage[t * bpp + 0];
+                    texels[t * bpp_8 + 1] = storage[t * bpp + 1];
+                    texels[t * bpp_8 + 2] = storage[t * bpp + 2];
+                    texels[t * bpp_8 + 3] = storage[t * bpp + 3];
+                    texels[t * bpp_8 + 4] = storage[t * bpp + 4];
+                    texels[t * bpp_8 + 5] = storage[t * bpp + 5];
+                    texels[t * bpp_8 + 6] = lowAlpha;
+                    texels[t * bpp_8 + 7] = highAlpha;
+                }
+            }
+        } else {
+            // R8G8B8 is not supported by VP2. Converted to R8G8B8A8.
+            constexpr int bpp_4 = 4;
+
+            desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
+            desc.fBytesPerRow = spec.width * bpp_4;
+            desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
+
+            texels.resize(desc.fBytesPerSlice);
+
+            for (int y = 0; y < spec.height; y++) {
+                for (int x = 0; x < spec.width; x++) {
+                    const int t = spec.width * y + x;
+                    texels[t * bpp_4] = storage[t * bpp];
+                    texels[t * bpp_4 + 1] = storage[t * bpp + 1];
+                    texels[t * bpp_4 + 2] = storage[t * bpp + 2];
+                    texels[t * bpp_4 + 3] = 255;
+                }
+            }
+
+            data._isColorSpaceSRGB = image->IsColorSpaceSRGB();
+        }
+        break;
+    case GL_RGBA:
+        if (spec.type == GL_FLOAT) {
+            desc.fFormat = MHWRender::kR32G32B32A32_FLOAT;
+        } else if (spec.type == GL_HALF_FLOAT) {
+            desc.fFormat = MHWRender::kR16G16B16A16_FLOAT;
+        } else {
+            desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
+            data._isColorSpaceSRGB = image->IsColorSpaceSRGB();
+        }
+        texels = std::move(storage);
+        break;
+    default: return false;
+    }
+#endif
+
+    return true;
+}
+
+/*! \brief  Uploads the texels to a new VP2 texture with the specified name.
+
+    Must be called from the main thread.
+*/
+MHWRender::MTexture*
+HdVP2TextureLoader::Upload(const std::string& name, const HdVP2TextureData& data)
+{
+    MProfilingScope profilingScope(
+        sProfilerCategory, MProfiler::kColorD_L2, "UploadTexture", name.c_str());
+
+    MHWRender::MTextureManager* const textureMgr = _GetTextureManager();
+    if (!TF_VERIFY(textureMgr)) {
+        return nullptr;
+    }
+
+    return textureMgr->acquireTexture(name.c_str(), data._desc, data._texels.data());
+}
+
+/*! \brief  Requests the texture at the specified path for a material.
+
+    Must be called from the main thread. The first request of a texture starts reading it in
+    the background and returns Status::Loading. Once it has been read, the material is marked
+    dirty and the next request uploads the texture and returns it.
+
+    \param  path                Path of the image file
+    \param  maxResolution       Maximum width and height of the texture, or 0 for full resolution
+    \param  materialId          Material to sync again once the texture has been read
+    \param  texture             Set to the texture, with a new reference, when it is loaded
+    \param  isColorSpaceSRGB    Set to whether sRGB linearization is needed, when it is loaded
+*/
+HdVP2TextureLoader::Status HdVP2TextureLoader::Load(
+    const std::string&    path,
+    int                   maxResolution,
+    const SdfPath&        materialId,
+    MHWRender::MTexture** texture,
+    bool*                 isColorSpaceSRGB)
+{
+    const std::string name = GetTextureName(path, maxResolution);
+
+    HdVP2TextureData data;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _entries.find(name);
+        if (it == _entries.end()) {
+            // The texture may have been uploaded for another material already.
+            MHWRender::MTextureManager* const textureMgr = _GetTextureManager();
+            MHWRender::MTexture* const found
+                = textureMgr ? textureMgr->findTexture(name.c_str()) : nullptr;
+            if (found) {
+                const auto uploadedIt = _uploaded.find(name);
+                if (uploadedIt != _uploaded.end()) {
+                    uploadedIt->second._materials.insert(materialId);
+                    *texture = found;
+                    *isColorSpaceSRGB = uploadedIt->second._isColorSpaceSRGB;
+                    return Status::Loaded;
+                }
+                // The texture is still cached by VP2 but its sRGB flag is unknown, either because
+                // all the materials released it or because it was not loaded here: read it again.
+                textureMgr->releaseTexture(found);
+            }
+
+            it = _entries.emplace(name, _Entry()).first;
+            it->second._path = path;
+            it->second._maxResolution = maxResolution;
+            _queue.push_back(name);
+        }
+
+        _Entry& entry = it->second;
+        switch (entry._state) {
+        case _State::Queued:
+        case _State::Reading:
+            entry._materials.insert(materialId);
+            _Dispatch();
+            return Status::Loading;
+        case _State::Failed:
+            // Keep the entry for the other materials, so that the image isn't read again.
+            entry._materials.erase(materialId);
+            if (entry._materials.empty()) {
+                _entries.erase(it);
+            }
+            return Status::Failed;
+        case _State::Read:
+            data = std::move(entry._data);
+            _residentBytes -= data._texels.size();
+            _entries.erase(it);
+            _Dispatch();
+            break;
+        }
+    }
+
+    *texture = Upload(name, data);
+    *isColorSpaceSRGB = data._isColorSpaceSRGB;
+    if (!*texture) {
+        return Status::Failed;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _Uploaded&                  uploaded = _uploaded[name];
+    uploaded._isColorSpaceSRGB = data._isColorSpaceSRGB;
+    uploaded._materials.insert(materialId);
+    return Status::Loaded;
+}
+
+/*! \brief  Drops the reference of a material to a texture returned by Load(), or that it waits for.
+
+    The sRGB flag of the texture is forgotten once no material uses it anymore. A texture that no
+    material waits for anymore is dropped, along with its texels if it has been read already. Must
+    be called when the material releases the texture, stops using it, or is deleted.
+*/
+void HdVP2TextureLoader::Release(
+    const std::string& path,
+    int                maxResolution,
+    const SdfPath&     materialId)
+{
+    const std::string name = GetTextureName(path, maxResolution);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const auto uploadedIt = _uploaded.find(name);
+    if (uploadedIt != _uploaded.end()) {
+        uploadedIt->second._materials.erase(materialId);
+        if (uploadedIt->second._materials.empty()) {
+            _uploaded.erase(uploadedIt);
+        }
+    }
+
+    const auto entryIt = _entries.find(name);
+    if (entryIt != _entries.end()) {
+        _Entry& entry = entryIt->second;
+        entry._materials.erase(materialId);
+
+        // Textures being read are dropped once the read completes.
+        if (entry._materials.empty() && entry._state != _State::Reading) {
+            _residentBytes -= entry._data._texels.size();
+            _entries.erase(entryIt);
+            _Dispatch();
+        }
+    }
+}
+
+/*! \brief  Marks dirty the materials waiting for the textures that have been read.
+
+    Must be called from the main thread, before syncing the render index.
+*/
+void HdVP2TextureLoader::MarkLoadedMaterialsDirty(HdChangeTracker& changeTracker)
+{
+    _refreshQueued = false;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (const std::string& name : _loaded) {
+        const auto it = _entries.find(name);
+        if (it != _entries.end()) {
+            for (const SdfPath& materialId : it->second._materials) {
+                changeTracker.MarkSprimDirty(materialId, HdMaterial::DirtyParams);
+            }
+        }
+    }
+    _loaded.clear();
+}
+
+/*! \brief  Starts reading the queued textures, within the memory budget.
+
+    Must be called with the mutex locked.
+*/
+void HdVP2TextureLoader::_Dispatch()
+{
+    while (!_queue.empty() && _reading < _maxReading && _residentBytes < _budget) {
+        const std::string name = std::move(_queue.front());
+        _queue.pop_front();
+
+        // Skip the textures that have been dropped while queued.
+        const auto it = _entries.find(name);
+        if (it == _entries.end() || it->second._state != _State::Queued) {
+            continue;
+        }
+
+        _Entry& entry = it->second;
+        entry._state = _State::Reading;
+        ++_reading;
+
+        const std::string path = entry._path;
+        const int         maxResolution = entry._maxResolution;
+        _tasks.run([this, name, path, maxResolution]() { _Read(name, path, maxResolution); });
+    }
+}
+
+/*! \brief  Reads a texture on a worker thread.
+ */
+void HdVP2TextureLoader::_Read(const std::string& name, const std::string& path, int maxResolution)
+{
+    HdVP2TextureData data;
+    bool             success = false;
+    {
+        MProfilingScope profilingScope(
+            sProfilerCategory, MProfiler::kColorD_L2, "ReadTexture", path.c_str());
+
+        success = Read(path, maxResolution, data);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        --_reading;
+
+        const auto it = _entries.find(name);
+        if (it != _entries.end()) {
+            if (it->second._materials.empty()) {
+                _entries.erase(it);
+            } else {
+                _Entry& entry = it->second;
+                entry._state = success ? _State::Read : _State::Failed;
+                if (success) {
+                    _residentBytes += data._texels.size();
+                    entry._data = std::move(data);
+                }
+                _loaded.push_back(name);
+            }
+        }
+
+        _Dispatch();
+    }
+
+    // Let the viewport pick up the texture. Refreshes are coalesced until the next sync.
+    if (!_refreshQueued.exchange(true)) {
+        MGlobal::executeCommandOnIdle("refresh -force", false);
+    }
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,166 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef HD_VP2_TEXTURE_LOADER
+#define HD_VP2_TEXTURE_LOADER
+
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+
+#include <maya/MTextureManager.h>
+
+#include <tbb/task_group.h>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+class HdChangeTracker;
+
+/*! \brief  Texels read from an image file, converted to a format supported by VP2.
+ */
+struct HdVP2TextureData
+{
+    MHWRender::MTextureDescription _desc;                       //!< Description of the texels
+    std::vector<unsigned char>     _texels;                     //!< Texels, as described
+    bool                           _isColorSpaceSRGB { false }; //!< Whether to linearize sRGB
+};
+
+/*! \brief  Loads textures on worker threads for HdVP2Material.
+    \class  HdVP2TextureLoader
+
+    Reading and converting the texels of an image is done on TBB worker threads. Only the upload
+    to VP2 happens on the main thread, when the material requesting the texture syncs again.
+    While the texture is loading, the material binds a placeholder texture.
+
+    Once a texture is read, a viewport refresh is queued and the materials waiting for it are
+    marked dirty before the next sync, see MarkLoadedMaterialsDirty().
+
+    Textures can be loaded with a maximum resolution, in which case they are downsampled as they
+    are read. Each resolution limit gives a distinct VP2 texture, see GetTextureName().
+
+    The texels that have been read but not uploaded yet are bounded by a memory budget: no new
+    read is started while they exceed it. The reads already running may still add one texture
+    each on top of the budget.
+
+    Asynchronous loading is enabled by setting the HDVP2_ASYNC_TEXTURE_LOADING environment
+    variable to 1. The memory budget is set in megabytes with the
+    HDVP2_TEXTURE_LOADING_MEMORY_BUDGET_MB environment variable, and defaults to 512.
+*/
+class HdVP2TextureLoader
+{
+public:
+    //! Loading status of a requested texture
+    enum class Status
+    {
+        Loading, //!< The texture is being read, a placeholder should be used meanwhile
+        Loaded,  //!< The texture has been uploaded to VP2
+        Failed   //!< The texture could not be read
+    };
+
+    HdVP2TextureLoader();
+    ~HdVP2TextureLoader();
+
+    HdVP2TextureLoader(const HdVP2TextureLoader&) = delete;
+    HdVP2TextureLoader& operator=(const HdVP2TextureLoader&) = delete;
+
+    //! Whether textures are loaded asynchronously, see HDVP2_ASYNC_TEXTURE_LOADING
+    static bool IsEnabled();
+
+    //! Name of the VP2 texture loaded from an image with a resolution limit
+    static std::string GetTextureName(const std::string& path, int maxResolution);
+
+    //! Reads and converts the texels of an image, from any thread
+    static bool Read(const std::string& path, int maxResolution, HdVP2TextureData& data);
+
+    //! Uploads texels to a new VP2 texture, from the main thread
+    static MHWRender::MTexture* Upload(const std::string& name, const HdVP2TextureData& data);
+
+    //! Requests a texture for a material, starting to read it in the background if needed
+    Status Load(
+        const std::string&    path,
+        int                   maxResolution,
+        const SdfPath&        materialId,
+        MHWRender::MTexture** texture,
+        bool*                 isColorSpaceSRGB);
+
+    //! Drops the reference of a material to a texture returned by Load(), or that it waits for
+    void Release(const std::string& path, int maxResolution, const SdfPath& materialId);
+
+    //! Marks dirty the materials waiting for the textures read since the last call
+    void MarkLoadedMaterialsDirty(HdChangeTracker& changeTracker);
+
+    static const int sProfilerCategory; //!< Profiler category
+
+private:
+    //! State of a texture that is not uploaded yet
+    enum class _State
+    {
+        Queued,
+        Reading,
+        Read,
+        Failed
+    };
+
+    //! A texture that is not uploaded yet
+    struct _Entry
+    {
+        _State                                     _state { _State::Queued };
+        std::string                                _path;                //!< Path of the image
+        int                                        _maxResolution { 0 }; //!< Resolution limit
+        HdVP2TextureData                           _data;
+        std::unordered_set<SdfPath, SdfPath::Hash> _materials; //!< Materials waiting for it
+    };
+
+    //! A texture uploaded by the loader
+    struct _Uploaded
+    {
+        bool _isColorSpaceSRGB { false }; //!< Whether to linearize sRGB, which VP2 does not keep
+        std::unordered_set<SdfPath, SdfPath::Hash> _materials; //!< Materials using it
+    };
+
+    void _Dispatch();
+    void _Read(const std::string& name, const std::string& path, int maxResolution);
+
+    std::mutex _mutex; //!< Protects everything below, up to the task group
+
+    //! Textures not uploaded yet, by texture name
+    std::unordered_map<std::string, _Entry> _entries;
+    std::deque<std::string>                 _queue;  //!< Textures waiting for a worker
+    std::vector<std::string>                _loaded; //!< Textures read since the last sync
+
+    //! Textures uploaded and still used by a material, by texture name
+    std::unordered_map<std::string, _Uploaded> _uploaded;
+
+    size_t _residentBytes { 0 }; //!< Size of the texels read but not uploaded
+    size_t _reading { 0 };       //!< Number of textures being read
+
+    const size_t _budget;     //!< Memory budget, in bytes
+    const size_t _maxReading; //!< Maximum number of textures read concurrently
+
+    std::atomic_bool _refreshQueued { false }; //!< Whether a viewport refresh is pending
+
+    tbb::task_group _tasks; //!< Running reads
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif
@@ -182,10 +182,14 @@ ProxyShapeHierarchy::createUFEChildList(const UsdPrimSiblingRange& range, bool f
     // single component appended to it.
     auto               parentPath = fItem->path();
     Ufe::SceneItemList children;
-    UFE_V3(std::string dagPathStr;)
+#ifdef UFE_V3_FEATURES_AVAILABLE
+    std::string dagPathStr;
+    auto&       primUpdaterManager = PXR_NS::PrimUpdaterManager::getInstance();
+    const bool  hasPulledPrims = primUpdaterManager.hasPulledPrims(getUsdRootPrim().GetStage());
+#endif
     for (const auto& child : range) {
 #ifdef UFE_V3_FEATURES_AVAILABLE
-        if (PXR_NS::PrimUpdaterManager::readPullInformation(child, dagPathStr)) {
+        if (hasPulledPrims && primUpdaterManager.findPulledPrim(child, dagPathStr)) {
             auto item = Ufe::Hierarchy::createItem(Ufe::PathString::path(dagPathStr));
             if (TF_VERIFY(item, "No item for pulled path '%s'\n", dagPathStr.c_str())) {
                 children.emplace_back(item);
@@ -23,12 +23,14 @@
 #ifdef UFE_V2_FEATURES_AVAILABLE
 #include <mayaUsd/ufe/UsdCamera.h>
 #endif
+#include <mayaUsd/ufe/UsdHierarchy.h>
 #include <mayaUsd/ufe/UsdStageMap.h>
 #include <mayaUsd/ufe/Utils.h>
 #ifdef UFE_V2_FEATURES_AVAILABLE
 #include <mayaUsd/undo/UsdUndoManager.h>
 #endif
 
+#include <pxr/base/tf/getenv.h>
 #include <pxr/pxr.h>
 #include <pxr/usd/usd/prim.h>
 #include <pxr/usd/usdGeom/pointInstancer.h>
@@ -133,6 +135,64 @@ void sendObjectPostDelete(const Ufe::SceneItem::Ptr& sceneItem)
 #endif
 }
 
+// Number of resynced paths in a single USD notice above which the scene notifications are batched.
+// Set the MAYAUSD_UFE_BATCH_RESYNC_THRESHOLD environment variable to 0 to never batch them.
+size_t batchResyncThreshold()
+{
+    static const int threshold = TfGetenvInt("MAYAUSD_UFE_BATCH_RESYNC_THRESHOLD", 100);
+    return threshold > 0 ? static_cast<size_t>(threshold) : std::numeric_limits<size_t>::max();
+}
+
+// Send the scene notifications for many resynced prims at once, typically after a layer or variant
+// change. A resync invalidates the whole subtree of a prim, so only the topmost resynced prims are
+// notified. Prims that no longer exist are notified through their closest existing ancestor.
+void sendBatchedResync(
+    const Ufe::Path&     stageUfePath,
+    const UsdStagePtr&   stage,
+    const SdfPathVector& resyncedPrimPaths)
+{
+    SdfPathVector topmostPaths;
+    topmostPaths.reserve(resyncedPrimPaths.size());
+    for (SdfPath path : resyncedPrimPaths) {
+        while (path != SdfPath::AbsoluteRootPath() && !stage->GetPrimAtPath(path)) {
+            path = path.GetParentPath();
+        }
+        topmostPaths.push_back(path);
+    }
+    SdfPath::RemoveDescendentPaths(&topmostPaths);
+
+#ifdef UFE_V2_FEATURES_AVAILABLE
+    Ufe::SceneCompositeNotification notification;
+    bool                            hasItems = false;
+#endif
+    for (const SdfPath& path : topmostPaths) {
+        const Ufe::Path ufePath = (path == SdfPath::AbsoluteRootPath())
+            ? stageUfePath
+            : stageUfePath + MayaUsd::ufe::usdPathToUfePathSegment(path);
+        auto sceneItem = Ufe::Hierarchy::createItem(ufePath);
+        if (!sceneItem)
+            continue;
+
+#ifdef UFE_V2_FEATURES_AVAILABLE
+        notification.appendSubtreeInvalidate(sceneItem);
+        hasItems = true;
+#else
+        // In Ufe v1 there was no subtree invalidate notif. So we mimic it by sending
+        // delete/add notifs.
+        sendObjectPostDelete(sceneItem);
+        sendObjectAdd(sceneItem);
+#endif
+    }
+
+#ifdef UFE_V2_FEATURES_AVAILABLE
+    // A single notification for the whole batch, so that observers such as the Outliner only
+    // refresh once.
+    if (hasItems) {
+        Ufe::Scene::instance().notify(notification);
+    }
+#endif
+}
+
 } // namespace
 
 namespace MAYAUSD_NS_DEF {
@@ -142,7 +202,6 @@ namespace ufe {
 // Global variables & macros
 //------------------------------------------------------------------------------
 extern UsdStageMap g_StageMap;
-extern Ufe::Rtid   g_USDRtid;
 
 //------------------------------------------------------------------------------
 // StagesSubject
@@ -254,6 +313,9 @@ void StagesSubject::afterOpen()
     // - convert the Dag paths to UFE paths.
     // - get their stage.
     g_StageMap.setDirty();
+
+    // The cached children were those of the previous stages.
+    UsdHierarchy::invalidateChildListCache();
 }
 
 void StagesSubject::stageChanged(
@@ -261,11 +323,31 @@ void StagesSubject::stageChanged(
     UsdStageWeakPtr const&           sender)
 {
     // If the stage path has not been initialized yet, do nothing
-    if (stagePath(sender).empty())
+    const Ufe::Path stageUfePath = stagePath(sender);
+    if (stageUfePath.empty())
         return;
 
     auto stage = notice.GetStage();
     auto resyncPaths = notice.GetResyncedPaths();
+
+    // Resyncs can add, remove or reorder children.
+    if (!resyncPaths.empty()) {
+        UsdHierarchy::invalidateChildListCache();
+    }
+
+    // Scene items are only created for the scene notifications, which are skipped altogether when
+    // nobody observes the scene.
+#ifdef UFE_V2_FEATURES_AVAILABLE
+    const bool notifyScene = Ufe::Scene::instance().nbObservers() > 0;
+#else
+    const bool notifyScene = true;
+#endif
+
+    // Notifications of our own add, delete and path change operations are always sent one by one.
+    const bool batchResyncs = notifyScene && resyncPaths.size() > batchResyncThreshold()
+        && !InPathChange::inPathChange() && !InAddOrDeleteOperation::inAddOrDeleteOperation();
+    SdfPathVector batchedPrimPaths;
+
     for (auto it = resyncPaths.begin(), end = resyncPaths.end(); it != end; ++it) {
         const auto& changedPath = *it;
         if (changedPath.IsPrimPropertyPath()) {
@@ -273,8 +355,7 @@ void StagesSubject::stageChanged(
             // We need to send some notifs so Maya can update (such as on undo
             // to move the transform manipulator back to original position).
             const TfToken nameToken = changedPath.GetNameToken();
-            auto          usdPrimPathStr = changedPath.GetPrimPath().GetString();
-            auto ufePath = stagePath(sender) + Ufe::PathSegment(usdPrimPathStr, g_USDRtid, '/');
+            auto ufePath = stageUfePath + usdPathToUfePathSegment(changedPath.GetPrimPath());
             if (isTransformChange(nameToken)) {
                 if (!InTransform3dChange::inTransform3dChange()) {
                     Ufe::Transform3d::notify(ufePath);
@@ -291,6 +372,14 @@ void StagesSubject::stageChanged(
         if (changedPath.IsPropertyPath())
             continue;
 
+        if (!notifyScene || InPathChange::inPathChange())
+            continue;
+
+        if (batchResyncs) {
+            batchedPrimPaths.push_back(changedPath);
+            continue;
+        }
+
         // Assume proxy shapes (and thus stages) cannot be instanced.  We can
         // therefore map the stage to a single UFE path.  Lifting this
         // restriction would mean sending one add or delete notification for
@@ -298,15 +387,14 @@ void StagesSubject::stageChanged(
         Ufe::Path ufePath;
         UsdPrim   prim;
         if (changedPath == SdfPath::AbsoluteRootPath()) {
-            ufePath = stagePath(sender);
+            ufePath = stageUfePath;
             prim = stage->GetPseudoRoot();
         } else {
-            const std::string& usdPrimPathStr = changedPath.GetPrimPath().GetString();
-            ufePath = stagePath(sender) + Ufe::PathSegment(usdPrimPathStr, g_USDRtid, '/');
+            ufePath = stageUfePath + usdPathToUfePathSegment(changedPath.GetPrimPath());
             prim = stage->GetPrimAtPath(changedPath);
         }
 
-        if (prim.IsValid() && !InPathChange::inPathChange()) {
+        if (prim.IsValid()) {
             auto sceneItem = Ufe::Hierarchy::createItem(ufePath);
 
             // AL LayerCommands.addSubLayer test will cause Maya to crash
@@ -359,7 +447,7 @@ void StagesSubject::stageChanged(
             }
         }
 #ifdef UFE_V2_FEATURES_AVAILABLE
-        else if (!prim.IsValid() && !InPathChange::inPathChange()) {
+        else {
             Ufe::SceneItem::Ptr sceneItem = Ufe::Hierarchy::createItem(ufePath);
             if (!sceneItem || InAddOrDeleteOperation::inAddOrDeleteOperation()) {
                 Ufe::Scene::instance().notify(Ufe::ObjectDestroyed(ufePath));
@@ -370,12 +458,15 @@ void StagesSubject::stageChanged(
 #endif
     }
 
+    if (!batchedPrimPaths.empty()) {
+        sendBatchedResync(stageUfePath, stage, batchedPrimPaths);
+    }
+
     auto changedInfoOnlyPaths = notice.GetChangedInfoOnlyPaths();
     for (auto it = changedInfoOnlyPaths.begin(), end = changedInfoOnlyPaths.end(); it != end;
          ++it) {
         const auto& changedPath = *it;
-        auto        usdPrimPathStr = changedPath.GetPrimPath().GetString();
-        auto        ufePath = stagePath(sender) + Ufe::PathSegment(usdPrimPathStr, g_USDRtid, '/');
+        auto        ufePath = stageUfePath + usdPathToUfePathSegment(changedPath.GetPrimPath());
 
 #ifdef UFE_V2_FEATURES_AVAILABLE
         bool sendValueChangedFallback = true;
@@ -445,7 +536,7 @@ void StagesSubject::stageChanged(
                         : std::numeric_limits<int>::max();
 
                     for (int instanceIndex = 0; instanceIndex < numIndices; ++instanceIndex) {
-                        const Ufe::Path instanceUfePath = stagePath(sender)
+                        const Ufe::Path instanceUfePath = stageUfePath
                             + usdPathToUfePathSegment(changedPath.GetPrimPath(), instanceIndex);
                         Ufe::Transform3d::notify(instanceUfePath);
                     }
@@ -476,8 +567,7 @@ void StagesSubject::stageChanged(
 #ifdef UFE_V2_FEATURES_AVAILABLE
     // Special case when we are notified, but no paths given.
     if (notice.GetResyncedPaths().empty() && notice.GetChangedInfoOnlyPaths().empty()) {
-        auto                       ufePath = stagePath(sender);
-        Ufe::AttributeValueChanged vc(ufePath, "/");
+        Ufe::AttributeValueChanged vc(stageUfePath, "/");
         Ufe::Attributes::notify(vc);
     }
 #endif
@@ -37,6 +37,7 @@
 #include <cassert>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 
 #ifdef UFE_V2_FEATURES_AVAILABLE
 #include <mayaUsd/ufe/UsdUndoCreateGroupCommand.h>
@@ -84,6 +85,51 @@ UsdPrimSiblingRange getUSDFilteredChildren(
     //
     return prim.GetFilteredChildren(UsdTraverseInstanceProxies(pred));
 }
+
+// Number of parents whose children are cached, above which the cache is cleared.
+constexpr size_t kChildListCacheSize = 1024;
+
+// Child lists built by createUFEChildList(), by parent path. The Outliner asks for the children of
+// an expanded item on every refresh, and building the list of thousands of children is slow. The
+// cache is version-stamped: it is cleared when a stage is resynced or when the set of prims edited
+// as Maya changes.
+struct ChildListCache
+{
+    using ChildLists = std::unordered_map<Ufe::Path, Ufe::SceneItemList>;
+
+    size_t     _version { 1 };
+    size_t     _builtVersion { 0 };
+    size_t     _pulledPrimsVersion { 0 };
+    ChildLists _children;         // children matching MayaUsdPrimDefaultPredicate
+    ChildLists _filteredChildren; // children matching another predicate
+};
+
+ChildListCache& childListCache()
+{
+    static ChildListCache cache;
+    return cache;
+}
+
+// Returns the cached child lists for the current version, clearing them if it changed.
+ChildListCache::ChildLists& cachedChildLists(bool defaultPredicate)
+{
+    ChildListCache& cache = childListCache();
+
+    size_t pulledPrimsVersion = 0;
+#ifdef UFE_V3_FEATURES_AVAILABLE
+    pulledPrimsVersion = PXR_NS::PrimUpdaterManager::getInstance().pulledPrimsVersion();
+#endif
+    if (cache._builtVersion != cache._version || cache._pulledPrimsVersion != pulledPrimsVersion
+        || cache._children.size() + cache._filteredChildren.size() > kChildListCacheSize) {
+        cache._children.clear();
+        cache._filteredChildren.clear();
+        cache._builtVersion = cache._version;
+        cache._pulledPrimsVersion = pulledPrimsVersion;
+    }
+
+    return defaultPredicate ? cache._children : cache._filteredChildren;
+}
+
 } // namespace
 
 namespace MAYAUSD_NS_DEF {
@@ -119,7 +165,13 @@ bool UsdHierarchy::hasChildren() const { return !getUSDFilteredChildren(fItem).e
 
 Ufe::SceneItemList UsdHierarchy::children() const
 {
-    return createUFEChildList(getUSDFilteredChildren(fItem));
+    auto& childLists = cachedChildLists(true);
+    auto  found = childLists.find(fItem->path());
+    if (found != childLists.end()) {
+        return found->second;
+    }
+
+    return childLists[fItem->path()] = createUFEChildList(getUSDFilteredChildren(fItem));
 }
 
 #ifdef UFE_V2_FEATURES_AVAILABLE
@@ -129,10 +181,19 @@ Ufe::SceneItemList UsdHierarchy::filteredChildren(const ChildFilter& childFilter
     //       See UsdHierarchyHandler::childFilter()
     if ((childFilter.size() == 1) && (childFilter.front().name == "InactivePrims")) {
         // See uniqueChildName() for explanation of USD filter predicate.
-        Usd_PrimFlagsPredicate flags = childFilter.front().value
-            ? UsdPrimIsDefined && !UsdPrimIsAbstract
-            : MayaUsdPrimDefaultPredicate;
-        return createUFEChildList(getUSDFilteredChildren(fItem, flags));
+        if (!childFilter.front().value) {
+            return children();
+        }
+
+        auto& childLists = cachedChildLists(false);
+        auto  found = childLists.find(fItem->path());
+        if (found != childLists.end()) {
+            return found->second;
+        }
+
+        Usd_PrimFlagsPredicate flags = UsdPrimIsDefined && !UsdPrimIsAbstract;
+        return childLists[fItem->path()]
+            = createUFEChildList(getUSDFilteredChildren(fItem, flags));
     }
 
     UFE_LOG("Unknown child filter");
@@ -149,10 +210,14 @@ Ufe::SceneItemList UsdHierarchy::createUFEChildList(const UsdPrimSiblingRange& r
     // we expect to receive an empty range in that case, and will return an
     // empty scene item list as a result.
     Ufe::SceneItemList children;
-    UFE_V3(std::string dagPathStr;)
+#ifdef UFE_V3_FEATURES_AVAILABLE
+    std::string dagPathStr;
+    auto&       primUpdaterManager = PXR_NS::PrimUpdaterManager::getInstance();
+    const bool  hasPulledPrims = primUpdaterManager.hasPulledPrims(fItem->prim().GetStage());
+#endif
     for (const auto& child : range) {
 #ifdef UFE_V3_FEATURES_AVAILABLE
-        if (PXR_NS::PrimUpdaterManager::readPullInformation(child, dagPathStr)) {
+        if (hasPulledPrims && primUpdaterManager.findPulledPrim(child, dagPathStr)) {
             auto item = Ufe::Hierarchy::createItem(Ufe::PathString::path(dagPathStr));
             if (TF_VERIFY(item)) {
                 children.emplace_back(item);
@@ -167,6 +232,9 @@ Ufe::SceneItemList UsdHierarchy::createUFEChildList(const UsdPrimSiblingRange& r
     return children;
 }
 
+/*static*/
+void UsdHierarchy::invalidateChildListCache() { ++childListCache()._version; }
+
 Ufe::SceneItem::Ptr UsdHierarchy::parent() const
 {
     // We do not have a special case for point instances here. If fItem
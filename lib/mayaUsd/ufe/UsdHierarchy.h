@@ -59,6 +59,9 @@ public:
 
     UsdSceneItem::Ptr usdSceneItem() const;
 
+    //! Discard the cached child lists, after a change of the USD scene hierarchy.
+    static void invalidateChildListCache();
+
     // Ufe::Hierarchy overrides
     Ufe::SceneItem::Ptr sceneItem() const override;
     bool                hasChildren() const override;
@@ -15,6 +15,7 @@
 //
 #include "UsdObject3d.h"
 
+#include <mayaUsd/nodes/proxyShapeBase.h>
 #include <mayaUsd/ufe/UsdUndoVisibleCommand.h>
 #include <mayaUsd/ufe/Utils.h>
 
@@ -74,6 +75,7 @@ Ufe::BBox3d UsdObject3d::boundingBox() const
     // as the time.
 
     auto path = sceneItem()->path();
+
     auto purposes = getProxyShapePurposes(path);
     // Add in the default purpose.
     purposes.emplace_back(UsdGeomTokens->default_);
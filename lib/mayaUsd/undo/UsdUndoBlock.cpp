@@ -22,10 +22,14 @@
 #include <pxr/usd/sdf/layer.h>
 #include <pxr/usd/usd/prim.h>
 
+#include <algorithm>
+
 namespace MAYAUSD_NS_DEF {
 
 uint32_t UsdUndoBlock::_undoBlockDepth { 0 };
 
+std::vector<std::pair<UsdUndoBlock::ClosingCallback, void*>> UsdUndoBlock::_closingCallbacks;
+
 const MString UsdUndoBlockCmd::commandName { "undoBlockCmd" };
 
 UsdUndoableItem UsdUndoBlockCmd::argUndoItem;
@@ -49,6 +53,15 @@ UsdUndoBlock::~UsdUndoBlock()
 {
     auto& undoManager = UsdUndoManager::instance();
 
+    // run the closing callbacks while the edits are still collected. Callbacks may remove
+    // themselves, so iterate over a copy.
+    if (_undoBlockDepth == 1 && !_closingCallbacks.empty()) {
+        const auto callbacks = _closingCallbacks;
+        for (const auto& callback : callbacks) {
+            callback.first(callback.second);
+        }
+    }
+
     // decrease the depth
     --_undoBlockDepth;
 
@@ -71,6 +84,21 @@ UsdUndoBlock::~UsdUndoBlock()
     TF_DEBUG_MSG(USDMAYA_UNDOSTACK, "--Closed undo block at depth %i\n", _undoBlockDepth);
 }
 
+void UsdUndoBlock::addClosingCallback(ClosingCallback callback, void* clientData)
+{
+    _closingCallbacks.emplace_back(callback, clientData);
+}
+
+void UsdUndoBlock::removeClosingCallback(ClosingCallback callback, void* clientData)
+{
+    _closingCallbacks.erase(
+        std::remove(
+            _closingCallbacks.begin(),
+            _closingCallbacks.end(),
+            std::make_pair(callback, clientData)),
+        _closingCallbacks.end());
+}
+
 void UsdUndoBlockCmd::execute(const UsdUndoableItem& undoableItem)
 {
     argUndoItem = undoableItem;
@@ -25,6 +25,9 @@
 #include <maya/MGlobal.h>
 #include <maya/MPxCommand.h>
 
+#include <utility>
+#include <vector>
+
 PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace MAYAUSD_NS_DEF {
@@ -49,11 +52,24 @@ public:
 
     static uint32_t depth() { return _undoBlockDepth; }
 
+    //! Function called when the outermost undo block is about to close.
+    using ClosingCallback = void (*)(void* clientData);
+
+    //! Registers a callback run when the outermost undo block is about to close, before its
+    //! edits are collected. Edits it makes are collected in the same undoable item, so they are
+    //! undone along with the edits they depend on.
+    static void addClosingCallback(ClosingCallback callback, void* clientData);
+
+    //! Removes a callback registered with addClosingCallback.
+    static void removeClosingCallback(ClosingCallback callback, void* clientData);
+
 private:
     friend class UsdUndoManager;
 
     static uint32_t _undoBlockDepth;
 
+    static std::vector<std::pair<ClosingCallback, void*>> _closingCallbacks;
+
     UsdUndoableItem* _undoItem;
 };
 
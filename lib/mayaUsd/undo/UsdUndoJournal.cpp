@@ -0,0 +1,53 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "UsdUndoJournal.h"
+
+#include "UsdUndoManager.h"
+
+#include <pxr/base/tf/diagnostic.h>
+
+namespace MAYAUSD_NS_DEF {
+
+UsdUndoJournal::UsdUndoJournal(InvertFuncs&& invertFuncs, size_t memorySize)
+    : _invertFuncs(std::move(invertFuncs))
+    , _memorySize(memorySize)
+{
+}
+
+UsdUndoJournal::~UsdUndoJournal() { UsdUndoManager::instance().releaseJournal(*this); }
+
+void UsdUndoJournal::invert() const
+{
+    if (_discarded) {
+        TF_WARN("The USD edits of this undo step were discarded to stay within the undo memory "
+                "budget, they cannot be restored.");
+        return;
+    }
+
+    for (auto it = _invertFuncs.rbegin(); it != _invertFuncs.rend(); ++it) {
+        (*it)();
+    }
+}
+
+void UsdUndoJournal::discard()
+{
+    // release the captured values, not only the functions
+    InvertFuncs().swap(_invertFuncs);
+    _discarded = true;
+}
+
+} // namespace MAYAUSD_NS_DEF
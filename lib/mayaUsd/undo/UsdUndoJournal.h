@@ -0,0 +1,73 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef MAYAUSD_UNDO_UNDOJOURNAL_H
+#define MAYAUSD_UNDO_UNDOJOURNAL_H
+
+#include <mayaUsd/base/api.h>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace MAYAUSD_NS_DEF {
+
+//! \brief UsdUndoJournal
+/*!
+    This class stores the inverse edit functions collected by an UsdUndoBlock, along with an
+    estimate of the memory they hold. Journals are immutable once collected and are shared by the
+    copies of an UsdUndoableItem.
+
+    The UsdUndoManager accounts for the memory of every live journal. When the undo memory budget
+    is exceeded, the oldest journals are discarded: their functions are released and the undo
+    steps holding them no longer restore any USD edit.
+*/
+class MAYAUSD_CORE_PUBLIC UsdUndoJournal
+{
+public:
+    using InvertFunc = std::function<void()>;
+    using InvertFuncs = std::vector<InvertFunc>;
+
+    UsdUndoJournal(InvertFuncs&& invertFuncs, size_t memorySize);
+    ~UsdUndoJournal();
+
+    // delete the copy/move constructors assignment operators.
+    UsdUndoJournal(const UsdUndoJournal&) = delete;
+    UsdUndoJournal& operator=(const UsdUndoJournal&) = delete;
+    UsdUndoJournal(UsdUndoJournal&&) = delete;
+    UsdUndoJournal& operator=(UsdUndoJournal&&) = delete;
+
+    // calls the invert functions in reverse order.
+    void invert() const;
+
+    // estimated number of bytes held by the invert functions.
+    size_t memorySize() const { return _memorySize; }
+
+    bool isDiscarded() const { return _discarded; }
+
+private:
+    friend class UsdUndoManager;
+
+    void discard();
+
+    InvertFuncs _invertFuncs;
+    size_t      _memorySize;
+    bool        _discarded { false };
+};
+
+} // namespace MAYAUSD_NS_DEF
+
+#endif // MAYAUSD_UNDO_UNDOJOURNAL_H
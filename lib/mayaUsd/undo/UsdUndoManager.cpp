@@ -19,8 +19,25 @@
 #include "UsdUndoBlock.h"
 #include "UsdUndoStateDelegate.h"
 
+#include <mayaUsd/base/debugCodes.h>
+#include <mayaUsd/utils/hash.h>
+
+#include <pxr/base/tf/envSetting.h>
+
+#include <algorithm>
+
 PXR_NAMESPACE_USING_DIRECTIVE
 
+namespace {
+
+TF_DEFINE_ENV_SETTING(
+    MAYAUSD_UNDO_MEMORY_BUDGET_MB,
+    0,
+    "Maximum memory held by the USD edits of the undo queue, in megabytes. When exceeded, the "
+    "edits of the oldest undo steps are discarded. 0 means unlimited.");
+
+} // namespace
+
 namespace MAYAUSD_NS_DEF {
 
 UsdUndoManager& UsdUndoManager::instance()
@@ -29,6 +46,11 @@ UsdUndoManager& UsdUndoManager::instance()
     return undoManager;
 }
 
+UsdUndoManager::UsdUndoManager()
+    : _memoryBudget(size_t(std::max(0, TfGetEnvSetting(MAYAUSD_UNDO_MEMORY_BUDGET_MB))) << 20)
+{
+}
+
 void UsdUndoManager::trackLayerStates(const SdfLayerHandle& layer)
 {
     // Check if the layer has already been given a UsdUndoStateDelegate
@@ -40,20 +62,119 @@ void UsdUndoManager::trackLayerStates(const SdfLayerHandle& layer)
     }
 }
 
-void UsdUndoManager::addInverse(InvertFunc func)
+void UsdUndoManager::setMemoryBudget(size_t bytes)
+{
+    _memoryBudget = bytes;
+    enforceMemoryBudget();
+}
+
+bool UsdUndoManager::InverseKey::operator==(const InverseKey& other) const
+{
+    return _delegate == other._delegate && _path == other._path && _fieldName == other._fieldName
+        && _keyPath == other._keyPath && _isTimeSample == other._isTimeSample
+        && _time == other._time;
+}
+
+size_t UsdUndoManager::InverseKeyHash::operator()(const InverseKey& key) const
+{
+    size_t hash = key._path.GetHash();
+    hash_combine(hash, key._delegate);
+    hash_combine(hash, key._fieldName.Hash());
+    hash_combine(hash, key._keyPath.Hash());
+    hash_combine(hash, key._time);
+    return hash;
+}
+
+// Returns true if an inverse restoring the same value was already collected in the current undo
+// block, in which case the caller does not need to collect one. Otherwise the key is recorded and
+// the caller must collect the inverse.
+bool UsdUndoManager::coalesceInverse(const InverseKey& key)
+{
+    if (UsdUndoBlock::depth() == 0) {
+        return false;
+    }
+
+    return !_collectedInverses.insert(key).second;
+}
+
+void UsdUndoManager::addInverse(InvertFunc func, size_t memorySize)
 {
     if (UsdUndoBlock::depth() == 0) {
         TF_CODING_ERROR("Collecting invert functions outside of undoblock is not allowed!");
         return;
     }
 
-    _invertFuncs.emplace_back(func);
+    _invertFuncs.emplace_back(std::move(func));
+    _invertFuncsSize += memorySize;
 }
 
 void UsdUndoManager::transferEdits(UsdUndoableItem& undoableItem)
 {
     // transfer the edits
-    undoableItem._invertFuncs = std::move(_invertFuncs);
+    _invertFuncs.shrink_to_fit();
+    auto journal = std::make_shared<UsdUndoJournal>(std::move(_invertFuncs), _invertFuncsSize);
+    _invertFuncs = InvertFuncs();
+    _invertFuncsSize = 0;
+    _collectedInverses.clear();
+
+    _memoryUsage += journal->memorySize();
+    _journals.push_back(journal);
+    undoableItem._journal = std::move(journal);
+
+    TF_DEBUG_MSG(
+        USDMAYA_UNDOSTACK,
+        "Collected %zu bytes of USD edits, %zu bytes in the undo queue\n",
+        undoableItem.memorySize(),
+        _memoryUsage);
+
+    enforceMemoryBudget();
+}
+
+void UsdUndoManager::releaseJournal(const UsdUndoJournal& journal)
+{
+    if (!journal.isDiscarded()) {
+        _memoryUsage -= journal.memorySize();
+    }
+}
+
+// Discards the oldest journals until the memory usage fits the budget. The most recent journal is
+// always kept, so that the last operation can be undone.
+void UsdUndoManager::enforceMemoryBudget()
+{
+    // Journals released out of order, like those of redo steps dropped from the queue, are only
+    // removed from the front. Sweep them from time to time.
+    if (_journals.size() >= _purgeSize) {
+        _journals.erase(
+            std::remove_if(
+                _journals.begin(),
+                _journals.end(),
+                [](const std::weak_ptr<UsdUndoJournal>& journal) { return journal.expired(); }),
+            _journals.end());
+        _purgeSize = std::max<size_t>(64, _journals.size() * 2);
+    }
+
+    if (_memoryBudget == 0) {
+        return;
+    }
+
+    size_t discarded = 0;
+    while (_memoryUsage > _memoryBudget && _journals.size() > 1) {
+        if (auto journal = _journals.front().lock()) {
+            _memoryUsage -= journal->memorySize();
+            journal->discard();
+            ++discarded;
+        }
+        _journals.pop_front();
+    }
+
+    if (discarded > 0) {
+        TF_DEBUG_MSG(
+            USDMAYA_UNDOSTACK,
+            "Discarded the USD edits of %zu undo steps to fit the undo memory budget, %zu bytes in "
+            "the undo queue\n",
+            discarded,
+            _memoryUsage);
+    }
 }
 
 } // namespace MAYAUSD_NS_DEF
@@ -18,11 +18,15 @@
 #define MAYAUSD_UNDO_UNDOMANAGER_H
 
 #include <mayaUsd/base/api.h>
+#include <mayaUsd/undo/UsdUndoJournal.h>
 #include <mayaUsd/undo/UsdUndoableItem.h>
 
 #include <pxr/usd/sdf/layer.h>
 
+#include <deque>
 #include <functional>
+#include <memory>
+#include <unordered_set>
 #include <vector>
 
 PXR_NAMESPACE_USING_DIRECTIVE
@@ -35,12 +39,18 @@ namespace MAYAUSD_NS_DEF {
     1- tracking layer state changes from UsdUndoStateDelegate
     2- collecting InvertFunc() in every state change
     3- transferring collected edits into an UsdUndoableItem
+    4- keeping the memory held by the undoable items within the undo memory budget
+
+    Only the first inverse restoring a given value is collected in an UsdUndoBlock: undoing the
+    block runs it after the inverses of the later edits of the value, so that it restores the
+    value from before the block by itself. Setting the same attribute repeatedly inside a block,
+    like dragging a manipulator does, collects a single inverse.
 */
 class MAYAUSD_CORE_PUBLIC UsdUndoManager
 {
 public:
-    using InvertFunc = std::function<void()>;
-    using InvertFuncs = std::vector<InvertFunc>;
+    using InvertFunc = UsdUndoJournal::InvertFunc;
+    using InvertFuncs = UsdUndoJournal::InvertFuncs;
 
     // returns an instance of the undo manager.
     static UsdUndoManager& instance();
@@ -54,19 +64,56 @@ public:
     // tracks layer states by spawning a new UsdUndoStateDelegate
     void trackLayerStates(const SdfLayerHandle& layer);
 
+    // estimated number of bytes held by the undoable items.
+    size_t memoryUsage() const { return _memoryUsage; }
+
+    // maximum number of bytes held by the undoable items, 0 when unlimited.
+    size_t memoryBudget() const { return _memoryBudget; }
+    void   setMemoryBudget(size_t bytes);
+
 private:
     friend class UsdUndoStateDelegate;
     friend class UsdUndoBlock;
     friend class UsdUndoableItem;
-
-    UsdUndoManager() = default;
+    friend class UsdUndoJournal;
+
+    //! Identifies the value restored by an inverse: a field, a dictionary value of a field
+    //! (keyPath) or a time sample of a spec of the layer of a state delegate.
+    struct InverseKey
+    {
+        const void* _delegate;
+        SdfPath     _path;
+        TfToken     _fieldName;
+        TfToken     _keyPath;
+        bool        _isTimeSample { false };
+        double      _time { 0.0 };
+
+        bool operator==(const InverseKey& other) const;
+    };
+
+    struct InverseKeyHash
+    {
+        size_t operator()(const InverseKey& key) const;
+    };
+
+    UsdUndoManager();
     ~UsdUndoManager() = default;
 
-    void addInverse(InvertFunc func);
+    bool coalesceInverse(const InverseKey& key);
+    void addInverse(InvertFunc func, size_t memorySize = sizeof(InvertFunc));
     void transferEdits(UsdUndoableItem& undoableItem);
 
+    void releaseJournal(const UsdUndoJournal& journal);
+    void enforceMemoryBudget();
+
 private:
-    InvertFuncs _invertFuncs;
+    InvertFuncs                                    _invertFuncs;
+    size_t                                         _invertFuncsSize { 0 };
+    std::unordered_set<InverseKey, InverseKeyHash> _collectedInverses;
+    std::deque<std::weak_ptr<UsdUndoJournal>>      _journals;
+    size_t                                         _purgeSize { 64 };
+    size_t                                         _memoryUsage { 0 };
+    size_t                                         _memoryBudget { 0 };
 };
 
 } // namespace MAYAUSD_NS_DEF
@@ -20,52 +20,92 @@
 
 #include <mayaUsd/base/debugCodes.h>
 
+#include <pxr/base/tf/type.h>
+#include <pxr/usd/sdf/types.h>
+
 PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace {
 
-void copySpecAtPath(const SdfAbstractData& src, SdfAbstractData* dst, const SdfPath& path)
+// Fixed memory of an inverse: the function, its bound spec path and field name.
+constexpr size_t kInverseSize
+    = sizeof(MAYAUSD_NS::UsdUndoManager::InvertFunc) + sizeof(SdfPath) + sizeof(TfToken) * 2;
+
+// Estimates the number of bytes held by a value, including the elements of arrays and time
+// samples. Arrays shared with the layer are counted too: the layer may release them.
+size_t estimateSize(const VtValue& value)
 {
-    // create a new spec at a path with the given specType
-    dst->CreateSpec(path, src.GetSpecType(path));
+    size_t size = sizeof(VtValue);
+    if (value.IsArrayValued()) {
+        size += value.GetArraySize() * TfType::Find(value.GetElementTypeid()).GetSizeof();
+    } else if (value.IsHolding<SdfTimeSampleMap>()) {
+        for (const auto& sample : value.UncheckedGet<SdfTimeSampleMap>()) {
+            size += sizeof(sample) + estimateSize(sample.second);
+        }
+    } else if (value.IsHolding<std::string>()) {
+        size += value.UncheckedGet<std::string>().capacity();
+    }
+    return size;
+}
 
-    // get the list of tokens
-    const std::vector<TfToken>& tokens = src.List(path);
+} // namespace
 
-    // set the value of dst at the given path and a fieldName
-    for (const auto& token : tokens) {
-        dst->Set(path, token, src.Get(path, token));
-    }
-}
+namespace MAYAUSD_NS_DEF {
 
-// This class is used to copy specs from source SdfAbstractData container
-// to the destination SdfAbstractData container.
-class SpecCopier : public SdfAbstractDataSpecVisitor
+//! \brief The specs of a deleted hierarchy, to restore them on undo.
+/*!
+    The specs are stored in flat arrays rather than in an SdfData, which allocates a hash table
+    entry and a field vector for every spec. Array values are shared with the layer data until
+    either is edited.
+*/
+class UsdUndoStateDelegate::DeletedSpecs
 {
 public:
-    SpecCopier(SdfAbstractData* dst)
-        : _dst(dst)
-    {
-    }
-
-    bool VisitSpec(const SdfAbstractData& src, const SdfPath& path) override
+    DeletedSpecs(const SdfLayerHandle& layer, const SdfAbstractData& data, const SdfPath& path)
     {
-        copySpecAtPath(src, _dst, path);
-        return true;
-    }
-
-    void Done(const SdfAbstractData&) override
+        // children come before their parent, like SdfLayer::Traverse visits them
+        layer->Traverse(path, [&](const SdfPath& specPath) {
+            _paths.push_back(specPath);
+            _specTypes.push_back(data.GetSpecType(specPath));
+            for (const TfToken& fieldName : data.List(specPath)) {
+                _fieldNames.push_back(fieldName);
+                _fieldValues.push_back(data.Get(specPath, fieldName));
+                _memorySize += sizeof(TfToken) + estimateSize(_fieldValues.back());
+            }
+            _fieldEnds.push_back(_fieldNames.size());
+        });
+
+        _paths.shrink_to_fit();
+        _specTypes.shrink_to_fit();
+        _fieldEnds.shrink_to_fit();
+        _fieldNames.shrink_to_fit();
+        _fieldValues.shrink_to_fit();
+        _memorySize += sizeof(*this)
+            + _paths.size() * (sizeof(SdfPath) + sizeof(SdfSpecType) + sizeof(size_t));
+    }
+
+    void restore(SdfAbstractData& data) const
     {
-        // Do nothing
-    }
-
-    SdfAbstractData* const _dst;
+        size_t field = 0;
+        for (size_t spec = 0; spec < _paths.size(); ++spec) {
+            data.CreateSpec(_paths[spec], _specTypes[spec]);
+            for (; field < _fieldEnds[spec]; ++field) {
+                data.Set(_paths[spec], _fieldNames[field], _fieldValues[field]);
+            }
+        }
+    }
+
+    size_t memorySize() const { return _memorySize; }
+
+private:
+    std::vector<SdfPath>     _paths;
+    std::vector<SdfSpecType> _specTypes;
+    std::vector<size_t>      _fieldEnds; // end of the fields of each spec
+    std::vector<TfToken>     _fieldNames;
+    std::vector<VtValue>     _fieldValues;
+    size_t                   _memorySize { 0 };
 };
 
-} // namespace
-
-namespace MAYAUSD_NS_DEF {
-
 UsdUndoStateDelegate::UsdUndoStateDelegate()
     : _dirty(false)
     , _setMessageAlreadyShowed(false)
@@ -124,10 +164,10 @@ void UsdUndoStateDelegate::invertCreateSpec(const SdfPath& path, bool inert)
 }
 
 void UsdUndoStateDelegate::invertDeleteSpec(
-    const SdfPath&       path,
-    bool                 inert,
-    SdfSpecType          deletedSpecType,
-    const SdfDataRefPtr& deletedData)
+    const SdfPath&         path,
+    bool                   inert,
+    SdfSpecType            deletedSpecType,
+    const DeletedSpecsPtr& deletedSpecs)
 {
     _setMessageAlreadyShowed = true;
 
@@ -138,9 +178,8 @@ void UsdUndoStateDelegate::invertDeleteSpec(
     auto layerDataPtr = get_pointer(_GetLayerData());
     TF_AXIOM(layerDataPtr);
 
-    // copy back every spec(s) with the given visitor
-    SpecCopier specCopier(layerDataPtr);
-    deletedData->VisitSpecs(&specCopier);
+    // copy back every spec(s)
+    deletedSpecs->restore(*layerDataPtr);
 
     _setMessageAlreadyShowed = false;
 }
@@ -257,26 +296,7 @@ void UsdUndoStateDelegate::_OnSetField(
     const TfToken& fieldName,
     const VtValue& value)
 {
-    _MarkCurrentStateAsDirty();
-
-    // early return if we are not inside an UsdUndoBlock
-    if (UsdUndoBlock::depth() == 0) {
-        return;
-    }
-
-    if (!_setMessageAlreadyShowed) {
-        TF_DEBUG(USDMAYA_UNDOSTATEDELEGATE)
-            .Msg("Setting Field '%s' for Spec '%s'\n", fieldName.GetText(), path.GetText());
-    }
-
-    if (!_layer) {
-        return;
-    }
-
-    const VtValue inverseValue = _layer->GetField(path, fieldName);
-
-    UsdUndoManager::instance().addInverse(
-        std::bind(&UsdUndoStateDelegate::invertSetField, this, path, fieldName, inverseValue));
+    _OnSetFieldImpl(path, fieldName);
 }
 
 void UsdUndoStateDelegate::_OnSetField(
@@ -284,27 +304,7 @@ void UsdUndoStateDelegate::_OnSetField(
     const TfToken&                   fieldName,
     const SdfAbstractDataConstValue& value)
 {
-    _MarkCurrentStateAsDirty();
-
-    // early return if we are not inside an UsdUndoBlock
-    if (UsdUndoBlock::depth() == 0) {
-        return;
-    }
-
-    if (!_setMessageAlreadyShowed) {
-        TF_DEBUG(USDMAYA_UNDOSTATEDELEGATE)
-            .Msg("Setting Field '%s' for Spec '%s'\n", fieldName.GetText(), path.GetText());
-    }
-
-    if (!_layer) {
-        return;
-    }
-
-    const VtValue inverseValue = _layer->GetField(path, fieldName);
-
-    // add invert
-    UsdUndoManager::instance().addInverse(
-        std::bind(&UsdUndoStateDelegate::invertSetField, this, path, fieldName, inverseValue));
+    _OnSetFieldImpl(path, fieldName);
 }
 
 void UsdUndoStateDelegate::_OnSetFieldDictValueByKey(
@@ -376,19 +376,22 @@ void UsdUndoStateDelegate::_OnDeleteSpec(const SdfPath& path, bool inert)
         return;
     }
 
-    SdfDataRefPtr deletedData = TfCreateRefPtr(new SdfData());
-
-    // traverse the hierarchy and call copySpecAtPath on each spec
-    auto layerDataPtr = std::cref(*get_pointer(_GetLayerData()));
-    auto deleteDataPtr = get_pointer(deletedData);
-
-    _GetLayer()->Traverse(
-        path, [&](const SdfPath& path) { copySpecAtPath(layerDataPtr, deleteDataPtr, path); });
+    // traverse the hierarchy and copy each spec
+    DeletedSpecsPtr deletedSpecs
+        = std::make_shared<DeletedSpecs>(_GetLayer(), *get_pointer(_GetLayerData()), path);
 
     const SdfSpecType deletedSpecType = _GetLayer()->GetSpecType(path);
+    const size_t      memorySize = kInverseSize + deletedSpecs->memorySize();
 
-    UsdUndoManager::instance().addInverse(std::bind(
-        &UsdUndoStateDelegate::invertDeleteSpec, this, path, inert, deletedSpecType, deletedData));
+    UsdUndoManager::instance().addInverse(
+        std::bind(
+            &UsdUndoStateDelegate::invertDeleteSpec,
+            this,
+            path,
+            inert,
+            deletedSpecType,
+            std::move(deletedSpecs)),
+        memorySize);
 }
 
 void UsdUndoStateDelegate::_OnMoveSpec(const SdfPath& oldPath, const SdfPath& newPath)
@@ -513,6 +516,38 @@ void UsdUndoStateDelegate::_OnPopChild(
         &UsdUndoStateDelegate::invertPopPathChild, this, parentPath, fieldName, oldValue));
 }
 
+void UsdUndoStateDelegate::_OnSetFieldImpl(const SdfPath& path, const TfToken& fieldName)
+{
+    _MarkCurrentStateAsDirty();
+
+    // early return if we are not inside an UsdUndoBlock
+    if (UsdUndoBlock::depth() == 0) {
+        return;
+    }
+
+    if (!_setMessageAlreadyShowed) {
+        TF_DEBUG(USDMAYA_UNDOSTATEDELEGATE)
+            .Msg("Setting Field '%s' for Spec '%s'\n", fieldName.GetText(), path.GetText());
+    }
+
+    if (!_layer) {
+        return;
+    }
+
+    // the value from before the undo block is already restored
+    auto& undoManager = UsdUndoManager::instance();
+    if (undoManager.coalesceInverse({ this, path, fieldName })) {
+        return;
+    }
+
+    const VtValue inverseValue = _layer->GetField(path, fieldName);
+    const size_t  memorySize = kInverseSize + estimateSize(inverseValue);
+
+    undoManager.addInverse(
+        std::bind(&UsdUndoStateDelegate::invertSetField, this, path, fieldName, inverseValue),
+        memorySize);
+}
+
 void UsdUndoStateDelegate::_OnSetFieldDictValueByKeyImpl(
     const SdfPath& path,
     const TfToken& fieldName,
@@ -538,15 +573,23 @@ void UsdUndoStateDelegate::_OnSetFieldDictValueByKeyImpl(
         return;
     }
 
+    auto& undoManager = UsdUndoManager::instance();
+    if (undoManager.coalesceInverse({ this, path, fieldName, keyPath })) {
+        return;
+    }
+
     const VtValue inverseValue = _layer->GetFieldDictValueByKey(path, fieldName, keyPath);
+    const size_t  memorySize = kInverseSize + estimateSize(inverseValue);
 
-    UsdUndoManager::instance().addInverse(std::bind(
-        &UsdUndoStateDelegate::invertSetFieldDictValueByKey,
-        this,
-        path,
-        fieldName,
-        keyPath,
-        inverseValue));
+    undoManager.addInverse(
+        std::bind(
+            &UsdUndoStateDelegate::invertSetFieldDictValueByKey,
+            this,
+            path,
+            fieldName,
+            keyPath,
+            inverseValue),
+        memorySize);
 }
 
 void UsdUndoStateDelegate::_OnSetTimeSampleImpl(const SdfPath& path, double time)
@@ -561,21 +604,35 @@ void UsdUndoStateDelegate::_OnSetTimeSampleImpl(const SdfPath& path, double time
     TF_DEBUG(USDMAYA_UNDOSTATEDELEGATE)
         .Msg("Setting time sample '%f' for spec '%s'\n", time, path.GetText());
 
+    auto& undoManager = UsdUndoManager::instance();
+
     if (!_GetLayer()->HasField(path, SdfFieldKeys->TimeSamples)) {
-        UsdUndoManager::instance().addInverse(std::bind(
-            &UsdUndoStateDelegate::invertSetField,
-            this,
-            path,
-            SdfFieldKeys->TimeSamples,
-            VtValue()));
+        if (undoManager.coalesceInverse({ this, path, SdfFieldKeys->TimeSamples })) {
+            return;
+        }
+
+        undoManager.addInverse(
+            std::bind(
+                &UsdUndoStateDelegate::invertSetField,
+                this,
+                path,
+                SdfFieldKeys->TimeSamples,
+                VtValue()),
+            kInverseSize);
 
     } else {
+        if (undoManager.coalesceInverse(
+                { this, path, SdfFieldKeys->TimeSamples, TfToken(), true, time })) {
+            return;
+        }
+
         VtValue oldValue;
 
         _GetLayer()->QueryTimeSample(path, time, &oldValue);
 
-        UsdUndoManager::instance().addInverse(
-            std::bind(&UsdUndoStateDelegate::invertSetTimeSample, this, path, time, oldValue));
+        undoManager.addInverse(
+            std::bind(&UsdUndoStateDelegate::invertSetTimeSample, this, path, time, oldValue),
+            kInverseSize + estimateSize(oldValue));
     }
 }
 
@@ -25,6 +25,8 @@
 // convenient way to bring in other headers
 #include <pxr/usd/usd/prim.h>
 
+#include <memory>
+
 PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace MAYAUSD_NS_DEF {
@@ -48,13 +50,16 @@ public:
     static UsdUndoStateDelegateRefPtr New();
 
 private:
+    class DeletedSpecs;
+    using DeletedSpecsPtr = std::shared_ptr<const DeletedSpecs>;
+
     void invertSetField(const SdfPath& path, const TfToken& fieldName, const VtValue& inverse);
     void invertCreateSpec(const SdfPath& path, bool inert);
     void invertDeleteSpec(
-        const SdfPath&       path,
-        bool                 inert,
-        SdfSpecType          deletedSpecType,
-        const SdfDataRefPtr& deletedData);
+        const SdfPath&         path,
+        bool                   inert,
+        SdfSpecType            deletedSpecType,
+        const DeletedSpecsPtr& deletedSpecs);
     void invertMoveSpec(const SdfPath& oldPath, const SdfPath& newPath);
     void
     invertPushTokenChild(const SdfPath& parentPath, const TfToken& fieldName, const TfToken& value);
@@ -114,6 +119,7 @@ protected:
         override;
 
 private:
+    void _OnSetFieldImpl(const SdfPath& path, const TfToken& fieldName);
     void _OnSetFieldDictValueByKeyImpl(
         const SdfPath& path,
         const TfToken& fieldName,
@@ -26,6 +26,11 @@ void UsdUndoableItem::undo() { doInvert(); }
 
 void UsdUndoableItem::redo() { doInvert(); }
 
+size_t UsdUndoableItem::memorySize() const
+{
+    return (_journal && !_journal->isDiscarded()) ? _journal->memorySize() : 0;
+}
+
 void UsdUndoableItem::doInvert()
 {
     if (UsdUndoBlock::depth() != 0) {
@@ -36,11 +41,9 @@ void UsdUndoableItem::doInvert()
     UsdUndoBlock undoBlock(this);
 
     // call invert functions in reverse order
-    {
+    if (_journal) {
         SdfChangeBlock changeBlock;
-        for (auto it = _invertFuncs.rbegin(); it != _invertFuncs.rend(); ++it) {
-            (*it)();
-        }
+        _journal->invert();
     }
 }
 
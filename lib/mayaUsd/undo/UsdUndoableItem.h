@@ -18,22 +18,22 @@
 #define MAYAUSD_UNDO_UNDOABLE_ITEM_H
 
 #include <mayaUsd/base/api.h>
+#include <mayaUsd/undo/UsdUndoJournal.h>
 
-#include <functional>
-#include <vector>
+#include <memory>
 
 namespace MAYAUSD_NS_DEF {
 
 //! \brief UsdUndoableItem
 /*!
-    This class stores the list of inverse edit functions that are invoked
+    This class stores the journal of inverse edit functions that are invoked
     on undo() / redo() call. This is the object that must be placed in Maya's undo stack.
 */
 class MAYAUSD_CORE_PUBLIC UsdUndoableItem
 {
 public:
-    using InvertFunc = std::function<void()>;
-    using InvertFuncs = std::vector<InvertFunc>;
+    using InvertFunc = UsdUndoJournal::InvertFunc;
+    using InvertFuncs = UsdUndoJournal::InvertFuncs;
 
     // default constructor/destructor
     UsdUndoableItem() = default;
@@ -50,12 +50,15 @@ public:
     void undo();
     void redo();
 
+    // estimated number of bytes held by the item, 0 once discarded.
+    size_t memorySize() const;
+
 private:
     friend class UsdUndoManager;
 
     void doInvert();
 
-    InvertFuncs _invertFuncs;
+    std::shared_ptr<const UsdUndoJournal> _journal;
 };
 
 } // namespace MAYAUSD_NS_DEF
@@ -15,6 +15,7 @@
 //
 // Modifications copyright (C) 2020 Autodesk
 //
+#include <mayaUsd/fileio/primReaderPrefetch.h>
 #include <mayaUsd/fileio/primReaderRegistry.h>
 #include <mayaUsd/fileio/translators/translatorGprim.h>
 #include <mayaUsd/fileio/translators/translatorMaterial.h>
@@ -124,9 +125,13 @@ bool MayaUsdPrimReaderMesh::Read(UsdMayaPrimReaderContext& context)
         }
     }
 
-    // assign primvars to mesh
+    // assign primvars to mesh, using their prefetched values if any
+    const UsdMayaPrefetchedPrimData* prefetched = context.GetPrefetchedData(prim.GetPath());
     UsdMayaMeshReadUtils::assignPrimvarsToMesh(
-        mesh, meshRead.meshObject(), _GetArgs().GetExcludePrimvarNames());
+        mesh,
+        meshRead.meshObject(),
+        _GetArgs().GetExcludePrimvarNames(),
+        prefetched ? &prefetched->primvars : nullptr);
 
     // assign invisible faces
     UsdMayaMeshReadUtils::assignInvisibleFaces(mesh, meshRead.meshObject());
@@ -319,6 +319,13 @@ bool PxrUsdTranslators_MeshWriter::writeAnimatedMeshExtents(
     VtVec3fArray   vtMeshPts(pVtMeshPts, pVtMeshPts + numVertices);
     VtVec3fArray   meshBBox(2);
     UsdGeomPointBased::ComputeExtent(vtMeshPts, &meshBBox);
+    return updateAnimatedMeshExtents(meshBBox, usdTime);
+}
+
+bool PxrUsdTranslators_MeshWriter::updateAnimatedMeshExtents(
+    const VtVec3fArray& meshBBox,
+    const UsdTimeCode&  usdTime)
+{
     bool bStat = true;
     if (meshBBox != this->_prevMeshExtentsSample) {
         bStat = this->_writeJobCtx.UpdateSkelBindingsWithExtent(
@@ -335,6 +342,60 @@ void PxrUsdTranslators_MeshWriter::Write(const UsdTimeCode& usdTime)
 
     UsdGeomMesh primSchema(_usdPrim);
     writeMeshAttrs(usdTime, primSchema);
+
+    _gatheredPoints = VtVec3fArray();
+    _gatheredExtent = VtVec3fArray();
+}
+
+bool PxrUsdTranslators_MeshWriter::IsThreadSafe() const { return true; }
+
+void PxrUsdTranslators_MeshWriter::GatherWriteData(const UsdTimeCode& usdTime)
+{
+    _gatheredPoints = VtVec3fArray();
+    _gatheredExtent = VtVec3fArray();
+    _gatheredTime = usdTime;
+
+    if (!writesFinalMeshPoints(usdTime)) {
+        return;
+    }
+
+    MStatus       status;
+    const MFnMesh finalMesh(GetDagPath(), &status);
+    if (!status) {
+        return;
+    }
+
+    const float* meshPts = finalMesh.getRawPoints(&status);
+    if (!status) {
+        return;
+    }
+
+    const GfVec3f* pVtMeshPts = reinterpret_cast<const GfVec3f*>(meshPts);
+    _gatheredPoints.assign(pVtMeshPts, pVtMeshPts + finalMesh.numVertices());
+}
+
+void PxrUsdTranslators_MeshWriter::ConvertWriteData(const UsdTimeCode& usdTime)
+{
+    if (_gatheredTime != usdTime || _gatheredPoints.empty()) {
+        return;
+    }
+
+    VtVec3fArray extent(2);
+    if (UsdGeomPointBased::ComputeExtent(_gatheredPoints, &extent)) {
+        _gatheredExtent = extent;
+    }
+}
+
+bool PxrUsdTranslators_MeshWriter::writesFinalMeshPoints(const UsdTimeCode& usdTime) const
+{
+    // Only animated samples of meshes without blend shapes are written from
+    // the final mesh points. Skinned meshes are never considered animated.
+    return !usdTime.IsDefault() && isMeshAnimated() && !_GetExportArgs().exportBlendShapes;
+}
+
+bool PxrUsdTranslators_MeshWriter::hasGatheredPoints(const UsdTimeCode& usdTime) const
+{
+    return _gatheredTime == usdTime && !_gatheredPoints.empty() && _gatheredExtent.size() == 2;
 }
 
 bool PxrUsdTranslators_MeshWriter::writeMeshAttrs(
@@ -495,9 +556,12 @@ bool PxrUsdTranslators_MeshWriter::writeMeshAttrs(
     }
 
     // NOTE: (yliangsiew) Write out the final deformed mesh extents for each frame here.
+    // The final mesh is the deformed mesh, so gathered points already have its extent.
     MDagPath deformedMeshDagPath = this->GetDagPath();
     MObject  deformedMesh = deformedMeshDagPath.node();
-    bStat = this->writeAnimatedMeshExtents(deformedMesh, usdTime);
+    bStat = hasGatheredPoints(usdTime)
+        ? this->updateAnimatedMeshExtents(_gatheredExtent, usdTime)
+        : this->writeAnimatedMeshExtents(deformedMesh, usdTime);
     if (!bStat) {
         return false;
     }
@@ -583,8 +647,13 @@ bool PxrUsdTranslators_MeshWriter::writeMeshAttrs(
         // TODO: (yliangsiew) Any other deformers that get implemented in the future will have to
         // make sure that they don't just enter this scope; otherwise, their deformed point
         // positions will get "baked" into the pref pose as well.
-        UsdMayaMeshWriteUtils::writePointsData(
-            geomMesh, primSchema, usdTime, _GetSparseValueWriter());
+        if (hasGatheredPoints(usdTime)) {
+            UsdMayaMeshWriteUtils::writePointsData(
+                &_gatheredPoints, &_gatheredExtent, primSchema, usdTime, _GetSparseValueWriter());
+        } else {
+            UsdMayaMeshWriteUtils::writePointsData(
+                geomMesh, primSchema, usdTime, _GetSparseValueWriter());
+        }
     }
 
     // Write faceVertexIndices
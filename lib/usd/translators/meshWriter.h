@@ -56,6 +56,13 @@ public:
 
     void Write(const UsdTimeCode& usdTime) override;
     bool ExportsGprims() const override;
+
+    /// The points of animated meshes are copied from Maya in GatherWriteData()
+    /// and their extent is computed in ConvertWriteData(). Write() authors
+    /// them along with the rest of the mesh data.
+    bool IsThreadSafe() const override;
+    void GatherWriteData(const UsdTimeCode& usdTime) override;
+    void ConvertWriteData(const UsdTimeCode& usdTime) override;
     void PostExport() override;
 
 private:
@@ -73,6 +80,15 @@ private:
     MObject writeBlendShapeData(UsdGeomMesh& primSchema);
     bool    writeBlendShapeAnimation(const UsdTimeCode& usdTime);
     bool    writeAnimatedMeshExtents(const MObject& deformedMesh, const UsdTimeCode& usdTime);
+    bool    updateAnimatedMeshExtents(const VtVec3fArray& meshBBox, const UsdTimeCode& usdTime);
+
+    /// Whether the points of the final mesh are written as they are at the
+    /// given time, in which case they can be gathered ahead of Write().
+    bool writesFinalMeshPoints(const UsdTimeCode& usdTime) const;
+
+    /// Whether the points and extent for the given time were gathered and
+    /// converted ahead of Write().
+    bool hasGatheredPoints(const UsdTimeCode& usdTime) const;
 
     /// Used to cache the animated blend shape weight plugs that need to be
     /// sampled per-frame.  Becuase UsdSkelBlendShape stores animation in an
@@ -91,6 +107,12 @@ private:
 
     UsdSkelAnimation _skelAnim;
 
+    /// The final mesh points gathered at _gatheredTime, and their extent once
+    /// computed by ConvertWriteData().
+    VtVec3fArray _gatheredPoints;
+    VtVec3fArray _gatheredExtent;
+    UsdTimeCode  _gatheredTime { UsdTimeCode::Default() };
+
     /// Set of color sets that should be excluded.
     /// Intermediate processes may alter this set prior to writeMeshAttrs().
     std::set<std::string> _excludeColorSets;
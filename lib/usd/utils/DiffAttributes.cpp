@@ -15,14 +15,62 @@
 //
 #include "DiffPrims.h"
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_group.h>
+
 namespace MayaUsdUtils {
 
 using UsdAttribute = PXR_NS::UsdAttribute;
 using VtValue = PXR_NS::VtValue;
 using UsdTimeCode = PXR_NS::UsdTimeCode;
 
-DiffResult
-compareAttributes(const UsdAttribute& modified, const UsdAttribute& baseline, DiffResult* quickDiff)
+namespace {
+
+// Below this number of time samples, the samples are always compared serially.
+constexpr size_t kParallelTimeSamples = 16;
+
+/// Compares the attributes at each of the given times on the TBB worker threads. Once a sample
+/// decides the overall result, the remaining samples are skipped and left as Same.
+std::vector<DiffResult> compareTimeSamplesInParallel(
+    const UsdAttribute&        modified,
+    const UsdAttribute&        baseline,
+    const std::vector<double>& times,
+    bool                       quick)
+{
+    std::vector<DiffResult> results(times.size(), DiffResult::Same);
+
+    tbb::task_group_context context;
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, times.size()),
+        [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                if (context.is_group_execution_cancelled())
+                    return;
+
+                const DiffResult sampleResult = compareAttributes(
+                    modified, baseline, UsdTimeCode(times[i]), DiffThreading::Parallel);
+                results[i] = sampleResult;
+
+                if (sampleResult == DiffResult::Differ
+                    || (quick && sampleResult != DiffResult::Same)) {
+                    context.cancel_group_execution();
+                    return;
+                }
+            }
+        },
+        context);
+
+    return results;
+}
+
+} // namespace
+
+DiffResult compareAttributes(
+    const UsdAttribute& modified,
+    const UsdAttribute& baseline,
+    DiffResult*         quickDiff,
+    DiffThreading       threading)
 {
     // We will not compare the set of point-in-times themselves but the overall result
     // of the animated values. This takes care of trying to match time-samples: we
@@ -40,16 +88,25 @@ compareAttributes(const UsdAttribute& modified, const UsdAttribute& baseline, Di
     // If there are no time samples at all in both attributes, we will compare the default values
     // instead.
     if (times.size() <= 0) {
-        const DiffResult result = compareAttributes(modified, baseline, UsdTimeCode::Default());
+        const DiffResult result
+            = compareAttributes(modified, baseline, UsdTimeCode::Default(), threading);
         if (quickDiff)
             *quickDiff = result;
         return result;
     }
 
+    // When run in parallel, all the samples are compared first and then folded in order below.
+    std::vector<DiffResult> sampleResults;
+    if (threading == DiffThreading::Parallel && times.size() >= kParallelTimeSamples)
+        sampleResults
+            = compareTimeSamplesInParallel(modified, baseline, times, quickDiff != nullptr);
+
     // The algorithm returns the common result if there is one. Stop as soon as we reach Differ.
     DiffResult overallResult = DiffResult::Same;
-    for (const double time : times) {
-        const DiffResult sampleResult = compareAttributes(modified, baseline, UsdTimeCode(time));
+    for (size_t i = 0; i < times.size(); ++i) {
+        const DiffResult sampleResult = sampleResults.empty()
+            ? compareAttributes(modified, baseline, UsdTimeCode(times[i]), threading)
+            : sampleResults[i];
         if (sampleResult == DiffResult::Same) {
             continue;
         }
@@ -78,7 +135,8 @@ compareAttributes(const UsdAttribute& modified, const UsdAttribute& baseline, Di
 DiffResult compareAttributes(
     const UsdAttribute& modified,
     const UsdAttribute& baseline,
-    const UsdTimeCode&  timeCode)
+    const UsdTimeCode&  timeCode,
+    DiffThreading       threading)
 {
     VtValue    modifiedValue;
     const bool hasmodifiedValue = modified.Get(&modifiedValue, timeCode);
@@ -94,7 +152,7 @@ DiffResult compareAttributes(
     if (!hasBaselineValue)
         return DiffResult::Created;
 
-    return compareValues(modifiedValue, baselineValue);
+    return compareValues(modifiedValue, baselineValue, threading);
 }
 
 } // namespace MayaUsdUtils
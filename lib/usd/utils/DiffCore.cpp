@@ -15,10 +15,19 @@
 //
 #include "DiffCore.h"
 
+#include "DiffCoreKernels.h"
+
 #include <mayaUsdUtils/SIMD.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
 
 namespace MayaUsdUtils {
 
@@ -147,70 +156,13 @@ bool vec2AreAllTheSame(const float* array, size_t count)
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-bool vec3AreAllTheSame(const float* array, size_t count)
+static bool baselineVec3AreAllTheSame(const float* array, size_t count)
 {
     // if already at the end of the array, we're done
     if (count <= 1) {
         return true;
     }
-#ifdef __AVX2__
-
-    const float x = array[0];
-    const float y = array[1];
-    const float z = array[2];
-
-    // test the first 8 in the array
-    for (int32_t i = 3, n = 3 * std::min(size_t(8), count); i < n; i += 3) {
-        if (x != array[i] || y != array[i + 1] || z != array[i + 2])
-            return false;
-    }
-    // if already at the end of the array, we're done
-    if (count <= 8) {
-        return true;
-    }
-
-    // load 8 vec3s
-    const f256 first8[3] = { loadu8f(array + 0), loadu8f(array + 8), loadu8f(array + 16) };
-
-    // now test groups of 8 x 3D vectors
-    size_t count8 = count & ~7ULL;
-    for (int32_t i = 3 * 8, n = 3 * count8; i < n; i += 3 * 8) {
-        const f256 a = loadu8f(array + i + 0);
-        const f256 b = loadu8f(array + i + 8);
-        const f256 c = loadu8f(array + i + 16);
-        const f256 cmpa = cmpne8f(first8[0], a);
-        const f256 cmpb = cmpne8f(first8[1], b);
-        const f256 cmpc = cmpne8f(first8[2], c);
-        const f256 cmp = or8f(or8f(cmpa, cmpb), cmpc);
-        if (movemask8f(cmp))
-            return false;
-    }
-
-    // now test a final group of 4 x 3D vectors
-    if (count & 4) {
-        const f128 a = loadu4f(array + 3 * count8 + 0);
-        const f128 b = loadu4f(array + 3 * count8 + 4);
-        const f128 c = loadu4f(array + 3 * count8 + 8);
-        const f128 cmpa = cmpne4f(extract4f(first8[0], 0), a);
-        const f128 cmpb = cmpne4f(extract4f(first8[0], 1), b);
-        const f128 cmpc = cmpne4f(extract4f(first8[1], 0), c);
-        const f128 cmp = or4f(or4f(cmpa, cmpb), cmpc);
-        if (movemask4f(cmp))
-            return false;
-        count8 += 4;
-    }
-
-    // and now the remaining three
-    if (count & 3) {
-        for (int i = 3 * count8, n = 3 * count; i < n; i += 3) {
-            if (x != array[i] || y != array[i + 1] || z != array[i + 2]) {
-                return false;
-            }
-        }
-    }
-    return true;
-
-#elif defined(__SSE__)
+#if defined(__SSE__)
 
     const float x = array[0];
     const float y = array[1];
@@ -703,41 +655,13 @@ bool compareArray(
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-bool compareArray(
+static bool baselineCompareDoubleArray(
     const double* const input0,
     const double* const input1,
     const size_t        count0,
-    const size_t        count1,
     const double        eps)
 {
-    if (count0 != count1) {
-        return false;
-    }
-#ifdef __AVX2__
-    const d256   eps4 = splat4d(eps);
-    const size_t count4 = count0 & ~0x3ULL;
-    size_t       i = 0;
-
-    // check all values that can be processed in blocks of 8
-    for (; i < count4; i += 4) {
-        const d256 in0 = loadu4d(input0 + i);
-        const d256 in1 = loadu4d(input1 + i);
-        const d256 diff = abs4d(sub4d(in0, in1));
-        const d256 cmp = cmpgt4d(diff, eps4);
-        if (movemask4d(cmp))
-            return false;
-    }
-
-    // use a masked load to load the last 0 -> 7 elements in each array. The unused
-    // elements will be set to zero, so the if(diff > eps) test should return 0
-    // in the movemask for those elements.
-    const d256 in0 = loadmask3d(input0 + i, count0);
-    const d256 in1 = loadmask3d(input1 + i, count0);
-    const d256 diff = abs4d(sub4d(in0, in1));
-    const d256 cmp = cmpgt4d(diff, eps4);
-    return movemask4d(cmp) == 0;
-
-#elif defined(__SSE__)
+#if defined(__SSE__)
     const d128   eps2 = splat2d(eps);
     const size_t count2 = count0 & ~0x1ULL;
     size_t       i = 0;
@@ -766,42 +690,13 @@ bool compareArray(
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-bool compareArray(
+static bool baselineCompareFloatArray(
     const float* const input0,
     const float* const input1,
     const size_t       count0,
-    const size_t       count1,
     const float        eps)
 {
-    if (count0 != count1) {
-        return false;
-    }
-#ifdef __AVX2__
-    const f256   eps8 = splat8f(eps);
-    const size_t count8 = count0 & ~0x7ULL;
-    size_t       i = 0;
-
-    // check all values that can be processed in blocks of 8
-    for (; i < count8; i += 8) {
-        const f256 in0 = loadu8f(input0 + i);
-        const f256 in1 = loadu8f(input1 + i);
-        const f256 diff = abs8f(sub8f(in0, in1));
-        const f256 cmp = cmpgt8f(diff, eps8);
-        if (movemask8f(cmp)) {
-            return false;
-        }
-    }
-
-    // use a masked load to load the last 0 -> 7 elements in each array. The unused
-    // elements will be set to zero, so the if(diff > eps) test should return 0
-    // in the movemask for those elements.
-    const f256 in0 = loadmask7f(input0 + i, count0);
-    const f256 in1 = loadmask7f(input1 + i, count0);
-    const f256 diff = abs8f(sub8f(in0, in1));
-    const f256 cmp = cmpgt8f(diff, eps8);
-    return movemask8f(cmp) == 0;
-
-#elif defined(__SSE__)
+#if defined(__SSE__)
     const f128   eps4 = splat4f(eps);
     const size_t count4 = count0 & ~0x3ULL;
     size_t       i = 0;
@@ -994,76 +889,14 @@ bool compareArray(
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-bool compareUvArray(
+static bool baselineCompareUvArray(
     const float* const u0,
     const float* const v0,
     const float* const uv1,
     const size_t       count0,
-    const size_t       count1,
     const float        eps)
 {
-    if (count0 != count1) {
-        return false;
-    }
-
-#ifdef __AVX2__
-
-    const f256   eps8 = splat8f(eps);
-    const size_t count8 = count0 & ~0x7ULL;
-    size_t       i = 0, j = 0;
-
-    // check all values that can be processed in blocks of 8
-    for (; i < count8; i += 8, j += 16) {
-        const f256 inu0 = loadu8f(u0 + i);
-        const f256 inv0 = loadu8f(v0 + i);
-        const f256 inuv1a = loadu8f(uv1 + j);
-        const f256 inuv1b = loadu8f(uv1 + j + 8);
-
-        // zip U and V arrays together
-        const f256 xy0 = unpacklo8f(inu0, inv0);
-        const f256 xy1 = unpackhi8f(inu0, inv0);
-        const f256 inuv0a = permute128f<0, 2>(xy0, xy1);
-        const f256 inuv0b = permute128f<1, 3>(xy0, xy1);
-
-        const f256 diff0 = abs8f(sub8f(inuv0a, inuv1a));
-        const f256 diff1 = abs8f(sub8f(inuv0b, inuv1b));
-        const f256 cmp0 = cmpgt8f(diff0, eps8);
-        const f256 cmp1 = cmpgt8f(diff1, eps8);
-        if (movemask8f(cmp0) | movemask8f(cmp1))
-            return false;
-    }
-
-    if (count0 != count8) {
-        f256 inu0, inv0, inuv1a, inuv1b;
-        if (count0 & 0x4) {
-            inu0 = loadmask7f(u0 + i, count0);
-            inv0 = loadmask7f(v0 + i, count0);
-            inuv1a = loadu8f(uv1 + j);
-            inuv1b = loadmask7f(uv1 + j + 8, count0 << 1);
-        } else {
-            inu0 = loadmask7f(u0 + i, count0);
-            inv0 = loadmask7f(v0 + i, count0);
-            inuv1a = loadmask7f(uv1 + j, count0 << 1);
-            inuv1b = zero8f();
-        }
-
-        // zip U and V arrays together
-        const f256 xy0 = unpacklo8f(inu0, inv0);
-        const f256 xy1 = unpackhi8f(inu0, inv0);
-        const f256 inuv0a = permute128f<0, 2>(xy0, xy1);
-        const f256 inuv0b = permute128f<1, 3>(xy0, xy1);
-
-        const f256 diff0 = abs8f(sub8f(inuv0a, inuv1a));
-        const f256 diff1 = abs8f(sub8f(inuv0b, inuv1b));
-        const f256 cmp0 = cmpgt8f(diff0, eps8);
-        const f256 cmp1 = cmpgt8f(diff1, eps8);
-        if (movemask8f(cmp0) | movemask8f(cmp1))
-            return false;
-    }
-
-    return true;
-
-#elif defined(__SSE__)
+#if defined(__SSE__)
 
     const f128   eps4 = splat4f(eps);
     const size_t count4 = count0 & ~0x3ULL;
@@ -1124,7 +957,7 @@ bool compareUvArray(
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-bool compareUvArray(
+static bool baselineCompareUvArrayToValue(
     const float        u0,
     const float        v0,
     const float* const u1,
@@ -1132,49 +965,7 @@ bool compareUvArray(
     const size_t       count,
     const float        eps)
 {
-#ifdef __AVX2__
-    const f256 U = splat8f(u0);
-    const f256 V = splat8f(v0);
-
-    const f256   eps8 = splat8f(eps);
-    const size_t count8 = count & ~0x7ULL;
-    size_t       i = 0;
-
-    // check all values that can be processed in blocks of 4
-    for (; i < count8; i += 8) {
-        const f256 au1 = loadu8f(u1 + i);
-        const f256 av1 = loadu8f(v1 + i);
-
-        const f256 diffu = abs8f(sub8f(au1, U));
-        const f256 diffv = abs8f(sub8f(av1, V));
-        const f256 cmpu = cmpgt8f(diffu, eps8);
-        const f256 cmpv = cmpgt8f(diffv, eps8);
-        if (movemask8f(cmpu) || movemask8f(cmpv))
-            return false;
-    }
-
-    if (count8 != count) {
-        alignas(32) float utemp[8];
-        alignas(32) float vtemp[8];
-        storeu8f(utemp, U);
-        storeu8f(vtemp, V);
-        f256 inu0, inv0, inu1, inv1;
-        inu0 = loadmask7f(utemp, count);
-        inv0 = loadmask7f(utemp, count);
-        inu1 = loadmask7f(u1 + i, count);
-        inv1 = loadmask7f(v1 + i, count);
-
-        const f256 diffu = abs8f(sub8f(inu0, inu1));
-        const f256 diffv = abs8f(sub8f(inv0, inv1));
-        const f256 cmpu = cmpgt8f(diffu, eps8);
-        const f256 cmpv = cmpgt8f(diffv, eps8);
-        if (movemask8f(cmpu) || movemask8f(cmpv))
-            return false;
-    }
-
-    return true;
-
-#elif defined(__SSE__)
+#if defined(__SSE__)
 
     const f128 U = splat4f(u0);
     const f128 V = splat4f(v0);
@@ -1275,7 +1066,7 @@ bool compareArray3Dto4D(
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-bool compareRGBAArray(
+static bool baselineCompareRGBAArray(
     const float        r,
     const float        g,
     const float        b,
@@ -1284,29 +1075,7 @@ bool compareRGBAArray(
     const size_t       count,
     const float        eps)
 {
-#ifdef __AVX2__
-    const f256   colour = set8f(r, g, b, a, r, g, b, a);
-    const f256   eps8 = splat8f(eps);
-    const size_t count2 = count & ~0x1ULL;
-    size_t       i = 0;
-
-    // check all values that can be processed in blocks of 4
-    for (; i < count2 * 4; i += 8) {
-        const f256 in = loadu8f(rgba + i);
-        const f256 diff = abs8f(sub8f(in, colour));
-        const f256 cmp = cmpgt8f(diff, eps8);
-        if (movemask8f(cmp))
-            return false;
-    }
-
-    if (count & 1) {
-        const f128 in = loadu4f(rgba + i);
-        const f128 diff = abs4f(sub4f(in, cast4f(colour)));
-        const f128 cmp = cmpgt4f(diff, cast4f(eps8));
-        if (movemask4f(cmp))
-            return false;
-    }
-#elif defined(__SSE__)
+#if defined(__SSE__)
     const f128 colour = set4f(r, g, b, a);
     const f128 eps4 = splat4f(eps);
 
@@ -1329,4 +1098,219 @@ bool compareRGBAArray(
     return true;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Runtime dispatch of the compare kernels.
+//----------------------------------------------------------------------------------------------------------------------
+namespace {
+
+const DiffCoreKernels baselineKernels = { "baseline",
+                                          baselineVec3AreAllTheSame,
+                                          baselineCompareFloatArray,
+                                          baselineCompareDoubleArray,
+                                          baselineCompareUvArray,
+                                          baselineCompareUvArrayToValue,
+                                          baselineCompareRGBAArray };
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+bool cpuSupports(const SimdIsa isa)
+{
+    if (isa == SimdIsa::Baseline) {
+        return true;
+    }
+
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+
+    // the OS needs to save the YMM (and ZMM) registers on context switches
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave) {
+        return false;
+    }
+    const unsigned long long xcr0 = _xgetbv(0);
+
+    __cpuidex(info, 7, 0);
+    switch (isa) {
+    case SimdIsa::AVX2: return (xcr0 & 0x6) == 0x6 && (info[1] & (1 << 5)) != 0;
+    case SimdIsa::AVX512: return (xcr0 & 0xE6) == 0xE6 && (info[1] & (1 << 16)) != 0;
+    default: break;
+    }
+    return false;
+}
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+bool cpuSupports(const SimdIsa isa)
+{
+    // also checks that the OS saves the YMM / ZMM registers on context switches
+    __builtin_cpu_init();
+    switch (isa) {
+    case SimdIsa::AVX2: return __builtin_cpu_supports("avx2");
+    case SimdIsa::AVX512: return __builtin_cpu_supports("avx512f");
+    default: break;
+    }
+    return true;
+}
+#else
+bool cpuSupports(const SimdIsa isa) { return isa == SimdIsa::Baseline; }
+#endif
+
+const DiffCoreKernels* kernelsFor(const SimdIsa isa)
+{
+    if (!cpuSupports(isa)) {
+        return nullptr;
+    }
+    switch (isa) {
+    case SimdIsa::AVX2: return avx2DiffCoreKernels();
+    case SimdIsa::AVX512: return avx512DiffCoreKernels();
+    default: break;
+    }
+    return &baselineKernels;
+}
+
+SimdIsa initialSimdIsa()
+{
+    // MAYAUSD_SIMD_ISA can be used to cap the instruction set, e.g. to rule out the wider
+    // kernels when tracking down a difference between two machines.
+    SimdIsa     isa = highestSupportedSimdIsa();
+    const char* cap = std::getenv("MAYAUSD_SIMD_ISA");
+    if (cap) {
+        for (const SimdIsa candidate : { SimdIsa::Baseline, SimdIsa::AVX2 }) {
+            if (std::strcmp(cap, simdIsaName(candidate)) == 0 && candidate < isa) {
+                isa = candidate;
+            }
+        }
+    }
+    return isa;
+}
+
+std::atomic<SimdIsa>& activeIsa()
+{
+    static std::atomic<SimdIsa> isa(initialSimdIsa());
+    return isa;
+}
+
+std::atomic<const DiffCoreKernels*>& activeKernels()
+{
+    static std::atomic<const DiffCoreKernels*> kernels(kernelsFor(activeIsa().load()));
+    return kernels;
+}
+
+inline const DiffCoreKernels& kernels() { return *activeKernels().load(std::memory_order_relaxed); }
+
+} // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+const char* simdIsaName(const SimdIsa isa)
+{
+    switch (isa) {
+    case SimdIsa::AVX2: return "avx2";
+    case SimdIsa::AVX512: return "avx512";
+    default: break;
+    }
+    return "baseline";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool isSimdIsaSupported(const SimdIsa isa) { return kernelsFor(isa) != nullptr; }
+
+//----------------------------------------------------------------------------------------------------------------------
+SimdIsa highestSupportedSimdIsa()
+{
+    static const SimdIsa highest = isSimdIsaSupported(SimdIsa::AVX512)
+        ? SimdIsa::AVX512
+        : (isSimdIsaSupported(SimdIsa::AVX2) ? SimdIsa::AVX2 : SimdIsa::Baseline);
+    return highest;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+SimdIsa activeSimdIsa() { return activeIsa().load(); }
+
+//----------------------------------------------------------------------------------------------------------------------
+bool setActiveSimdIsa(const SimdIsa isa)
+{
+    const DiffCoreKernels* const isaKernels = kernelsFor(isa);
+    if (!isaKernels) {
+        return false;
+    }
+    activeKernels().store(isaKernels);
+    activeIsa().store(isa);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool vec3AreAllTheSame(const float* array, size_t count)
+{
+    return kernels().vec3AreAllTheSame(array, count);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool compareArray(
+    const double* const input0,
+    const double* const input1,
+    const size_t        count0,
+    const size_t        count1,
+    const double        eps)
+{
+    if (count0 != count1) {
+        return false;
+    }
+    return kernels().compareDoubleArray(input0, input1, count0, eps);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool compareArray(
+    const float* const input0,
+    const float* const input1,
+    const size_t       count0,
+    const size_t       count1,
+    const float        eps)
+{
+    if (count0 != count1) {
+        return false;
+    }
+    return kernels().compareFloatArray(input0, input1, count0, eps);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool compareUvArray(
+    const float* const u0,
+    const float* const v0,
+    const float* const uv1,
+    const size_t       count0,
+    const size_t       count1,
+    const float        eps)
+{
+    if (count0 != count1) {
+        return false;
+    }
+    return kernels().compareUvArray(u0, v0, uv1, count0, eps);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool compareUvArray(
+    const float        u0,
+    const float        v0,
+    const float* const u1,
+    const float* const v1,
+    const size_t       count,
+    const float        eps)
+{
+    return kernels().compareUvArrayToValue(u0, v0, u1, v1, count, eps);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool compareRGBAArray(
+    const float        r,
+    const float        g,
+    const float        b,
+    const float        a,
+    const float* const rgba,
+    const size_t       count,
+    const float        eps)
+{
+    return kernels().compareRGBAArray(r, g, b, a, rgba, count, eps);
+}
+
 } // namespace MayaUsdUtils
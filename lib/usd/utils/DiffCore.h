@@ -22,6 +22,52 @@
 
 namespace MayaUsdUtils {
 
+//----------------------------------------------------------------------------------------------------------------------
+/// The instruction sets the compare kernels of vec3AreAllTheSame, compareArray (float and double),
+/// compareUvArray and compareRGBAArray can be dispatched to. The kernels are selected at runtime
+/// from the highest instruction set supported by the CPU, which can be capped with the
+/// MAYAUSD_SIMD_ISA environment variable (set to "baseline" or "avx2").
+enum class SimdIsa
+{
+    Baseline, // The SSE (or scalar) code selected by the compiler flags of the library.
+    AVX2,     // 256 bit kernels.
+    AVX512    // 512 bit kernels, requires AVX-512F.
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns the name of an instruction set, i.e. "baseline", "avx2" or "avx512"
+//----------------------------------------------------------------------------------------------------------------------
+MAYA_USD_UTILS_PUBLIC
+const char* simdIsaName(SimdIsa isa);
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns true if the library was built with kernels for the instruction set, and the CPU
+///         supports it.
+//----------------------------------------------------------------------------------------------------------------------
+MAYA_USD_UTILS_PUBLIC
+bool isSimdIsaSupported(SimdIsa isa);
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns the widest instruction set for which isSimdIsaSupported returns true.
+//----------------------------------------------------------------------------------------------------------------------
+MAYA_USD_UTILS_PUBLIC
+SimdIsa highestSupportedSimdIsa();
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns the instruction set the compare kernels are currently dispatched to.
+//----------------------------------------------------------------------------------------------------------------------
+MAYA_USD_UTILS_PUBLIC
+SimdIsa activeSimdIsa();
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  selects the instruction set the compare kernels are dispatched to. Mostly useful for
+///         testing and benchmarking the different kernels.
+/// \param  isa the instruction set to use
+/// \return false if the instruction set is not supported, in which case nothing is changed.
+//----------------------------------------------------------------------------------------------------------------------
+MAYA_USD_UTILS_PUBLIC
+bool setActiveSimdIsa(SimdIsa isa);
+
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  tests to see whether the U & V coordinates are identical
 /// \param  u the U coordinate array
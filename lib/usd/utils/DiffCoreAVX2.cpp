@@ -0,0 +1,326 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is compiled with AVX2 enabled (see CMakeLists.txt), and is only ever called after
+// DiffCore.cpp has checked that the host CPU supports it. Avoid inline helpers from the standard
+// library in here (std::min, std::abs, ...), since an out-of-line copy compiled with AVX2 could be
+// picked by the linker for the baseline code path too.
+//
+#include "DiffCoreKernels.h"
+
+#include <mayaUsdUtils/SIMD.h>
+
+namespace MayaUsdUtils {
+
+#if defined(__AVX2__)
+
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+bool vec3AreAllTheSame(const float* array, size_t count)
+{
+    // if already at the end of the array, we're done
+    if (count <= 1) {
+        return true;
+    }
+
+    const float x = array[0];
+    const float y = array[1];
+    const float z = array[2];
+
+    // test the first 8 in the array
+    for (size_t i = 3, n = 3 * (count < 8 ? count : 8); i < n; i += 3) {
+        if (x != array[i] || y != array[i + 1] || z != array[i + 2])
+            return false;
+    }
+    // if already at the end of the array, we're done
+    if (count <= 8) {
+        return true;
+    }
+
+    // load 8 vec3s
+    const f256 first8[3] = { loadu8f(array + 0), loadu8f(array + 8), loadu8f(array + 16) };
+
+    // now test groups of 8 x 3D vectors
+    size_t count8 = count & ~7ULL;
+    for (size_t i = 3 * 8, n = 3 * count8; i < n; i += 3 * 8) {
+        const f256 a = loadu8f(array + i + 0);
+        const f256 b = loadu8f(array + i + 8);
+        const f256 c = loadu8f(array + i + 16);
+        const f256 cmpa = cmpne8f(first8[0], a);
+        const f256 cmpb = cmpne8f(first8[1], b);
+        const f256 cmpc = cmpne8f(first8[2], c);
+        const f256 cmp = or8f(or8f(cmpa, cmpb), cmpc);
+        if (movemask8f(cmp))
+            return false;
+    }
+
+    // now test a final group of 4 x 3D vectors
+    if (count & 4) {
+        const f128 a = loadu4f(array + 3 * count8 + 0);
+        const f128 b = loadu4f(array + 3 * count8 + 4);
+        const f128 c = loadu4f(array + 3 * count8 + 8);
+        const f128 cmpa = cmpne4f(extract4f(first8[0], 0), a);
+        const f128 cmpb = cmpne4f(extract4f(first8[0], 1), b);
+        const f128 cmpc = cmpne4f(extract4f(first8[1], 0), c);
+        const f128 cmp = or4f(or4f(cmpa, cmpb), cmpc);
+        if (movemask4f(cmp))
+            return false;
+        count8 += 4;
+    }
+
+    // and now the remaining three
+    if (count & 3) {
+        for (size_t i = 3 * count8, n = 3 * count; i < n; i += 3) {
+            if (x != array[i] || y != array[i + 1] || z != array[i + 2]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool compareFloatArray(
+    const float* const input0,
+    const float* const input1,
+    const size_t       count,
+    const float        eps)
+{
+    const f256   eps8 = splat8f(eps);
+    const size_t count8 = count & ~0x7ULL;
+    size_t       i = 0;
+
+    // check all values that can be processed in blocks of 8
+    for (; i < count8; i += 8) {
+        const f256 in0 = loadu8f(input0 + i);
+        const f256 in1 = loadu8f(input1 + i);
+        const f256 diff = abs8f(sub8f(in0, in1));
+        const f256 cmp = cmpgt8f(diff, eps8);
+        if (movemask8f(cmp)) {
+            return false;
+        }
+    }
+
+    // use a masked load to load the last 0 -> 7 elements in each array. The unused
+    // elements will be set to zero, so the if(diff > eps) test should return 0
+    // in the movemask for those elements.
+    const f256 in0 = loadmask7f(input0 + i, count);
+    const f256 in1 = loadmask7f(input1 + i, count);
+    const f256 diff = abs8f(sub8f(in0, in1));
+    const f256 cmp = cmpgt8f(diff, eps8);
+    return movemask8f(cmp) == 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool compareDoubleArray(
+    const double* const input0,
+    const double* const input1,
+    const size_t        count,
+    const double        eps)
+{
+    const d256   eps4 = splat4d(eps);
+    const size_t count4 = count & ~0x3ULL;
+    size_t       i = 0;
+
+    // check all values that can be processed in blocks of 4
+    for (; i < count4; i += 4) {
+        const d256 in0 = loadu4d(input0 + i);
+        const d256 in1 = loadu4d(input1 + i);
+        const d256 diff = abs4d(sub4d(in0, in1));
+        const d256 cmp = cmpgt4d(diff, eps4);
+        if (movemask4d(cmp))
+            return false;
+    }
+
+    // use a masked load to load the last 0 -> 3 elements in each array. The unused
+    // elements will be set to zero, so the if(diff > eps) test should return 0
+    // in the movemask for those elements.
+    const d256 in0 = loadmask3d(input0 + i, count);
+    const d256 in1 = loadmask3d(input1 + i, count);
+    const d256 diff = abs4d(sub4d(in0, in1));
+    const d256 cmp = cmpgt4d(diff, eps4);
+    return movemask4d(cmp) == 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool compareUvArray(
+    const float* const u0,
+    const float* const v0,
+    const float* const uv1,
+    const size_t       count,
+    const float        eps)
+{
+    const f256   eps8 = splat8f(eps);
+    const size_t count8 = count & ~0x7ULL;
+    size_t       i = 0, j = 0;
+
+    // check all values that can be processed in blocks of 8
+    for (; i < count8; i += 8, j += 16) {
+        const f256 inu0 = loadu8f(u0 + i);
+        const f256 inv0 = loadu8f(v0 + i);
+        const f256 inuv1a = loadu8f(uv1 + j);
+        const f256 inuv1b = loadu8f(uv1 + j + 8);
+
+        // zip U and V arrays together
+        const f256 xy0 = unpacklo8f(inu0, inv0);
+        const f256 xy1 = unpackhi8f(inu0, inv0);
+        const f256 inuv0a = permute128f<0, 2>(xy0, xy1);
+        const f256 inuv0b = permute128f<1, 3>(xy0, xy1);
+
+        const f256 diff0 = abs8f(sub8f(inuv0a, inuv1a));
+        const f256 diff1 = abs8f(sub8f(inuv0b, inuv1b));
+        const f256 cmp0 = cmpgt8f(diff0, eps8);
+        const f256 cmp1 = cmpgt8f(diff1, eps8);
+        if (movemask8f(cmp0) | movemask8f(cmp1))
+            return false;
+    }
+
+    if (count != count8) {
+        f256 inu0, inv0, inuv1a, inuv1b;
+        if (count & 0x4) {
+            inu0 = loadmask7f(u0 + i, count);
+            inv0 = loadmask7f(v0 + i, count);
+            inuv1a = loadu8f(uv1 + j);
+            inuv1b = loadmask7f(uv1 + j + 8, count << 1);
+        } else {
+            inu0 = loadmask7f(u0 + i, count);
+            inv0 = loadmask7f(v0 + i, count);
+            inuv1a = loadmask7f(uv1 + j, count << 1);
+            inuv1b = zero8f();
+        }
+
+        // zip U and V arrays together
+        const f256 xy0 = unpacklo8f(inu0, inv0);
+        const f256 xy1 = unpackhi8f(inu0, inv0);
+        const f256 inuv0a = permute128f<0, 2>(xy0, xy1);
+        const f256 inuv0b = permute128f<1, 3>(xy0, xy1);
+
+        const f256 diff0 = abs8f(sub8f(inuv0a, inuv1a));
+        const f256 diff1 = abs8f(sub8f(inuv0b, inuv1b));
+        const f256 cmp0 = cmpgt8f(diff0, eps8);
+        const f256 cmp1 = cmpgt8f(diff1, eps8);
+        if (movemask8f(cmp0) | movemask8f(cmp1))
+            return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool compareUvArrayToValue(
+    const float        u0,
+    const float        v0,
+    const float* const u1,
+    const float* const v1,
+    const size_t       count,
+    const float        eps)
+{
+    const f256 U = splat8f(u0);
+    const f256 V = splat8f(v0);
+
+    const f256   eps8 = splat8f(eps);
+    const size_t count8 = count & ~0x7ULL;
+    size_t       i = 0;
+
+    // check all values that can be processed in blocks of 8
+    for (; i < count8; i += 8) {
+        const f256 au1 = loadu8f(u1 + i);
+        const f256 av1 = loadu8f(v1 + i);
+
+        const f256 diffu = abs8f(sub8f(au1, U));
+        const f256 diffv = abs8f(sub8f(av1, V));
+        const f256 cmpu = cmpgt8f(diffu, eps8);
+        const f256 cmpv = cmpgt8f(diffv, eps8);
+        if (movemask8f(cmpu) || movemask8f(cmpv))
+            return false;
+    }
+
+    if (count8 != count) {
+        alignas(32) float utemp[8];
+        alignas(32) float vtemp[8];
+        storeu8f(utemp, U);
+        storeu8f(vtemp, V);
+        const f256 inu0 = loadmask7f(utemp, count);
+        const f256 inv0 = loadmask7f(vtemp, count);
+        const f256 inu1 = loadmask7f(u1 + i, count);
+        const f256 inv1 = loadmask7f(v1 + i, count);
+
+        const f256 diffu = abs8f(sub8f(inu0, inu1));
+        const f256 diffv = abs8f(sub8f(inv0, inv1));
+        const f256 cmpu = cmpgt8f(diffu, eps8);
+        const f256 cmpv = cmpgt8f(diffv, eps8);
+        if (movemask8f(cmpu) || movemask8f(cmpv))
+            return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool compareRGBAArray(
+    const float        r,
+    const float        g,
+    const float        b,
+    const float        a,
+    const float* const rgba,
+    const size_t       count,
+    const float        eps)
+{
+    const f256   colour = set8f(r, g, b, a, r, g, b, a);
+    const f256   eps8 = splat8f(eps);
+    const size_t count2 = count & ~0x1ULL;
+    size_t       i = 0;
+
+    // check all values that can be processed in blocks of 2
+    for (; i < count2 * 4; i += 8) {
+        const f256 in = loadu8f(rgba + i);
+        const f256 diff = abs8f(sub8f(in, colour));
+        const f256 cmp = cmpgt8f(diff, eps8);
+        if (movemask8f(cmp))
+            return false;
+    }
+
+    if (count & 1) {
+        const f128 in = loadu4f(rgba + i);
+        const f128 diff = abs4f(sub4f(in, extract4f(colour, 0)));
+        const f128 cmp = cmpgt4f(diff, extract4f(eps8, 0));
+        if (movemask4f(cmp))
+            return false;
+    }
+    return true;
+}
+
+const DiffCoreKernels kernels = { "avx2",
+                                  vec3AreAllTheSame,
+                                  compareFloatArray,
+                                  compareDoubleArray,
+                                  compareUvArray,
+                                  compareUvArrayToValue,
+                                  compareRGBAArray };
+
+} // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+const DiffCoreKernels* avx2DiffCoreKernels() { return &kernels; }
+
+#else
+
+//----------------------------------------------------------------------------------------------------------------------
+const DiffCoreKernels* avx2DiffCoreKernels() { return nullptr; }
+
+#endif
+
+} // namespace MayaUsdUtils
@@ -0,0 +1,258 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is compiled with AVX-512F enabled (see CMakeLists.txt), and is only ever called after
+// DiffCore.cpp has checked that the host CPU supports it. Avoid inline helpers from the standard
+// library in here (std::min, std::abs, ...), since an out-of-line copy compiled with AVX-512 could
+// be picked by the linker for the baseline code path too.
+//
+// All of the kernels process the tail of the arrays with masked loads, which never touch the
+// masked out memory, and set the masked out elements to zero so they always compare as equal.
+//
+#include "DiffCoreKernels.h"
+
+#include <mayaUsdUtils/SIMD.h>
+
+namespace MayaUsdUtils {
+
+#if defined(__AVX512F__)
+
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+bool vec3AreAllTheSame(const float* array, size_t count)
+{
+    // if already at the end of the array, we're done
+    if (count <= 1) {
+        return true;
+    }
+
+    const float x = array[0];
+    const float y = array[1];
+    const float z = array[2];
+
+    // 16 x 3D vectors span exactly 3 registers, so the pattern to compare against repeats every
+    // 48 floats. Test the first 16 vectors one by one to build it.
+    for (size_t i = 3, n = 3 * (count < 16 ? count : 16); i < n; i += 3) {
+        if (x != array[i] || y != array[i + 1] || z != array[i + 2])
+            return false;
+    }
+    if (count <= 16) {
+        return true;
+    }
+
+    const f512 first16[3] = { loadu16f(array + 0), loadu16f(array + 16), loadu16f(array + 32) };
+
+    // now test groups of 16 x 3D vectors
+    const size_t n = 3 * count;
+    size_t       i = 3 * 16;
+    for (; i + 48 <= n; i += 48) {
+        const mask16 cmp = cmpne16f(first16[0], loadu16f(array + i + 0), 0xFFFF)
+            | cmpne16f(first16[1], loadu16f(array + i + 16), 0xFFFF)
+            | cmpne16f(first16[2], loadu16f(array + i + 32), 0xFFFF);
+        if (cmp)
+            return false;
+    }
+
+    // and the remaining 0 -> 15 vectors
+    for (int r = 0; i < n; ++r, i += 16) {
+        const mask16 mask = firstN16(n - i);
+        if (cmpne16f(first16[r], loadmask16f(array + i, mask), mask))
+            return false;
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool compareFloatArray(
+    const float* const input0,
+    const float* const input1,
+    const size_t       count,
+    const float        eps)
+{
+    const f512   eps16 = splat16f(eps);
+    const size_t count16 = count & ~0xFULL;
+    size_t       i = 0;
+
+    // check all values that can be processed in blocks of 16
+    for (; i < count16; i += 16) {
+        const f512 diff = abs16f(sub16f(loadu16f(input0 + i), loadu16f(input1 + i)));
+        if (cmpgt16f(diff, eps16))
+            return false;
+    }
+
+    const mask16 mask = firstN16(count - i);
+    const f512   diff = abs16f(sub16f(loadmask16f(input0 + i, mask), loadmask16f(input1 + i, mask)));
+    return cmpgt16f(diff, eps16) == 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool compareDoubleArray(
+    const double* const input0,
+    const double* const input1,
+    const size_t        count,
+    const double        eps)
+{
+    const d512   eps8 = splat8d(eps);
+    const size_t count8 = count & ~0x7ULL;
+    size_t       i = 0;
+
+    // check all values that can be processed in blocks of 8
+    for (; i < count8; i += 8) {
+        const d512 diff = abs8d(sub8d(loadu8d(input0 + i), loadu8d(input1 + i)));
+        if (cmpgt8d(diff, eps8))
+            return false;
+    }
+
+    const mask8 mask = firstN8(count - i);
+    const d512  diff = abs8d(sub8d(loadmask8d(input0 + i, mask), loadmask8d(input1 + i, mask)));
+    return cmpgt8d(diff, eps8) == 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool compareUvArray(
+    const float* const u0,
+    const float* const v0,
+    const float* const uv1,
+    const size_t       count,
+    const float        eps)
+{
+    const f512   eps16 = splat16f(eps);
+    const size_t count16 = count & ~0xFULL;
+    size_t       i = 0, j = 0;
+
+    // check all values that can be processed in blocks of 16
+    for (; i < count16; i += 16, j += 32) {
+        const f512 inu0 = loadu16f(u0 + i);
+        const f512 inv0 = loadu16f(v0 + i);
+
+        // zip U and V arrays together
+        const f512 inuv0a = interleavelo16f(inu0, inv0);
+        const f512 inuv0b = interleavehi16f(inu0, inv0);
+
+        const f512 diff0 = abs16f(sub16f(inuv0a, loadu16f(uv1 + j)));
+        const f512 diff1 = abs16f(sub16f(inuv0b, loadu16f(uv1 + j + 16)));
+        if (cmpgt16f(diff0, eps16) | cmpgt16f(diff1, eps16))
+            return false;
+    }
+
+    if (i != count) {
+        const size_t remaining = count - i;
+        const mask16 mask = firstN16(remaining);
+        const f512   inu0 = loadmask16f(u0 + i, mask);
+        const f512   inv0 = loadmask16f(v0 + i, mask);
+        const f512   inuv0a = interleavelo16f(inu0, inv0);
+        const f512   inuv0b = interleavehi16f(inu0, inv0);
+
+        // 2 floats per UV, so the tail of uv1 spans up to 30 floats
+        const mask16 maska = firstN16(remaining << 1);
+        const mask16 maskb = remaining > 8 ? firstN16((remaining - 8) << 1) : mask16(0);
+        const f512   diff0 = abs16f(sub16f(inuv0a, loadmask16f(uv1 + j, maska)));
+        const f512   diff1 = abs16f(sub16f(inuv0b, loadmask16f(uv1 + j + 16, maskb)));
+        if (cmpgt16f(diff0, eps16) | cmpgt16f(diff1, eps16))
+            return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool compareUvArrayToValue(
+    const float        u0,
+    const float        v0,
+    const float* const u1,
+    const float* const v1,
+    const size_t       count,
+    const float        eps)
+{
+    const f512 U = splat16f(u0);
+    const f512 V = splat16f(v0);
+
+    const f512   eps16 = splat16f(eps);
+    const size_t count16 = count & ~0xFULL;
+    size_t       i = 0;
+
+    // check all values that can be processed in blocks of 16
+    for (; i < count16; i += 16) {
+        const f512 diffu = abs16f(sub16f(loadu16f(u1 + i), U));
+        const f512 diffv = abs16f(sub16f(loadu16f(v1 + i), V));
+        if (cmpgt16f(diffu, eps16) | cmpgt16f(diffv, eps16))
+            return false;
+    }
+
+    if (i != count) {
+        // masked compares, the masked out zeros would otherwise be compared to U and V
+        const mask16 mask = firstN16(count - i);
+        const f512   diffu = abs16f(sub16f(loadmask16f(u1 + i, mask), U));
+        const f512   diffv = abs16f(sub16f(loadmask16f(v1 + i, mask), V));
+        if ((cmpgt16f(diffu, eps16) | cmpgt16f(diffv, eps16)) & mask)
+            return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool compareRGBAArray(
+    const float        r,
+    const float        g,
+    const float        b,
+    const float        a,
+    const float* const rgba,
+    const size_t       count,
+    const float        eps)
+{
+    const f512   colour = set4x4f(r, g, b, a);
+    const f512   eps16 = splat16f(eps);
+    const size_t n = count * 4;
+    size_t       i = 0;
+
+    // check all values that can be processed in blocks of 4 colours
+    for (; i + 16 <= n; i += 16) {
+        const f512 diff = abs16f(sub16f(loadu16f(rgba + i), colour));
+        if (cmpgt16f(diff, eps16))
+            return false;
+    }
+
+    if (i != n) {
+        const mask16 mask = firstN16(n - i);
+        const f512   diff = abs16f(sub16f(loadmask16f(rgba + i, mask), colour));
+        if (cmpgt16f(diff, eps16) & mask)
+            return false;
+    }
+    return true;
+}
+
+const DiffCoreKernels kernels = { "avx512",
+                                  vec3AreAllTheSame,
+                                  compareFloatArray,
+                                  compareDoubleArray,
+                                  compareUvArray,
+                                  compareUvArrayToValue,
+                                  compareRGBAArray };
+
+} // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+const DiffCoreKernels* avx512DiffCoreKernels() { return &kernels; }
+
+#else
+
+//----------------------------------------------------------------------------------------------------------------------
+const DiffCoreKernels* avx512DiffCoreKernels() { return nullptr; }
+
+#endif
+
+} // namespace MayaUsdUtils
@@ -0,0 +1,81 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include <cstddef>
+
+namespace MayaUsdUtils {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The table of compare kernels that are dispatched at runtime. One table exists per
+///         instruction set, each one living in a translation unit compiled with the matching ISA
+///         flags. The array sizes have already been checked against each other by the public
+///         functions in DiffCore.cpp, so the kernels only receive a single element count.
+//----------------------------------------------------------------------------------------------------------------------
+struct DiffCoreKernels
+{
+    const char* name;
+
+    bool (*vec3AreAllTheSame)(const float* array, size_t count);
+
+    bool (*compareFloatArray)(
+        const float* input0,
+        const float* input1,
+        size_t       count,
+        float        eps);
+
+    bool (*compareDoubleArray)(
+        const double* input0,
+        const double* input1,
+        size_t        count,
+        double        eps);
+
+    bool (*compareUvArray)(
+        const float* u0,
+        const float* v0,
+        const float* uv1,
+        size_t       count,
+        float        eps);
+
+    bool (*compareUvArrayToValue)(
+        float        u0,
+        float        v0,
+        const float* u1,
+        const float* v1,
+        size_t       count,
+        float        eps);
+
+    bool (*compareRGBAArray)(
+        float        r,
+        float        g,
+        float        b,
+        float        a,
+        const float* rgba,
+        size_t       count,
+        float        eps);
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns the AVX2 kernels, or nullptr if the library was built without them.
+//----------------------------------------------------------------------------------------------------------------------
+const DiffCoreKernels* avx2DiffCoreKernels();
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns the AVX-512 kernels, or nullptr if the library was built without them.
+//----------------------------------------------------------------------------------------------------------------------
+const DiffCoreKernels* avx512DiffCoreKernels();
+
+} // namespace MayaUsdUtils
@@ -15,7 +15,12 @@
 //
 #include "DiffPrims.h"
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_group.h>
+
 #include <map>
+#include <vector>
 
 namespace MayaUsdUtils {
 
@@ -33,8 +38,67 @@ using UsdRelationship = PXR_NS::UsdRelationship;
         }                                              \
     } while (false)
 
-DiffResultPerToken
-comparePrimsAttributes(const UsdPrim& modified, const UsdPrim& baseline, DiffResult* quickDiff)
+namespace {
+
+/// The result of one of the items compared by compareItems().
+struct ItemResult
+{
+    bool       compared { false };
+    DiffResult result { DiffResult::Same };
+};
+
+/// Compares each item, on the TBB worker threads when requested. The result of each item is kept
+/// at the index of the item so that the callers gather them in the same order as when compared
+/// serially. With a quick result, the first difference stops the comparisons still to be done and
+/// the items that were not compared are flagged as such.
+template <class ITEM, class COMPARE>
+std::vector<ItemResult> compareItems(
+    const std::vector<ITEM>& items,
+    bool                     quick,
+    DiffThreading            threading,
+    const COMPARE&           compare)
+{
+    std::vector<ItemResult> results(items.size());
+
+    const auto compareRange = [&](size_t begin, size_t end, tbb::task_group_context* context) {
+        for (size_t i = begin; i != end; ++i) {
+            if (context && context->is_group_execution_cancelled())
+                return;
+
+            DiffResult itemQuickDiff = DiffResult::Same;
+            results[i].result = compare(items[i], quick ? &itemQuickDiff : nullptr);
+            results[i].compared = true;
+
+            if (quick && results[i].result != DiffResult::Same) {
+                if (context)
+                    context->cancel_group_execution();
+                return;
+            }
+        }
+    };
+
+    if (threading == DiffThreading::Parallel && items.size() > 1) {
+        tbb::task_group_context context;
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, items.size()),
+            [&](const tbb::blocked_range<size_t>& range) {
+                compareRange(range.begin(), range.end(), &context);
+            },
+            context);
+    } else {
+        compareRange(0, items.size(), nullptr);
+    }
+
+    return results;
+}
+
+} // namespace
+
+DiffResultPerToken comparePrimsAttributes(
+    const UsdPrim& modified,
+    const UsdPrim& baseline,
+    DiffResult*    quickDiff,
+    DiffThreading  threading)
 {
     DiffResultPerToken results;
 
@@ -53,18 +117,26 @@ comparePrimsAttributes(const UsdPrim& modified, const UsdPrim& baseline, DiffRes
     // Compare the attributes from the modified prim.
     // Baseline attributes map won't change from now on, so cache the end.
     {
-        const auto baselineEnd = baselineAttrs.end();
-        for (const UsdAttribute& attr : modified.GetAuthoredAttributes()) {
-            const TfToken& name = attr.GetName();
-            const auto     iter = baselineAttrs.find(name);
-            if (iter == baselineEnd) {
-                USD_MAYA_RETURN_QUICK_RESULT(DiffResult::Created, results);
-                results[name] = DiffResult::Created;
-            } else {
-                const DiffResult result = compareAttributes(attr, iter->second, quickDiff);
-                USD_MAYA_RETURN_QUICK_RESULT(result, results);
-                results[name] = result;
-            }
+        const auto                      baselineEnd = baselineAttrs.end();
+        const std::vector<UsdAttribute> attrs = modified.GetAuthoredAttributes();
+        const std::vector<ItemResult>   attrResults = compareItems(
+            attrs,
+            quickDiff != nullptr,
+            threading,
+            [&](const UsdAttribute& attr, DiffResult* attrQuickDiff) {
+                const auto iter = baselineAttrs.find(attr.GetName());
+                if (iter == baselineEnd)
+                    return DiffResult::Created;
+                return compareAttributes(attr, iter->second, attrQuickDiff, threading);
+            });
+
+        for (size_t i = 0; i < attrs.size(); ++i) {
+            if (!attrResults[i].compared)
+                continue;
+
+            const DiffResult result = attrResults[i].result;
+            USD_MAYA_RETURN_QUICK_RESULT(result, results);
+            results[attrs[i].GetName()] = result;
         }
     }
 
@@ -126,8 +198,11 @@ comparePrimsRelationships(const UsdPrim& modified, const UsdPrim& baseline, Diff
     return results;
 }
 
-DiffResultPerPath
-comparePrimsChildren(const UsdPrim& modified, const UsdPrim& baseline, DiffResult* quickDiff)
+DiffResultPerPath comparePrimsChildren(
+    const UsdPrim& modified,
+    const UsdPrim& baseline,
+    DiffResult*    quickDiff,
+    DiffThreading  threading)
 {
     DiffResultPerPath results;
 
@@ -146,17 +221,27 @@ comparePrimsChildren(const UsdPrim& modified, const UsdPrim& baseline, DiffResul
     // Compare the children from the modified prim.
     // Baseline children map won't change from now on, so cache the end.
     {
-        const auto baselineEnd = baselineChildren.end();
-        for (const UsdPrim& child : modified.GetAllChildren()) {
-            const SdfPath& path = child.GetPath();
-            const auto     iter = baselineChildren.find(path);
-            if (iter == baselineEnd) {
-                USD_MAYA_RETURN_QUICK_RESULT(DiffResult::Created, results);
-                results[path] = DiffResult::Created;
-            } else {
-                results[path] = comparePrims(child, iter->second, quickDiff);
-                USD_MAYA_RETURN_QUICK_RESULT(*quickDiff, results);
-            }
+        const auto                    baselineEnd = baselineChildren.end();
+        const auto                    childrenRange = modified.GetAllChildren();
+        const std::vector<UsdPrim>    children(childrenRange.begin(), childrenRange.end());
+        const std::vector<ItemResult> childResults = compareItems(
+            children,
+            quickDiff != nullptr,
+            threading,
+            [&](const UsdPrim& child, DiffResult* childQuickDiff) {
+                const auto iter = baselineChildren.find(child.GetPath());
+                if (iter == baselineEnd)
+                    return DiffResult::Created;
+                return comparePrims(child, iter->second, childQuickDiff, threading);
+            });
+
+        for (size_t i = 0; i < children.size(); ++i) {
+            if (!childResults[i].compared)
+                continue;
+
+            const DiffResult result = childResults[i].result;
+            USD_MAYA_RETURN_QUICK_RESULT(result, results);
+            results[children[i].GetPath()] = result;
         }
     }
 
@@ -176,7 +261,8 @@ static DiffResult comparePrims(
     const PXR_NS::UsdPrim& modified,
     const PXR_NS::UsdPrim& baseline,
     bool                   compareChildren,
-    DiffResult*            quickDiff)
+    DiffResult*            quickDiff,
+    DiffThreading          threading)
 {
     if (quickDiff)
         *quickDiff = DiffResult::Same;
@@ -198,7 +284,7 @@ static DiffResult comparePrims(
     // Note: we will short-cut to DifResult::Differ as soon as we detect one such result.
 
     {
-        const auto attrDiffs = comparePrimsAttributes(modified, baseline, quickDiff);
+        const auto attrDiffs = comparePrimsAttributes(modified, baseline, quickDiff, threading);
         USD_MAYA_RETURN_QUICK_RESULT(*quickDiff, *quickDiff);
 
         // Note: no need to quick result when computing overall result as it would already have
@@ -226,7 +312,7 @@ static DiffResult comparePrims(
     }
 
     if (compareChildren) {
-        const auto childrenDiffs = comparePrimsChildren(modified, baseline, quickDiff);
+        const auto childrenDiffs = comparePrimsChildren(modified, baseline, quickDiff, threading);
         USD_MAYA_RETURN_QUICK_RESULT(*quickDiff, *quickDiff);
 
         // Note: no need to quick result when computing overall result as it would already have
@@ -243,17 +329,19 @@ static DiffResult comparePrims(
 DiffResult comparePrims(
     const PXR_NS::UsdPrim& modified,
     const PXR_NS::UsdPrim& baseline,
-    DiffResult*            quickDiff)
+    DiffResult*            quickDiff,
+    DiffThreading          threading)
 {
-    return comparePrims(modified, baseline, true, quickDiff);
+    return comparePrims(modified, baseline, true, quickDiff, threading);
 }
 
 DiffResult comparePrimsOnly(
     const PXR_NS::UsdPrim& modified,
     const PXR_NS::UsdPrim& baseline,
-    DiffResult*            quickDiff)
+    DiffResult*            quickDiff,
+    DiffThreading          threading)
 {
-    return comparePrims(modified, baseline, false, quickDiff);
+    return comparePrims(modified, baseline, false, quickDiff, threading);
 }
 
 } // namespace MayaUsdUtils
@@ -52,6 +52,16 @@ enum class DiffResult
     Differ     // The item differs from the baseline in a more complex way.
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+/// How the comparisons are run. The results are the same in both cases, except for the partial
+/// results returned when a quick result is requested.
+enum class DiffThreading
+{
+    Serial,  // Everything is compared on the calling thread.
+    Parallel // Children prims, attributes, time samples and large arrays are compared on the TBB
+             // worker threads. With a quick result, the first difference found stops the others.
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 /// The set of differences for each token. For example:
 ///    - For each property that were compared between two prims.
@@ -90,13 +100,15 @@ template <class MAP> MAYA_USD_UTILS_PUBLIC DiffResult computeOverallResult(const
 /// \param  modified the potentially modified prim that is compared.
 /// \param  baseline the prim that is used as the baseline for the comparison.
 /// \param  quickDiff if not null, returns a result other than Same when a difference is found.
+/// \param  threading whether to run the comparison on the TBB worker threads.
 /// \return the overall result, all results are possible.
 //----------------------------------------------------------------------------------------------------------------------
 MAYA_USD_UTILS_PUBLIC
 DiffResult comparePrims(
     const PXR_NS::UsdPrim& modified,
     const PXR_NS::UsdPrim& baseline,
-    DiffResult*            quickDiff = nullptr);
+    DiffResult*            quickDiff = nullptr,
+    DiffThreading          threading = DiffThreading::Serial);
 
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  compares a modified prim to a baseline one but not their children.
@@ -104,32 +116,37 @@ DiffResult comparePrims(
 /// \param  modified the potentially modified prim that is compared.
 /// \param  baseline the prim that is used as the baseline for the comparison.
 /// \param  quickDiff if not null, returns a result other than Same when a difference is found.
+/// \param  threading whether to run the comparison on the TBB worker threads.
 /// \return the overall result, all results are possible.
 //----------------------------------------------------------------------------------------------------------------------
 MAYA_USD_UTILS_PUBLIC
 DiffResult comparePrimsOnly(
     const PXR_NS::UsdPrim& modified,
     const PXR_NS::UsdPrim& baseline,
-    DiffResult*            quickDiff = nullptr);
+    DiffResult*            quickDiff = nullptr,
+    DiffThreading          threading = DiffThreading::Serial);
 
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  compares all the children of a modified prim to a baseline one.
 /// \param  modified the potentially modified prim that is compared.
 /// \param  baseline the prim that is used as the baseline for the comparison.
 /// \param  quickDiff if not null, returns a result other than Same when a difference is found.
+/// \param  threading whether to run the comparison on the TBB worker threads.
 /// \return the map of children paths to the result of comparison of that child.
 //----------------------------------------------------------------------------------------------------------------------
 MAYA_USD_UTILS_PUBLIC
 DiffResultPerPath comparePrimsChildren(
     const PXR_NS::UsdPrim& modified,
     const PXR_NS::UsdPrim& baseline,
-    DiffResult*            quickDiff = nullptr);
+    DiffResult*            quickDiff = nullptr,
+    DiffThreading          threading = DiffThreading::Serial);
 
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  compares all the attributes of a modified prim to a baseline one.
 /// \param  modified the potentially modified prim that is compared.
 /// \param  baseline the prim that is used as the baseline for the comparison.
 /// \param  quickDiff if not null, returns a result other than Same when a difference is found.
+/// \param  threading whether to run the comparison on the TBB worker threads.
 /// \return the map of attribute names to the result of comparison of that attribute.
 /// Currently Subset and Superset are never returned.
 //----------------------------------------------------------------------------------------------------------------------
@@ -137,7 +154,8 @@ MAYA_USD_UTILS_PUBLIC
 DiffResultPerToken comparePrimsAttributes(
     const PXR_NS::UsdPrim& modified,
     const PXR_NS::UsdPrim& baseline,
-    DiffResult*            quickDiff = nullptr);
+    DiffResult*            quickDiff = nullptr,
+    DiffThreading          threading = DiffThreading::Serial);
 
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  compares all the relationships of a modified prim to a baseline one.
@@ -162,6 +180,7 @@ DiffResultPerPathPerToken comparePrimsRelationships(
 /// \param  modified the potentially modified attribute that is compared.
 /// \param  baseline the attribute that is used as the baseline for the comparison.
 /// \param  quickDiff if not null, returns a result other than Same when a difference is found.
+/// \param  threading whether to run the comparison on the TBB worker threads.
 /// \return the result of the comparison of that modified attribute.
 /// Currently Subset and Superset are never returned.
 //----------------------------------------------------------------------------------------------------------------------
@@ -169,13 +188,15 @@ MAYA_USD_UTILS_PUBLIC
 DiffResult compareAttributes(
     const PXR_NS::UsdAttribute& modified,
     const PXR_NS::UsdAttribute& baseline,
-    DiffResult*                 quickDiff = nullptr);
+    DiffResult*                 quickDiff = nullptr,
+    DiffThreading               threading = DiffThreading::Serial);
 
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  compares a modified attribute to a baseline one at a given time code.
 /// \param  modified the potentially modified attribute that is compared.
 /// \param  baseline the attribute that is used as the baseline for the comparison.
 /// \param  timeCode the time code at which to compare the attributes.
+/// \param  threading whether to compare large array values on the TBB worker threads.
 /// \return the result of the comparison of that modified attribute.
 /// Currently Subset and Superset are never returned.
 //----------------------------------------------------------------------------------------------------------------------
@@ -183,7 +204,8 @@ MAYA_USD_UTILS_PUBLIC
 DiffResult compareAttributes(
     const PXR_NS::UsdAttribute& modified,
     const PXR_NS::UsdAttribute& baseline,
-    const PXR_NS::UsdTimeCode&  timeCode);
+    const PXR_NS::UsdTimeCode&  timeCode,
+    DiffThreading               threading = DiffThreading::Serial);
 
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  compares all the targets of a modified relationship to a baseline one.
@@ -239,11 +261,15 @@ std::unordered_set<PXR_NS::TfToken, PXR_NS::TfToken::HashFunctor>& getIgnoredMet
 /// \brief  compares a modified value to a baseline value.
 /// \param  modified the potentially modified value that is compared.
 /// \param  baseline the value that is used as the baseline for the comparison.
+/// \param  threading whether to compare large array values on the TBB worker threads.
 /// \return the result of the comparison of that modified value.
 /// Currently Subset and Superset are never returned.
 //----------------------------------------------------------------------------------------------------------------------
 MAYA_USD_UTILS_PUBLIC
-DiffResult compareValues(const PXR_NS::VtValue& modified, const PXR_NS::VtValue& baseline);
+DiffResult compareValues(
+    const PXR_NS::VtValue& modified,
+    const PXR_NS::VtValue& baseline,
+    DiffThreading          threading = DiffThreading::Serial);
 
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  compares a modified list of items to a baseline list.
@@ -33,6 +33,12 @@
 #include <pxr/base/vt/value.h>
 #include <pxr/usd/sdf/valueTypeName.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_group.h>
+
+#include <atomic>
+
 namespace MayaUsdUtils {
 
 using VtValue = PXR_NS::VtValue;
@@ -48,12 +54,49 @@ namespace {
 //
 // For a duo of empty values, it returns a function that always returns DiffResult::Same.
 
-using DiffFunc = std::function<DiffResult(const VtValue& modified, const VtValue& baseline)>;
+using DiffFunc = std::function<
+    DiffResult(const VtValue& modified, const VtValue& baseline, DiffThreading threading)>;
 using DiffKey = std::pair<std::type_index, std::type_index>;
 using DiffFuncMap = std::map<DiffKey, DiffFunc>;
 
+//----------------------------------------------------------------------------------------------------------------------
+// Large arrays are split in chunks compared on the TBB worker threads when the comparison is
+// parallel. The elements are compared one by one, so the chunks give the same result as a single
+// comparison.
+
+constexpr size_t kParallelArraySize = 1 << 16; // Number of elements from which arrays are split.
+constexpr size_t kArrayChunkSize = 1 << 14;    // Number of elements compared by each task.
+
+template <class T1, class T2>
+bool compareArrayInChunks(
+    const T1* const     input0,
+    const T2* const     input1,
+    const size_t        count0,
+    const size_t        count1,
+    const DiffThreading threading)
+{
+    if (threading == DiffThreading::Serial || count0 != count1 || count0 < kParallelArraySize)
+        return compareArray(input0, input1, count0, count1);
+
+    tbb::task_group_context context;
+    std::atomic<bool>       same { true };
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, count0, kArrayChunkSize),
+        [&](const tbb::blocked_range<size_t>& range) {
+            const size_t start = range.begin();
+            if (!compareArray(input0 + start, input1 + start, range.size(), range.size())) {
+                same = false;
+                context.cancel_group_execution();
+            }
+        },
+        context);
+
+    return same;
+}
+
 template <class T1, class T2>
-DiffResult diffTwoTypesWithEps(const VtValue& modified, const VtValue& baseline)
+DiffResult
+diffTwoTypesWithEps(const VtValue& modified, const VtValue& baseline, DiffThreading /*threading*/)
 {
     const T1& v1 = modified.Get<T1>();
     const T2& v2 = baseline.Get<T2>();
@@ -61,28 +104,38 @@ DiffResult diffTwoTypesWithEps(const VtValue& modified, const VtValue& baseline)
 }
 
 template <class T1, class T2>
-DiffResult diffTwoArrayTypesWithEps(const VtValue& modified, const VtValue& baseline)
+DiffResult
+diffTwoArrayTypesWithEps(const VtValue& modified, const VtValue& baseline, DiffThreading threading)
 {
     const VtArray<T1>& v1 = modified.Get<VtArray<T1>>();
     const VtArray<T2>& v2 = baseline.Get<VtArray<T2>>();
-    return compareArray(v1.cdata(), v2.cdata(), modified.GetArraySize(), baseline.GetArraySize())
+    return compareArrayInChunks(
+               v1.cdata(),
+               v2.cdata(),
+               modified.GetArraySize(),
+               baseline.GetArraySize(),
+               threading)
         ? DiffResult::Same
         : DiffResult::Differ;
 }
 
-template <class T> DiffResult diffOneTypeWithEps(const VtValue& modified, const VtValue& baseline)
+template <class T>
+DiffResult
+diffOneTypeWithEps(const VtValue& modified, const VtValue& baseline, DiffThreading threading)
 {
-    return diffTwoTypesWithEps<T, T>(modified, baseline);
+    return diffTwoTypesWithEps<T, T>(modified, baseline, threading);
 }
 
 template <class T>
-DiffResult diffOneArrayTypeWithEps(const VtValue& modified, const VtValue& baseline)
+DiffResult
+diffOneArrayTypeWithEps(const VtValue& modified, const VtValue& baseline, DiffThreading threading)
 {
-    return diffTwoArrayTypesWithEps<T, T>(modified, baseline);
+    return diffTwoArrayTypesWithEps<T, T>(modified, baseline, threading);
 }
 
 template <class V1, class V2, int SIZE>
-DiffResult diffTwoVecs(const VtValue& modified, const VtValue& baseline)
+DiffResult
+diffTwoVecs(const VtValue& modified, const VtValue& baseline, DiffThreading /*threading*/)
 {
     const V1& v1 = modified.Get<V1>();
     const V2& v2 = baseline.Get<V2>();
@@ -90,23 +143,26 @@ DiffResult diffTwoVecs(const VtValue& modified, const VtValue& baseline)
 }
 
 template <class V1, class V2, int SIZE>
-DiffResult diffTwoVecArrays(const VtValue& modified, const VtValue& baseline)
+DiffResult
+diffTwoVecArrays(const VtValue& modified, const VtValue& baseline, DiffThreading threading)
 {
     const VtArray<V1>& v1 = modified.Get<VtArray<V1>>();
     const VtArray<V2>& v2 = baseline.Get<VtArray<V2>>();
     using V1ValueType = typename V1::ScalarType;
     using V2ValueType = typename V2::ScalarType;
-    return compareArray(
+    return compareArrayInChunks(
                reinterpret_cast<const V1ValueType*>(v1.cdata()),
                reinterpret_cast<const V2ValueType*>(v2.cdata()),
                modified.GetArraySize() * SIZE,
-               baseline.GetArraySize() * SIZE)
+               baseline.GetArraySize() * SIZE,
+               threading)
         ? DiffResult::Same
         : DiffResult::Differ;
 }
 
 template <class V1, class V2, int SIZE>
-DiffResult diffTwoQuats(const VtValue& modified, const VtValue& baseline)
+DiffResult
+diffTwoQuats(const VtValue& modified, const VtValue& baseline, DiffThreading /*threading*/)
 {
     const V1& v1 = modified.Get<V1>();
     const V2& v2 = baseline.Get<V2>();
@@ -122,27 +178,33 @@ DiffResult diffTwoQuats(const VtValue& modified, const VtValue& baseline)
 }
 
 template <class V1, class V2, int SIZE>
-DiffResult diffTwoQuatArrays(const VtValue& modified, const VtValue& baseline)
+DiffResult
+diffTwoQuatArrays(const VtValue& modified, const VtValue& baseline, DiffThreading threading)
 {
     const VtArray<V1>& v1 = modified.Get<VtArray<V1>>();
     const VtArray<V2>& v2 = baseline.Get<VtArray<V2>>();
     using V1ValueType = typename V1::ScalarType;
     using V2ValueType = typename V2::ScalarType;
-    return compareArray(
+    return compareArrayInChunks(
                reinterpret_cast<const V1ValueType*>(v1.cdata()),
                reinterpret_cast<const V2ValueType*>(v2.cdata()),
                modified.GetArraySize() * SIZE,
-               baseline.GetArraySize() * SIZE)
+               baseline.GetArraySize() * SIZE,
+               threading)
         ? DiffResult::Same
         : DiffResult::Differ;
 }
 
-DiffResult diffByDefault(const VtValue& modified, const VtValue& baseline)
+DiffResult
+diffByDefault(const VtValue& modified, const VtValue& baseline, DiffThreading /*threading*/)
 {
     return modified == baseline ? DiffResult::Same : DiffResult::Differ;
 }
 
-DiffResult diffEmpties(const VtValue& /*modified*/, const VtValue& /*baseline*/)
+DiffResult diffEmpties(
+    const VtValue& /*modified*/,
+    const VtValue& /*baseline*/,
+    DiffThreading /*threading*/)
 {
     return DiffResult::Same;
 }
@@ -282,10 +344,10 @@ DiffFunc getDiffFunction(const VtValue& modified, const VtValue& baseline)
 
 } // namespace
 
-DiffResult compareValues(const VtValue& modified, const VtValue& baseline)
+DiffResult compareValues(const VtValue& modified, const VtValue& baseline, DiffThreading threading)
 {
     DiffFunc diff = getDiffFunction(modified, baseline);
-    return diff(modified, baseline);
+    return diff(modified, baseline, threading);
 }
 
 } // namespace MayaUsdUtils
@@ -19,6 +19,9 @@
 
 #include <pxr/base/tf/stringUtils.h>
 #include <pxr/usd/sdf/copyUtils.h>
+#include <pxr/usd/sdf/listOp.h>
+#include <pxr/usd/sdf/primSpec.h>
+#include <pxr/usd/sdf/schema.h>
 #include <pxr/usd/usdGeom/xformCommonAPI.h>
 
 #include <algorithm>
@@ -789,6 +792,176 @@ bool mergeDiffPrims(
     return SdfCopySpec(srcLayer, srcPath, dstLayer, dstPath, copyValue, copyChildren);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Upper layer opinions handling.
+//
+// To ignore the opinions of the layers above the destination layer, the merge is done in a
+// temporary stage holding only the destination layer opinions. Copying the whole destination
+// layer there and back costs as much as the layer size, so only the merged subtree and its
+// ancestors are copied, unless the subtree composes prims from elsewhere in the layer.
+//----------------------------------------------------------------------------------------------------------------------
+
+bool isOutsideSubtree(const SdfPath& arcPath, const SdfPath& specPath, const SdfPath& rootPath)
+{
+    return !arcPath.MakeAbsolutePath(specPath.GetPrimPath()).HasPrefix(rootPath);
+}
+
+template <class REFERENCE>
+bool isOutsideSubtree(const REFERENCE& arc, const SdfPath& /*specPath*/, const SdfPath& rootPath)
+{
+    // Only internal references and payloads target prims of the layer.
+    return arc.GetAssetPath().empty() && !arc.GetPrimPath().HasPrefix(rootPath);
+}
+
+template <class ARC>
+bool hasArcOutsideSubtree(
+    const SdfLayerHandle& layer,
+    const SdfPath&        specPath,
+    const TfToken&        field,
+    const SdfPath&        rootPath)
+{
+    SdfListOp<ARC> arcs;
+    if (!layer->HasField(specPath, field, &arcs))
+        return false;
+
+    for (const ARC& arc : arcs.GetAppliedItems()) {
+        if (isOutsideSubtree(arc, specPath, rootPath))
+            return true;
+    }
+
+    return false;
+}
+
+bool hasArcOutsideSubtree(
+    const SdfLayerHandle& layer,
+    const SdfPath&        specPath,
+    const SdfPath&        rootPath)
+{
+    return hasArcOutsideSubtree<SdfPath>(layer, specPath, SdfFieldKeys->InheritPaths, rootPath)
+        || hasArcOutsideSubtree<SdfPath>(layer, specPath, SdfFieldKeys->Specializes, rootPath)
+        || hasArcOutsideSubtree<SdfReference>(layer, specPath, SdfFieldKeys->References, rootPath)
+        || hasArcOutsideSubtree<SdfPayload>(layer, specPath, SdfFieldKeys->Payload, rootPath);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Verifies if the opinions of the subtree at the given path in the layer can be composed without
+/// the rest of the layer.
+bool canComposeSubtreeAlone(const SdfLayerHandle& layer, const SdfPath& path)
+{
+    if (path.IsAbsoluteRootPath() || path.ContainsPrimVariantSelection())
+        return false;
+
+    // Ancestors variants could hold opinions about the subtree.
+    for (SdfPath ancestor = path.GetParentPath(); !ancestor.IsAbsoluteRootPath();
+         ancestor = ancestor.GetParentPath()) {
+        if (layer->HasField(ancestor, SdfChildrenKeys->VariantSetChildren))
+            return false;
+        if (hasArcOutsideSubtree(layer, ancestor, path))
+            return false;
+    }
+
+    bool canCompose = true;
+    layer->Traverse(path, [&layer, &path, &canCompose](const SdfPath& specPath) {
+        if (canCompose && (specPath.IsPrimPath() || specPath.IsPrimVariantSelectionPath()))
+            canCompose = !hasArcOutsideSubtree(layer, specPath, path);
+    });
+    return canCompose;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Copies the subtree at the given path to the temporary layer, along with the fields of its
+/// ancestors and of the layer pseudo-root. The other children of the ancestors are not copied.
+void copySubtreeWithAncestors(
+    const SdfLayerHandle& srcLayer,
+    const SdfLayerHandle& dstLayer,
+    const SdfPath&        path)
+{
+    const SdfSchema& schema = SdfSchema::GetInstance();
+
+    auto copyFields = [&srcLayer, &dstLayer, &schema](const SdfPath& specPath) {
+        for (const TfToken& field : srcLayer->ListFields(specPath)) {
+            if (!schema.HoldsChildren(field))
+                dstLayer->SetField(specPath, field, srcLayer->GetField(specPath, field));
+        }
+    };
+
+    copyFields(SdfPath::AbsoluteRootPath());
+    for (const SdfPath& ancestor : path.GetParentPath().GetPrefixes()) {
+        if (!srcLayer->HasSpec(ancestor))
+            break;
+        SdfJustCreatePrimInLayer(dstLayer, ancestor);
+        copyFields(ancestor);
+    }
+
+    if (srcLayer->HasSpec(path))
+        SdfCopySpec(srcLayer, path, dstLayer, path);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Copies the merged subtree back, only authoring the fields that differ.
+bool copyMergedSubtree(
+    const SdfLayerHandle& fromLayer,
+    const SdfLayerHandle& toLayer,
+    const SdfPath&        path)
+{
+    const SdfPath parentPath = path.GetParentPath();
+    if (!toLayer->HasSpec(parentPath))
+        SdfJustCreatePrimInLayer(toLayer, parentPath);
+
+    auto copyValue = [&path](SdfSpecType               specType,
+                        const TfToken&            field,
+                        const SdfLayerHandle&     srcLayer,
+                        const SdfPath&            srcPath,
+                        bool                      fieldInSrc,
+                        const SdfLayerHandle&     dstLayer,
+                        const SdfPath&            dstPath,
+                        bool                      fieldInDst,
+                        boost::optional<VtValue>* valueToCopy) {
+        if (fieldInSrc && fieldInDst
+            && srcLayer->GetField(srcPath, field) == dstLayer->GetField(dstPath, field))
+            return false;
+
+        return SdfShouldCopyValue(
+            path,
+            path,
+            specType,
+            field,
+            srcLayer,
+            srcPath,
+            fieldInSrc,
+            dstLayer,
+            dstPath,
+            fieldInDst,
+            valueToCopy);
+    };
+
+    auto copyChildren = [&path](
+                            const TfToken&            childrenField,
+                            const SdfLayerHandle&     srcLayer,
+                            const SdfPath&            srcPath,
+                            bool                      fieldInSrc,
+                            const SdfLayerHandle&     dstLayer,
+                            const SdfPath&            dstPath,
+                            bool                      fieldInDst,
+                            boost::optional<VtValue>* srcChildren,
+                            boost::optional<VtValue>* dstChildren) {
+        return SdfShouldCopyChildren(
+            path,
+            path,
+            childrenField,
+            srcLayer,
+            srcPath,
+            fieldInSrc,
+            dstLayer,
+            dstPath,
+            fieldInDst,
+            srcChildren,
+            dstChildren);
+    };
+
+    return SdfCopySpec(fromLayer, path, toLayer, path, copyValue, copyChildren);
+}
+
 } // namespace
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -810,6 +983,15 @@ bool mergePrims(
         auto           tempStage = UsdStage::CreateInMemory();
         SdfLayerHandle tempLayer = tempStage->GetSessionLayer();
 
+        if (canComposeSubtreeAlone(dstLayer, dstPath)) {
+            copySubtreeWithAncestors(dstLayer, tempLayer, dstPath);
+
+            const bool success = mergeDiffPrims(
+                options, srcStage, srcLayer, srcPath, tempStage, tempLayer, dstPath);
+
+            return success && copyMergedSubtree(tempLayer, dstLayer, dstPath);
+        }
+
         tempLayer->TransferContent(dstLayer);
 
         const bool success
@@ -104,7 +104,9 @@ struct MergePrimsOptions
     bool mergeChildren { false };
 
     // If true, the merge is done in a temporary layer so to ignore opinions
-    // from upper layers (and children of upper layers).
+    // from upper layers (and children of upper layers). Only the merged subtree
+    // is copied to that layer, unless it composes prims from elsewhere in the
+    // destination layer, through inherits or internal references for example.
     bool ignoreUpperLayerOpinions { false };
 
     // How missing attributes are handled.
@@ -25,7 +25,7 @@
 
 #include <stdint.h>
 
-#ifdef __AVX2__
+#if defined(__AVX2__) || defined(__AVX512F__)
 #include <immintrin.h>
 #endif
 
@@ -59,7 +59,20 @@
 #define ENABLE_SOME_AVX_ROUTINES 1
 #endif
 
+// The helpers below are compiled differently depending on the instruction set flags of the
+// translation unit including this file (DiffCoreAVX2.cpp and DiffCoreAVX512.cpp are built with
+// wider ISA flags than the rest of the library). Placing them in an ISA specific inline namespace
+// ensures the linker can never merge an AVX encoded copy of a helper into the baseline code path.
+#if defined(__AVX512F__)
+#define MAYAUSD_SIMD_ISA_NAMESPACE isa_avx512
+#elif defined(__AVX2__)
+#define MAYAUSD_SIMD_ISA_NAMESPACE isa_avx2
+#else
+#define MAYAUSD_SIMD_ISA_NAMESPACE isa_baseline
+#endif
+
 namespace MayaUsdUtils {
+inline namespace MAYAUSD_SIMD_ISA_NAMESPACE {
 
 #if defined(__SSE__)
 typedef __m128  f128;
@@ -557,4 +570,74 @@ inline f128 loadmask3f(const void* const ptr, size_t count)
 }
 #endif
 
+#if defined(__AVX512F__)
+typedef __m512    f512;
+typedef __m512d   d512;
+typedef __mmask16 mask16;
+typedef __mmask8  mask8;
+
+inline f512 splat16f(const float f) { return _mm512_set1_ps(f); }
+inline d512 splat8d(const double f) { return _mm512_set1_pd(f); }
+/// \brief  repeats { a, b, c, d } over the 4 lanes of the register.
+inline f512 set4x4f(const float a, const float b, const float c, const float d)
+{
+    return _mm512_setr4_ps(a, b, c, d);
+}
+
+inline f512 loadu16f(const void* const ptr) { return _mm512_loadu_ps(ptr); }
+inline d512 loadu8d(const void* const ptr) { return _mm512_loadu_pd(ptr); }
+
+/// \brief  returns a mask selecting the first min(count, 16) elements of a register.
+inline mask16 firstN16(const size_t count)
+{
+    return count >= 16 ? mask16(0xFFFF) : mask16((1U << count) - 1U);
+}
+
+/// \brief  returns a mask selecting the first min(count, 8) elements of a register.
+inline mask8 firstN8(const size_t count)
+{
+    return count >= 8 ? mask8(0xFF) : mask8((1U << count) - 1U);
+}
+
+/// \brief  loads the elements of ptr selected by mask, and sets the other elements to zero. The
+///         masked out elements are never read, so this is safe to use on the tail of an array.
+inline f512 loadmask16f(const void* const ptr, const mask16 mask)
+{
+    return _mm512_maskz_loadu_ps(mask, ptr);
+}
+inline d512 loadmask8d(const void* const ptr, const mask8 mask)
+{
+    return _mm512_maskz_loadu_pd(mask, ptr);
+}
+
+inline f512 sub16f(const f512 a, const f512 b) { return _mm512_sub_ps(a, b); }
+inline d512 sub8d(const d512 a, const d512 b) { return _mm512_sub_pd(a, b); }
+
+inline f512 abs16f(const f512 v) { return _mm512_abs_ps(v); }
+inline d512 abs8d(const d512 v) { return _mm512_abs_pd(v); }
+
+inline mask16 cmpgt16f(const f512 a, const f512 b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+inline mask8  cmpgt8d(const d512 a, const d512 b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+inline mask16 cmpne16f(const f512 a, const f512 b, const mask16 mask)
+{
+    return _mm512_mask_cmp_ps_mask(mask, a, b, _CMP_NEQ_UQ);
+}
+
+/// \brief  interleaves the low 8 elements of a and b, i.e. { a0, b0, a1, b1 ... a7, b7 }
+inline f512 interleavelo16f(const f512 a, const f512 b)
+{
+    const __m512i index = _mm512_setr_epi32(0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+    return _mm512_permutex2var_ps(a, index, b);
+}
+
+/// \brief  interleaves the high 8 elements of a and b, i.e. { a8, b8, a9, b9 ... a15, b15 }
+inline f512 interleavehi16f(const f512 a, const f512 b)
+{
+    const __m512i index
+        = _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+    return _mm512_permutex2var_ps(a, index, b);
+}
+#endif
+
+} // namespace MAYAUSD_SIMD_ISA_NAMESPACE
 } // namespace MayaUsdUtils
@@ -0,0 +1,168 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Micro-benchmarks for the prim diffs of MayaUsdUtils.
+//
+// Merge-to-USD and the validation tooling diff whole assets with comparePrims. The diff is run
+// over synthetic in-memory hierarchies (10k prims by default), made of groups of 100 prims that
+// each hold a few scalar attributes, a points array (--points=<count>, 256 by default) and an
+// animated attribute. Each hierarchy is compared to an identical copy with a full diff, and to a
+// copy where only the last prim differs with a quick diff, serially and on all cores
+// (DiffThreading::Parallel). No Maya session is needed.
+//
+#include <mayaUsdBenchmark.h>
+#include <mayaUsdUtils/DiffPrims.h>
+
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/vt/array.h>
+#include <pxr/usd/sdf/layer.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/types.h>
+#include <pxr/usd/usd/attribute.h>
+#include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+using namespace MayaUsdUtils;
+using MayaUsdBenchmark::Benchmark;
+
+namespace {
+
+constexpr size_t kPrimsPerGroup = 100;
+constexpr size_t kTimeSamples = 24;
+
+//! The hierarchy that is diffed, an identical copy and a copy where only the last prim differs.
+struct SyntheticStages
+{
+    UsdStageRefPtr modified;
+    UsdStageRefPtr identical;
+    UsdStageRefPtr lastDiffers;
+    SdfPath        lastPrimPath;
+    size_t         primCount { 0 };
+};
+
+UsdStageRefPtr copyStage(const UsdStageRefPtr& stage)
+{
+    UsdStageRefPtr copy = UsdStage::CreateInMemory();
+    copy->GetRootLayer()->TransferContent(stage->GetRootLayer());
+    return copy;
+}
+
+SyntheticStages makeStages(const size_t targetPrims, const size_t pointCount)
+{
+    SyntheticStages stages;
+    stages.modified = UsdStage::CreateInMemory();
+
+    const SdfPath rootPath("/Root");
+    stages.modified->DefinePrim(rootPath, TfToken("Xform"));
+
+    const size_t groupCount
+        = std::max<size_t>(1, (targetPrims + kPrimsPerGroup - 1) / kPrimsPerGroup);
+    for (size_t g = 0; g < groupCount; ++g) {
+        const SdfPath groupPath = rootPath.AppendChild(TfToken("Group_" + std::to_string(g)));
+        stages.modified->DefinePrim(groupPath, TfToken("Xform"));
+
+        for (size_t p = 0; p < kPrimsPerGroup; ++p) {
+            const SdfPath primPath = groupPath.AppendChild(TfToken("Prim_" + std::to_string(p)));
+            UsdPrim       prim = stages.modified->DefinePrim(primPath, TfToken("Mesh"));
+
+            const float offset = float(g * kPrimsPerGroup + p);
+            prim.CreateAttribute(TfToken("size"), SdfValueTypeNames->Double).Set(double(offset));
+            prim.CreateAttribute(TfToken("visible"), SdfValueTypeNames->Bool).Set(true);
+            prim.CreateAttribute(TfToken("label"), SdfValueTypeNames->String)
+                .Set(primPath.GetName());
+
+            VtArray<GfVec3f> points(pointCount);
+            for (size_t i = 0; i < pointCount; ++i) {
+                points[i] = GfVec3f(offset, float(i), std::sin(float(i) * 0.1f));
+            }
+            prim.CreateAttribute(TfToken("points"), SdfValueTypeNames->Point3fArray).Set(points);
+
+            UsdAttribute animated
+                = prim.CreateAttribute(TfToken("weight"), SdfValueTypeNames->Float);
+            for (size_t t = 0; t < kTimeSamples; ++t) {
+                animated.Set(offset + float(t), UsdTimeCode(double(t)));
+            }
+
+            stages.lastPrimPath = primPath;
+            ++stages.primCount;
+        }
+    }
+
+    stages.identical = copyStage(stages.modified);
+    stages.lastDiffers = copyStage(stages.modified);
+    stages.lastDiffers->GetPrimAtPath(stages.lastPrimPath).GetAttribute(TfToken("size")).Set(-1.0);
+
+    return stages;
+}
+
+void addBenchmarks(
+    std::vector<Benchmark>& benchmarks,
+    const std::string&      name,
+    const SyntheticStages&  stages,
+    const UsdStageRefPtr&   baseline,
+    bool                    quick)
+{
+    const UsdPrim modifiedRoot = stages.modified->GetPseudoRoot();
+    const UsdPrim baselineRoot = baseline->GetPseudoRoot();
+    const size_t  n = stages.primCount;
+
+    const auto diff = [=](DiffThreading threading) {
+        DiffResult quickDiff = DiffResult::Same;
+        comparePrims(modifiedRoot, baselineRoot, quick ? &quickDiff : nullptr, threading);
+    };
+
+    benchmarks.push_back({ name + "/serial", 0, n, [=]() { diff(DiffThreading::Serial); }, true });
+    benchmarks.push_back({ name + "/parallel", 0, n, [=]() { diff(DiffThreading::Parallel); } });
+}
+
+std::vector<Benchmark> makeBenchmarks(const SyntheticStages& stages)
+{
+    std::vector<Benchmark> benchmarks;
+    addBenchmarks(benchmarks, "comparePrims/identical", stages, stages.identical, false);
+    addBenchmarks(benchmarks, "comparePrims/quick/identical", stages, stages.identical, true);
+    addBenchmarks(benchmarks, "comparePrims/quick/lastDiffers", stages, stages.lastDiffers, true);
+    return benchmarks;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    size_t pointCount = 256;
+
+    return MayaUsdBenchmark::runBenchmarks(
+        argc,
+        argv,
+        "mayaUsdUtilsBenchmarks",
+        { 10000 },
+        [&](size_t size, const MayaUsdBenchmark::RunFunction& run) {
+            const SyntheticStages stages = makeStages(size, pointCount);
+            run(stages.primCount, makeBenchmarks(stages));
+        },
+        { { "points",
+            "count",
+            [&](const std::string& value) {
+                pointCount = std::strtoull(value.c_str(), nullptr, 10);
+            } } });
+}
@@ -23,11 +23,17 @@
 
 #include <mayaUsd/nodes/stageData.h>
 
+#include <pxr/base/gf/math.h>
 #include <pxr/usd/usdGeom/mesh.h>
+#include <pxr/usd/usdGeom/tokens.h>
 
+#include <maya/MAnimControl.h>
 #include <maya/MFnMesh.h>
 #include <maya/MTime.h>
 
+#include <algorithm>
+#include <cstring>
+
 namespace AL {
 namespace usdmaya {
 namespace nodes {
@@ -41,6 +47,7 @@ MObject MeshAnimDeformer::m_inTime = MObject::kNullObj;
 MObject MeshAnimDeformer::m_inStageData = MObject::kNullObj;
 MObject MeshAnimDeformer::m_outMesh = MObject::kNullObj;
 MObject MeshAnimDeformer::m_inMesh = MObject::kNullObj;
+MObject MeshAnimDeformer::m_streaming = MObject::kNullObj;
 
 //----------------------------------------------------------------------------------------------------------------------
 MStatus MeshAnimDeformer::initialise()
@@ -61,10 +68,12 @@ MStatus MeshAnimDeformer::initialise()
             kWritable | kStorable | kConnectable);
         m_outMesh = addMeshAttr("outMesh", "out", kReadable | kStorable | kConnectable);
         m_inMesh = addMeshAttr("inMesh", "in", kWritable | kStorable | kConnectable);
+        m_streaming = addBoolAttr("streaming", "str", false, kReadable | kWritable | kStorable);
         attributeAffects(m_primPath, m_outMesh);
         attributeAffects(m_inTime, m_outMesh);
         attributeAffects(m_inStageData, m_outMesh);
         attributeAffects(m_inMesh, m_outMesh);
+        attributeAffects(m_streaming, m_outMesh);
     } catch (const MStatus& status) {
         return status;
     }
@@ -92,7 +101,11 @@ MStatus MeshAnimDeformer::compute(const MPlug& plug, MDataBlock& data)
     MObject obj = inputHandle.asMesh();
 
     UsdStageRefPtr stage = getStage();
-    if (stage) {
+    if (stage && inputBoolValue(data, m_streaming)) {
+        MFnMesh fnMesh(obj);
+        streamFrame(stage, usdTime, fnMesh);
+        outputHandle.set(obj);
+    } else if (stage) {
         UsdPrim     prim = stage->GetPrimAtPath(m_cachePath);
         UsdGeomMesh mesh(prim);
 
@@ -123,6 +136,136 @@ MStatus MeshAnimDeformer::compute(const MPlug& plug, MDataBlock& data)
     return status;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::streamFrame(
+    const UsdStageRefPtr& stage,
+    const UsdTimeCode     usdTime,
+    MFnMesh&              fnMesh)
+{
+    updateQueries(stage);
+
+    // Swap the buffers if the frame read ahead is the one being evaluated.
+    waitForPrefetch();
+    const Frame& back = m_frames[1 - m_front];
+    if (back.valid && back.time == usdTime) {
+        m_front = 1 - m_front;
+    }
+    Frame& front = m_frames[m_front];
+    if (!front.valid || front.time != usdTime) {
+        readFrame(front, usdTime);
+    }
+
+    MStatus      status;
+    float* const ptr = m_pointsAnimated ? (float*)fnMesh.getRawPoints(&status) : nullptr;
+    if (ptr) {
+        const size_t numPoints
+            = std::min(front.points.size(), static_cast<size_t>(fnMesh.numVertices()));
+        std::memcpy(ptr, front.points.cdata(), sizeof(float) * 3 * numPoints);
+    }
+
+    float* const nptr = m_normalsAnimated ? (float*)fnMesh.getRawNormals(&status) : nullptr;
+    if (nptr) {
+        const size_t numNormals
+            = std::min(front.normals.size(), static_cast<size_t>(fnMesh.numNormals()));
+        std::memcpy(nptr, front.normals.cdata(), sizeof(float) * 3 * numNormals);
+    }
+
+    prefetchFrame(usdTime);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::updateQueries(const UsdStageRefPtr& stage)
+{
+    if (!m_queriesDirty && m_stage == stage && m_queriedPath == m_cachePath) {
+        return;
+    }
+
+    // the prefetch may be reading the queries being replaced
+    waitForPrefetch();
+
+    if (m_stage != stage) {
+        m_stage = stage;
+        m_stageListener.SetStage(stage);
+        m_stageListener.SetStageObjectsChangedCallback(
+            [this](const UsdNotice::ObjectsChanged& notice) { onStageObjectsChanged(notice); });
+    }
+
+    m_queriesDirty = false;
+    m_queriedPath = m_cachePath;
+
+    UsdGeomMesh mesh(stage->GetPrimAtPath(m_queriedPath));
+    m_pointsQuery = mesh ? UsdAttributeQuery(mesh.GetPointsAttr()) : UsdAttributeQuery();
+    m_normalsQuery = mesh ? UsdAttributeQuery(mesh.GetNormalsAttr()) : UsdAttributeQuery();
+    m_pointsAnimated = m_pointsQuery.IsValid() && m_pointsQuery.ValueMightBeTimeVarying();
+    m_normalsAnimated = m_normalsQuery.IsValid() && m_normalsQuery.ValueMightBeTimeVarying();
+
+    m_frames[0].valid = false;
+    m_frames[1].valid = false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::readFrame(Frame& frame, const UsdTimeCode usdTime) const
+{
+    if (!m_pointsAnimated || !m_pointsQuery.Get(&frame.points, usdTime)) {
+        frame.points.clear();
+    }
+    if (!m_normalsAnimated || !m_normalsQuery.Get(&frame.normals, usdTime)) {
+        frame.normals.clear();
+    }
+    frame.time = usdTime;
+    frame.valid = true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::prefetchFrame(const UsdTimeCode usdTime)
+{
+    const double timeStep
+        = m_lastTime.IsDefault() ? 0.0 : usdTime.GetValue() - m_lastTime.GetValue();
+    const bool   linear = timeStep != 0.0 && GfIsClose(timeStep, m_lastTimeStep, 1e-6);
+
+    m_lastTime = usdTime;
+    m_lastTimeStep = timeStep;
+
+    // only read ahead during playback, so that the stage is not edited while being read
+    if (!linear || !(m_pointsAnimated || m_normalsAnimated) || !MAnimControl::isPlaying()) {
+        return;
+    }
+
+    Frame&            back = m_frames[1 - m_front];
+    const UsdTimeCode nextTime(usdTime.GetValue() + timeStep);
+    back.valid = false;
+    m_prefetching = true;
+    m_dispatcher.Run([this, &back, nextTime]() { readFrame(back, nextTime); });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::waitForPrefetch()
+{
+    if (m_prefetching) {
+        m_dispatcher.Wait();
+        m_prefetching = false;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::onStageObjectsChanged(const UsdNotice::ObjectsChanged& notice)
+{
+    for (const SdfPath& path : notice.GetResyncedPaths()) {
+        if (m_queriedPath.HasPrefix(path)) {
+            m_queriesDirty = true;
+            return;
+        }
+    }
+    for (const SdfPath& path : notice.GetChangedInfoOnlyPaths()) {
+        if (path.GetPrimPath() == m_queriedPath
+            && (path.GetNameToken() == UsdGeomTokens->points
+                || path.GetNameToken() == UsdGeomTokens->normals)) {
+            m_queriesDirty = true;
+            return;
+        }
+    }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MStatus MeshAnimDeformer::connectionMade(const MPlug& plug, const MPlug& otherPlug, bool asSrc)
 {
@@ -191,6 +334,7 @@ void MeshAnimDeformer::onAttributeChanged(
             } else {
                 deformer->m_cachePath = SdfPath();
             }
+            deformer->m_queriesDirty = true;
         }
     }
 }
@@ -17,12 +17,22 @@
 #include "AL/maya/utils/MayaHelperMacros.h"
 #include "AL/maya/utils/NodeHelper.h"
 
+#include <mayaUsd/listeners/stageNoticeListener.h>
+
+#include <pxr/base/vt/types.h>
+#include <pxr/base/work/dispatcher.h>
+#include <pxr/usd/usd/attributeQuery.h>
+#include <pxr/usd/usd/notice.h>
 #include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usd/timeCode.h>
 
+#include <maya/MFnMesh.h>
 #include <maya/MNodeMessage.h>
 #include <maya/MObjectHandle.h>
 #include <maya/MPxNode.h>
 
+#include <atomic>
+
 PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace AL {
@@ -31,6 +41,13 @@ namespace nodes {
 
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief   This node is a simple deformer that modifies
+///          the points and normals of a mesh to match the animated points and normals of a
+///          UsdGeomMesh.
+///
+///          In streaming mode, the points and normals attributes are resolved once, and the
+///          values of the next frame are read on a worker thread during playback, into the
+///          second of two buffers, while Maya evaluates the current frame. Values that are not
+///          time-varying are never read or copied.
 /// \ingroup nodes
 //----------------------------------------------------------------------------------------------------------------------
 class MeshAnimDeformer
@@ -45,7 +62,11 @@ public:
     {
     }
 
-    inline ~MeshAnimDeformer() { MNodeMessage::removeCallback(m_attributeChanged); }
+    inline ~MeshAnimDeformer()
+    {
+        MNodeMessage::removeCallback(m_attributeChanged);
+        waitForPrefetch();
+    }
 
     //--------------------------------------------------------------------------------------------------------------------
     /// Type Info & Registration
@@ -61,6 +82,7 @@ public:
     AL_DECL_ATTRIBUTE(inStageData);
     AL_DECL_ATTRIBUTE(inMesh);
     AL_DECL_ATTRIBUTE(outMesh);
+    AL_DECL_ATTRIBUTE(streaming);
 
 private:
     void           postConstructor() override;
@@ -70,10 +92,42 @@ private:
     MStatus        compute(const MPlug& plug, MDataBlock& data) override;
     UsdStageRefPtr getStage();
 
+    /// \brief  The points and normals read at a given time
+    struct Frame
+    {
+        UsdTimeCode  time = UsdTimeCode::Default();
+        VtVec3fArray points;
+        VtVec3fArray normals;
+        bool         valid = false;
+    };
+
+    void streamFrame(const UsdStageRefPtr& stage, UsdTimeCode usdTime, MFnMesh& fnMesh);
+    void updateQueries(const UsdStageRefPtr& stage);
+    void readFrame(Frame& frame, UsdTimeCode usdTime) const;
+    void prefetchFrame(UsdTimeCode usdTime);
+    void waitForPrefetch();
+    void onStageObjectsChanged(const UsdNotice::ObjectsChanged& notice);
+
 private:
     SdfPath       m_cachePath;
     MObjectHandle proxyShapeHandle;
     MCallbackId   m_attributeChanged = 0;
+
+    // streaming mode
+    UsdMayaStageNoticeListener m_stageListener;
+    UsdStageWeakPtr            m_stage;
+    SdfPath                    m_queriedPath;
+    UsdAttributeQuery          m_pointsQuery;
+    UsdAttributeQuery          m_normalsQuery;
+    bool                       m_pointsAnimated = false;
+    bool                       m_normalsAnimated = false;
+    std::atomic_bool           m_queriesDirty { true };
+    Frame                      m_frames[2];
+    uint32_t                   m_front = 0;
+    UsdTimeCode                m_lastTime = UsdTimeCode::Default();
+    double                     m_lastTimeStep = 0.0;
+    bool                       m_prefetching = false;
+    WorkDispatcher             m_dispatcher;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
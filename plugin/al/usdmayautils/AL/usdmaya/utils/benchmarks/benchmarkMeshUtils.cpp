@@ -0,0 +1,345 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Micro-benchmarks for the mesh conversion kernels of AL_USDMayaUtils.
+//
+// The kernels are run against synthetic quad grid meshes (1k to 10M vertices by default), with a
+// face varying UV / normal / colour set on each of them so that the guess*InterpolationType*
+// methods have to walk all of their input. Only Maya's array classes are used, so no Maya session
+// (or licence) is needed.
+//
+#include "AL/usdmaya/utils/DiffPrimVar.h"
+#include "AL/usdmaya/utils/MeshUtils.h"
+
+#include <maya/MFloatArray.h>
+#include <maya/MIntArray.h>
+
+#include <mayaUsdBenchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace AL::usdmaya::utils;
+using MayaUsdBenchmark::Benchmark;
+
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// A grid of quads, with face varying UVs, normals and colours (i.e. one unique value per
+/// face-vertex), stored in the layouts the kernels expect.
+//----------------------------------------------------------------------------------------------------------------------
+struct SyntheticMesh
+{
+    uint32_t numPoints = 0;
+    uint32_t numFaceVertices = 0;
+
+    MIntArray faceCounts;
+    MIntArray pointIndices;
+    MIntArray uvIndices;
+
+    std::vector<float>  points3f;
+    std::vector<double> points3d;
+
+    MFloatArray        u;
+    MFloatArray        v;
+    std::vector<float> uv;
+
+    std::vector<float>  normals3f;
+    std::vector<double> normals3d;
+    std::vector<float>  colours;
+};
+
+SyntheticMesh makeGridMesh(const size_t targetPoints)
+{
+    const uint32_t side = std::max(2u, uint32_t(std::ceil(std::sqrt(double(targetPoints)))));
+    const uint32_t numFaces = (side - 1) * (side - 1);
+
+    SyntheticMesh mesh;
+    mesh.numPoints = side * side;
+    mesh.numFaceVertices = numFaces * 4;
+
+    mesh.points3f.resize(mesh.numPoints * 3);
+    mesh.points3d.resize(mesh.numPoints * 3);
+    for (uint32_t i = 0; i < mesh.numPoints; ++i) {
+        const float x = float(i % side);
+        const float z = float(i / side);
+        const float y = std::sin(x * 0.1f) * std::cos(z * 0.1f);
+        mesh.points3f[i * 3 + 0] = mesh.points3d[i * 3 + 0] = x;
+        mesh.points3f[i * 3 + 1] = mesh.points3d[i * 3 + 1] = y;
+        mesh.points3f[i * 3 + 2] = mesh.points3d[i * 3 + 2] = z;
+    }
+
+    mesh.faceCounts.setLength(numFaces);
+    mesh.pointIndices.setLength(mesh.numFaceVertices);
+    mesh.uvIndices.setLength(mesh.numFaceVertices);
+    mesh.u.setLength(mesh.numFaceVertices);
+    mesh.v.setLength(mesh.numFaceVertices);
+    mesh.uv.resize(mesh.numFaceVertices * 2);
+    mesh.normals3f.resize(mesh.numFaceVertices * 3);
+    mesh.normals3d.resize(mesh.numFaceVertices * 3);
+    mesh.colours.resize(mesh.numFaceVertices * 4);
+
+    const float scale = 1.0f / float(side);
+    uint32_t    fv = 0;
+    for (uint32_t z = 0; z < side - 1; ++z) {
+        for (uint32_t x = 0; x < side - 1; ++x) {
+            const uint32_t face = z * (side - 1) + x;
+            const uint32_t corners[4][2]
+                = { { x, z }, { x + 1, z }, { x + 1, z + 1 }, { x, z + 1 } };
+            mesh.faceCounts[face] = 4;
+            for (uint32_t c = 0; c < 4; ++c, ++fv) {
+                mesh.pointIndices[fv] = corners[c][1] * side + corners[c][0];
+                mesh.uvIndices[fv] = fv;
+
+                // offset each face in UV space, so no two face-vertices share a value
+                const float u = (corners[c][0] + 0.5f * face) * scale;
+                const float v = corners[c][1] * scale;
+                mesh.u[fv] = mesh.uv[fv * 2 + 0] = u;
+                mesh.v[fv] = mesh.uv[fv * 2 + 1] = v;
+
+                const float n[3] = { float(c) * 0.25f, 1.0f, float(face & 0xFF) / 255.0f };
+                for (uint32_t k = 0; k < 3; ++k) {
+                    mesh.normals3f[fv * 3 + k] = mesh.normals3d[fv * 3 + k] = n[k];
+                }
+                mesh.colours[fv * 4 + 0] = u;
+                mesh.colours[fv * 4 + 1] = v;
+                mesh.colours[fv * 4 + 2] = n[2];
+                mesh.colours[fv * 4 + 3] = 1.0f;
+            }
+        }
+    }
+    return mesh;
+}
+
+// keeps the results of the kernels alive, so they can't be optimised away
+volatile size_t g_sink = 0;
+
+std::vector<Benchmark> makeBenchmarks(SyntheticMesh& mesh, std::vector<float>& scratch)
+{
+    const size_t np = mesh.numPoints;
+    const size_t nfv = mesh.numFaceVertices;
+    const size_t nf = mesh.faceCounts.length();
+    scratch.resize(std::max(np * 4, nfv * 2) * 2);
+    float*  out = scratch.data();
+    double* outd = reinterpret_cast<double*>(scratch.data());
+
+    const size_t f = sizeof(float);
+    const size_t d = sizeof(double);
+    const size_t i = sizeof(int32_t);
+
+    auto extract = std::make_shared<std::vector<uint32_t>>();
+
+    std::vector<Benchmark> benchmarks = {
+        // MeshUtils
+        { "floatToDouble",
+          np * 3 * (f + d),
+          np * 3,
+          [&mesh, outd, np]() { floatToDouble(outd, mesh.points3f.data(), np * 3); } },
+        { "doubleToFloat",
+          np * 3 * (f + d),
+          np * 3,
+          [&mesh, out, np]() { doubleToFloat(out, mesh.points3d.data(), np * 3); } },
+        { "convert3DArrayTo4DArray",
+          np * 7 * f,
+          np,
+          [&mesh, out, np]() { convert3DArrayTo4DArray(mesh.points3f.data(), out, np); } },
+        { "zipUVs",
+          nfv * 4 * f,
+          nfv,
+          [&mesh, out, nfv]() { zipUVs(&mesh.u[0], &mesh.v[0], out, nfv); } },
+        { "unzipUVs",
+          nfv * 4 * f,
+          nfv,
+          [&mesh, out, nfv]() { unzipUVs(mesh.uv.data(), out, out + nfv, nfv); } },
+        { "interleaveIndexedUvData",
+          nfv * (4 * f + i),
+          nfv,
+          [&mesh, out, nfv]() {
+              interleaveIndexedUvData(out, &mesh.u[0], &mesh.v[0], &mesh.uvIndices[0], nfv);
+          } },
+        { "isUvSetDataSparse",
+          nfv * i,
+          nfv,
+          [&mesh, nfv]() { g_sink = g_sink + isUvSetDataSparse(&mesh.uvIndices[0], nfv); } },
+
+        // DiffPrimVar
+        { "guessUVInterpolationType",
+          nfv * (2 * f + 2 * i),
+          nfv,
+          [&mesh]() {
+              g_sink = g_sink
+                  + guessUVInterpolationType(mesh.u, mesh.v, mesh.uvIndices, mesh.pointIndices)
+                        .Hash();
+          } },
+        { "guessUVInterpolationTypeExtended",
+          nfv * (2 * f + 3 * i) + nf * i,
+          nfv,
+          [&mesh]() {
+              g_sink = g_sink
+                  + guessUVInterpolationTypeExtended(
+                        mesh.u, mesh.v, mesh.uvIndices, mesh.pointIndices, mesh.faceCounts)
+                        .Hash();
+          } },
+        { "guessUVInterpolationTypeExtensive",
+          nfv * (2 * f + 3 * i) + nf * i,
+          nfv,
+          [&mesh, extract]() {
+              extract->clear();
+              g_sink = g_sink
+                  + guessUVInterpolationTypeExtensive(
+                        mesh.u,
+                        mesh.v,
+                        mesh.uvIndices,
+                        mesh.pointIndices,
+                        mesh.faceCounts,
+                        *extract)
+                        .Hash();
+          } },
+        { "guessVec3InterpolationType<float>",
+          nfv * (3 * f + 2 * i),
+          nfv,
+          [&mesh, nfv]() {
+              g_sink = g_sink
+                  + guessVec3InterpolationType(
+                        mesh.normals3f.data(), nfv, mesh.uvIndices, mesh.pointIndices)
+                        .Hash();
+          } },
+        { "guessVec3InterpolationTypeExtended<float>",
+          nfv * (3 * f + 3 * i) + nf * i,
+          nfv,
+          [&mesh, nfv]() {
+              g_sink = g_sink
+                  + guessVec3InterpolationTypeExtended(
+                        mesh.normals3f.data(),
+                        nfv,
+                        mesh.uvIndices,
+                        mesh.pointIndices,
+                        mesh.faceCounts)
+                        .Hash();
+          } },
+        { "guessVec3InterpolationTypeExtensive<float>",
+          nfv * (3 * f + 3 * i) + nf * i,
+          nfv,
+          [&mesh, nfv]() {
+              g_sink = g_sink
+                  + guessVec3InterpolationTypeExtensive(
+                        mesh.normals3f.data(),
+                        nfv,
+                        mesh.uvIndices,
+                        mesh.pointIndices,
+                        mesh.faceCounts)
+                        .Hash();
+          } },
+        { "guessVec3InterpolationType<double>",
+          nfv * (3 * d + 2 * i),
+          nfv,
+          [&mesh, nfv]() {
+              g_sink = g_sink
+                  + guessVec3InterpolationType(
+                        mesh.normals3d.data(), nfv, mesh.uvIndices, mesh.pointIndices)
+                        .Hash();
+          } },
+        { "guessVec3InterpolationTypeExtended<double>",
+          nfv * (3 * d + 3 * i) + nf * i,
+          nfv,
+          [&mesh, nfv]() {
+              g_sink = g_sink
+                  + guessVec3InterpolationTypeExtended(
+                        mesh.normals3d.data(),
+                        nfv,
+                        mesh.uvIndices,
+                        mesh.pointIndices,
+                        mesh.faceCounts)
+                        .Hash();
+          } },
+        { "guessVec3InterpolationTypeExtensive<double>",
+          nfv * (3 * d + 3 * i) + nf * i,
+          nfv,
+          [&mesh, nfv]() {
+              g_sink = g_sink
+                  + guessVec3InterpolationTypeExtensive(
+                        mesh.normals3d.data(),
+                        nfv,
+                        mesh.uvIndices,
+                        mesh.pointIndices,
+                        mesh.faceCounts)
+                        .Hash();
+          } },
+        { "guessVec4InterpolationType<float>",
+          nfv * (4 * f + 2 * i),
+          nfv,
+          [&mesh, nfv]() {
+              g_sink = g_sink
+                  + guessVec4InterpolationType(
+                        mesh.colours.data(), nfv, mesh.uvIndices, mesh.pointIndices)
+                        .Hash();
+          } },
+        { "guessVec4InterpolationTypeExtensive<float>",
+          nfv * (4 * f + 3 * i) + nf * i,
+          nfv,
+          [&mesh, nfv]() {
+              g_sink = g_sink
+                  + guessVec4InterpolationTypeExtensive(
+                        mesh.colours.data(),
+                        nfv,
+                        mesh.uvIndices,
+                        mesh.pointIndices,
+                        mesh.faceCounts)
+                        .Hash();
+          } },
+        { "guessColourSetInterpolationType",
+          nfv * 4 * f,
+          nfv,
+          [&mesh, nfv]() {
+              g_sink = g_sink + guessColourSetInterpolationType(mesh.colours.data(), nfv).Hash();
+          } },
+        { "guessColourSetInterpolationTypeExtensive",
+          nfv * (4 * f + i) + nf * i,
+          nfv,
+          [&mesh, nfv, np, extract]() {
+              extract->clear();
+              g_sink = g_sink
+                  + guessColourSetInterpolationTypeExtensive(
+                        mesh.colours.data(),
+                        nfv,
+                        np,
+                        mesh.pointIndices,
+                        mesh.faceCounts,
+                        *extract)
+                        .Hash();
+          } },
+    };
+    return benchmarks;
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    return MayaUsdBenchmark::runBenchmarks(
+        argc,
+        argv,
+        "AL_USDMayaUtilsBenchmarks",
+        { 1000, 10000, 100000, 1000000, 10000000 },
+        [](size_t size, const MayaUsdBenchmark::RunFunction& run) {
+            SyntheticMesh      mesh = makeGridMesh(size);
+            std::vector<float> scratch;
+            run(size, makeBenchmarks(mesh, scratch));
+        });
+}
@@ -0,0 +1,244 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef MAYAUSD_BENCHMARK_H
+#define MAYAUSD_BENCHMARK_H
+
+// Harness shared by the micro-benchmark executables (see BUILD_MAYAUSD_BENCHMARKS).
+//
+// Each executable only provides its fixture and its list of benchmarks, and calls
+// MayaUsdBenchmark::runBenchmarks from main. Results are written in the JSON layout of Google
+// Benchmark, so the existing tooling for that format (e.g. compare.py) can be used to track
+// regressions between releases:
+//
+//   <executable> [--json=<file>] [--sizes=<n,n,...>] [--filter=<substring>]
+//                [--min-time=<seconds>] [<extra arguments>]
+//
+#include <tbb/task_arena.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace MayaUsdBenchmark {
+
+struct Benchmark
+{
+    std::string           name;
+    size_t                bytes; ///< bytes read + written by one run, 0 if not meaningful
+    size_t                items; ///< elements processed by one run
+    std::function<void()> run;
+    bool                  serial { false }; ///< whether to run on a single thread
+};
+
+struct Result
+{
+    std::string name;
+    size_t      iterations;
+    double      nsPerIteration;
+    double      bytesPerSecond;
+    double      itemsPerSecond;
+};
+
+//! An executable specific argument, given as --<name>=<value>.
+struct Argument
+{
+    std::string                             name;
+    std::string                             usage;
+    std::function<void(const std::string&)> set;
+};
+
+//! Runs the benchmarks created for one fixture. size is the actual size of the fixture, which is
+//! appended to the benchmark names.
+using RunFunction = std::function<void(size_t size, const std::vector<Benchmark>&)>;
+
+//! Creates the fixture closest to the requested size, and the benchmarks for it, then hands them
+//! to run. The fixture only needs to live until run returns.
+using MakeFunction = std::function<void(size_t requestedSize, const RunFunction& run)>;
+
+inline Result runBenchmark(const Benchmark& benchmark, const size_t size, const double minTime)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // warm up the caches and any lazily allocated memory
+    benchmark.run();
+
+    size_t                        iterations = 0;
+    std::chrono::duration<double> elapsed(0);
+    const Clock::time_point       start = Clock::now();
+    do {
+        benchmark.run();
+        ++iterations;
+        elapsed = Clock::now() - start;
+    } while (elapsed.count() < minTime);
+
+    const double seconds = elapsed.count();
+    return { benchmark.name + "/" + std::to_string(size),
+             iterations,
+             seconds * 1e9 / double(iterations),
+             double(benchmark.bytes) * double(iterations) / seconds,
+             double(benchmark.items) * double(iterations) / seconds };
+}
+
+inline void
+writeJson(std::ostream& os, const std::string& executable, const std::vector<Result>& results)
+{
+    char              date[64] = { 0 };
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    os << "{\n";
+    os << "  \"context\": {\n";
+    os << "    \"date\": \"" << date << "\",\n";
+    os << "    \"executable\": \"" << executable << "\",\n";
+    os << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+    os << "    \"library_build_type\": \"release\"\n";
+#else
+    os << "    \"library_build_type\": \"debug\"\n";
+#endif
+    os << "  },\n";
+    os << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        os << (i ? ",\n" : "\n");
+        os << "    {\n";
+        os << "      \"name\": \"" << r.name << "\",\n";
+        os << "      \"run_type\": \"iteration\",\n";
+        os << "      \"iterations\": " << r.iterations << ",\n";
+        os << "      \"real_time\": " << r.nsPerIteration << ",\n";
+        os << "      \"cpu_time\": " << r.nsPerIteration << ",\n";
+        os << "      \"time_unit\": \"ns\",\n";
+        if (r.bytesPerSecond > 0.0) {
+            os << "      \"bytes_per_second\": " << r.bytesPerSecond << ",\n";
+        }
+        os << "      \"items_per_second\": " << r.itemsPerSecond << "\n";
+        os << "    }";
+    }
+    os << "\n  ]\n}\n";
+}
+
+inline bool parseArg(const char* arg, const char* name, std::string& value)
+{
+    const size_t length = std::strlen(name);
+    if (std::strncmp(arg, name, length) == 0 && arg[length] == '=') {
+        value = arg + length + 1;
+        return true;
+    }
+    return false;
+}
+
+//! Parses the command line, runs the benchmarks for each size and writes the results. Returns
+//! the exit code of the executable.
+inline int runBenchmarks(
+    int                          argc,
+    char**                       argv,
+    const std::string&           executable,
+    std::vector<size_t>          sizes,
+    const MakeFunction&          makeBenchmarks,
+    const std::vector<Argument>& arguments = {})
+{
+    std::string jsonPath;
+    std::string filter;
+    double      minTime = 0.2;
+
+    for (int a = 1; a < argc; ++a) {
+        std::string value;
+        if (parseArg(argv[a], "--json", jsonPath) || parseArg(argv[a], "--filter", filter)) {
+            continue;
+        } else if (parseArg(argv[a], "--min-time", value)) {
+            minTime = std::atof(value.c_str());
+        } else if (parseArg(argv[a], "--sizes", value)) {
+            sizes.clear();
+            std::istringstream ss(value);
+            for (std::string size; std::getline(ss, size, ',');) {
+                sizes.push_back(std::strtoull(size.c_str(), nullptr, 10));
+            }
+        } else {
+            bool parsed = false;
+            for (const Argument& argument : arguments) {
+                if (parseArg(argv[a], ("--" + argument.name).c_str(), value)) {
+                    argument.set(value);
+                    parsed = true;
+                    break;
+                }
+            }
+            if (!parsed) {
+                std::cerr << "usage: " << argv[0]
+                          << " [--json=<file>] [--sizes=<n,n,...>] [--filter=<substring>]"
+                             " [--min-time=<seconds>]";
+                for (const Argument& argument : arguments) {
+                    std::cerr << " [--" << argument.name << "=<" << argument.usage << ">]";
+                }
+                std::cerr << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    tbb::task_arena serialArena(1);
+
+    std::vector<Result> results;
+    const RunFunction   run = [&](size_t size, const std::vector<Benchmark>& benchmarks) {
+        for (const Benchmark& benchmark : benchmarks) {
+            if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) {
+                continue;
+            }
+            if (benchmark.serial) {
+                serialArena.execute(
+                    [&]() { results.push_back(runBenchmark(benchmark, size, minTime)); });
+            } else {
+                results.push_back(runBenchmark(benchmark, size, minTime));
+            }
+
+            const Result& r = results.back();
+            std::fprintf(
+                stderr,
+                "%-56s %14.0f ns %10.2f GB/s %10.3f M items/s\n",
+                r.name.c_str(),
+                r.nsPerIteration,
+                r.bytesPerSecond * 1e-9,
+                r.itemsPerSecond * 1e-6);
+        }
+    };
+    for (const size_t size : sizes) {
+        makeBenchmarks(size, run);
+    }
+
+    if (jsonPath.empty()) {
+        writeJson(std::cout, executable, results);
+    } else {
+        std::ofstream file(jsonPath);
+        if (!file) {
+            std::cerr << "unable to write " << jsonPath << std::endl;
+            return 1;
+        }
+        writeJson(file, executable, results);
+    }
+    return 0;
+}
+
+} // namespace MayaUsdBenchmark
+
+#endif // MAYAUSD_BENCHMARK_H
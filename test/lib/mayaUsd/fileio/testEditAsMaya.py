@@ -169,6 +169,10 @@ class EditAsMayaTestCase(unittest.TestCase):
             with self.assertRaises(RuntimeError):
                 om.MSelectionList().add(aMayaPathStr)
 
+            # The USD item is a child of the proxy shape again.
+            psHier = ufe.Hierarchy.hierarchy(ps)
+            self.assertIn(aUsdItem, psHier.children())
+
         verifyNoLongerEdited()
         
         # Redo
@@ -212,6 +212,41 @@ class MergeToUsdTestCase(unittest.TestCase):
 
         verifyMergeToUsd()
 
+    @unittest.skipIf(os.getenv('UFE_PREVIEW_VERSION_NUM', '0000') < '3006', 'Test only available in UFE preview version 0.3.6 and greater')
+    def testChildrenAfterEditAsMayaAndMerge(self):
+        '''The cached children of a USD item follow edit as Maya and merge.'''
+
+        (_, _, _, aUsdUfePathStr, _, aUsdItem,
+         _, _, bUsdUfePathStr, _, bUsdItem) = createSimpleXformScene()
+
+        # Cache the children of A before pulling B.
+        aHier = ufe.Hierarchy.hierarchy(aUsdItem)
+        self.assertEqual(aHier.children(), [bUsdItem])
+
+        cmds.mayaUsdEditAsMaya(bUsdUfePathStr)
+        bMayaItem = ufe.GlobalSelection.get().front()
+        bMayaPathStr = ufe.PathString.string(bMayaItem.path())
+
+        def verifyEditedAsMaya():
+            children = aHier.children()
+            self.assertEqual(len(children), 1)
+            self.assertEqual(children[0].runTimeId(), bMayaItem.runTimeId())
+            self.assertEqual(children[0].path(), bMayaItem.path())
+
+        def verifyMerged():
+            self.assertEqual(aHier.children(), [bUsdItem])
+
+        verifyEditedAsMaya()
+
+        cmds.mayaUsdMergeToUsd(bMayaPathStr)
+        verifyMerged()
+
+        cmds.undo()
+        verifyEditedAsMaya()
+
+        cmds.redo()
+        verifyMerged()
+
     @unittest.skipIf(os.getenv('UFE_PREVIEW_VERSION_NUM', '0000') < '3006', 'Test only available in UFE preview version 0.3.6 and greater')
     def testMergeToUsdToNonRootTargetInSessionLayer(self):
         '''Merge edits on a USD transform back to USD targeting a non-root destination path that
@@ -347,6 +382,49 @@ class MergeToUsdTestCase(unittest.TestCase):
         bottomIndices = cylBottomPrim.GetAttribute("indices")
         self.assertEqual("int[]", bottomIndices.GetTypeName())
 
+    @unittest.skipIf(os.getenv('UFE_PREVIEW_VERSION_NUM', '0000') < '3006', 'Test only available in UFE preview version 0.3.6 and greater')
+    def testMergeToUsdSkipUnchangedPrims(self):
+        '''Merge edits back to USD, skipping the prims that were not edited.'''
+
+        (ps, aXlateOp, _, aUsdUfePathStr, aUsdUfePath, aUsdItem,
+         bXlateOp, _, bUsdUfePathStr, bUsdUfePath, bUsdItem) = \
+            createSimpleXformScene()
+
+        aUsdMatrix = aXlateOp.GetOpTransform(mayaUsd.ufe.getTime(aUsdUfePathStr))
+
+        with mayaUsd.lib.OpUndoItemList():
+            self.assertTrue(mayaUsd.lib.PrimUpdaterManager.editAsMaya(aUsdUfePathStr))
+
+        # Only edit the child prim.
+        aMayaItem = ufe.GlobalSelection.get().front()
+        aMayaPathStr = ufe.PathString.string(aMayaItem.path())
+        bMayaPathStr = aMayaPathStr + '|B'
+        bMayaItem = ufe.Hierarchy.createItem(ufe.PathString.path(bMayaPathStr))
+        (_, _, _, bMayaMatrix) = \
+            setMayaTranslation(bMayaItem, om.MVector(10, 11, 12))
+
+        with mayaUsd.lib.OpUndoItemList():
+            self.assertTrue(mayaUsd.lib.PrimUpdaterManager.mergeToUsd(
+                aMayaPathStr, {'skipUnchangedPrims': True}))
+
+        # The child edit is merged and the parent transform is unchanged.
+        bUsdPrim = mayaUsd.ufe.ufePathToPrim(bUsdUfePathStr)
+        bXlateOp = UsdGeom.Xformable(bUsdPrim).GetOrderedXformOps()[0]
+        bUsdMatrix = bXlateOp.GetOpTransform(mayaUsd.ufe.getTime(bUsdUfePathStr))
+        assertVectorAlmostEqual(self, [v for v in bMayaMatrix],
+                                [v for row in bUsdMatrix for v in row])
+
+        aUsdPrim = mayaUsd.ufe.ufePathToPrim(aUsdUfePathStr)
+        aXlateOp = UsdGeom.Xformable(aUsdPrim).GetOrderedXformOps()[0]
+        assertVectorAlmostEqual(
+            self, [v for row in aUsdMatrix for v in row],
+            [v for row in aXlateOp.GetOpTransform(mayaUsd.ufe.getTime(aUsdUfePathStr)) for v in row])
+
+        # Maya nodes are removed, including the ones of the skipped prims.
+        for mayaPathStr in [aMayaPathStr, bMayaPathStr]:
+            with self.assertRaises(RuntimeError):
+                om.MSelectionList().add(mayaPathStr)
+
     def testMergeWithoutMaterials(self):
         '''Merge edits on data and not merging the materials.'''
 
@@ -110,6 +110,51 @@ class testPointBasedDeformerNode(unittest.TestCase):
         self._ValidateControlPoint(testCube, 2, Gf.Vec3d(-1.0, 0.0, 1.0))
         self._ValidateControlPoint(testCube, 3, Gf.Vec3d(0.0, 1.0, 1.0))
 
+    def testCubeWithDeformerWeights(self):
+        """
+        Tests that the envelope and the per-point weights of a point based
+        deformer node blend between the native Maya points and the USD points,
+        and that stepping through time reads the points of each frame.
+        """
+        timeUnit = OM.MTime.uiUnit()
+        OMA.MAnimControl.setAnimationStartEndTime(
+            OM.MTime(self.START_TIMECODE, timeUnit), OM.MTime(self.END_TIMECODE, timeUnit))
+        cmds.currentTime(self.START_TIMECODE)
+
+        testCube = cmds.polyCube(depth=1.0, height=1.0, width=1.0)[0]
+
+        stageNode = cmds.createNode('pxrUsdStageNode')
+        cmds.setAttr('%s.filePath' % stageNode, self._deformingCubeUsdFilePath,
+            type='string')
+
+        cmds.select(testCube, replace=True)
+        deformerNode = cmds.deformer(type='pxrUsdPointBasedDeformerNode')[0]
+        cmds.setAttr('%s.primPath' % deformerNode, self._deformingCubePrimPath,
+            type='string')
+        cmds.connectAttr('%s.outUsdStage' % stageNode,
+            '%s.inUsdStage' % deformerNode)
+        cmds.connectAttr('time1.outTime', '%s.time' % deformerNode)
+
+        # Half way between the Maya cube and the USD cube.
+        cmds.setAttr('%s.envelope' % deformerNode, 0.5)
+        self._ValidateControlPoint(testCube, 0, Gf.Vec3d(-0.75, -0.75, 0.75))
+        self._ValidateControlPoint(testCube, 3, Gf.Vec3d(0.75, 0.75, 0.75))
+
+        # A point with a null weight is not deformed.
+        cmds.setAttr('%s.envelope' % deformerNode, 1.0)
+        cmds.setAttr('%s.weightList[0].weights[0]' % deformerNode, 0.0)
+        self._ValidateControlPoint(testCube, 0, Gf.Vec3d(-0.5, -0.5, 0.5))
+        self._ValidateControlPoint(testCube, 3, Gf.Vec3d(1.0, 1.0, 1.0))
+
+        # Step through the frames one by one, as during playback.
+        for frame in range(int(self.START_TIMECODE), int(self.MID_TIMECODE) + 1):
+            cmds.currentTime(frame)
+            cmds.getAttr('%s.controlPoints[3].xValue' % testCube)
+
+        self._ValidateControlPoint(testCube, 0, Gf.Vec3d(-0.5, -0.5, 0.5))
+        self._ValidateControlPoint(testCube, 1, Gf.Vec3d(1.0, 0.0, 1.0))
+        self._ValidateControlPoint(testCube, 3, Gf.Vec3d(0.0, 1.0, 1.0))
+
 
 if __name__ == '__main__':
     unittest.main(verbosity=2)
@@ -50,6 +50,127 @@ class testProxyShapeBase(unittest.TestCase):
         bboxSize = cmds.getAttr('Cube_usd.boundingBoxSize')[0]
         self.assertEqual(bboxSize, (1.0, 1.0, 1.0))
 
+    def testBoundingBoxAnimatedAndEdited(self):
+        '''
+        Verify the bounding box follows animated transforms and stage edits.
+        '''
+        cmds.file(new=True, force=True)
+
+        import mayaUsd_createStageWithNewLayer
+        proxyShapePath = mayaUsd_createStageWithNewLayer.createStageWithNewLayer()
+        stage = mayaUsd.lib.GetPrim(proxyShapePath).GetStage()
+
+        from pxr import UsdGeom
+        staticCube = UsdGeom.Cube.Define(stage, '/Static')
+        animatedCube = UsdGeom.Cube.Define(stage, '/Animated')
+        UsdGeom.Xformable(animatedCube).AddTranslateOp().Set((10.0, 0.0, 0.0), 1.0)
+        UsdGeom.Xformable(animatedCube).GetOrderedXformOps()[0].Set((20.0, 0.0, 0.0), 10.0)
+
+        cmds.currentTime(1)
+        self.assertAlmostEqual(cmds.getAttr(proxyShapePath + '.boundingBoxMaxX'), 11.0)
+        cmds.currentTime(10)
+        self.assertAlmostEqual(cmds.getAttr(proxyShapePath + '.boundingBoxMaxX'), 21.0)
+        self.assertAlmostEqual(cmds.getAttr(proxyShapePath + '.boundingBoxMinX'), -1.0)
+
+        # Editing the static prim must invalidate its cached bound.
+        staticCube.GetSizeAttr().Set(10.0)
+        self.assertAlmostEqual(cmds.getAttr(proxyShapePath + '.boundingBoxMinX'), -5.0)
+
+    def testBoundingBoxResetXformStack(self):
+        '''
+        Verify the bounding box ignores the ancestor transforms of a prim
+        that resets the transform stack, even when they change.
+        '''
+        cmds.file(new=True, force=True)
+
+        import mayaUsd_createStageWithNewLayer
+        proxyShapePath = mayaUsd_createStageWithNewLayer.createStageWithNewLayer()
+        stage = mayaUsd.lib.GetPrim(proxyShapePath).GetStage()
+
+        from pxr import UsdGeom
+        parent = UsdGeom.Xform.Define(stage, '/Parent')
+        parentTranslate = parent.AddTranslateOp()
+        parentTranslate.Set((5.0, 0.0, 0.0))
+        cube = UsdGeom.Cube.Define(stage, '/Parent/Cube')
+        UsdGeom.Xformable(cube).SetResetXformStack(True)
+
+        self.assertAlmostEqual(cmds.getAttr(proxyShapePath + '.boundingBoxMaxX'), 1.0)
+
+        parentTranslate.Set((50.0, 0.0, 0.0))
+        self.assertAlmostEqual(cmds.getAttr(proxyShapePath + '.boundingBoxMaxX'), 1.0)
+
+    def testBoundingBoxNestedPurposes(self):
+        '''
+        Verify the purpose authored on an ancestor overrides the purpose
+        authored on its descendants, like in UsdGeomBBoxCache.
+        '''
+        cmds.file(new=True, force=True)
+
+        import mayaUsd_createStageWithNewLayer
+        proxyShapePath = mayaUsd_createStageWithNewLayer.createStageWithNewLayer()
+        stage = mayaUsd.lib.GetPrim(proxyShapePath).GetStage()
+
+        # Only the default and proxy purposes are drawn by default.
+        from pxr import Usd, UsdGeom
+        proxyGroup = UsdGeom.Xform.Define(stage, '/ProxyGroup')
+        proxyGroup.GetPurposeAttr().Set(UsdGeom.Tokens.proxy)
+        renderCube = UsdGeom.Cube.Define(stage, '/ProxyGroup/RenderCube')
+        renderCube.GetPurposeAttr().Set(UsdGeom.Tokens.render)
+        renderCube.AddTranslateOp().Set((10.0, 0.0, 0.0))
+
+        renderGroup = UsdGeom.Xform.Define(stage, '/RenderGroup')
+        renderGroup.GetPurposeAttr().Set(UsdGeom.Tokens.render)
+        proxyCube = UsdGeom.Cube.Define(stage, '/RenderGroup/ProxyCube')
+        proxyCube.GetPurposeAttr().Set(UsdGeom.Tokens.proxy)
+        proxyCube.AddTranslateOp().Set((-20.0, 0.0, 0.0))
+
+        self.assertAlmostEqual(cmds.getAttr(proxyShapePath + '.boundingBoxMinX'), 9.0)
+        self.assertAlmostEqual(cmds.getAttr(proxyShapePath + '.boundingBoxMaxX'), 11.0)
+
+        bboxCache = UsdGeom.BBoxCache(
+            Usd.TimeCode.Default(), [UsdGeom.Tokens.default_, UsdGeom.Tokens.proxy])
+        bbox = bboxCache.ComputeUntransformedBound(stage.GetPseudoRoot()).ComputeAlignedRange()
+        self.assertAlmostEqual(bbox.GetMin()[0], 9.0)
+        self.assertAlmostEqual(bbox.GetMax()[0], 11.0)
+
+    def testBoundingBoxPrototypeEdit(self):
+        '''
+        Verify the bounding box of an instance follows edits to its prototype.
+        '''
+        cmds.file(new=True, force=True)
+
+        import mayaUsd_createStageWithNewLayer
+        proxyShapePath = mayaUsd_createStageWithNewLayer.createStageWithNewLayer()
+        stage = mayaUsd.lib.GetPrim(proxyShapePath).GetStage()
+
+        from pxr import UsdGeom
+        UsdGeom.Xform.Define(stage, '/Source')
+        sourceCube = UsdGeom.Cube.Define(stage, '/Source/Cube')
+        instance = UsdGeom.Xform.Define(stage, '/Instance')
+        instance.AddTranslateOp().Set((100.0, 0.0, 0.0))
+        instance.GetPrim().GetReferences().AddInternalReference('/Source')
+        instance.GetPrim().SetInstanceable(True)
+
+        self.assertAlmostEqual(cmds.getAttr(proxyShapePath + '.boundingBoxMaxX'), 101.0)
+
+        # The edit is notified on the prototype path, not on the instance.
+        sourceCube.GetSizeAttr().Set(4.0)
+        self.assertAlmostEqual(cmds.getAttr(proxyShapePath + '.boundingBoxMaxX'), 102.0)
+
+    def testMaxTextureResolution(self):
+        '''
+        Verify the viewport texture resolution limit is off by default and can be set.
+        '''
+        cmds.file(new=True, force=True)
+
+        import mayaUsd_createStageWithNewLayer
+        proxyShapePath = mayaUsd_createStageWithNewLayer.createStageWithNewLayer()
+
+        self.assertEqual(cmds.getAttr(proxyShapePath + '.maxTextureResolution'), 0)
+        cmds.setAttr(proxyShapePath + '.maxTextureResolution', 512)
+        self.assertEqual(cmds.getAttr(proxyShapePath + '.maxTextureResolution'), 512)
+        cmds.refresh(force=True)
+
     @unittest.skipUnless(ufeUtils.ufeFeatureSetVersion() >= 2, 'testDuplicateProxyStageAnonymous only available in UFE v2 or greater.')
     def testDuplicateProxyStageAnonymous(self):
         '''
@@ -0,0 +1,15 @@
+#include <maya/MLibrary.h>
+
+#include <gtest/gtest.h>
+
+int main(int argc, char** argv)
+{
+    // The render delegate profiles its work, which needs Maya to be initialized.
+    MLibrary::initialize(false, argv[0]);
+
+    ::testing::InitGoogleTest(&argc, argv);
+    const int result = RUN_ALL_TESTS();
+
+    MLibrary::cleanup(result, false);
+    return result;
+}
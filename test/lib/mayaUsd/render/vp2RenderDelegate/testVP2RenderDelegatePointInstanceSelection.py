@@ -23,6 +23,8 @@ import usdUtils
 from mayaUsd import lib as mayaUsdLib
 from mayaUsd import ufe as mayaUsdUfe
 
+from pxr import Gf, UsdGeom, Vt
+
 from maya import cmds
 
 import ufe
@@ -163,6 +165,48 @@ class testVP2RenderDelegatePointInstanceSelection(imageUtils.ImageDiffingTestCas
         mayaUtils.openPointInstancesGrid14Scene()
         self._RunTest()
 
+    def testHideShowWithoutSelectedInstances(self):
+        """Tests that the render item of the selected instances is not drawn
+        with stale instances when the PointInstancer is hidden and shown again
+        while none of its instances is selected."""
+        mayaUtils.openPointInstancesGrid14Scene()
+
+        stage = mayaUsdLib.GetPrim('|UsdProxy|UsdProxyShape').GetStage()
+        instancerPrim = stage.GetPrimAtPath('/PointInstancerGrid/PointInstancer')
+        instancer = UsdGeom.PointInstancer(instancerPrim)
+
+        # Draw the first instance as selected, then deselect it.
+        globalSelection = ufe.GlobalSelection.get()
+        globalSelection.clear()
+        globalSelection.append(self._GetSceneItem(0))
+        cmds.refresh(force=True)
+        globalSelection.clear()
+        cmds.refresh(force=True)
+
+        # Move the instances away from where the instance was selected.
+        positions = instancer.GetPositionsAttr().Get()
+        instancer.GetPositionsAttr().Set(
+            Vt.Vec3fArray([p + Gf.Vec3f(0.5, 0.5, 0.0) for p in positions]))
+        expectedImage = os.path.join(self._testDir, 'HideShow_expected.png')
+        imageUtils.snapshot(expectedImage, width=960, height=540)
+
+        # Hide and show the instances, both with their visibility and with
+        # their purpose.
+        imageable = UsdGeom.Imageable(instancerPrim)
+        imageable.MakeInvisible()
+        cmds.refresh(force=True)
+        imageable.MakeVisible()
+        snapshotImage = os.path.join(self._testDir, 'HideShow_visibility.png')
+        imageUtils.snapshot(snapshotImage, width=960, height=540)
+        self.assertImagesClose(expectedImage, snapshotImage)
+
+        imageable.GetPurposeAttr().Set(UsdGeom.Tokens.guide)
+        cmds.refresh(force=True)
+        imageable.GetPurposeAttr().Set(UsdGeom.Tokens.default_)
+        snapshotImage = os.path.join(self._testDir, 'HideShow_purpose.png')
+        imageUtils.snapshot(snapshotImage, width=960, height=540)
+        self.assertImagesClose(expectedImage, snapshotImage)
+
     def testPointInstancerGrid7k(self):
         self._numInstances = 7000
         self._testName = 'Grid_7k'
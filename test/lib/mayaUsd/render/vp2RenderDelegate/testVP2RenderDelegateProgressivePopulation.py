@@ -0,0 +1,88 @@
+#!/usr/bin/env mayapy
+#
+# Copyright 2021 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import os
+
+# The render delegate reads the variable once, when the first proxy shape is drawn.
+os.environ['HDVP2_PROGRESSIVE_POPULATION'] = '1'
+
+import fixturesUtils
+import imageUtils
+import mayaUtils
+import testUtils
+
+from maya import cmds
+
+import ufe
+
+
+class testVP2RenderDelegateProgressivePopulation(imageUtils.ImageDiffingTestCase):
+    """
+    Tests that the rprims drawn as boxes by the progressive population are all
+    synced after a few frames.
+    """
+
+    @classmethod
+    def setUpClass(cls):
+        cls._inputPath = fixturesUtils.setUpClass(__file__,
+            initializeStandalone=False, loadPlugin=False)
+
+        cls._testDir = os.path.abspath('.')
+
+    def assertSnapshotClose(self, baselineDir, imageName):
+        # Once populated, the scenes must look the same as when they are synced
+        # in the first frame, so the baselines of other tests are used.
+        baselineImage = os.path.join(self._inputPath, baselineDir, 'baseline', imageName)
+        snapshotImage = os.path.join(self._testDir, imageName)
+        imageUtils.snapshot(snapshotImage, width=960, height=540)
+        return self.assertImagesClose(baselineImage, snapshotImage)
+
+    def drawFrames(self):
+        for _ in range(10):
+            cmds.refresh(force=True)
+
+    def testPlaceholdersRemoved(self):
+        """The placeholder box of a mesh is removed once it is synced."""
+        cmds.upAxis(axis='y')
+        cmds.file(force=True, new=True)
+        mayaUtils.loadPlugin("mayaUsdPlugin")
+
+        cmds.xform("persp", t=(0, 0, 2))
+        cmds.xform("persp", ro=[0, 0, 0], ws=True)
+
+        testFile = testUtils.getTestScene("UsdPreviewSurface", "UsdTransform2dTest.usda")
+        mayaUtils.createProxyFromFile(testFile)
+
+        self.drawFrames()
+        self.assertSnapshotClose('VP2RenderDelegateUSDPreviewSurface', 'UsdTransform2dTest.png')
+
+    def testInstancedPrototypesPopulated(self):
+        """The prototypes of a PointInstancer have no placeholder box, they
+        are drawn through their instances once synced."""
+        # The test USD data is authored Z-up, so make sure Maya is configured
+        # that way too.
+        cmds.upAxis(axis='z')
+        mayaUtils.openPointInstancesGrid14Scene()
+        ufe.GlobalSelection.get().clear()
+
+        self.drawFrames()
+        self.assertSnapshotClose(
+            'VP2RenderDelegatePointInstanceSelectionTest', 'Grid_14_unselected.png')
+
+
+if __name__ == '__main__':
+    fixturesUtils.runTests(globals())
@@ -0,0 +1,148 @@
+#!/usr/bin/env mayapy
+#
+# Copyright 2021 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import os
+
+# The render delegate reads the variable once, before the first material sync.
+os.environ['HDVP2_ASYNC_TEXTURE_LOADING'] = '1'
+
+import fixturesUtils
+import imageUtils
+
+import mayaUtils
+import testUtils
+
+from pxr import Sdf
+
+from maya import cmds
+from maya.api import OpenMayaRender as omr
+
+import time
+
+class testVP2RenderDelegateTextureLoading(imageUtils.ImageDiffingTestCase):
+    """
+    Test the textures loaded on worker threads by the VP2 render delegate.
+    """
+
+    @classmethod
+    def setUpClass(cls):
+        input_path = fixturesUtils.setUpClass(
+            __file__, initializeStandalone=False, loadPlugin=False
+        )
+
+        # The textures loaded asynchronously must look the same as the ones
+        # loaded while syncing.
+        cls._baseline_dir = os.path.join(
+            input_path, "VP2RenderDelegateUSDPreviewSurface", "baseline"
+        )
+
+        cls._test_dir = os.path.abspath(".")
+
+    def assertSnapshotClose(self, imageName):
+        baseline_image = os.path.join(self._baseline_dir, imageName)
+        snapshot_image = os.path.join(self._test_dir, imageName)
+        imageUtils.snapshot(snapshot_image, width=960, height=540)
+        return self.assertImagesClose(baseline_image, snapshot_image)
+
+    def createTextureProxy(self):
+        """Loads the texture test scene, leaving the color space of the texture
+        to the image file, so that the loader's sRGB flag is the one used."""
+        testFile = testUtils.getTestScene("UsdPreviewSurface", "UsdTransform2dTest.usda")
+        shapeNode, shapeStage = mayaUtils.createProxyFromFile(testFile)
+        shapeStage.SetEditTarget(shapeStage.GetSessionLayer())
+        textureShader = shapeStage.GetPrimAtPath('/pPlane1/Looks/usdPreviewSurface1SG/file1')
+        textureShader.GetAttribute('inputs:sourceColorSpace').Set('auto')
+        return shapeNode, shapeStage
+
+    def waitForTexture(self, textureName):
+        """Refreshes the viewport while the texture is read, then checks that
+        it has been uploaded."""
+        # VP2 may keep a released texture in its cache, so its presence does
+        # not tell whether the materials are still waiting for a new read.
+        for _ in range(20):
+            cmds.refresh(force=True)
+            time.sleep(0.1)
+        cmds.refresh(force=True)
+
+        textureMgr = omr.MRenderer.getTextureManager()
+        texture = textureMgr.findTexture(textureName)
+        self.assertIsNotNone(texture, textureName)
+        textureMgr.releaseTexture(texture)
+
+    def testSRGBRoundTrip(self):
+        """Tests that the sRGB flag of a loaded texture is kept when the
+        texture is shared with another material, and after the texture has
+        been released and loaded again."""
+        cmds.file(force=True, new=True)
+        mayaUtils.loadPlugin("mayaUsdPlugin")
+
+        cmds.xform("persp", t=(0, 0, 2))
+        cmds.xform("persp", ro=[0, 0, 0], ws=True)
+
+        texturePath = os.path.abspath(
+            testUtils.getTestScene("UsdPreviewSurface", "grid.png"))
+
+        # Read on a worker thread and uploaded.
+        firstShape, _ = self.createTextureProxy()
+        self.waitForTexture(texturePath)
+        self.assertSnapshotClose('UsdTransform2dTest.png')
+
+        # Found in the VP2 texture cache by the material of another stage.
+        secondShape, _ = self.createTextureProxy()
+        cmds.hide(cmds.listRelatives(firstShape, parent=True, fullPath=True))
+        cmds.refresh(force=True)
+        self.assertSnapshotClose('UsdTransform2dTest.png')
+
+        # Released by all the materials, then loaded again.
+        cmds.delete(cmds.listRelatives([firstShape, secondShape], parent=True, fullPath=True))
+        cmds.refresh(force=True)
+        self.createTextureProxy()
+        self.waitForTexture(texturePath)
+        self.assertSnapshotClose('UsdTransform2dTest.png')
+
+    def testFileChangedWhileLoading(self):
+        """Tests that a material which stops using a texture while it is read
+        still gets the texture it uses afterwards."""
+        cmds.file(force=True, new=True)
+        mayaUtils.loadPlugin("mayaUsdPlugin")
+
+        cmds.xform("persp", t=(0, 0, 2))
+        cmds.xform("persp", ro=[0, 0, 0], ws=True)
+
+        texturePath = os.path.abspath(
+            testUtils.getTestScene("UsdPreviewSurface", "grid.png"))
+
+        _, shapeStage = self.createTextureProxy()
+        fileAttr = shapeStage.GetPrimAtPath(
+            '/pPlane1/Looks/usdPreviewSurface1SG/file1').GetAttribute('inputs:file')
+
+        # The read of the first texture has started, the material now waits for
+        # another one, then for the first one again.
+        cmds.refresh(force=True)
+        # The paths are authored in the session layer, so they are absolute.
+        cmds.refresh(force=True)
+        fileAttr.Set(Sdf.AssetPath(
+            os.path.join(os.path.dirname(texturePath), 'missing.png')))
+        cmds.refresh(force=True)
+        fileAttr.Set(Sdf.AssetPath(texturePath))
+
+        self.waitForTexture(texturePath)
+        self.assertSnapshotClose('UsdTransform2dTest.png')
+
+
+if __name__ == '__main__':
+    fixturesUtils.runTests(globals())
@@ -27,6 +27,7 @@ from mayaUsd import lib as mayaUsdLib
 from mayaUsd import ufe as mayaUsdUfe
 
 from maya import cmds
+from maya.api import OpenMayaRender as omr
 
 import ufe
 
@@ -155,6 +156,37 @@ class testVP2RenderDelegateUSDPreviewSurface(imageUtils.ImageDiffingTestCase):
 
         self.assertSnapshotClose('UsdTransform2dTest.png')
 
+    def testMaxTextureResolution(self):
+        """Tests that the maxTextureResolution of the proxy shape limits the
+        size of the textures uploaded to VP2."""
+        cmds.file(force=True, new=True)
+        mayaUtils.loadPlugin("mayaUsdPlugin")
+
+        panel = mayaUtils.activeModelPanel()
+        cmds.modelEditor(panel, edit=True, displayTextures=True)
+
+        testFile = testUtils.getTestScene("UsdPreviewSurface", "UsdTransform2dTest.usda")
+        shapeNode, _ = mayaUtils.createProxyFromFile(testFile)
+        texturePath = os.path.abspath(
+            testUtils.getTestScene("UsdPreviewSurface", "grid.png"))
+
+        def uploadedTextureSize(textureName):
+            textureMgr = omr.MRenderer.getTextureManager()
+            texture = textureMgr.findTexture(textureName)
+            self.assertIsNotNone(texture, textureName)
+            desc = texture.textureDescription()
+            textureMgr.releaseTexture(texture)
+            return (desc.fWidth, desc.fHeight)
+
+        # grid.png is 640x640.
+        cmds.refresh(force=True)
+        self.assertEqual(uploadedTextureSize(texturePath), (640, 640))
+
+        cmds.setAttr(shapeNode + '.maxTextureResolution', 128)
+        cmds.refresh(force=True)
+        self.assertEqual(
+            uploadedTextureSize(texturePath + '?maxResolution=128'), (128, 128))
+
     def testUseSpecularWorkflow(self):
         cmds.file(force=True, new=True)
         mayaUtils.loadPlugin("mayaUsdPlugin")
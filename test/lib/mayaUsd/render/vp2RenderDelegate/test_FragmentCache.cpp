@@ -0,0 +1,67 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "fragmentCache.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(HdVP2FragmentCache, roundTrip)
+{
+    HdVP2FragmentCache& cache = HdVP2FragmentCache::GetInstance();
+    ASSERT_TRUE(cache.IsEnabled());
+
+    // The cache folder outlives the test, make sure the topology was never cached.
+    const std::string topology = "roundTrip "
+        + std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
+    const std::string key = HdVP2FragmentCache::GetKey(topology, "1.38.0", "libraries");
+
+    HdVP2CachedFragment       fragment;
+    HdVP2FragmentCache::Stats stats = cache.GetStats();
+    EXPECT_FALSE(cache.Find(key, fragment));
+    EXPECT_EQ(cache.GetStats()._misses, stats._misses + 1);
+
+    HdVP2CachedFragment generated;
+    generated._name = "roundTripFragment";
+    generated._source = "<fragment uiName=\"roundTripFragment\">\n</fragment>\n";
+    generated._isTransparent = true;
+    generated._requiredPrimvars = { TfToken("st"), TfToken("displayColor") };
+    cache.Add(key, generated, 0.5);
+    EXPECT_DOUBLE_EQ(cache.GetStats()._generationTime, stats._generationTime + 0.5);
+
+    stats = cache.GetStats();
+    ASSERT_TRUE(cache.Find(key, fragment));
+    EXPECT_EQ(cache.GetStats()._hits, stats._hits + 1);
+    EXPECT_EQ(fragment._name, generated._name);
+    EXPECT_EQ(fragment._source, generated._source);
+    EXPECT_EQ(fragment._isTransparent, generated._isTransparent);
+    EXPECT_EQ(fragment._requiredPrimvars, generated._requiredPrimvars);
+
+    // Fragments generated by another version or with other libraries are not reused.
+    const std::string otherVersionKey = HdVP2FragmentCache::GetKey(topology, "1.38.1", "libraries");
+    const std::string otherLibrariesKey = HdVP2FragmentCache::GetKey(topology, "1.38.0", "other");
+    EXPECT_NE(otherVersionKey, key);
+    EXPECT_NE(otherLibrariesKey, key);
+
+    stats = cache.GetStats();
+    EXPECT_FALSE(cache.Find(otherVersionKey, fragment));
+    EXPECT_FALSE(cache.Find(otherLibrariesKey, fragment));
+    EXPECT_EQ(cache.GetStats()._misses, stats._misses + 2);
+}
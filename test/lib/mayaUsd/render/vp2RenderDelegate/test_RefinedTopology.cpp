@@ -0,0 +1,176 @@
+//
+// Copyright 2021 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "refinedTopology.h"
+
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/vt/types.h>
+#include <pxr/imaging/pxOsd/tokens.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+// A unit cube centered on the origin, with right-handed faces seen from outside.
+const VtVec3fArray cubePoints { GfVec3f(-0.5f, -0.5f, 0.5f),  GfVec3f(0.5f, -0.5f, 0.5f),
+                                GfVec3f(-0.5f, 0.5f, 0.5f),   GfVec3f(0.5f, 0.5f, 0.5f),
+                                GfVec3f(-0.5f, 0.5f, -0.5f),  GfVec3f(0.5f, 0.5f, -0.5f),
+                                GfVec3f(-0.5f, -0.5f, -0.5f), GfVec3f(0.5f, -0.5f, -0.5f) };
+const VtIntArray   cubeFaceVertexCounts { 4, 4, 4, 4, 4, 4 };
+const VtIntArray   cubeFaceVertexIndices { 0, 1, 3, 2, 2, 3, 5, 4, 4, 5, 7, 6,
+                                         6, 7, 1, 0, 1, 7, 5, 3, 6, 0, 2, 4 };
+
+HdMeshTopology cubeTopology(const TfToken& orientation = PxOsdOpenSubdivTokens->rightHanded)
+{
+    VtIntArray faceVertexIndices = cubeFaceVertexIndices;
+    if (orientation == PxOsdOpenSubdivTokens->leftHanded) {
+        for (size_t i = 0; i < faceVertexIndices.size(); i += 4) {
+            std::reverse(faceVertexIndices.begin() + i, faceVertexIndices.begin() + i + 4);
+        }
+    }
+    return HdMeshTopology(
+        PxOsdOpenSubdivTokens->catmullClark,
+        orientation,
+        cubeFaceVertexCounts,
+        faceVertexIndices);
+}
+
+// The center of a face of the refined cube, and its normal from the winding of the face.
+void refinedFaceFrame(
+    const HdVP2RefinedTopology& refined,
+    const VtVec3fArray&         points,
+    int                         face,
+    GfVec3f&                    center,
+    GfVec3f&                    normal)
+{
+    const int* indices = refined.GetTopology().GetFaceVertexIndices().cdata() + face * 4;
+    center = (points[indices[0]] + points[indices[1]] + points[indices[2]] + points[indices[3]])
+        / 4.0f;
+    normal = GfCross(
+        points[indices[2]] - points[indices[0]], points[indices[3]] - points[indices[1]]);
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(HdVP2RefinedTopology, refinedCounts)
+{
+    const HdVP2RefinedTopology refined(cubeTopology(), 1);
+    ASSERT_TRUE(refined.IsValid());
+
+    // Each quad is split in 4, with a new vertex on each face and on each edge.
+    const HdMeshTopology& topology = refined.GetTopology();
+    EXPECT_EQ(topology.GetNumFaces(), 24);
+    EXPECT_EQ(topology.GetNumPoints(), 8 + 12 + 6);
+    EXPECT_EQ(topology.GetFaceVertexIndices().size(), 96u);
+    for (int count : topology.GetFaceVertexCounts()) {
+        EXPECT_EQ(count, 4);
+    }
+
+    const VtValue points = refined.Refine(VtValue(cubePoints), HdInterpolationVertex);
+    ASSERT_TRUE(points.IsHolding<VtVec3fArray>());
+    EXPECT_EQ(points.UncheckedGet<VtVec3fArray>().size(), 26u);
+
+    const VtValue varying = refined.Refine(VtValue(VtFloatArray(8, 1.0f)), HdInterpolationVarying);
+    ASSERT_TRUE(varying.IsHolding<VtFloatArray>());
+    EXPECT_EQ(varying.UncheckedGet<VtFloatArray>().size(), 26u);
+
+    // Face-varying values are flattened, one per refined face vertex.
+    const VtValue faceVarying
+        = refined.Refine(VtValue(VtFloatArray(24, 1.0f)), HdInterpolationFaceVarying);
+    ASSERT_TRUE(faceVarying.IsHolding<VtFloatArray>());
+    const VtFloatArray& faceVaryingValues = faceVarying.UncheckedGet<VtFloatArray>();
+    ASSERT_EQ(faceVaryingValues.size(), 96u);
+    for (float value : faceVaryingValues) {
+        EXPECT_FLOAT_EQ(value, 1.0f);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(HdVP2RefinedTopology, uniformPrimvar)
+{
+    const HdVP2RefinedTopology refined(cubeTopology(), 1);
+    ASSERT_TRUE(refined.IsValid());
+
+    // Each refined face gets the value of its base face, which is on the same side of the cube.
+    const VtVec3fArray baseNormals { GfVec3f(0, 0, 1),  GfVec3f(0, 1, 0), GfVec3f(0, 0, -1),
+                                     GfVec3f(0, -1, 0), GfVec3f(1, 0, 0), GfVec3f(-1, 0, 0) };
+    VtFloatArray       baseValues(6);
+    std::iota(baseValues.begin(), baseValues.end(), 0.0f);
+    const VtValue refinedValues = refined.Refine(VtValue(baseValues), HdInterpolationUniform);
+    ASSERT_TRUE(refinedValues.IsHolding<VtFloatArray>());
+    const VtFloatArray& values = refinedValues.UncheckedGet<VtFloatArray>();
+    ASSERT_EQ(values.size(), 24u);
+
+    const VtVec3fArray points
+        = refined.Refine(VtValue(cubePoints), HdInterpolationVertex).Get<VtVec3fArray>();
+    for (int face = 0; face < 24; face++) {
+        const int baseFace = static_cast<int>(values[face]);
+        ASSERT_GE(baseFace, 0);
+        ASSERT_LT(baseFace, 6);
+        EXPECT_EQ(std::count(values.begin(), values.end(), values[face]), 4);
+
+        GfVec3f center, normal;
+        refinedFaceFrame(refined, points, face, center, normal);
+        EXPECT_GT(GfDot(center.GetNormalized(), baseNormals[baseFace]), 0.7f);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(HdVP2RefinedTopology, leftHanded)
+{
+    for (const TfToken& orientation :
+         { PxOsdOpenSubdivTokens->rightHanded, PxOsdOpenSubdivTokens->leftHanded }) {
+        const HdVP2RefinedTopology refined(cubeTopology(orientation), 1);
+        ASSERT_TRUE(refined.IsValid());
+
+        // The refiner has already reversed the left-handed faces.
+        EXPECT_EQ(refined.GetTopology().GetOrientation(), PxOsdOpenSubdivTokens->rightHanded);
+
+        const VtVec3fArray points
+            = refined.Refine(VtValue(cubePoints), HdInterpolationVertex).Get<VtVec3fArray>();
+        ASSERT_EQ(points.size(), 26u);
+        for (int face = 0; face < refined.GetTopology().GetNumFaces(); face++) {
+            GfVec3f center, normal;
+            refinedFaceFrame(refined, points, face, center, normal);
+            EXPECT_GT(GfDot(center, normal), 0.0f) << orientation << " face " << face;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(HdVP2RefinedTopologyCache, sharing)
+{
+    HdVP2RefinedTopologyCache& cache = HdVP2RefinedTopologyCache::GetInstance();
+
+    const auto refined = cache.Get(cubeTopology(), 1);
+    ASSERT_TRUE(refined);
+    EXPECT_EQ(cache.Get(cubeTopology(), 1), refined);
+
+    // Other refine levels and topologies are refined separately.
+    const auto refinedTwice = cache.Get(cubeTopology(), 2);
+    ASSERT_TRUE(refinedTwice);
+    EXPECT_NE(refinedTwice, refined);
+    EXPECT_EQ(refinedTwice->GetTopology().GetNumFaces(), 96);
+
+    const auto leftHanded = cache.Get(cubeTopology(PxOsdOpenSubdivTokens->leftHanded), 1);
+    ASSERT_TRUE(leftHanded);
+    EXPECT_NE(leftHanded, refined);
+}
@@ -103,3 +103,88 @@ class TestUsdUndoManager(unittest.TestCase):
 
         # expect to have 2 items on the undo queue
         self.assertEqual(cmds.undoInfo(q=True), nbCmds+2)
+
+    def testCoalescedSetField(self):
+        '''
+            Setting the same attribute repeatedly in an UsdUndoBlock only keeps
+            the value from before the block, and undo restores it.
+        '''
+        # start with a new file
+        cmds.file(force=True, new=True)
+
+        prim = UsdGeom.Xform.Define(self.stage, '/World')
+        translateOp = prim.AddTranslateOp()
+        translateOp.Set(Gf.Vec3d(0, 0, 0))
+
+        with mayaUsdLib.UsdUndoBlock():
+            for i in range(100):
+                translateOp.Set(Gf.Vec3d(i, 0, 0))
+
+        self.assertEqual(translateOp.Get(), Gf.Vec3d(99, 0, 0))
+
+        cmds.undo()
+        self.assertEqual(translateOp.Get(), Gf.Vec3d(0, 0, 0))
+
+        cmds.redo()
+        self.assertEqual(translateOp.Get(), Gf.Vec3d(99, 0, 0))
+
+    def testDeleteSpecUndo(self):
+        '''
+            Undoing the deletion of a prim restores its whole hierarchy.
+        '''
+        # start with a new file
+        cmds.file(force=True, new=True)
+
+        sphere = UsdGeom.Sphere.Define(self.stage, '/World/Group/Sphere')
+        sphere.GetRadiusAttr().Set(2.0)
+
+        with mayaUsdLib.UsdUndoBlock():
+            self.stage.RemovePrim('/World')
+
+        self.assertFalse(self.stage.GetPrimAtPath('/World/Group/Sphere'))
+
+        cmds.undo()
+        sphere = UsdGeom.Sphere(self.stage.GetPrimAtPath('/World/Group/Sphere'))
+        self.assertTrue(sphere)
+        self.assertEqual(sphere.GetRadiusAttr().Get(), 2.0)
+
+        cmds.redo()
+        self.assertFalse(self.stage.GetPrimAtPath('/World'))
+
+    def testMemoryBudget(self):
+        '''
+            The memory held by the undo queue is reported, and the edits of the
+            oldest undo steps are discarded when it exceeds the budget.
+        '''
+        # start with a new file
+        cmds.file(force=True, new=True)
+
+        budget = mayaUsdLib.UsdUndoManager.getMemoryBudget()
+        try:
+            mayaUsdLib.UsdUndoManager.setMemoryBudget(0)
+
+            mesh = UsdGeom.Mesh.Define(self.stage, '/Mesh')
+            pointsAttr = mesh.GetPointsAttr()
+            pointsAttr.Set([Gf.Vec3f(0, 0, 0)] * 10000)
+
+            usage = mayaUsdLib.UsdUndoManager.getMemoryUsage()
+            with mayaUsdLib.UsdUndoBlock():
+                pointsAttr.Set([Gf.Vec3f(1, 0, 0)] * 10000)
+            with mayaUsdLib.UsdUndoBlock():
+                pointsAttr.Set([Gf.Vec3f(2, 0, 0)] * 10000)
+
+            # each step holds the 10000 points it restores
+            self.assertGreater(mayaUsdLib.UsdUndoManager.getMemoryUsage(), usage + 2 * 10000 * 12)
+
+            # only keep the most recent step
+            mayaUsdLib.UsdUndoManager.setMemoryBudget(1)
+            self.assertLess(mayaUsdLib.UsdUndoManager.getMemoryUsage(), usage + 2 * 10000 * 12)
+
+            cmds.undo()
+            self.assertEqual(pointsAttr.Get()[0], Gf.Vec3f(1, 0, 0))
+
+            # the edits of the first step were discarded
+            cmds.undo()
+            self.assertEqual(pointsAttr.Get()[0], Gf.Vec3f(1, 0, 0))
+        finally:
+            mayaUsdLib.UsdUndoManager.setMemoryBudget(budget)
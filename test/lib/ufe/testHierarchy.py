@@ -0,0 +1,132 @@
+#!/usr/bin/env python
+
+#
+# Copyright 2021 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import fixturesUtils
+import mayaUtils
+
+from usdUtils import mayaUsd_createStageWithNewLayer
+
+import mayaUsd.lib
+
+from pxr import Usd, UsdUtils
+
+from maya import cmds
+from maya import standalone
+
+import ufe
+
+import unittest
+
+
+class HierarchyTestCase(unittest.TestCase):
+    '''Verify that the children of USD scene items follow the changes of the
+    stage, which are cached between calls.
+    '''
+
+    pluginsLoaded = False
+
+    @classmethod
+    def setUpClass(cls):
+        fixturesUtils.readOnlySetUpClass(__file__, loadPlugin=False)
+
+        if not cls.pluginsLoaded:
+            cls.pluginsLoaded = mayaUtils.isMayaUsdPluginLoaded()
+
+    @classmethod
+    def tearDownClass(cls):
+        standalone.uninitialize()
+
+    def setUp(self):
+        ''' Called initially to set up the Maya test environment '''
+
+        # Load plugins
+        self.assertTrue(self.pluginsLoaded)
+
+        cmds.file(new=True, force=True)
+
+    def childNames(self, hierarchy):
+        return [child.nodeName() for child in hierarchy.children()]
+
+    def testChildrenAfterResync(self):
+        '''Add, remove, reorder and deactivate the children of a prim.'''
+        psPathStr = mayaUsd_createStageWithNewLayer.createStageWithNewLayer()
+        stage = mayaUsd.lib.GetPrim(psPathStr).GetStage()
+        stage.DefinePrim('/A', 'Xform')
+        stage.DefinePrim('/A/B', 'Xform')
+        stage.DefinePrim('/A/C', 'Xform')
+
+        aItem = ufe.Hierarchy.createItem(ufe.PathString.path(psPathStr + ',/A'))
+        aHier = ufe.Hierarchy.hierarchy(aItem)
+        self.assertEqual(self.childNames(aHier), ['B', 'C'])
+
+        stage.DefinePrim('/A/D', 'Xform')
+        self.assertEqual(self.childNames(aHier), ['B', 'C', 'D'])
+
+        stage.RemovePrim('/A/C')
+        self.assertEqual(self.childNames(aHier), ['B', 'D'])
+
+        stage.GetPrimAtPath('/A').SetChildrenReorder(['D', 'B'])
+        self.assertEqual(self.childNames(aHier), ['D', 'B'])
+
+        # Inactive prims are only returned by the inactive prims filter, whose
+        # child lists are cached separately.
+        rid = ufe.RunTimeMgr.instance().getId('USD')
+        cf = ufe.RunTimeMgr.instance().hierarchyHandler(rid).childFilter()
+        cf[0].value = True
+        self.assertEqual(
+            [child.nodeName() for child in aHier.filteredChildren(cf)], ['D', 'B'])
+
+        stage.GetPrimAtPath('/A/B').SetActive(False)
+        self.assertEqual(self.childNames(aHier), ['D'])
+        self.assertEqual(
+            [child.nodeName() for child in aHier.filteredChildren(cf)], ['D', 'B'])
+
+        stage.GetPrimAtPath('/A/B').SetActive(True)
+        self.assertEqual(self.childNames(aHier), ['D', 'B'])
+
+    def testChildrenAfterStageReplaced(self):
+        '''Replace the stage of a proxy shape by one with other children.'''
+        stageCache = UsdUtils.StageCache.Get()
+
+        stageA = Usd.Stage.CreateInMemory()
+        stageA.DefinePrim('/Root', 'Xform')
+        stageA.DefinePrim('/Root/FromA', 'Xform')
+        stageB = Usd.Stage.CreateInMemory()
+        stageB.DefinePrim('/Root', 'Xform')
+        stageB.DefinePrim('/Root/FromB1', 'Xform')
+        stageB.DefinePrim('/Root/FromB2', 'Xform')
+
+        shapeNode = cmds.createNode('mayaUsdProxyShape')
+        cmds.setAttr('{}.stageCacheId'.format(shapeNode),
+                     stageCache.Insert(stageA).ToLongInt())
+        psPathStr = cmds.ls(shapeNode, long=True)[0]
+
+        rootPath = ufe.PathString.path(psPathStr + ',/Root')
+        rootHier = ufe.Hierarchy.hierarchy(ufe.Hierarchy.createItem(rootPath))
+        self.assertEqual(self.childNames(rootHier), ['FromA'])
+
+        cmds.setAttr('{}.stageCacheId'.format(shapeNode),
+                     stageCache.Insert(stageB).ToLongInt())
+        self.assertEqual(mayaUsd.lib.GetPrim(psPathStr).GetStage(), stageB)
+
+        rootHier = ufe.Hierarchy.hierarchy(ufe.Hierarchy.createItem(rootPath))
+        self.assertEqual(self.childNames(rootHier), ['FromB1', 'FromB2'])
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
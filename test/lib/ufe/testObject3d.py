@@ -530,7 +530,24 @@ class Object3dTestCase(unittest.TestCase):
         capsuleHeightAttr.Set(10.0)
 
         self.assertAlmostEqual(capsuleHeightAttr.Get(), 10.0)
-        # Extent will have been recomputed:
+        # Outside of an undo block, the extent is recomputed at idle time, so
+        # that bulk edits are batched.
+        self.assertTrue(almostEqualBBox(capsuleExtentAttr.Get(), expectedExtent))
+        cmds.flushIdleQueue()
+        capsuleExtent = capsuleExtentAttr.Get()
+        expectedExtent = ((-0.5, -0.5, -5.5), (0.5, 0.5, 5.5))
+        self.assertTrue(almostEqualBBox(capsuleExtent, expectedExtent))
+
+        # Inside an undo block, the extent is recomputed when the block closes
+        # and is undone along with the edit.
+        with mayaUsd.lib.UsdUndoBlock():
+            capsuleHeightAttr.Set(20.0)
+        capsuleExtent = capsuleExtentAttr.Get()
+        expectedExtent = ((-0.5, -0.5, -10.5), (0.5, 0.5, 10.5))
+        self.assertTrue(almostEqualBBox(capsuleExtent, expectedExtent))
+
+        cmds.undo()
+        self.assertAlmostEqual(capsuleHeightAttr.Get(), 10.0)
         capsuleExtent = capsuleExtentAttr.Get()
         expectedExtent = ((-0.5, -0.5, -5.5), (0.5, 0.5, 5.5))
         self.assertTrue(almostEqualBBox(capsuleExtent, expectedExtent))
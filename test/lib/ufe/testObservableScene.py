@@ -17,7 +17,11 @@
 #
 
 import fixturesUtils
+import mayaUtils
 
+from pxr import Sdf
+
+from maya import cmds
 from maya import standalone
 
 import ufe
@@ -120,6 +124,32 @@ class UFEObservableSceneTest(unittest.TestCase):
         #     ufe.Scene.notify(ufe.ObjectAdd(itemB))
         #     ufe.Scene.notify(ufe.ObjectAdd(itemC))
 
+    def testBatchedResync(self):
+        '''Many resyncs in a single USD notice are sent as one composite notification.'''
+        self.assertTrue(mayaUtils.isMayaUsdPluginLoaded())
+        cmds.file(new=True, force=True)
+
+        shapeNode, shapeStage = mayaUtils.createProxyAndStage()
+        shapeStage.DefinePrim('/Root', 'Xform')
+        layer = shapeStage.GetRootLayer()
+
+        snObs = TestObserver()
+        ufe.Scene.addObserver(snObs)
+
+        # Add many more prims than the default batching threshold at once.
+        with Sdf.ChangeBlock():
+            for i in range(200):
+                primSpec = Sdf.CreatePrimInLayer(layer, '/Root/Child%d' % i)
+                primSpec.specifier = Sdf.SpecifierDef
+                primSpec.typeName = 'Xform'
+
+        self.assertEqual(len(shapeStage.GetPrimAtPath('/Root').GetChildren()), 200)
+
+        # No individual add notification, a single composite one instead.
+        self.checkNotifications(snObs, [0,0,0,0,1])
+
+        ufe.Scene.removeObserver(snObs)
+
 
 if __name__ == '__main__':
     unittest.main(verbosity=2)
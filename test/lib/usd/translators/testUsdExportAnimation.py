@@ -22,7 +22,9 @@ import unittest
 import fixturesUtils
 from maya import cmds
 from maya import standalone
+from pxr import Tf
 from pxr import Usd
+from pxr import UsdUtils
 
 
 class testUsdExportAnimation(unittest.TestCase):
@@ -105,3 +107,47 @@ class testUsdExportAnimation(unittest.TestCase):
         # Make sure value is there because previous code did not write any:
         self.assertEqual(attr.Get(), [20.0, 40.0])
 
+
+    def testExportParallelWrite(self):
+        """Test that the parallel write mode goes through the thread-safe
+           transform and mesh writers and produces the same animated values
+           as the serial write."""
+        cmds.file(new=True, force=True)
+        root = cmds.group(empty=True, name="root")
+        cube, cubeMaker = cmds.polyCube(name="Cube")
+        cmds.parent(cube, root)
+        cmds.setKeyframe(root, v=0, at='translateY', time=1)
+        cmds.setKeyframe(root, v=5, at='translateY', time=10)
+        cmds.setKeyframe(cube, v=0, at='rotateX', time=1)
+        cmds.setKeyframe(cube, v=90, at='rotateX', time=10)
+        cmds.setKeyframe(cubeMaker, v=1, at='width', time=1)
+        cmds.setKeyframe(cubeMaker, v=3, at='width', time=10)
+
+        stages = []
+        for state in (False, True):
+            path = os.path.join(self.temp_dir, "parallelWrite{}.usda".format("On" if state else "Off"))
+            delegate = UsdUtils.CoalescingDiagnosticDelegate()
+            cmds.mayaUSDExport(f=path, frameRange=(1, 10), parallelWrite=state, verbose=True)
+            messages = delegate.TakeUncoalescedDiagnostics()
+            stages.append(Usd.Stage.Open(path))
+
+            # The root and Cube transforms and the Cube mesh go through the
+            # parallel write at each of the 10 frames.
+            parallelWrites = [x.commentary for x in messages
+                              if x.diagnosticCode == Tf.TF_DIAGNOSTIC_STATUS_TYPE
+                              and x.commentary.startswith('Parallel write:')]
+            if state:
+                self.assertEqual(parallelWrites, ['Parallel write: 3 prim writers'] * 10)
+            else:
+                self.assertEqual(parallelWrites, [])
+
+        for primPath, attrName in (("/root", "xformOp:translate"),
+                                   ("/root/Cube", "xformOp:rotateXYZ"),
+                                   ("/root/Cube", "points"),
+                                   ("/root/Cube", "extent")):
+            serialAttr = stages[0].GetPrimAtPath(primPath).GetAttribute(attrName)
+            parallelAttr = stages[1].GetPrimAtPath(primPath).GetAttribute(attrName)
+            self.assertEqual(serialAttr.GetTimeSamples(), list(range(1, 11)))
+            self.assertEqual(serialAttr.GetTimeSamples(), parallelAttr.GetTimeSamples())
+            for time in serialAttr.GetTimeSamples():
+                self.assertEqual(serialAttr.Get(time), parallelAttr.Get(time))
@@ -33,8 +33,8 @@ class testUsdImportMesh(unittest.TestCase):
     def setUpClass(cls):
         inputPath = fixturesUtils.readOnlySetUpClass(__file__)
 
-        usdFile = os.path.join(inputPath, "UsdImportMeshTest", "Mesh.usda")
-        cmds.usdImport(file=usdFile, shadingMode=[['none', 'default'], ])
+        cls.usdFile = os.path.join(inputPath, "UsdImportMeshTest", "Mesh.usda")
+        cmds.usdImport(file=cls.usdFile, shadingMode=[['none', 'default'], ])
 
     @classmethod
     def tearDownClass(cls):
@@ -93,5 +93,31 @@ class testUsdImportMesh(unittest.TestCase):
     def testImportLeftHandedSubdiv(self):
         self.verifySubdivCommonAttributes('LeftHandedSubdivMeshShape')
 
+    def testParallelPrefetch(self):
+        """Test that prefetching the USD data on worker threads imports the
+           same meshes as the serial import."""
+        prefetchRoot = cmds.group(empty=True, name='PrefetchRoot')
+        cmds.usdImport(file=self.usdFile, parent=prefetchRoot,
+            shadingMode=[['none', 'default'], ], parallelPrefetch=True)
+
+        try:
+            for name in ('SubdivMesh', 'LeftHandedSubdivMesh', 'PolyMesh',
+                         'IndexedNormalsMesh', 'LeftHandedPolyMesh'):
+                serialMesh = '|World|{0}|{0}Shape'.format(name)
+                prefetchedMesh = '|PrefetchRoot' + serialMesh
+                self.assertTrue(cmds.objExists(prefetchedMesh))
+
+                self.assertEqual(
+                    cmds.xform(prefetchedMesh + '.vtx[*]', q=True, objectSpace=True, translation=True),
+                    cmds.xform(serialMesh + '.vtx[*]', q=True, objectSpace=True, translation=True))
+                self.assertEqual(
+                    cmds.polyInfo(prefetchedMesh, faceToVertex=True),
+                    cmds.polyInfo(serialMesh, faceToVertex=True))
+                self.assertEqual(
+                    cmds.polyNormalPerVertex(prefetchedMesh + '.vtxFace[*][*]', q=True, xyz=True),
+                    cmds.polyNormalPerVertex(serialMesh + '.vtxFace[*][*]', q=True, xyz=True))
+        finally:
+            cmds.delete(prefetchRoot)
+
 if __name__ == '__main__':
     unittest.main(verbosity=2)
@@ -414,3 +414,42 @@ TEST(DiffAttributes, compareAttributesCreatedSampledDouble)
     compareAttributes(modifiedAttr, baselineAttr, &quickDiff);
     EXPECT_NE(quickDiff, DiffResult::Same);
 }
+
+TEST(DiffAttributes, compareAttributesParallelSampledDouble)
+{
+    SdfPath primPath("/A");
+    auto    doubleType = SdfValueTypeNames->Double;
+
+    auto baselineStage = UsdStage::CreateInMemory();
+    auto baselinePrim = baselineStage->DefinePrim(SdfPath(primPath));
+    auto baselineAttr = baselinePrim.CreateAttribute(TfToken("test_attr"), doubleType, true);
+
+    auto modifiedStage = UsdStage::CreateInMemory();
+    auto modifiedPrim = modifiedStage->DefinePrim(SdfPath(primPath));
+    auto modifiedAttr = modifiedPrim.CreateAttribute(TfToken("test_attr"), doubleType, true);
+
+    // Enough samples to be compared on the worker threads.
+    for (double time = 0.; time < 100.1; time += 1.0) {
+        baselineAttr.Set(1.0 * time, UsdTimeCode(time));
+        modifiedAttr.Set(1.0 * time, UsdTimeCode(time));
+    }
+
+    DiffResult result
+        = compareAttributes(modifiedAttr, baselineAttr, nullptr, DiffThreading::Parallel);
+
+    EXPECT_EQ(result, DiffResult::Same);
+
+    DiffResult quickDiff = DiffResult::Differ;
+    compareAttributes(modifiedAttr, baselineAttr, &quickDiff, DiffThreading::Parallel);
+    EXPECT_EQ(quickDiff, DiffResult::Same);
+
+    modifiedAttr.Set(-1.0, UsdTimeCode(100.0));
+
+    result = compareAttributes(modifiedAttr, baselineAttr, nullptr, DiffThreading::Parallel);
+
+    EXPECT_EQ(result, DiffResult::Differ);
+
+    quickDiff = DiffResult::Same;
+    compareAttributes(modifiedAttr, baselineAttr, &quickDiff, DiffThreading::Parallel);
+    EXPECT_NE(quickDiff, DiffResult::Same);
+}
@@ -0,0 +1,228 @@
+#include <mayaUsdUtils/DiffCore.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+using MayaUsdUtils::SimdIsa;
+
+namespace {
+
+const SimdIsa allIsas[] = { SimdIsa::Baseline, SimdIsa::AVX2, SimdIsa::AVX512 };
+
+// Restores the instruction set that was active when the test started.
+struct ActiveIsaGuard
+{
+    ActiveIsaGuard()
+        : _isa(MayaUsdUtils::activeSimdIsa())
+    {
+    }
+    ~ActiveIsaGuard() { MayaUsdUtils::setActiveSimdIsa(_isa); }
+
+    SimdIsa _isa;
+};
+
+std::vector<float> makeVec3s(size_t count)
+{
+    std::vector<float> a(count * 3);
+    for (size_t i = 0; i < a.size(); i += 3) {
+        a[i + 0] = 2;
+        a[i + 1] = 3;
+        a[i + 2] = 4;
+    }
+    return a;
+}
+
+std::vector<float> makeRGBAs(size_t count)
+{
+    std::vector<float> a(count * 4);
+    for (size_t i = 0; i < a.size(); i += 4) {
+        a[i + 0] = 0.1f;
+        a[i + 1] = 0.2f;
+        a[i + 2] = 0.3f;
+        a[i + 3] = 1.0f;
+    }
+    return a;
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(DiffCoreDispatch, highestSupportedIsaIsActiveByDefault)
+{
+    EXPECT_TRUE(MayaUsdUtils::isSimdIsaSupported(SimdIsa::Baseline));
+    EXPECT_TRUE(MayaUsdUtils::isSimdIsaSupported(MayaUsdUtils::highestSupportedSimdIsa()));
+    if (!getenv("MAYAUSD_SIMD_ISA")) {
+        EXPECT_EQ(MayaUsdUtils::highestSupportedSimdIsa(), MayaUsdUtils::activeSimdIsa());
+    }
+
+    ActiveIsaGuard guard;
+    for (const SimdIsa isa : allIsas) {
+        EXPECT_EQ(MayaUsdUtils::isSimdIsaSupported(isa), MayaUsdUtils::setActiveSimdIsa(isa));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Every kernel is checked for every supported instruction set, against array sizes that cover the
+// vectorised loops and all of the possible tail lengths, with a difference at every position.
+//----------------------------------------------------------------------------------------------------------------------
+TEST(DiffCoreDispatch, kernelsAgreeForAllIsas)
+{
+    ActiveIsaGuard guard;
+    for (const SimdIsa isa : allIsas) {
+        if (!MayaUsdUtils::setActiveSimdIsa(isa)) {
+            continue;
+        }
+        SCOPED_TRACE(MayaUsdUtils::simdIsaName(isa));
+
+        for (size_t count = 0; count < 70; ++count) {
+            SCOPED_TRACE(count);
+
+            // vec3AreAllTheSame
+            std::vector<float> vec3s = makeVec3s(count);
+            EXPECT_TRUE(MayaUsdUtils::vec3AreAllTheSame(vec3s.data(), count));
+            for (size_t i = 3; i < vec3s.size(); ++i) {
+                vec3s[i] += 1.0f;
+                EXPECT_FALSE(MayaUsdUtils::vec3AreAllTheSame(vec3s.data(), count));
+                vec3s[i] -= 1.0f;
+            }
+
+            // compareArray
+            std::vector<float>  f0(count), f1(count);
+            std::vector<double> d0(count), d1(count);
+            for (size_t i = 0; i < count; ++i) {
+                f0[i] = f1[i] = float(i);
+                d0[i] = d1[i] = double(i);
+            }
+            EXPECT_TRUE(MayaUsdUtils::compareArray(f0.data(), f1.data(), count, count));
+            EXPECT_TRUE(MayaUsdUtils::compareArray(d0.data(), d1.data(), count, count));
+            for (size_t i = 0; i < count; ++i) {
+                f1[i] += 1.0f;
+                d1[i] += 1.0;
+                EXPECT_FALSE(MayaUsdUtils::compareArray(f0.data(), f1.data(), count, count));
+                EXPECT_FALSE(MayaUsdUtils::compareArray(d0.data(), d1.data(), count, count));
+                f1[i] -= 1.0f;
+                d1[i] -= 1.0;
+            }
+
+            // compareUvArray
+            std::vector<float> u(count), v(count), uv(count * 2);
+            for (size_t i = 0; i < count; ++i) {
+                u[i] = uv[2 * i] = float(i);
+                v[i] = uv[2 * i + 1] = float(i) + 0.5f;
+            }
+            EXPECT_TRUE(MayaUsdUtils::compareUvArray(u.data(), v.data(), uv.data(), count, count));
+            for (size_t i = 0; i < uv.size(); ++i) {
+                uv[i] += 1.0f;
+                EXPECT_FALSE(
+                    MayaUsdUtils::compareUvArray(u.data(), v.data(), uv.data(), count, count));
+                uv[i] -= 1.0f;
+            }
+
+            // compareUvArray to a single value
+            std::vector<float> us(count, 0.25f), vs(count, 0.75f);
+            EXPECT_TRUE(MayaUsdUtils::compareUvArray(0.25f, 0.75f, us.data(), vs.data(), count));
+            for (size_t i = 0; i < count; ++i) {
+                us[i] = 0.0f;
+                EXPECT_FALSE(
+                    MayaUsdUtils::compareUvArray(0.25f, 0.75f, us.data(), vs.data(), count));
+                us[i] = 0.25f;
+                vs[i] = 0.0f;
+                EXPECT_FALSE(
+                    MayaUsdUtils::compareUvArray(0.25f, 0.75f, us.data(), vs.data(), count));
+                vs[i] = 0.75f;
+            }
+
+            // compareRGBAArray
+            std::vector<float> rgba = makeRGBAs(count);
+            EXPECT_TRUE(
+                MayaUsdUtils::compareRGBAArray(0.1f, 0.2f, 0.3f, 1.0f, rgba.data(), count));
+            for (size_t i = 0; i < rgba.size(); ++i) {
+                rgba[i] += 1.0f;
+                EXPECT_FALSE(
+                    MayaUsdUtils::compareRGBAArray(0.1f, 0.2f, 0.3f, 1.0f, rgba.data(), count));
+                rgba[i] -= 1.0f;
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Reports the throughput of each kernel for each supported instruction set. The arrays are equal,
+// so every kernel reads all of its input. Results are printed and recorded as test properties,
+// e.g. "compareArray(float).avx2" = "12.3 GB/s".
+//----------------------------------------------------------------------------------------------------------------------
+TEST(DiffCoreBenchmark, throughput)
+{
+    const size_t count = 1 << 20;
+
+    const std::vector<float>  vec3s = makeVec3s(count);
+    const std::vector<float>  f(count, 1.0f);
+    const std::vector<double> d(count, 1.0);
+    const std::vector<float>  uv(count * 2, 1.0f);
+    const std::vector<float>  rgba = makeRGBAs(count);
+
+    struct Kernel
+    {
+        const char*           name;
+        size_t                bytes;
+        std::function<bool()> run;
+    };
+    const Kernel kernels[] = {
+        { "vec3AreAllTheSame",
+          vec3s.size() * sizeof(float),
+          [&]() { return MayaUsdUtils::vec3AreAllTheSame(vec3s.data(), count); } },
+        { "compareArray(float)",
+          2 * count * sizeof(float),
+          [&]() { return MayaUsdUtils::compareArray(f.data(), f.data(), count, count); } },
+        { "compareArray(double)",
+          2 * count * sizeof(double),
+          [&]() { return MayaUsdUtils::compareArray(d.data(), d.data(), count, count); } },
+        { "compareUvArray",
+          4 * count * sizeof(float),
+          [&]() {
+              return MayaUsdUtils::compareUvArray(f.data(), f.data(), uv.data(), count, count);
+          } },
+        { "compareUvArray(value)",
+          2 * count * sizeof(float),
+          [&]() { return MayaUsdUtils::compareUvArray(1.0f, 1.0f, f.data(), f.data(), count); } },
+        { "compareRGBAArray",
+          rgba.size() * sizeof(float),
+          [&]() {
+              return MayaUsdUtils::compareRGBAArray(0.1f, 0.2f, 0.3f, 1.0f, rgba.data(), count);
+          } },
+    };
+
+    ActiveIsaGuard guard;
+    for (const Kernel& kernel : kernels) {
+        for (const SimdIsa isa : allIsas) {
+            if (!MayaUsdUtils::setActiveSimdIsa(isa)) {
+                continue;
+            }
+
+            // warm up, then time enough iterations to get a stable figure
+            ASSERT_TRUE(kernel.run());
+            using Clock = std::chrono::steady_clock;
+            size_t                        iterations = 0;
+            std::chrono::duration<double> elapsed(0);
+            const Clock::time_point       start = Clock::now();
+            while (elapsed.count() < 0.05) {
+                ASSERT_TRUE(kernel.run());
+                ++iterations;
+                elapsed = Clock::now() - start;
+            }
+
+            const double gbPerSecond = double(kernel.bytes * iterations) / elapsed.count() * 1e-9;
+            char         result[32];
+            std::snprintf(result, sizeof(result), "%.2f GB/s", gbPerSecond);
+            std::printf("%-24s %-10s %s\n", kernel.name, MayaUsdUtils::simdIsaName(isa), result);
+            ::testing::Test::RecordProperty(
+                std::string(kernel.name) + "." + MayaUsdUtils::simdIsaName(isa), result);
+        }
+    }
+}
@@ -344,3 +344,57 @@ TEST(DiffPrims, comparePrimsCreatedChildRelationship)
     comparePrimsOnly(modifiedPrim, baselinePrim, &quickDiff);
     EXPECT_EQ(quickDiff, DiffResult::Same);
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Parallel comparison.
+
+TEST(DiffPrims, comparePrimsParallel)
+{
+    // Test that comparing on the worker threads gives the same results as comparing serially.
+
+    auto baselineStage = UsdStage::CreateInMemory();
+    auto baselinePrim = createPrim(baselineStage, primPath);
+
+    auto modifiedStage = UsdStage::CreateInMemory();
+    auto modifiedPrim = createPrim(modifiedStage, primPath);
+
+    for (int i = 0; i < 100; ++i) {
+        const SdfPath childPath = primPath.AppendChild(TfToken("child" + std::to_string(i)));
+        auto          baselineChild = createChild(baselineStage, childPath, 1.0);
+        auto          modifiedChild = createChild(modifiedStage, childPath, 1.0);
+        createAttr(baselineChild, otherAttrName, double(i));
+        createAttr(modifiedChild, otherAttrName, double(i));
+    }
+
+    DiffResult result = comparePrims(modifiedPrim, baselinePrim, nullptr, DiffThreading::Parallel);
+
+    EXPECT_EQ(result, DiffResult::Same);
+
+    DiffResult quickDiff = DiffResult::Differ;
+    comparePrims(modifiedPrim, baselinePrim, &quickDiff, DiffThreading::Parallel);
+    EXPECT_EQ(quickDiff, DiffResult::Same);
+
+    // Modify a few children deep in the list.
+    auto modifiedChild = modifiedStage->GetPrimAtPath(primPath.AppendChild(TfToken("child90")));
+    createAttr(modifiedChild, 2.0);
+    createChild(modifiedStage, primPath.AppendChild(TfToken("extra")), 1.0);
+    modifiedStage->RemovePrim(primPath.AppendChild(TfToken("child10")));
+
+    const DiffResultPerPath serialResults
+        = comparePrimsChildren(modifiedPrim, baselinePrim, nullptr, DiffThreading::Serial);
+    const DiffResultPerPath parallelResults
+        = comparePrimsChildren(modifiedPrim, baselinePrim, nullptr, DiffThreading::Parallel);
+
+    EXPECT_EQ(parallelResults, serialResults);
+    EXPECT_EQ(parallelResults.at(primPath.AppendChild(TfToken("child90"))), DiffResult::Differ);
+    EXPECT_EQ(parallelResults.at(primPath.AppendChild(TfToken("extra"))), DiffResult::Created);
+    EXPECT_EQ(parallelResults.at(primPath.AppendChild(TfToken("child10"))), DiffResult::Absent);
+
+    result = comparePrims(modifiedPrim, baselinePrim, nullptr, DiffThreading::Parallel);
+
+    EXPECT_EQ(result, comparePrims(modifiedPrim, baselinePrim));
+
+    quickDiff = DiffResult::Same;
+    comparePrims(modifiedPrim, baselinePrim, &quickDiff, DiffThreading::Parallel);
+    EXPECT_NE(quickDiff, DiffResult::Same);
+}
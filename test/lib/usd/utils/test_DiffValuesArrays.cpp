@@ -311,3 +311,22 @@ TEST(DiffValuesArrays, uint64CompareValueArraysDiff)
 
     EXPECT_EQ(result, DiffResult::Differ);
 }
+
+TEST(DiffValuesArrays, doubleCompareLargeValueArraysParallel)
+{
+    // Large enough to be compared in chunks on the worker threads.
+    VtArray<double> baselineArray(200000, 1.0);
+    VtArray<double> modifiedArray(200000, 1.0);
+
+    DiffResult result
+        = compareValues(VtValue(modifiedArray), VtValue(baselineArray), DiffThreading::Parallel);
+    EXPECT_EQ(result, DiffResult::Same);
+
+    modifiedArray[modifiedArray.size() - 1] = 2.0;
+
+    result = compareValues(VtValue(modifiedArray), VtValue(baselineArray), DiffThreading::Parallel);
+    EXPECT_EQ(result, DiffResult::Differ);
+
+    result = compareValues(VtValue(modifiedArray), VtValue(baselineArray), DiffThreading::Serial);
+    EXPECT_EQ(result, DiffResult::Differ);
+}
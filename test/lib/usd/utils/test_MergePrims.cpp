@@ -4,7 +4,10 @@
 #include <pxr/base/tf/type.h>
 #include <pxr/usd/sdf/path.h>
 #include <pxr/usd/sdf/valueTypeName.h>
+#include <pxr/usd/sdf/attributeSpec.h>
 #include <pxr/usd/usd/attribute.h>
+#include <pxr/usd/usd/editContext.h>
+#include <pxr/usd/usd/inherits.h>
 #include <pxr/usd/usd/prim.h>
 #include <pxr/usd/usd/relationship.h>
 
@@ -22,6 +25,9 @@ const SdfPath primPath("/A");
 const SdfPath childPath1("/A/B");
 const SdfPath childPath2("/A/C");
 
+const SdfPath otherPath("/other");
+const SdfPath classPath("/_class");
+
 const SdfPath targetPath1("/target1");
 const SdfPath targetPath2("/target2");
 const SdfPath targetPath3("/target3");
@@ -65,6 +71,16 @@ UsdPrim createChild(UsdStageRefPtr& stage, const SdfPath& path, double value)
     return child;
 }
 
+double getLayerValue(const SdfLayerHandle& layer, const SdfPath& primPath)
+{
+    auto attrSpec = layer->GetAttributeAtPath(primPath.AppendProperty(testAttrName));
+    if (!attrSpec)
+        return 0.;
+
+    const VtValue value = attrSpec->GetDefaultValue();
+    return value.IsHolding<double>() ? value.UncheckedGet<double>() : 0.;
+}
+
 template <class ITER_RANGE> size_t rangeSize(const ITER_RANGE& range)
 {
     size_t     count = 0;
@@ -719,3 +735,90 @@ TEST(MergePrims, mergePrimsChildRelationshipAddTarget)
     EXPECT_EQ(targets[0], targetPath1);
     EXPECT_EQ(targets[1], targetPath3);
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Upper layer opinions.
+
+TEST(MergePrims, mergePrimsIgnoreUpperLayerOpinions)
+{
+    // Test that a value hidden by an upper layer opinion is merged in the destination layer,
+    // without touching the prims outside of the merged subtree.
+
+    auto baselineStage = UsdStage::CreateInMemory();
+    auto baselinePrim = createPrim(baselineStage, primPath);
+    createChild(baselineStage, childPath1, 1.0);
+    createChild(baselineStage, otherPath, 5.0);
+    {
+        UsdEditContext editContext(baselineStage, baselineStage->GetSessionLayer());
+        baselineStage->GetPrimAtPath(childPath1).GetAttribute(testAttrName).Set(2.0);
+    }
+
+    auto modifiedStage = UsdStage::CreateInMemory();
+    auto modifiedPrim = createPrim(modifiedStage, primPath);
+    createChild(modifiedStage, childPath1, 2.0);
+
+    MergePrimsOptions options;
+    options.mergeChildren = true;
+    options.ignoreUpperLayerOpinions = true;
+    options.verbosity = MergeVerbosity::Failure;
+
+    const bool result = mergePrims(
+        modifiedStage,
+        modifiedStage->GetRootLayer(),
+        modifiedPrim.GetPath(),
+        baselineStage,
+        baselineStage->GetRootLayer(),
+        baselinePrim.GetPath(),
+        options);
+
+    EXPECT_TRUE(result);
+
+    const SdfLayerHandle rootLayer = baselineStage->GetRootLayer();
+    EXPECT_EQ(getLayerValue(rootLayer, childPath1), 2.);
+    EXPECT_EQ(getLayerValue(rootLayer, otherPath), 5.);
+    EXPECT_EQ(getLayerValue(baselineStage->GetSessionLayer(), childPath1), 2.);
+}
+
+TEST(MergePrims, mergePrimsIgnoreUpperLayerOpinionsWithInherit)
+{
+    // Test that a subtree inheriting from a class elsewhere in the destination layer is merged
+    // with the opinions of that class.
+
+    auto baselineStage = UsdStage::CreateInMemory();
+    auto baselineClass = baselineStage->CreateClassPrim(classPath);
+    createAttr(baselineClass, otherAttrName, 3.0);
+    auto baselinePrim = createPrim(baselineStage, primPath);
+    baselinePrim.GetInherits().AddInherit(classPath);
+    createAttr(baselinePrim, 1.0);
+    {
+        UsdEditContext editContext(baselineStage, baselineStage->GetSessionLayer());
+        baselinePrim.GetAttribute(testAttrName).Set(2.0);
+    }
+
+    auto modifiedStage = UsdStage::CreateInMemory();
+    auto modifiedPrim = createPrim(modifiedStage, primPath);
+    createAttr(modifiedPrim, 2.0);
+    createAttr(modifiedPrim, otherAttrName, 3.0);
+
+    MergePrimsOptions options;
+    options.ignoreUpperLayerOpinions = true;
+    options.propertiesHandling = MergeMissing::Create;
+    options.verbosity = MergeVerbosity::Failure;
+
+    const bool result = mergePrims(
+        modifiedStage,
+        modifiedStage->GetRootLayer(),
+        modifiedPrim.GetPath(),
+        baselineStage,
+        baselineStage->GetRootLayer(),
+        baselinePrim.GetPath(),
+        options);
+
+    EXPECT_TRUE(result);
+
+    // The inherited attribute is identical, so it is not authored on the prim.
+    const SdfLayerHandle rootLayer = baselineStage->GetRootLayer();
+    EXPECT_EQ(getLayerValue(rootLayer, primPath), 2.);
+    EXPECT_FALSE(rootLayer->GetAttributeAtPath(primPath.AppendProperty(otherAttrName)));
+    EXPECT_TRUE(rootLayer->GetPrimAtPath(classPath));
+}